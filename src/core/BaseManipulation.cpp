@@ -44,6 +44,7 @@ BaseManipulation::BaseManipulation(){
     m_counter       = sm_baseManipulationCounter;
     m_priority      = 0;
     m_apply         = false;
+    m_dirty         = true;
     sm_baseManipulationCounter++;
 
 #if MIMMO_ENABLE_MPI
@@ -95,6 +96,7 @@ BaseManipulation::BaseManipulation(const BaseManipulation & other){
 
     m_priority      = other.m_priority;
     m_apply         = other.m_apply;
+    m_dirty         = true;
 
     //logger is ready, since another BaseManipulation other, is instantiated.
     m_log           = &bitpit::log::cout(MIMMO_LOG_FILE);
@@ -123,6 +125,7 @@ BaseManipulation & BaseManipulation::operator=(const BaseManipulation & other){
     m_outputPlot    = other.m_outputPlot;
     m_priority      = other.m_priority;
     m_apply         = other.m_apply;
+    m_dirty         = true;
 #if MIMMO_ENABLE_MPI
 	MPI_Comm_dup(other.m_communicator, &m_communicator);
 	m_rank			= other.m_rank;
@@ -381,6 +384,25 @@ BaseManipulation::isApply(){
     return (m_apply);
 }
 
+/*!
+ * \return true if the execution of the object modifies in place the geometry it is linked to
+ * (see Chain::setIncremental). Default is true if the apply feature is active (see isApply);
+ * derived classes always deforming their geometry override it.
+ */
+bool
+BaseManipulation::isModifyingGeometry(){
+    return (isApply());
+}
+
+/*!
+ * \return true if the object needs to be executed to update its results, i.e. its
+ * parameters or input links changed since its last execution.
+ */
+bool
+BaseManipulation::isDirty(){
+    return (m_dirty);
+}
+
 /*!
  * It gets if the object is activates or disable during the execution.
  * \return True/false if the object is activates or disable during the execution.
@@ -432,6 +454,7 @@ BaseManipulation::setName(std::string name){
 void
 BaseManipulation::setGeometry(MimmoSharedPointer<MimmoObject> geometry){
     m_geometry = geometry;
+    m_dirty = true;
 };
 
 /*!
@@ -462,6 +485,18 @@ BaseManipulation::setOutputPlot(std::string path){
 void
 BaseManipulation::setApply( bool flag){
     m_apply = flag;
+    m_dirty = true;
+}
+
+/*!
+ * Mark the object as dirty, i.e. it needs to be executed to update its results.
+ * Call it after changing parameters of the object outside of port connections,
+ * to force its execution in an incremental execution of a Chain.
+ * \param[in] flag true/false to mark/unmark the object as dirty
+ */
+void
+BaseManipulation::setDirty( bool flag){
+    m_dirty = flag;
 }
 
 /*!
@@ -479,6 +514,7 @@ BaseManipulation::setId(int id){
 void
 BaseManipulation::activate(){
     m_active = true;
+    m_dirty = true;
 };
 
 /*!
@@ -487,6 +523,7 @@ BaseManipulation::activate(){
 void
 BaseManipulation::disable(){
     m_active = false;
+    m_dirty = true;
 };
 
 /*!
@@ -550,7 +587,17 @@ BaseManipulation::clear(){
  */
 void
 BaseManipulation::exec(){
+    execBlock(true);
+}
 
+/*!
+ * It checks if the mandatory input ports of the object are linked.
+ * The check is skipped if MIMMO_EXPERT mode is active.
+ * An error is thrown if a mandatory port (or all the ports of a family of alternative
+ * mandatory ports) is not linked.
+ */
+void
+BaseManipulation::checkMandatoryPorts(){
     if (!MIMMO_EXPERT){
         std::map<int, std::vector<PortIn*> > families;
         std::map<int, std::vector<PortID> > familiesID;
@@ -590,18 +637,42 @@ BaseManipulation::exec(){
             itID++;
         }
     }
+}
+
+/*!
+ * Execution of the block: check of mandatory ports, execute() of the object, execution of
+ * output pins (connections), optional plotting and apply of results.
+ * At the end of the execution the object is no more dirty.
+ * \param[in] pinsOut if false the output pins are not executed; the caller is in charge
+ * to communicate the data to the linked objects through execPinsOut.
+ */
+void
+BaseManipulation::execBlock(bool pinsOut){
+
+    checkMandatoryPorts();
 
     if (m_active) execute();
 
+    if (pinsOut) execPinsOut();
+
+    if(isPlotInExecution())	plotOptionalResults();
+    if(isApply()) apply();
+
+    m_dirty = false;
+}
+
+/*!
+ * Execution of the output pins (connections) of the object.
+ * \param[in] receiver if not nullptr, only the pins linked to this object are executed.
+ */
+void
+BaseManipulation::execPinsOut(BaseManipulation * receiver){
     for (std::unordered_map<PortID, PortOut*>::iterator i=m_portOut.begin(); i!=m_portOut.end(); i++){
         std::vector<BaseManipulation*>	linked = i->second->getLink();
         if (linked.size() > 0){
-            i->second->exec();
+            i->second->exec(receiver);
         }
     }
-
-    if(isPlotInExecution())	plotOptionalResults();
-    if(isApply()) apply();
 }
 
 /*!
@@ -614,6 +685,7 @@ BaseManipulation::exec(){
 void
 BaseManipulation::absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name){
     BITPIT_UNUSED(name);
+    m_dirty = true;
 
     std::string input;
     if(slotXML.hasOption("Priority")){
@@ -821,6 +893,7 @@ void
 BaseManipulation::addPinIn(BaseManipulation* objIn, PortID portR){
     if (objIn != nullptr && m_portIn.count(portR) !=0 ){
         m_portIn[portR]->m_objLink.push_back(objIn);
+        m_dirty = true;
     }
 };
 
@@ -850,6 +923,7 @@ BaseManipulation::removePinIn(BaseManipulation* objIn, PortID portR){
         for (int i=0; i<(int)linked.size(); i++){
             if (linked[i] == objIn){
                 m_portIn[portR]->clear(i);
+                m_dirty = true;
             }
         }
     }
@@ -882,6 +956,7 @@ BaseManipulation::removePinIn(PortID portR, int j){
     if ( m_portIn.count(portR) != 0 ){
         if (j<(int)m_portIn[portR]->getLink().size() && j >= 0){
             m_portIn[portR]->clear(j);
+            m_dirty = true;
         }
     }
 }
@@ -949,6 +1024,8 @@ MPI_Comm &  BaseManipulation::getCommunicator(){
 
 /*!
  * Apply a deformation displacements field to the linked geometry.
+ * Displacements are added to a copy of the contiguous coordinates view of the geometry,
+ * which is written back to the vertices in one pass.
  * After the method call the geometry is permanently modified.
  * \param[in] displacements deformation vector field
  */
@@ -956,14 +1033,17 @@ void
 BaseManipulation::_apply(MimmoPiercedVector<darray3E> & displacements)
 {
     if (getGeometry() == nullptr) return;
-    darray3E vertexcoords;
-    long int ID;
-    for (const auto & vertex : getGeometry()->getVertices()){
-        vertexcoords = vertex.getCoords();
-        ID = vertex.getId();
-        if(displacements.exists(ID))     vertexcoords += displacements[ID];
-        getGeometry()->modifyVertex(vertexcoords, ID);
+    const VertexCoordsSoA & coords = getGeometry()->getVerticesCoordsSoA();
+    dvector1D x(coords.x), y(coords.y), z(coords.z);
+    for (auto it = displacements.begin(); it != displacements.end(); ++it){
+        auto found = coords.indices.find(it.getId());
+        if (found == coords.indices.end())  continue;
+        std::size_t index = found->second;
+        x[index] += (*it)[0];
+        y[index] += (*it)[1];
+        z[index] += (*it)[2];
     }
+    getGeometry()->modifyVerticesCoords(std::move(x), std::move(y), std::move(z));
 
     // Update geometry
     getGeometry()->update();
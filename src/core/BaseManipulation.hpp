@@ -98,6 +98,11 @@ namespace mimmo{
  * - <B>OutputPlot</B>: target directory for optional results writing.
  *
  * All BaseManipulation derived classes inherite these attributes.
+ *
+ * Each object carries a dirty flag (see isDirty/setDirty), used by incremental execution of a Chain.
+ * The flag is set at construction, when input pins are added/removed, when geometry, activation or
+ * apply feature are changed, when parameters are changed through the set/add/remove methods of the
+ * derived classes or absorbed from XML; it is reset at the end of each execution.
  */
 class BaseManipulation{
 
@@ -120,7 +125,11 @@ class BaseManipulation{
     /*!
      * see PortOut::exec
      */
-    friend void PortOut::exec();
+    friend void PortOut::exec(BaseManipulation * receiver);
+    /*!
+     * Chain executes blocks and their pins step by step
+     */
+    friend class Chain;
     /*!
      * see mimmo::setLogger
      */
@@ -157,6 +166,7 @@ protected:
     bool                        m_execPlot;      /**<Activate plotting of optional result directly in execution.*/
     bool                        m_apply;         /**<Activate apply result directly in execution.*/
     std::string                 m_outputPlot;    /**<Define path for plotting optional results in execution.*/
+    bool                        m_dirty;         /**<True if the object needs to be executed to update its results.*/
 
     bitpit::Logger*             m_log;           /**<Pointer to logger.*/
 
@@ -208,6 +218,8 @@ public:
     bool    isPlotInExecution();
     bool    isActive();
     bool    isApply();
+    bool    isDirty();
+    virtual bool isModifyingGeometry();
     int     getId();
 
     void	setLog(bitpit::Logger& log);
@@ -218,6 +230,7 @@ public:
     void    setOutputPlot(std::string path);
     void    setId(int );
     void    setApply(bool flag = true);
+    void    setDirty(bool flag = true);
 
     void    activate();
     void    disable();
@@ -259,6 +272,10 @@ protected:
     template<typename T, typename O>
     bool    createPortIn(O* obj, void (O::*setVar_)(T), PortID portR, bool mandatory = false, int family = 0);
 
+    void    checkMandatoryPorts();
+    void    execBlock(bool pinsOut = true);
+    void    execPinsOut(BaseManipulation * receiver = nullptr);
+
     void    setBufferIn(PortID port, mimmo::IBinaryStream& input);
     void    readBufferIn(PortID port);
     void    cleanBufferIn(PortID port);
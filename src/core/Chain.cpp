@@ -22,6 +22,8 @@
  *
 \*---------------------------------------------------------------------------*/
 #include "Chain.hpp"
+#include <algorithm>
+#include <unordered_map>
 
 namespace mimmo{
 
@@ -39,6 +41,8 @@ Chain::Chain(){
     sm_chaincounter++;
     m_plotDebRes = false;
     m_outputDebRes = ".";
+    m_execMode = ChainExecMode::SERIAL;
+    m_incremental = false;
     m_log = &bitpit::log::cout(MIMMO_LOG_FILE);
 };
 
@@ -62,6 +66,8 @@ void Chain::swap(Chain & x) noexcept{
     std::swap(m_objcounter,x.m_objcounter);
     std::swap(m_plotDebRes,x.m_plotDebRes);
     std::swap(m_outputDebRes,x.m_outputDebRes);
+    std::swap(m_execMode,x.m_execMode);
+    std::swap(m_incremental,x.m_incremental);
 };
 
 /*!
@@ -73,6 +79,8 @@ std::unique_ptr<Chain>  Chain::clone() const{
     std::unique_ptr<Chain> res(new Chain());
     res->setOutputDebugResults(m_outputDebRes);
     res->setPlotDebugResults(m_plotDebRes);
+    res->setExecMode(m_execMode);
+    res->setIncremental(m_incremental);
 
     int count(0);
     for(BaseManipulation * pp : m_objects){
@@ -272,6 +280,47 @@ std::string Chain::getOutputDebugResults(){
     return m_outputDebRes;
 }
 
+/*!
+ * Set the execution mode of the chain. ChainExecMode::TASKGRAPH is available only
+ * in builds with OpenMP support; otherwise the chain is executed serially.
+ * \param[in] mode execution mode of the chain
+ */
+void Chain::setExecMode(ChainExecMode mode){
+#if !MIMMO_ENABLE_OPENMP
+    if (mode == ChainExecMode::TASKGRAPH){
+        (*m_log) << "warning: chain task graph execution not available without OpenMP support -> serial execution is used" << std::endl;
+        mode = ChainExecMode::SERIAL;
+    }
+#endif
+    m_execMode = mode;
+}
+
+/*!
+ * \return execution mode of the chain
+ */
+ChainExecMode Chain::getExecMode(){
+    return m_execMode;
+}
+
+/*!
+ * Activate incremental execution of the chain. If active, an object of the chain is
+ * executed only if it is dirty (see BaseManipulation::isDirty), if at least one of its
+ * parents in the chain is executed during the current run or if at least one of its
+ * descendants modifying in place its geometry (see BaseManipulation::isModifyingGeometry)
+ * is executed; otherwise it is skipped and its children reuse its current outputs.
+ * \param[in] active true/false to activate incremental execution
+ */
+void Chain::setIncremental(bool active){
+    m_incremental = active;
+}
+
+/*!
+ * \return true if incremental execution of the chain is active.
+ */
+bool Chain::isIncremental(){
+    return m_incremental;
+}
+
 
 /*!
  * It executes the chain, i.e. it executes all the manipulator objects
@@ -299,6 +348,27 @@ Chain::exec(bool debug){
     }
     (*m_log) << " " << std::endl;
     checkLoops();
+
+    if (m_execMode == ChainExecMode::TASKGRAPH || m_incremental){
+        if(m_plotDebRes){
+            for (it = itb; it != itend; ++it){
+                (*it)->setPlotInExecution(m_plotDebRes);
+                (*it)->setOutputPlot(m_outputDebRes);
+            }
+        }
+        try{
+            execTaskGraph();
+        }catch(...){
+            m_log->setPriority(oldPriority);
+            throw;
+        }
+        (*m_log) << " " << std::endl;
+        (*m_log) << "--------------------------------------------------" << std::endl;
+        (*m_log) << " " << std::endl;
+        m_log->setPriority(oldPriority);
+        return;
+    }
+
     int i = 1;
     for (it = itb; it != itend; ++it){
         if(debug)
@@ -351,4 +421,247 @@ Chain::checkLoops(){
     }
 }
 
+/*!
+ * It builds the dependency graph of the objects contained in the chain,
+ * using their parent/child links.
+ * \param[out] graph dependency graph of the chain
+ */
+void
+Chain::buildTaskGraph(TaskGraph & graph){
+    int nobj = m_objects.size();
+    std::unordered_map<BaseManipulation*, int> index;
+    for (int i=0; i<nobj; i++){
+        index[m_objects[i]] = i;
+    }
+
+    graph.parents.clear();
+    graph.children.clear();
+    graph.external.clear();
+    graph.parents.resize(nobj);
+    graph.children.resize(nobj);
+    graph.external.resize(nobj);
+    graph.pending.assign(nobj, 0);
+    graph.run.assign(nobj, 1);
+    graph.failed = 0;
+    graph.error = nullptr;
+    graph.pinLocks.reset(new std::mutex[nobj]);
+    graph.geometryLocks.clear();
+
+    for (int i=0; i<nobj; i++){
+        BaseManipulation * obj = m_objects[i];
+        for (int j=0; j<obj->getNParent(); j++){
+            auto it = index.find(obj->getParent(j));
+            if (it != index.end()){
+                graph.parents[i].push_back(it->second);
+            }
+        }
+        for (int j=0; j<obj->getNChild(); j++){
+            BaseManipulation * child = obj->getChild(j);
+            auto it = index.find(child);
+            if (it != index.end()){
+                graph.children[i].push_back(it->second);
+            }else{
+                graph.external[i].push_back(child);
+            }
+        }
+        std::sort(graph.parents[i].begin(), graph.parents[i].end());
+        std::sort(graph.children[i].begin(), graph.children[i].end());
+        graph.pending[i] = graph.parents[i].size();
+    }
+}
+
+/*!
+ * It evaluates the objects of the chain to be executed in the current run.
+ * In incremental execution an object is executed if it is dirty or if one of its parents is executed.
+ * Moreover, all the ancestors of an executed object modifying in place its geometry are executed,
+ * in order to provide again the geometry before its modification.
+ * Since the chain order is a topological order of the dependency graph, the evaluation is
+ * performed by forward (parents to children) and backward (children to parents) sweeps,
+ * repeated until no new object is marked for execution.
+ * \param[in,out] graph dependency graph of the chain
+ */
+void
+Chain::evalRunObjects(TaskGraph & graph){
+    int nobj = m_objects.size();
+    if (!m_incremental){
+        graph.run.assign(nobj, 1);
+        return;
+    }
+
+    for (int i=0; i<nobj; i++){
+        graph.run[i] = m_objects[i]->isDirty();
+    }
+
+    std::vector<int> refresh(nobj, 0);
+    bool changed = true;
+    while (changed){
+        changed = false;
+        for (int i=0; i<nobj; i++){
+            for (int parent : graph.parents[i]){
+                if (graph.run[parent] && !graph.run[i]){
+                    graph.run[i] = 1;
+                    changed = true;
+                }
+            }
+        }
+        for (int i=nobj-1; i>=0; i--){
+            if (!refresh[i] && !(graph.run[i] && m_objects[i]->isModifyingGeometry())) continue;
+            for (int parent : graph.parents[i]){
+                if (!refresh[parent] || !graph.run[parent]){
+                    refresh[parent] = 1;
+                    graph.run[parent] = 1;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * It executes the objects of the chain following their dependency graph.
+ * In ChainExecMode::TASKGRAPH mode each object is executed as soon as all its parents in the chain
+ * are executed, concurrently with the other ready objects. If an object execution fails, its dependent
+ * objects are not executed and the first exception thrown is rethrown at the end of the execution.
+ * In ChainExecMode::SERIAL mode the objects are executed in chain order.
+ */
+void
+Chain::execTaskGraph(){
+    TaskGraph graph;
+    buildTaskGraph(graph);
+    evalRunObjects(graph);
+
+#if MIMMO_ENABLE_OPENMP
+    if (m_execMode == ChainExecMode::TASKGRAPH){
+#pragma omp parallel shared(graph)
+        {
+#pragma omp single
+            {
+                for (int i=0; i<(int)m_objects.size(); i++){
+                    if (graph.pending[i] == 0){
+#pragma omp task firstprivate(i) shared(graph)
+                        execTask(i, graph);
+                    }
+                }
+            }
+        }
+
+        if (graph.error){
+            std::rethrow_exception(graph.error);
+        }
+        return;
+    }
+#endif
+
+    for (int i=0; i<(int)m_objects.size(); i++){
+        execNode(i, graph);
+    }
+}
+
+/*!
+ * It executes an object of the chain during a dependency graph execution.
+ * The object is skipped if it is not marked for execution in the current run (see evalRunObjects).
+ * The object receives the data of the pins from its parents in chain order, then it is executed
+ * and it communicates its data to the linked objects not contained in the chain.
+ * The communication from a parent is serialized with the other children of the same parent, and
+ * the execution is serialized with the other objects linked to the same geometry.
+ * \param[in] idx index of the object in the chain
+ * \param[in,out] graph dependency graph of the chain
+ */
+void
+Chain::execNode(int idx, TaskGraph & graph){
+    BaseManipulation * obj = m_objects[idx];
+
+    if (!graph.run[idx]){
+#if MIMMO_ENABLE_OPENMP
+#pragma omp critical (mimmo_chain_log)
+#endif
+        (*m_log) << " skipping object " << idx+1 << "	: " << obj->getName() << " (up to date)" << std::endl;
+        return;
+    }
+
+#if MIMMO_ENABLE_OPENMP
+#pragma omp critical (mimmo_chain_log)
+#endif
+    (*m_log) << " execution object " << idx+1 << "	: " << obj->getName() << std::endl;
+
+    // sibling objects receive the data of a common parent one at a time
+    for (int parent : graph.parents[idx]){
+        std::lock_guard<std::mutex> pinLock(graph.pinLocks[parent]);
+        m_objects[parent]->execPinsOut(obj);
+    }
+
+    // objects linked to the same geometry are executed one at a time
+    std::unique_lock<std::mutex> geometryLock;
+    MimmoObject * geometry = obj->getGeometry().get();
+    if (geometry){
+        std::mutex * lock;
+        {
+            std::lock_guard<std::mutex> guard(graph.geometryLocksGuard);
+            std::unique_ptr<std::mutex> & entry = graph.geometryLocks[geometry];
+            if (!entry) entry.reset(new std::mutex());
+            lock = entry.get();
+        }
+        geometryLock = std::unique_lock<std::mutex>(*lock);
+    }
+
+    obj->execBlock(false);
+    for (BaseManipulation * external : graph.external[idx]){
+#if MIMMO_ENABLE_OPENMP
+#pragma omp critical (mimmo_chain_external_pins)
+#endif
+        obj->execPinsOut(external);
+    }
+}
+
+/*!
+ * It executes an object of the chain as a task of a task graph execution.
+ * Once the object is executed, the children whose parents are all executed are scheduled for execution.
+ * \param[in] idx index of the object in the chain
+ * \param[in,out] graph dependency graph of the chain
+ */
+void
+Chain::execTask(int idx, TaskGraph & graph){
+    int failed;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp flush
+#pragma omp atomic read
+#endif
+    failed = graph.failed;
+
+    if (!failed){
+        try{
+            execNode(idx, graph);
+        }catch(...){
+#if MIMMO_ENABLE_OPENMP
+#pragma omp critical (mimmo_chain_error)
+#endif
+            {
+                if (!graph.error) graph.error = std::current_exception();
+            }
+#if MIMMO_ENABLE_OPENMP
+#pragma omp atomic write
+#endif
+            graph.failed = 1;
+        }
+    }
+
+#if MIMMO_ENABLE_OPENMP
+#pragma omp flush
+#endif
+    for (int child : graph.children[idx]){
+        int left;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif
+        left = --graph.pending[child];
+        if (left == 0){
+            TaskGraph * pgraph = &graph;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp task firstprivate(child, pgraph)
+#endif
+            execTask(child, *pgraph);
+        }
+    }
+}
+
 }
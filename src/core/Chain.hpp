@@ -26,9 +26,21 @@
 
 #include "BaseManipulation.hpp"
 #include <memory>
+#include <exception>
+#include <map>
+#include <mutex>
 
 namespace mimmo{
 
+/*!
+ * \ingroup core
+ * \brief Execution mode of the blocks of a Chain.
+ */
+enum class ChainExecMode{
+    SERIAL = 0,     /**< execute blocks one after another following the chain order (deterministic).*/
+    TASKGRAPH = 1   /**< execute concurrently independent blocks, following parent/child dependencies (OpenMP builds only).*/
+};
+
 /*!
  * \class Chain
  * \ingroup core
@@ -44,6 +56,27 @@ namespace mimmo{
  * conflicts in parent/child dependencies.
  * Closed connections loops in the chain are not allowed.
  *
+ * In builds with OpenMP support the chain can be executed in ChainExecMode::TASKGRAPH mode:
+ * the dependency graph of the objects is built from their parent/child links and every object
+ * is executed as soon as all its parents in the chain are executed, concurrently with the
+ * other ready objects. Data of the pins are received by an object from its parents in chain order,
+ * just before its execution, so the data received are the same of the serial execution.
+ * Objects linked to the same geometry (see BaseManipulation::getGeometry) are never executed
+ * concurrently, since the geometry can be modified in place and its search trees and cached
+ * data are built lazily; the pins of an object are communicated to one child at a time.
+ * Objects executed concurrently must not modify geometries linked to other objects in other ways
+ * (e.g. through secondary geometry ports), and log messages of concurrent objects may be interleaved.
+ * The default ChainExecMode::SERIAL mode keeps the deterministic sequential execution.
+ *
+ * Incremental execution (setIncremental) can be activated in both modes, to re-execute
+ * a chain several times changing only a few parameters: objects that are not dirty
+ * (see BaseManipulation::isDirty) and whose parents are not re-executed are skipped,
+ * and their children reuse the data already stored in them.
+ * Objects modifying in place their geometry (see BaseManipulation::isModifyingGeometry) force
+ * the re-execution of all their ancestors in the chain, so that the geometry is provided again
+ * unmodified before being deformed; geometries not provided by objects of the chain are
+ * modified run after run.
+ *
  */
 class Chain{
 
@@ -53,6 +86,8 @@ protected:
 	std::vector<BaseManipulation*>	m_objects;			/**<Pointers to manipulation objects placed in the current execution chain. */
 	std::vector<int>				m_idObjects;		/**<ID (order of insertion) of the mimmo objects in the chain. */
 	uint32_t						m_objcounter;		/**<Counter of objects inserted the chain.*/
+    ChainExecMode                   m_execMode;         /**<Execution mode of the chain.*/
+    bool                            m_incremental;      /**<True if only dirty objects and their dependants are executed.*/
 
     bitpit::Logger*                 m_log;              /**<Pointer to logger.*/
 
@@ -85,15 +120,42 @@ public:
     bool            isPlottingDebugResults();
     std::string     getOutputDebugResults();
 
+    void            setExecMode(ChainExecMode mode);
+    ChainExecMode   getExecMode();
+    void            setIncremental(bool active);
+    bool            isIncremental();
+
 	//relationship methods
 	void 		exec(bool debug = false);
 	void 		exec(int idobj);
 
 protected:
+    /*!
+     * \brief Dependency graph of the objects of the chain, used in task graph execution.
+     */
+    struct TaskGraph{
+        std::vector<std::vector<int> >                  parents;    /**<Indices of parents in the chain of each object, in chain order.*/
+        std::vector<std::vector<int> >                  children;   /**<Indices of children in the chain of each object, in chain order.*/
+        std::vector<std::vector<BaseManipulation*> >    external;   /**<Children of each object not contained in the chain.*/
+        std::vector<int>                                pending;    /**<Number of parents of each object still to be executed.*/
+        std::vector<int>                                run;        /**<Not zero if the object has to be executed in the current run.*/
+        int                                             failed;     /**<Not zero if an object execution failed.*/
+        std::exception_ptr                              error;      /**<First exception thrown by an object execution.*/
+        std::unique_ptr<std::mutex[]>                   pinLocks;   /**<Locks serializing the communication of the pins of each object to its children.*/
+        std::map<MimmoObject*, std::unique_ptr<std::mutex> > geometryLocks; /**<Locks serializing the execution of objects sharing the same geometry.*/
+        std::mutex                                      geometryLocksGuard; /**<Lock protecting the insertion of new geometry locks.*/
+    };
+
     void swap(Chain &x) noexcept;
     //check methods
 	void		checkLoops();
 
+    void        execTaskGraph();
+    void        buildTaskGraph(TaskGraph & graph);
+    void        evalRunObjects(TaskGraph & graph);
+    void        execNode(int idx, TaskGraph & graph);
+    void        execTask(int idx, TaskGraph & graph);
+
 private:
     // preventing copy constr and assignment. use clone instead.
     Chain(const Chain & other);
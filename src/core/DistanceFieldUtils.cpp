@@ -0,0 +1,495 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+# include "DistanceFieldUtils.hpp"
+# include "SkdTreeUtils.hpp"
+# if MIMMO_ENABLE_MPI
+# include "communications.hpp"
+# endif
+# include <queue>
+
+namespace mimmo{
+
+namespace distanceFieldUtils{
+
+/*!
+ * \brief INTERNAL use. Graph of the nodes (points or cell centroids) of a mesh, with
+ * consecutive local indexing and adjacency stored in CSR format.
+ */
+struct MarchingGraph{
+    std::vector<long>   ids;        /**< ids of the nodes.*/
+    lilimap             index;      /**< local index of each node id.*/
+    dvecarr3E           coords;     /**< coordinates of the nodes.*/
+    std::vector<long>   offsets;    /**< offsets of the neighbours of each node.*/
+    std::vector<long>   neighs;     /**< neighbours of the nodes, in local indices.*/
+};
+
+/*!
+ * \brief INTERNAL use. State of the nodes during the marching.
+ */
+struct MarchingField{
+    dvector1D           dist;       /**< current distance of the nodes.*/
+    dvecarr3E           foot;       /**< closest point on the surface of the nodes.*/
+    std::vector<long>   cell;       /**< local surface cell owning the foot, NULL_ID if unknown.*/
+    std::vector<char>   hasFoot;    /**< true if the foot of the node is known.*/
+};
+
+/*!
+ * \brief INTERNAL use. Min-priority queue of (distance, node) pairs.
+ */
+typedef std::priority_queue<std::pair<double,long>, std::vector<std::pair<double,long> >,
+                            std::greater<std::pair<double,long> > > MarchingQueue;
+
+/*!
+ * INTERNAL use. Fill the graph of the points of a mesh, neighbours being given by
+ * the point connectivity. Ghost points are included.
+ * \param[in] mesh target mesh
+ * \param[out] graph points graph
+ */
+static void
+buildPointsGraph(MimmoObject & mesh, MarchingGraph & graph)
+{
+    if (mesh.getPointConnectivitySyncStatus() != SyncStatus::SYNC)
+        mesh.buildPointConnectivity();
+
+    bitpit::PiercedVector<bitpit::Vertex> & vertices = mesh.getVertices();
+    std::size_t n = vertices.size();
+    graph.ids.reserve(n);
+    graph.coords.reserve(n);
+    graph.index.reserve(n);
+    for (const bitpit::Vertex & vertex : vertices){
+        graph.index[vertex.getId()] = graph.ids.size();
+        graph.ids.push_back(vertex.getId());
+        graph.coords.push_back(vertex.getCoords());
+    }
+
+    graph.offsets.assign(n+1, 0);
+    // point clouds have no connectivity: the marching reduces to the seeds.
+    bool connected = (mesh.getType() != 3);
+    for (std::size_t i = 0; i < n; ++i){
+        if (connected){
+            for (long idN : mesh.getPointConnectivity(graph.ids[i])){
+                auto it = graph.index.find(idN);
+                if (it != graph.index.end())    graph.neighs.push_back(it->second);
+            }
+        }
+        graph.offsets[i+1] = graph.neighs.size();
+    }
+}
+
+/*!
+ * INTERNAL use. Fill the graph of the cell centroids of a mesh, neighbours being the
+ * face neighbours of the cells. Ghost cells are included.
+ * \param[in] mesh target mesh
+ * \param[out] graph cells graph
+ */
+static void
+buildCellsGraph(MimmoObject & mesh, MarchingGraph & graph)
+{
+    if (mesh.getAdjacenciesSyncStatus() != SyncStatus::SYNC)
+        mesh.updateAdjacencies();
+
+    bitpit::PatchKernel * patch = mesh.getPatch();
+    std::size_t n = patch->getCells().size();
+    graph.ids.reserve(n);
+    graph.coords.reserve(n);
+    graph.index.reserve(n);
+    for (const bitpit::Cell & cell : patch->getCells()){
+        graph.index[cell.getId()] = graph.ids.size();
+        graph.ids.push_back(cell.getId());
+        graph.coords.push_back(patch->evalCellCentroid(cell.getId()));
+    }
+
+    graph.offsets.assign(n+1, 0);
+    for (std::size_t i = 0; i < n; ++i){
+        for (long idN : patch->findCellNeighs(graph.ids[i], 1)){
+            auto it = graph.index.find(idN);
+            if (it != graph.index.end())    graph.neighs.push_back(it->second);
+        }
+        graph.offsets[i+1] = graph.neighs.size();
+    }
+}
+
+/*!
+ * INTERNAL use. Try to lower the distance of a node moving its closest surface cell
+ * to the neighbours of the current one, until no neighbour is closer (local search).
+ * \param[in] i local index of the node
+ * \param[in] graph mesh graph
+ * \param[in,out] field marching state
+ * \param[in] surface surface patch
+ * \param[in,out] surfaceNeighs cache of the neighbours of the surface cells
+ */
+static void
+refineFoot(long i, const MarchingGraph & graph, MarchingField & field, const bitpit::PatchKernel & surface,
+           std::unordered_map<long, livector1D> & surfaceNeighs)
+{
+    // the search follows a descent path on the surface, the cap only protects
+    // from cycles between cells at the same distance.
+    const int maxSteps = 64;
+    long best = field.cell[i];
+    double bestDist = field.dist[i];
+    darray3E bestFoot = field.foot[i], foot;
+    for (int step = 0; step < maxSteps; ++step){
+        auto it = surfaceNeighs.find(best);
+        if (it == surfaceNeighs.end()){
+            it = surfaceNeighs.emplace(best, surface.findCellNeighs(best)).first;
+        }
+        long current = best;
+        for (long idS : it->second){
+            double d = skdTreeUtils::distanceFromSurfaceCell(graph.coords[i], surface, idS, foot);
+            if (d < bestDist*(1.0 - 1.0E-12)){
+                bestDist = d;
+                best = idS;
+                bestFoot = foot;
+            }
+        }
+        if (best == current) break;
+    }
+    field.dist[i] = bestDist;
+    field.cell[i] = best;
+    field.foot[i] = bestFoot;
+}
+
+/*!
+ * INTERNAL use. Fast marching of the distance: nodes are accepted in increasing
+ * distance order and each of them tries to lower the distance of its neighbours
+ * by transporting its closest surface cell (or its foot, if the cell is not local).
+ * \param[in] graph mesh graph
+ * \param[in,out] field marching state
+ * \param[in,out] queue nodes to be processed
+ * \param[in] surface surface patch
+ * \param[in] maxdist threshold distance
+ * \param[in,out] surfaceNeighs cache of the neighbours of the surface cells
+ */
+static void
+march(const MarchingGraph & graph, MarchingField & field, MarchingQueue & queue,
+      const bitpit::PatchKernel & surface, double maxdist, std::unordered_map<long, livector1D> & surfaceNeighs)
+{
+    darray3E foot;
+    while (!queue.empty()){
+        double d = queue.top().first;
+        long i = queue.top().second;
+        queue.pop();
+        // lazy deletion of superseded entries
+        if (d > field.dist[i]) continue;
+
+        if (field.cell[i] != bitpit::Cell::NULL_ID){
+            refineFoot(i, graph, field, surface, surfaceNeighs);
+        }
+
+        for (long k = graph.offsets[i]; k < graph.offsets[i+1]; ++k){
+            long j = graph.neighs[k];
+            double edge = norm2(graph.coords[j] - graph.coords[i]);
+            double candidate;
+            if (field.cell[i] != bitpit::Cell::NULL_ID){
+                candidate = skdTreeUtils::distanceFromSurfaceCell(graph.coords[j], surface, field.cell[i], foot);
+            } else if (field.hasFoot[i]){
+                foot = field.foot[i];
+                candidate = norm2(graph.coords[j] - foot);
+            } else {
+                candidate = field.dist[i] + edge;
+            }
+
+            // the distance from a transported cell overestimates the one of the node until
+            // its local search: a slack of one edge keeps the nodes just inside maxdist.
+            if (candidate < maxdist + edge && candidate < field.dist[j]*(1.0 - 1.0E-12)){
+                field.dist[j] = candidate;
+                field.foot[j] = foot;
+                field.cell[j] = field.cell[i];
+                field.hasFoot[j] = (field.cell[i] != bitpit::Cell::NULL_ID) || field.hasFoot[i];
+                queue.push(std::make_pair(candidate, j));
+            }
+        }
+    }
+}
+
+#if MIMMO_ENABLE_MPI
+/*!
+ * INTERNAL use. Send the distances, feet and closest surface cells of the interior nodes
+ * to their ghost copies. During the marching a ghost whose received distance is lower than
+ * its current one is updated and queued for a new marching; once the marching converged,
+ * ghosts are overwritten with the values of their owners, so that ghost and interior values
+ * of the same node are equal.
+ * The closest surface cell received is kept only if the same cell is available on the local
+ * surface, i.e. its distance from the node matches the received one; otherwise the ghost
+ * transports the foot only.
+ * \param[in] mesh target mesh
+ * \param[in] onPoints true if the nodes are points, false if cells
+ * \param[in] graph mesh graph
+ * \param[in,out] field marching state
+ * \param[in,out] queue nodes to be processed
+ * \param[in] surface surface patch
+ * \param[in] overwrite true to overwrite the ghosts unconditionally (no node is queued)
+ * \return true if at least a ghost is updated
+ */
+static bool
+exchangeGhosts(MimmoObject & mesh, bool onPoints, const MarchingGraph & graph, MarchingField & field, MarchingQueue & queue,
+               const bitpit::PatchKernel & surface, bool overwrite)
+{
+    std::unique_ptr<bitpit::DataCommunicator> dataCommunicator(new bitpit::DataCommunicator(mesh.getCommunicator()));
+
+    std::unordered_map<int, std::vector<long>> sources, targets;
+    if (onPoints){
+        sources = mesh.getPatch()->getGhostVertexExchangeSources();
+        targets = mesh.getPatch()->getGhostVertexExchangeTargets();
+    } else {
+        sources = mesh.getPatch()->getGhostCellExchangeSources();
+        targets = mesh.getPatch()->getGhostCellExchangeTargets();
+    }
+
+    // distance, foot flag, foot coordinates and closest surface cell
+    std::size_t exchangeDataSize = 5*sizeof(double) + sizeof(long);
+
+    for (const auto & entry : sources) {
+        const int rank = entry.first;
+        auto & list = entry.second;
+        dataCommunicator->setSend(rank, list.size() * exchangeDataSize);
+        bitpit::SendBuffer & buffer = dataCommunicator->getSendBuffer(rank);
+        for (long id : list) {
+            long i = graph.index.at(id);
+            buffer << field.dist[i] << double(field.hasFoot[i]);
+            buffer << field.foot[i][0] << field.foot[i][1] << field.foot[i][2];
+            buffer << field.cell[i];
+        }
+        dataCommunicator->startSend(rank);
+    }
+
+    dataCommunicator->discoverRecvs();
+    dataCommunicator->startAllRecvs();
+
+    const bitpit::PiercedVector<bitpit::Cell> & surfaceCells = surface.getCells();
+    bool changed = false;
+    double dist, hasFoot;
+    darray3E foot, localFoot;
+    long cell;
+    int nCompletedRecvs = 0;
+    while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
+        int rank = dataCommunicator->waitAnyRecv();
+        const auto & list = targets.at(rank);
+        bitpit::RecvBuffer & buffer = dataCommunicator->getRecvBuffer(rank);
+        for (long id : list) {
+            buffer >> dist >> hasFoot;
+            buffer >> foot[0] >> foot[1] >> foot[2];
+            buffer >> cell;
+            long i = graph.index.at(id);
+            if (overwrite || dist < field.dist[i]*(1.0 - 1.0E-12)){
+                changed = changed || (dist != field.dist[i]);
+                field.dist[i] = dist;
+                field.foot[i] = foot;
+                field.hasFoot[i] = (hasFoot > 0.5);
+                if (cell != bitpit::Cell::NULL_ID && surfaceCells.exists(cell)
+                    && std::abs(skdTreeUtils::distanceFromSurfaceCell(graph.coords[i], surface, cell, localFoot) - dist) <= 1.0E-12*std::max(1.0, dist)){
+                    field.cell[i] = cell;
+                } else {
+                    field.cell[i] = bitpit::Cell::NULL_ID;
+                }
+                if (!overwrite) queue.push(std::make_pair(dist, i));
+            }
+        }
+        ++nCompletedRecvs;
+    }
+
+    dataCommunicator->waitAllSends();
+    dataCommunicator->finalize();
+
+    return changed;
+}
+#endif
+
+/*!
+ * INTERNAL use. Compute the distance field of a surface on the points or on the cells of a mesh.
+ * \param[in] mesh target mesh
+ * \param[in] surface surface mesh
+ * \param[in] maxdist threshold distance
+ * \param[in] seedlist (optional) list of seed nodes
+ * \param[in] onPoints true to compute on points, false on cell centroids
+ * \return distances of the nodes within maxdist from the surface
+ */
+static bitpit::PiercedVector<double>
+computeDistance(MimmoObject & mesh, MimmoObject & surface, double maxdist, const livector1D * seedlist, bool onPoints)
+{
+    bitpit::PiercedVector<double> result;
+    if (surface.getType() != 1) return result;
+    if (!onPoints && mesh.getType() == 3) return result;
+    // point clouds need seeds to start from
+    if (seedlist == nullptr && mesh.getType() == 3) return result;
+
+    if (surface.getAdjacenciesSyncStatus() != SyncStatus::SYNC)
+        surface.updateAdjacencies();
+
+    if (surface.getSkdTreeSyncStatus() != SyncStatus::SYNC)
+        surface.buildSkdTree();
+
+    if (seedlist == nullptr && mesh.getSkdTreeSyncStatus() != SyncStatus::SYNC)
+        mesh.buildSkdTree();
+
+    MarchingGraph graph;
+    if (onPoints){
+        buildPointsGraph(mesh, graph);
+    } else {
+        buildCellsGraph(mesh, graph);
+    }
+
+    std::size_t n = graph.ids.size();
+    MarchingField field;
+    field.dist.assign(n, std::numeric_limits<double>::max());
+    field.foot.assign(n, darray3E{{0.0, 0.0, 0.0}});
+    field.cell.assign(n, bitpit::Cell::NULL_ID);
+    field.hasFoot.assign(n, false);
+
+    bool parallelSurface = false;
+#if MIMMO_ENABLE_MPI
+    parallelSurface = surface.isParallel();
+#endif
+
+    // Seeds: the given ones, or the nodes of the mesh cells touching the surface.
+    // If no mesh cell touches it, the cells within maxdist from it are used.
+    livector1D seeds;
+    if (seedlist){
+        seeds.reserve(seedlist->size());
+        for (long id : *seedlist){
+            if (graph.index.count(id))  seeds.push_back(id);
+        }
+    } else {
+        std::array<double,2> tolerances = {{1.0E-04, maxdist}};
+        for (double tol : tolerances){
+            livector1D cells;
+#if MIMMO_ENABLE_MPI
+            if (parallelSurface){
+                cells = skdTreeUtils::selectByGlobalPatch(surface.getSkdTree(), mesh.getSkdTree(), tol);
+            } else
+#endif
+            {
+                cells = skdTreeUtils::selectByPatch(surface.getSkdTree(), mesh.getSkdTree(), tol);
+            }
+            seeds = onPoints ? mesh.getVertexFromCellList(cells) : cells;
+
+            bool found = !seeds.empty();
+#if MIMMO_ENABLE_MPI
+            if (mesh.isParallel()){
+                MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_C_BOOL, MPI_LOR, mesh.getCommunicator());
+            }
+#endif
+            if (found) break;
+        }
+    }
+
+    // Distances of the seeds by tree queries
+    int npoints = seeds.size();
+    dvecarr3E points;
+    points.reserve(npoints);
+    for (long id : seeds){
+        points.push_back(graph.coords[graph.index.at(id)]);
+    }
+    dvector1D distances(npoints, std::numeric_limits<double>::max());
+    livector1D surface_ids(npoints, bitpit::Cell::NULL_ID);
+    ivector1D surface_ranks(npoints, surface.getRank());
+#if MIMMO_ENABLE_MPI
+    if (parallelSurface){
+        skdTreeUtils::globalDistance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), surface_ranks.data(), distances.data(), maxdist);
+    } else
+#endif
+    {
+        skdTreeUtils::distance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), distances.data(), maxdist);
+    }
+
+    const bitpit::PatchKernel & surfacePatch = *(surface.getPatch());
+    const bitpit::PiercedVector<bitpit::Cell> & surfaceCells = surfacePatch.getCells();
+    MarchingQueue queue;
+    darray3E foot;
+    for (int ipoint = 0; ipoint < npoints; ++ipoint){
+        if (distances[ipoint] >= maxdist) continue;
+        long i = graph.index.at(seeds[ipoint]);
+        long idS = surface_ids[ipoint];
+        // the closest cell is transported only if it is available on the local surface
+        if (idS != bitpit::Cell::NULL_ID && surface_ranks[ipoint] == surface.getRank() && surfaceCells.exists(idS)){
+            field.dist[i] = skdTreeUtils::distanceFromSurfaceCell(points[ipoint], surfacePatch, idS, foot);
+            field.cell[i] = idS;
+            field.foot[i] = foot;
+            field.hasFoot[i] = true;
+        } else {
+            field.dist[i] = distances[ipoint];
+        }
+        queue.push(std::make_pair(field.dist[i], i));
+    }
+
+    std::unordered_map<long, livector1D> surfaceNeighs;
+    march(graph, field, queue, surfacePatch, maxdist, surfaceNeighs);
+
+#if MIMMO_ENABLE_MPI
+    // Exchange the distances on ghosts and march again until no rank changes anything,
+    // then align the ghosts to their owners: a ghost can be lowered by the marching of its
+    // local neighbours below the value of its owner.
+    if (mesh.isDistributed()){
+        bool changed = true;
+        while (changed){
+            changed = exchangeGhosts(mesh, onPoints, graph, field, queue, surfacePatch, false);
+            MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_C_BOOL, MPI_LOR, mesh.getCommunicator());
+            march(graph, field, queue, surfacePatch, maxdist, surfaceNeighs);
+        }
+        exchangeGhosts(mesh, onPoints, graph, field, queue, surfacePatch, true);
+    }
+#endif
+
+    for (std::size_t i = 0; i < n; ++i){
+        if (field.dist[i] < maxdist){
+            result.insert(graph.ids[i], field.dist[i]);
+        }
+    }
+    return result;
+}
+
+/*!
+ * Compute the distance of the points of a mesh from a surface, within a maximum
+ * distance. Ghost points are considered.
+ * \param[in] mesh target mesh
+ * \param[in] surface MimmoObject of type surface
+ * \param[in] maxdist threshold distance
+ * \param[in] seedlist (optional) list of vertices to start the marching from.
+ *            In case the mesh is a point cloud, a non empty seed list is mandatory.
+ * \return vertices within maxdist from the surface with their distance from it.
+ */
+bitpit::PiercedVector<double>
+pointsDistance(MimmoObject & mesh, MimmoObject & surface, double maxdist, const livector1D * seedlist)
+{
+    return computeDistance(mesh, surface, maxdist, seedlist, true);
+}
+
+/*!
+ * Compute the distance of the cell centroids of a mesh from a surface, within a
+ * maximum distance. Ghost cells are considered.
+ * \param[in] mesh target mesh
+ * \param[in] surface MimmoObject of type surface
+ * \param[in] maxdist threshold distance
+ * \param[in] seedlist (optional) list of cells to start the marching from.
+ * \return cells within maxdist from the surface with their distance from it.
+ */
+bitpit::PiercedVector<double>
+cellsDistance(MimmoObject & mesh, MimmoObject & surface, double maxdist, const livector1D * seedlist)
+{
+    return computeDistance(mesh, surface, maxdist, seedlist, false);
+}
+
+}; //end namespace distanceFieldUtils
+
+} //end namespace mimmo
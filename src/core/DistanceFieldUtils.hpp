@@ -0,0 +1,58 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+# ifndef __DISTANCEFIELDUTILS_HPP__
+# define __DISTANCEFIELDUTILS_HPP__
+
+# include "MimmoObject.hpp"
+
+namespace mimmo{
+
+/*!
+ * \brief Utilities computing the distance field of a surface on the points or on the
+ * cells of a mesh, up to a maximum distance (narrow band).
+ * \ingroup core
+ *
+ * The distance is computed by fast marching on the mesh graph (point connectivity for
+ * points, face adjacency for cell centroids), seeded from the mesh nodes closest to the
+ * surface. Instead of solving the discrete eikonal equation, each node carries the
+ * surface cell closest to it (closest point transport): the distance of a node is the
+ * exact distance from the surface cell inherited from its upwind neighbour, refined by
+ * a local search on the surface cells around it. Tree queries are required only for
+ * the seeds, the marching costs a few point-element distances per node.
+ *
+ * In parallel, the marching is repeated after each exchange of the distances of the
+ * interior nodes to their ghost copies, until no distance changes on any rank; ghosts
+ * are then overwritten with the values of their owners, so that ghost and interior
+ * values of the same node are equal in output.
+ */
+namespace distanceFieldUtils{
+
+    bitpit::PiercedVector<double> pointsDistance(MimmoObject & mesh, MimmoObject & surface, double maxdist, const livector1D * seedlist = nullptr);
+    bitpit::PiercedVector<double> cellsDistance(MimmoObject & mesh, MimmoObject & surface, double maxdist, const livector1D * seedlist = nullptr);
+
+}; //end namespace distanceFieldUtils
+
+} //end namespace mimmo
+
+#endif
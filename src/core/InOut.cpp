@@ -82,6 +82,7 @@ bool DataType::operator==(const DataType & other){
  */
 PortOut::PortOut(){
     m_objLink.clear();
+    m_directTransfer = true;
 };
 
 /*!
@@ -97,6 +98,7 @@ PortOut::PortOut(const PortOut & other){
     m_obuffer	= other.m_obuffer;
     m_portLink	= other.m_portLink;
     m_datatype	= other.m_datatype;
+    m_directTransfer = other.m_directTransfer;
     return;
 };
 
@@ -138,6 +140,25 @@ PortOut::getDataType(){
     return(m_datatype);
 }
 
+/*!
+ * It gets if the direct transfer of data to input ports of the same type is active.
+ * \return true if direct transfer is active.
+ */
+bool
+PortOut::isDirectTransfer(){
+    return(m_directTransfer);
+}
+
+/*!
+ * It activates/deactivates the direct transfer of data to input ports of the same type.
+ * If deactivated, data are always communicated through the buffer stream.
+ * \param[in] flag true to activate the direct transfer.
+ */
+void
+PortOut::setDirectTransfer(bool flag){
+    m_directTransfer = flag;
+}
+
 /*!
  * It empties the output buffer.
  */
@@ -171,21 +192,56 @@ mimmo::PortOut::clear(int j){
  * Execution of the PIN.
  * All the pins are called in execution of the sending owner after its own execution.
  * Reading stage of pin linked receivers is automatically performed within this execution.
+ * Receivers with an input port of the same type of the current port get the data directly,
+ * if direct transfer is active; the others read it through the buffer stream.
+ * \param[in] receiver if not nullptr, data are communicated only to the links of the port
+ * pointing to this object.
  */
 void
-mimmo::PortOut::exec(){
-    if (m_objLink.size() > 0){
+mimmo::PortOut::exec(BaseManipulation * receiver){
+    if (m_objLink.size() == 0) return;
+
+    std::vector<bool> active(m_objLink.size(), true);
+    std::vector<bool> direct(m_objLink.size(), false);
+    int lastDirect = -1;
+    bool stream = false;
+    for (int j=0; j<(int)m_objLink.size(); j++){
+        if (m_objLink[j] == nullptr || (receiver != nullptr && m_objLink[j] != receiver)){
+            active[j] = false;
+            continue;
+        }
+        if (m_directTransfer && m_objLink[j]->m_portIn[m_portLink[j]]->getValueType() == getValueType()){
+            direct[j] = true;
+            lastDirect = j;
+        }else{
+            stream = true;
+        }
+    }
+
+    // Buffer stream first, since direct transfer can move the data to the last receiver.
+    if (stream){
         writeBuffer();
         mimmo::IBinaryStream input(m_obuffer.data(), m_obuffer.getSize());
         cleanBuffer();
         for (int j=0; j<(int)m_objLink.size(); j++){
-            if (m_objLink[j] != nullptr){
+            if (active[j] && !direct[j]){
                 m_objLink[j]->setBufferIn(m_portLink[j], input);
                 m_objLink[j]->readBufferIn(m_portLink[j]);
                 m_objLink[j]->cleanBufferIn(m_portLink[j]);
             }
         }
     }
+
+    if (lastDirect > -1){
+        bool movable;
+        void * data = openDirect(movable);
+        for (int j=0; j<=lastDirect; j++){
+            if (direct[j]){
+                m_objLink[j]->m_portIn[m_portLink[j]]->readDirect(data, movable && (j == lastDirect));
+            }
+        }
+        closeDirect();
+    }
 };
 
 /*!
@@ -25,7 +25,9 @@
 #define __INOUT_HPP__
 
 #include <mimmo_binary_stream.hpp>
+#include "MimmoSharedPointer.hpp"
 #include <functional>
+#include <typeinfo>
 
 namespace mimmo{
 
@@ -88,6 +90,13 @@ public:
 *
 * The execution of the output PortT will automatically
 * exchange the buffer data, pass it to the input ports connected and makes them reading and decoding the data.
+*
+* If direct transfer is active (default, see setDirectTransfer), receivers whose input port
+* stores exactly the same C++ type of the output port get the data straight from the sender,
+* without any encoding/decoding into the binary buffer: the data recovered by a "get" method is
+* held in a MimmoSharedPointer for the time of the exchange, copied to all receivers but the
+* last one, which takes it by move. The buffer stream is used only for receivers with a
+* different (even if tag-compatible) C++ type.
 */
 class PortOut{
 public:
@@ -96,6 +105,7 @@ public:
     std::vector<BaseManipulation*>  m_objLink;	/**<Outputs object to which communicate the data.*/
     std::vector<PortID>             m_portLink;	/**<ID of the input ports of the linked objects.*/
     DataType                        m_datatype;	/**<TAG of type of data communicated.*/
+    bool                            m_directTransfer; /**<True if data are passed directly to receivers of the same type.*/
 
 public:
     PortOut();
@@ -114,10 +124,27 @@ public:
     virtual void	writeBuffer() = 0;
     void 			cleanBuffer();
 
+    /*!
+     * Pure virtual function returning the C++ type of data communicated.
+     */
+    virtual const std::type_info &  getValueType() = 0;
+    /*!
+     * Pure virtual function to expose the data for direct transfer.
+     * \param[out] movable true if the data exposed can be moved by the last receiver.
+     */
+    virtual void *  openDirect(bool & movable) = 0;
+    /*!
+     * Pure virtual function to release the data exposed for direct transfer.
+     */
+    virtual void    closeDirect() = 0;
+
+    bool    isDirectTransfer();
+    void    setDirectTransfer(bool flag);
+
     void clear();
     void clear(int j);
 
-    void exec();
+    void exec(BaseManipulation * receiver = nullptr);
 
 };
 
@@ -155,6 +182,7 @@ public:
     O*  m_obj_;             /**<Object owner of the port.*/
     T   *m_var_;            /**<Linked variable to communicate.*/
     T   (O::*m_getVar_)();  /**<Pointer to function that recovers the data to communicate (alternative to linked variable).*/
+    MimmoSharedPointer<T>   m_sdata_;   /**<Data recovered by get function, held during direct transfer.*/
 
 public:
     PortOutT();
@@ -169,6 +197,10 @@ public:
 
     void writeBuffer();
 
+    const std::type_info &  getValueType();
+    void *  openDirect(bool & movable);
+    void    closeDirect();
+
 };
 
 
@@ -226,6 +258,17 @@ public:
     virtual void    readBuffer() = 0;
     void            cleanBuffer();
 
+    /*!
+     * Pure virtual function returning the C++ type of data received.
+     */
+    virtual const std::type_info &  getValueType() = 0;
+    /*!
+     * Pure virtual function to read data passed directly by a sender port of the same type.
+     * \param[in] data pointer to sender data.
+     * \param[in] movable true if data can be moved instead of copied.
+     */
+    virtual void    readDirect(void * data, bool movable) = 0;
+
 };
 
 
@@ -278,6 +321,9 @@ public:
 
     void readBuffer();
 
+    const std::type_info &  getValueType();
+    void    readDirect(void * data, bool movable);
+
 };
 
 }
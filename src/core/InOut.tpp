@@ -137,6 +137,45 @@ PortOutT<T,O>::writeBuffer(){
     }
 }
 
+/*!
+ * \return C++ type of the data communicated by the port.
+ */
+template<typename T, typename O>
+const std::type_info &
+PortOutT<T,O>::getValueType(){
+    return typeid(T);
+}
+
+/*!
+ * It exposes the data to be communicated for a direct transfer to input ports of the same type.
+ * If the member pointer m_getVar_ is not nullptr, the data recovered by the get function
+ * is held in a shared pointer until closeDirect is called and it can be moved
+ * by the last receiver. Alternatively the linked variable m_var_ is exposed and it
+ * can only be copied.
+ * \param[out] movable true if the data exposed can be moved.
+ * \return pointer to the data exposed, nullptr if no data is linked to the port.
+ */
+template<typename T, typename O>
+void *
+PortOutT<T,O>::openDirect(bool & movable){
+    movable = false;
+    if (m_getVar_ != nullptr){
+        m_sdata_ = MimmoSharedPointer<T>(new T((m_obj_->*m_getVar_)()));
+        movable = true;
+        return m_sdata_.get();
+    }
+    return m_var_;
+}
+
+/*!
+ * It releases the data held for a direct transfer.
+ */
+template<typename T, typename O>
+void
+PortOutT<T,O>::closeDirect(){
+    m_sdata_.reset();
+}
+
 
 
 /*!
@@ -262,5 +301,37 @@ PortInT<T, O>::readBuffer(){
     }
 }
 
+/*!
+ * \return C++ type of the data received by the port.
+ */
+template<typename T, typename O>
+const std::type_info &
+PortInT<T, O>::getValueType(){
+    return typeid(T);
+}
+
+/*!
+ * It reads the data passed directly by an output port of the same type, without
+ * passing through the buffer stream.
+ * It stores the value in the linked m_var_ or passes it to the linked set function.
+ * \param[in] data pointer to the data of the sender, of the same type T of the port.
+ * \param[in] movable true if the data can be moved instead of copied.
+ */
+template<typename T, typename O>
+void
+PortInT<T, O>::readDirect(void * data, bool movable){
+    if (data == nullptr) return;
+    T & value = *(static_cast<T*>(data));
+    if (m_setVar_ != nullptr){
+        if (movable)    (m_obj_->*m_setVar_)(std::move(value));
+        else            (m_obj_->*m_setVar_)(value);
+        return;
+    }
+    if (m_var_ != nullptr){
+        if (movable)    (*m_var_) = std::move(value);
+        else            (*m_var_) = value;
+    }
+}
+
 
 } //end of mimmo namespace
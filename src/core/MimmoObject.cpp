@@ -24,12 +24,20 @@
 #include "MimmoObject.hpp"
 #include "MimmoNamespace.hpp"
 #include "SkdTreeUtils.hpp"
+#include "DistanceFieldUtils.hpp"
 #if MIMMO_ENABLE_MPI
 #include "communications.hpp"
 #endif
 #include <Operators.hpp>
 #include <set>
 #include <cassert>
+#include <chrono>
+#include <atomic>
+#if MIMMO_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+typedef std::chrono::high_resolution_clock Clock;
 
 namespace mimmo{
 
@@ -742,7 +750,12 @@ void MimmoObject::swap(MimmoObject & x) noexcept
 	std::swap(m_kdTree, x.m_kdTree);
 	std::swap(m_skdTreeSync, x.m_skdTreeSync);
 	std::swap(m_kdTreeSync, x.m_kdTreeSync);
+	std::swap(m_updateTimes, x.m_updateTimes);
     std::swap(m_boundingBoxSync, x.m_boundingBoxSync);
+    std::swap(m_verticesRevision, x.m_verticesRevision);
+    std::swap(m_cellsRevision, x.m_cellsRevision);
+    std::swap(m_verticesCoordsRevision, x.m_verticesCoordsRevision);
+    std::swap(m_verticesCoords, x.m_verticesCoords);
 
     m_patchInfo.setPatch(getPatch());
 	m_patchInfo.update();
@@ -981,28 +994,25 @@ MimmoObject::getPointGlobalCountOffset(){
 /*!
  * Return the compact list of local vertices hold by the class.
    Ghost cells are considered to fill the structure.
+   Coordinates are copied from the contiguous view of getVerticesCoordsSoA.
  * \return coordinates of mesh vertices
  * \param[out] mapDataInv pointer to inverse of Map of vertex ids,
                for aligning external vertex data to bitpit::Patch ordering.
  */
 dvecarr3E
 MimmoObject::getVerticesCoords(lilimap* mapDataInv){
-	dvecarr3E result(getNVertices());
-	int  i = 0;
-
-	auto pvert = getVertices();
-
-	if (mapDataInv != nullptr){
-		for (auto const & vertex : pvert){
-			result[i] = vertex.getCoords();
-			(*mapDataInv)[vertex.getId()] = i;
-			++i;
-		}
+	const VertexCoordsSoA & coords = getVerticesCoordsSoA();
+	std::size_t nvertices = coords.size();
+	dvecarr3E result(nvertices);
+
+	for (std::size_t i = 0; i < nvertices; ++i){
+		result[i][0] = coords.x[i];
+		result[i][1] = coords.y[i];
+		result[i][2] = coords.z[i];
 	}
-	else{
-		for (auto const & vertex : pvert){
-			result[i] = vertex.getCoords();
-			++i;
+	if (mapDataInv != nullptr){
+		for (std::size_t i = 0; i < nvertices; ++i){
+			(*mapDataInv)[coords.ids[i]] = i;
 		}
 	}
 	return result;
@@ -1021,6 +1031,96 @@ MimmoObject::getVertexCoords(long i) const
     return 	getPatch()->getVertexCoords(i);
 };
 
+/*!
+ * Return the contiguous structure-of-arrays view of the coordinates of the local vertices
+ * (ghosts included), in the order of the vertex container of the patch.
+ * The view is cached and rebuilt only if the vertices changed since the last call
+ * (see getVerticesRevision), so bulk kernels can read it repeatedly without chasing the
+ * vertex container. If OpenMP is enabled the coordinates are gathered concurrently.
+ * Vertices modified directly on the bitpit patch are not tracked: call setUnsyncAll or
+ * cleanVerticesCoordsSoA afterwards.
+ * The reference is invalidated by any modification of the vertices. The method can be called
+ * concurrently (e.g. by objects of a chain executed in task graph mode): the lazy build
+ * of the view is serialized.
+ * \return contiguous view of the vertices coordinates
+ */
+const VertexCoordsSoA &
+MimmoObject::getVerticesCoordsSoA(){
+
+	std::lock_guard<std::mutex> lock(m_verticesCoordsMutex);
+
+	const bitpit::PiercedVector<bitpit::Vertex> & vertices = getVertices();
+	std::size_t nvertices = vertices.size();
+	if (m_verticesCoordsRevision == m_verticesRevision && m_verticesCoords.size() == nvertices){
+		return m_verticesCoords;
+	}
+
+	VertexCoordsSoA & coords = m_verticesCoords;
+	coords.ids.resize(nvertices);
+	coords.rawIndices.resize(nvertices);
+	std::size_t i = 0;
+	for (auto it = vertices.cbegin(); it != vertices.cend(); ++it){
+		coords.ids[i] = it.getId();
+		coords.rawIndices[i] = it.getRawIndex();
+		++i;
+	}
+
+	coords.x.resize(nvertices);
+	coords.y.resize(nvertices);
+	coords.z.resize(nvertices);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+	for (long k = 0; k < long(nvertices); ++k){
+		const std::array<double,3> & point = vertices.rawAt(coords.rawIndices[k]).getCoords();
+		coords.x[k] = point[0];
+		coords.y[k] = point[1];
+		coords.z[k] = point[2];
+	}
+
+	coords.indices.clear();
+	coords.indices.reserve(nvertices);
+	for (std::size_t k = 0; k < nvertices; ++k){
+		coords.indices[coords.ids[k]] = k;
+	}
+
+	m_verticesCoordsRevision = m_verticesRevision;
+	return m_verticesCoords;
+}
+
+/*!
+ * \return revision of the vertices of the geometry. The revision is renewed at each
+ * insertion or modification of the vertices done through the class methods, and can be
+ * used by clients to detect if data computed on the vertices is outdated.
+ * Revisions are unique in the process: two geometries never share the same revision,
+ * so the revision alone identifies the vertices a client data refers to.
+ */
+std::size_t
+MimmoObject::getVerticesRevision() const {
+	return m_verticesRevision;
+}
+
+/*!
+ * \return revision of the cells of the geometry. The revision is renewed at each
+ * insertion or deletion of cells done through the class methods, and it is unique in
+ * the process as the vertices revision (see getVerticesRevision).
+ */
+std::size_t
+MimmoObject::getCellsRevision() const {
+	return m_cellsRevision;
+}
+
+/*!
+ * INTERNAL use. Get a new revision of vertices or cells, from a counter shared by all
+ * the geometries.
+ * \return new revision, never returned before in the process.
+ */
+std::size_t
+MimmoObject::newRevision(){
+	static std::atomic<std::size_t> revision(0);
+	return ++revision;
+}
+
 /*!
  * Return reference to the PiercedVector structure of local vertices hold
  * by bitpit::PatchKernel class member. Ghost cells vertices are considered.
@@ -1601,90 +1701,84 @@ MimmoObject::getPointGhostExchangeInfoSyncStatus()
 void MimmoObject::updatePointGhostExchangeInfo()
 {
 
-    //Update n interior vertices
+    //---
+    //Create consecutive map for vertices and fill locals, numbered locally.
+    //Global offset is added once the number of interior vertices of each rank is known.
+    //---
+    m_pointConsecutiveId.clear();
     m_ninteriorvertices = 0;
-    for (long vertexId : getVerticesIds()){
-        if (isPointInterior(vertexId)){
+    for (const long & id : getVerticesIds()){
+        if (isPointInterior(id)){
+            m_pointConsecutiveId[id] = m_ninteriorvertices;
             m_ninteriorvertices++;
         }
     }
 
-    //Update n global vertices
-    m_nglobalvertices = 0;
-    MPI_Allreduce(&m_ninteriorvertices, &m_nglobalvertices, 1, MPI_LONG, MPI_SUM, m_communicator);
+    //---
+    //Start the communication of local consecutive ids for ghost points, overlapped with
+    //the collective communication of the number of interior vertices.
+    //---
+    long consecutiveId;
+    size_t exchangeDataSize = sizeof(consecutiveId);
+    std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
+    dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
+
+    // Set and start the sends
+    for (const auto & entry : getPointGhostExchangeSources()) {
+        const int rank = entry.first;
+        auto &list = entry.second;
+        dataCommunicator->setSend(rank, list.size() * exchangeDataSize);
+        bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(rank);
+        for (long id : list) {
+            if (m_pointConsecutiveId.count(id)){
+                buffer << m_pointConsecutiveId.at(id);
+            }else{
+                buffer << long(-1);
+            }
+        }
+        dataCommunicator->startSend(rank);
+    }
+
+    // Discover & start all the receives
+    dataCommunicator->discoverRecvs();
+    dataCommunicator->startAllRecvs();
 
-    //Update n interior vertices for procs
+    //Update n interior vertices for procs and n global vertices
     m_rankinteriorvertices.clear();
     m_rankinteriorvertices.resize(m_nprocs);
     m_rankinteriorvertices[m_rank] = m_ninteriorvertices;
     long rankinteriorvertices = m_rankinteriorvertices[m_rank];
     MPI_Allgather(&rankinteriorvertices, 1, MPI_LONG, m_rankinteriorvertices.data(), 1, MPI_LONG, m_communicator);
 
-    //Update global offset
-    m_globaloffset = 0;
-    for (int i=0; i<m_rank; i++){
-        m_globaloffset += m_rankinteriorvertices[i];
+    m_nglobalvertices = 0;
+    std::vector<long> rankoffsets(m_nprocs, 0);
+    for (int i=0; i<m_nprocs; i++){
+        rankoffsets[i] = m_nglobalvertices;
+        m_nglobalvertices += m_rankinteriorvertices[i];
     }
 
-    //---
-    //Create consecutive map for vertices and fill locals
-    //---
-    m_pointConsecutiveId.clear();
-    long consecutiveId = m_globaloffset;
-    //Insert owned vertices
-    for (const long & id : getVerticesIds()){
-        if (isPointInterior(id)){
-            m_pointConsecutiveId[id] = consecutiveId;
-            consecutiveId++;
-        }
+    //Update global offset
+    m_globaloffset = rankoffsets[m_rank];
+    for (auto & entry : m_pointConsecutiveId){
+        entry.second += m_globaloffset;
     }
 
-
-    //---
-    //Communicate consecutive ids for ghost points
-    //---
-    {
-        size_t exchangeDataSize = sizeof(consecutiveId);
-        std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
-        dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
-
-        // Set and start the sends
-        for (const auto entry : getPointGhostExchangeSources()) {
-            const int rank = entry.first;
-            auto &list = entry.second;
-            dataCommunicator->setSend(rank, list.size() * exchangeDataSize);
-            bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(rank);
-            for (long id : list) {
-                if (m_pointConsecutiveId.count(id)){
-                    buffer << m_pointConsecutiveId.at(id);
-                }else{
-                    buffer << long(-1);
-                }
+    // Receive the consecutive ids of the ghosts, shifting them by the offset of their owner
+    int nCompletedRecvs = 0;
+    while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
+        int rank = dataCommunicator->waitAnyRecv();
+        const auto &list = getPointGhostExchangeTargets().at(rank);
+        bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(rank);
+        for (long id : list) {
+            buffer >> consecutiveId;
+            if (consecutiveId > -1){
+                m_pointConsecutiveId[id] = consecutiveId + rankoffsets[rank];
             }
-            dataCommunicator->startSend(rank);
         }
-
-        // Discover & start all the receives
-        dataCommunicator->discoverRecvs();
-        dataCommunicator->startAllRecvs();
-
-        // Receive the consecutive ids of the ghosts
-        int nCompletedRecvs = 0;
-        while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
-            int rank = dataCommunicator->waitAnyRecv();
-            const auto &list = getPointGhostExchangeTargets().at(rank);
-            bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(rank);
-            for (long id : list) {
-                buffer >> consecutiveId;
-                if (consecutiveId > -1){
-                    m_pointConsecutiveId[id] = consecutiveId;
-                }
-            }
-            ++nCompletedRecvs;
-        }
-        // Wait for the sends to finish
-        dataCommunicator->waitAllSends();
+        ++nCompletedRecvs;
     }
+    // Wait for the sends to finish
+    dataCommunicator->waitAllSends();
 
 	// Exchange info are now updated
 	m_pointGhostExchangeInfoSync = SyncStatus::SYNC;
@@ -1934,6 +2028,7 @@ void MimmoObject::deleteOrphanGhostCells(){
 	//clean marked ghosts;
 	if(!markToDelete.empty()){
 		getPatch()->deleteCells(markToDelete);
+		m_cellsRevision = newRevision();
 	}
 	//erase temporarely adjacencies
 	if(checkResetAdjacencies){
@@ -1990,6 +2085,7 @@ MimmoObject::addVertex(const darray3E & vertex, const long idtag){
 	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
 	m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
+	m_verticesRevision = newRevision();
 	return id;
 };
 
@@ -2026,6 +2122,7 @@ MimmoObject::addVertex(const bitpit::Vertex & vertex, const long idtag){
 	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
 	m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
+	m_verticesRevision = newRevision();
 	return id;
 };
 
@@ -2049,9 +2146,55 @@ MimmoObject::modifyVertex(const darray3E & vertex, const long & id){
 #if MIMMO_ENABLE_MPI
     m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
+	m_verticesRevision = newRevision();
 	return true;
 };
 
+/*!
+ * It modifies the coordinates of all the local vertices (ghosts included) in one pass.
+ * Coordinates are given in the order of the view returned by getVerticesCoordsSoA,
+ * e.g. as a copy of it displaced by a bulk kernel. The new coordinates are written
+ * to the patch concurrently, if OpenMP is enabled, and become the cached view,
+ * which stays valid after the call.
+ * \param[in] x new x coordinates of the vertices
+ * \param[in] y new y coordinates of the vertices
+ * \param[in] z new z coordinates of the vertices
+ */
+void
+MimmoObject::modifyVerticesCoords(dvector1D x, dvector1D y, dvector1D z){
+
+	// Be sure the view describes the current vertices
+	getVerticesCoordsSoA();
+
+	std::size_t nvertices = m_verticesCoords.size();
+	if (x.size() != nvertices || y.size() != nvertices || z.size() != nvertices){
+		throw std::runtime_error("MimmoObject::modifyVerticesCoords : coordinates size does not match the number of vertices");
+	}
+
+	bitpit::PiercedVector<bitpit::Vertex> & vertices = getVertices();
+	const std::vector<std::size_t> & rawIndices = m_verticesCoords.rawIndices;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+	for (long k = 0; k < long(nvertices); ++k){
+		vertices.rawAt(rawIndices[k]).setCoords({{x[k], y[k], z[k]}});
+	}
+
+	m_verticesCoords.x = std::move(x);
+	m_verticesCoords.y = std::move(y);
+	m_verticesCoords.z = std::move(z);
+
+	m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
+	m_kdTreeSync = std::min(m_kdTreeSync, SyncStatus::UNSYNC);
+	m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
+	m_boundingBoxSync = std::min(m_boundingBoxSync, SyncStatus::UNSYNC);
+#if MIMMO_ENABLE_MPI
+	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
+#endif
+	m_verticesRevision = newRevision();
+	m_verticesCoordsRevision = m_verticesRevision;
+}
+
 /*!
  * See method addConnectedCell(const livector1D & conn, bitpit::ElementType type, long PID, long idtag, int rank) doxy.
  * The only difference is the automatic assignment to PID= 0 for the current element and the automatic assignment of ID.
@@ -2123,6 +2266,7 @@ MimmoObject::addConnectedCell(const livector1D & conn, bitpit::ElementType type,
 
 	setPIDCell(checkedID, PID);
 
+	m_cellsRevision = newRevision();
 	m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
 	m_AdjSync = std::min(m_AdjSync, SyncStatus::UNSYNC);
 	m_IntSync = std::min(m_IntSync, SyncStatus::UNSYNC);
@@ -2190,6 +2334,7 @@ MimmoObject::addCell(bitpit::Cell & cell, const long idtag, int rank){
 
 	setPIDCell(checkedID, cell.getPID());
 
+    m_cellsRevision = newRevision();
     m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
     m_AdjSync = std::min(m_AdjSync, SyncStatus::UNSYNC);
     m_IntSync = std::min(m_IntSync, SyncStatus::UNSYNC);
@@ -2396,6 +2541,8 @@ MimmoObject::setUnsyncAll(){
 	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
 	cleanPointConnectivity(); //forcefully destroy point connectivity.
+	m_verticesRevision = newRevision();
+	m_cellsRevision = newRevision();
 };
 
 /*!
@@ -3126,22 +3273,86 @@ void MimmoObject::buildSkdTree(std::size_t value){
 	return;
 }
 
+/*!
+ * INTERNAL use. Sort recursively a range of vertices in KdTree insertion order (preorder
+ * of a balanced tree): the median along the splitting direction of the level (x, y, z
+ * cyclically) comes first, then the vertices with lower or equal coordinates, then the
+ * ones with greater coordinates, as the KdTree insertion rule. Subranges are sorted
+ * concurrently with OpenMP tasks, bound to the enclosing parallel region.
+ * \param[in,out] vertices vertices to be sorted, partitioned in place
+ * \param[in] begin first element of the range
+ * \param[in] end past the end element of the range
+ * \param[in] level level of the tree of the range median
+ * \param[out] sorted vertices in insertion order, range written from position outBegin
+ * \param[in] outBegin position of the range median in sorted
+ */
+static void
+sortKdTreeVertices(std::vector<bitpit::Vertex *> & vertices, std::size_t begin, std::size_t end, int level,
+                   std::vector<bitpit::Vertex *> & sorted, std::size_t outBegin)
+{
+    if (begin >= end)   return;
+
+    std::size_t mid = begin + (end - begin) / 2;
+    int dim = level % 3;
+    std::nth_element(vertices.begin() + begin, vertices.begin() + mid, vertices.begin() + end,
+                     [dim](const bitpit::Vertex * a, const bitpit::Vertex * b){
+                         return a->getCoords()[dim] < b->getCoords()[dim];
+                     });
+    // vertices with coordinate equal to the median go on its left side
+    double median = vertices[mid]->getCoords()[dim];
+    auto last = std::partition(vertices.begin() + mid + 1, vertices.begin() + end,
+                               [dim, median](const bitpit::Vertex * a){
+                                   return a->getCoords()[dim] <= median;
+                               });
+    std::size_t newMid = std::size_t(last - vertices.begin()) - 1;
+    std::swap(vertices[mid], vertices[newMid]);
+    mid = newMid;
+
+    sorted[outBegin] = vertices[mid];
+#if MIMMO_ENABLE_OPENMP
+#pragma omp task if(mid - begin > 4096) shared(vertices, sorted)
+#endif
+    sortKdTreeVertices(vertices, begin, mid, level + 1, sorted, outBegin + 1);
+    sortKdTreeVertices(vertices, mid + 1, end, level + 1, sorted, outBegin + 1 + (mid - begin));
+#if MIMMO_ENABLE_OPENMP
+#pragma omp taskwait
+#endif
+}
+
 /*!
  * Reset and build again vertex kdTree of your geometry.
- * Nodes fo ghost cells are insert in the tree.
+ * Nodes fo ghost cells are insert in the tree. Vertices are inserted in median order,
+ * sorted concurrently if OpenMP is enabled, so that the tree is balanced.
  */
 void MimmoObject::buildKdTree(){
 	if( getNVertices() == 0)  return;
-	long label;
 
 	if (m_kdTreeSync != SyncStatus::SYNC){
 		cleanKdTree();
 		//TODO Why : + m_kdTree->MAXSTK ?
 		m_kdTree->nodes.resize(getNVertices() + m_kdTree->MAXSTK);
 
+		// Vertices are inserted in median order, to get a balanced tree whatever the
+		// numbering of the mesh (e.g. lexicographic order of structured meshes).
+		std::vector<bitpit::Vertex *> vertices, sorted(getNVertices(), nullptr);
+		vertices.reserve(getNVertices());
 		for(auto & val : getVertices()){
-			label = val.getId();
-			m_kdTree->insert(&val, label);
+			vertices.push_back(&val);
+		}
+#if MIMMO_ENABLE_OPENMP
+		if (omp_in_parallel()){
+			sortKdTreeVertices(vertices, 0, vertices.size(), 0, sorted, 0);
+		}else{
+#pragma omp parallel
+#pragma omp single
+			sortKdTreeVertices(vertices, 0, vertices.size(), 0, sorted, 0);
+		}
+#else
+		sortKdTreeVertices(vertices, 0, vertices.size(), 0, sorted, 0);
+#endif
+		for(bitpit::Vertex * vertex : sorted){
+			long label = vertex->getId();
+			m_kdTree->insert(vertex, label);
 		}
 		m_kdTreeSync = SyncStatus::SYNC;
 	}
@@ -3204,13 +3415,33 @@ void MimmoObject::cleanBoundingBox(){
     }
 }
 
+/*!
+ * Clean the cached contiguous view of the vertices coordinates and renew the
+ * revisions of vertices and cells. To be called after modifications of the geometry
+ * done directly on the bitpit patch.
+ */
+void MimmoObject::cleanVerticesCoordsSoA(){
+    m_verticesCoords = VertexCoordsSoA();
+    m_verticesRevision = newRevision();
+    m_cellsRevision = newRevision();
+    m_verticesCoordsRevision = 0;
+}
+
 /*!
  * Update the MimmoObject after a manipulation, i.e. a mesh adaption, a cells/vertices insertion/delete or
  * a generic manipulation.
  * Note. To update parallel information the cell adjacencies have to be built.
+ * The search trees, which only read the patch, are built concurrently if OpenMP is enabled.
+ * The wall time spent on each structure is logged at DEBUG priority and available with
+ * getUpdateTimes.
  */
 void MimmoObject::update()
 {
+    m_updateTimes.clear();
+    auto elapsed = [](const Clock::time_point & start){
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+    Clock::time_point start;
 
 #if MIMMO_ENABLE_MPI
     // Communicate sync status of all the structures
@@ -3226,61 +3457,108 @@ void MimmoObject::update()
     bool resetAdjacencies = false;
     status = m_AdjSync;
     if (status == SyncStatus::UNSYNC){
+        start = Clock::now();
         updateAdjacencies();
+        m_updateTimes["adjacencies"] = elapsed(start);
     }
 #if MIMMO_ENABLE_MPI
     else if (status == SyncStatus::NONE){
         // The adjacencies are needed in parallel case to update the patch in bitpit
         resetAdjacencies = true;
+        start = Clock::now();
         updateAdjacencies();
+        m_updateTimes["adjacencies"] = elapsed(start);
     }
 #endif
 
     // Update interfaces
     status = m_IntSync;
     if (status == SyncStatus::UNSYNC){
+        start = Clock::now();
         updateInterfaces();
+        m_updateTimes["interfaces"] = elapsed(start);
     }
 
 
     // UPDATE PATCH
+    start = Clock::now();
     getPatch()->update();
+    m_updateTimes["patch"] = elapsed(start);
 
 
-    // Update trees
-    status = m_skdTreeSync;
-    if (status == SyncStatus::UNSYNC){
-        buildSkdTree();
+    // Update trees.
+    // The trees only read the patch: they are built concurrently, the KdTree sorting its
+    // vertices with the threads left.
+    bool buildSkd = (m_skdTreeSync == SyncStatus::UNSYNC);
+    bool buildKd = (m_kdTreeSync == SyncStatus::UNSYNC);
+    bool concurrentTrees = (buildSkd && buildKd);
+#if MIMMO_ENABLE_MPI
+    // The parallel SkdTree build communicates: it is kept on the calling thread, so that
+    // MPI initialized with MPI_THREAD_FUNNELED is enough.
+    if (isParallel()){
+        concurrentTrees = false;
     }
-    status = m_kdTreeSync;
-    if (status == SyncStatus::UNSYNC){
-        buildKdTree();
+#endif
+    double skdTreeTime = -1.0, kdTreeTime = -1.0;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel if(concurrentTrees)
+#pragma omp single
+#endif
+    {
+        if (buildSkd){
+#if MIMMO_ENABLE_OPENMP
+#pragma omp task shared(skdTreeTime)
+#endif
+            {
+                Clock::time_point skdStart = Clock::now();
+                buildSkdTree();
+                skdTreeTime = elapsed(skdStart);
+            }
+        }
+        if (buildKd){
+            Clock::time_point kdStart = Clock::now();
+            buildKdTree();
+            kdTreeTime = elapsed(kdStart);
+        }
+#if MIMMO_ENABLE_OPENMP
+#pragma omp taskwait
+#endif
     }
+    if (skdTreeTime >= 0.0)  m_updateTimes["skdtree"] = skdTreeTime;
+    if (kdTreeTime >= 0.0)   m_updateTimes["kdtree"] = kdTreeTime;
 
     // Update patch info
     status = m_infoSync;
     if (status == SyncStatus::UNSYNC){
+        start = Clock::now();
         buildPatchInfo();
+        m_updateTimes["patchinfo"] = elapsed(start);
     }
 
     // Update patch bounding box (//TODO when ready use automatic update in bitpit patch)
     status = m_boundingBoxSync;
     if (status != SyncStatus::SYNC){
+        start = Clock::now();
         getPatch()->updateBoundingBox(true);
         m_boundingBoxSync = SyncStatus::SYNC;
+        m_updateTimes["boundingbox"] = elapsed(start);
     }
 
     // Update point connectivity
     status = getPointConnectivitySyncStatus();
     if (status == SyncStatus::UNSYNC){
+        start = Clock::now();
         buildPointConnectivity();
+        m_updateTimes["pointconnectivity"] = elapsed(start);
     }
 
 #if MIMMO_ENABLE_MPI
     // Always update/build point ghost exchange information
     status = m_pointGhostExchangeInfoSync;
     if (status != SyncStatus::SYNC){
+        start = Clock::now();
         updatePointGhostExchangeInfo();
+        m_updateTimes["pointghostexchange"] = elapsed(start);
     }
 #endif
 
@@ -3288,6 +3566,24 @@ void MimmoObject::update()
     if (resetAdjacencies){
         destroyAdjacencies();
     }
+
+    bitpit::log::Priority oldPriority = m_log->getPriority();
+    m_log->setPriority(bitpit::log::Priority::DEBUG);
+    for (const auto & entry : m_updateTimes){
+        (*m_log)<<"MimmoObject::update "<<entry.first<<" : "<<entry.second<<" s"<<std::endl;
+    }
+    m_log->setPriority(oldPriority);
+}
+
+/*!
+ * \return wall time in seconds spent on each structure by the last update() call, keyed by
+ * structure name (adjacencies, interfaces, patch, skdtree, kdtree, patchinfo, boundingbox,
+ * pointconnectivity, pointghostexchange). Structures already synchronized are not listed.
+ */
+const std::map<std::string, double> &
+MimmoObject::getUpdateTimes() const
+{
+    return m_updateTimes;
 }
 
 /*!
@@ -3512,6 +3808,7 @@ void MimmoObject::resetPatch(){
 #endif
 	cleanPointConnectivity();
 	m_pointConnectivitySync = SyncStatus::NONE;
+	cleanVerticesCoordsSoA();
 };
 
 /*!
@@ -3626,16 +3923,18 @@ void MimmoObject::reset(int type){
 	m_infoSync = SyncStatus::NONE;
     m_boundingBoxSync = SyncStatus::NONE;
 	m_pointConnectivitySync = SyncStatus::NONE;
+	cleanVerticesCoordsSoA();
 }
 
 /*!
  * Dump contents of your current MimmoObject to a stream.
- * Dump all strict necessary information except for search tree structure,
- * Point ghost exchange info and point connectivity are recreated when restores.
+ * Dump all strict necessary information. Search trees are written only on demand,
+ * see dumpTrees. Point ghost exchange info and point connectivity are recreated when restores.
  * Write all in a binary format.
  * \param[in,out] stream to write on.
+ * \param[in] trees if true, write also the built search trees.
  */
-void MimmoObject::dump(std::ostream & stream){
+void MimmoObject::dump(std::ostream & stream, bool trees){
 
 	//scan pids inside your patch to be sure everything it's in order.
 	resyncPID();
@@ -3649,6 +3948,8 @@ void MimmoObject::dump(std::ostream & stream){
 		sspid[counter] = touple.second;
 		++counter;
 	}
+	//write the format marker (negative, to be distinguished from the type of old dumps)
+	bitpit::utils::binary::write(stream,int(-2));
 	//write comparison variables
 	bitpit::utils::binary::write(stream,m_type);
 #if MIMMO_ENABLE_MPI
@@ -3663,21 +3964,32 @@ void MimmoObject::dump(std::ostream & stream){
 
 	//write the patch
 	getPatch()->dump(stream);
+
+	//write the search trees
+	bitpit::utils::binary::write(stream,trees);
+	if(trees){
+		dumpTrees(stream);
+	}
 }
 
 /*!
  * Restore contents of a dumped MimmoObject from a stream in your current class.
  * New restored data will be owned internally by the class.
  * Every data previously stored will be lost.
- * Tree are not restored by default.
- * Read all in a binary format.
+ * Trees are restored only if they were dumped.
+ * Read all in a binary format. Dumps written before the search trees support are still readable.
  * \param[in,out] stream to write on.
  */
 
 void MimmoObject::restore(std::istream & stream){
-	//check comparisons
-	int type;
-	bitpit::utils::binary::read(stream,type);
+	//check format: old dumps start directly with the type of geometry
+	int format, type;
+	bitpit::utils::binary::read(stream,format);
+	if(format < 0){
+		bitpit::utils::binary::read(stream,type);
+	}else{
+		type = format;
+	}
 #if MIMMO_ENABLE_MPI
 	int nprocs;
 	bitpit::utils::binary::read(stream,nprocs);
@@ -3726,9 +4038,127 @@ void MimmoObject::restore(std::istream & stream){
 		++count;
 	}
 
+	//restore the search trees, if dumped
+	if(format < 0){
+		bool trees;
+		bitpit::utils::binary::read(stream,trees);
+		if(trees){
+			restoreTrees(stream);
+		}
+	}
+
 	//that's all folks.
 }
 
+/*!
+ * Dump the built search trees of the current MimmoObject to a stream, together with a
+ * signature of the geometry (vertices and cells) they refer to.
+ * It can be used to write the trees in a file separated from the geometry one
+ * (see restoreTrees).
+ *
+ * Only the KdTree is written, node by node, vertices are referred by their id.
+ * The SkdTree is not persisted and has to be built again after restore.
+ * Write all in a binary format.
+ * \param[in,out] stream to write on.
+ */
+void MimmoObject::dumpTrees(std::ostream & stream){
+
+	bitpit::utils::binary::write(stream,evalTreesSignature());
+
+	bool kdTree = (m_kdTreeSync == SyncStatus::SYNC);
+	bitpit::utils::binary::write(stream,kdTree);
+	if(kdTree){
+		int nnodes = m_kdTree->n_nodes;
+		bitpit::utils::binary::write(stream,nnodes);
+		for(int i=0; i<nnodes; ++i){
+			const bitpit::KdNode<bitpit::Vertex, long> & node = m_kdTree->nodes[i];
+			bitpit::utils::binary::write(stream,node.label);
+			bitpit::utils::binary::write(stream,node.lchild_);
+			bitpit::utils::binary::write(stream,node.rchild_);
+		}
+	}
+}
+
+/*!
+ * Restore the search trees of the current MimmoObject from a stream written by dumpTrees.
+ * Trees are taken only if the signature of the current geometry matches the dumped one,
+ * otherwise the stream contents are skipped and current trees are left untouched.
+ * Read all in a binary format.
+ * \param[in,out] stream to read from.
+ * \return true if the trees are restored.
+ */
+bool MimmoObject::restoreTrees(std::istream & stream){
+
+	uint64_t signature;
+	bitpit::utils::binary::read(stream,signature);
+	bool match = (signature == evalTreesSignature());
+
+	bool kdTree;
+	bitpit::utils::binary::read(stream,kdTree);
+	if(kdTree){
+		int nnodes;
+		bitpit::utils::binary::read(stream,nnodes);
+		if(match){
+			cleanKdTree();
+			m_kdTree->nodes.resize(getNVertices() + m_kdTree->MAXSTK);
+			m_kdTree->n_nodes = nnodes;
+		}
+		long label;
+		int lchild, rchild;
+		bitpit::PiercedVector<bitpit::Vertex> & vertices = getVertices();
+		for(int i=0; i<nnodes; ++i){
+			bitpit::utils::binary::read(stream,label);
+			bitpit::utils::binary::read(stream,lchild);
+			bitpit::utils::binary::read(stream,rchild);
+			if(match){
+				bitpit::KdNode<bitpit::Vertex, long> & node = m_kdTree->nodes[i];
+				node.object_ = &(vertices.at(label));
+				node.label = label;
+				node.lchild_ = lchild;
+				node.rchild_ = rchild;
+			}
+		}
+		if(match){
+			m_kdTreeSync = SyncStatus::SYNC;
+		}
+	}
+
+	return match;
+}
+
+/*!
+ * Evaluate a signature of the current geometry, used to check the coherence of dumped
+ * search trees: it hashes (FNV-1a) the ids and coordinates of the vertices and the ids
+ * and connectivity of the cells, in storage order.
+ * \return signature of the geometry.
+ */
+uint64_t MimmoObject::evalTreesSignature(){
+
+	uint64_t hash = 14695981039346656037ULL;
+	auto absorb = [&hash](const void * data, std::size_t size){
+		const unsigned char * bytes = static_cast<const unsigned char *>(data);
+		for(std::size_t i=0; i<size; ++i){
+			hash ^= uint64_t(bytes[i]);
+			hash *= 1099511628211ULL;
+		}
+	};
+
+	for(const bitpit::Vertex & vertex : getVertices()){
+		long id = vertex.getId();
+		absorb(&id, sizeof(long));
+		absorb(vertex.getCoords().data(), 3*sizeof(double));
+	}
+	for(const bitpit::Cell & cell : getCells()){
+		long id = cell.getId();
+		absorb(&id, sizeof(long));
+		bitpit::ConstProxyVector<long> conn = cell.getVertexIds();
+		for(long idV : conn){
+			absorb(&idV, sizeof(long));
+		}
+	}
+	return hash;
+}
+
 /*!
  * Evaluate general volume of each cell in the current local mesh,
  * according to its topology.
@@ -3936,7 +4366,8 @@ MimmoObject::getCellsNarrowBandToExtSurface(MimmoObject & surface, const double
 /*!
  * Get all the cells of the current mesh whose center is within a prescribed distance
    maxdist w.r.t to a target surface body.
- * Ghost cells are considered.
+ * Ghost cells are considered. Distances are computed by fast marching on the cell
+   face adjacency, see distanceFieldUtils::cellsDistance.
  * \param[in] surface MimmoObject of type surface.
  * \param[in] maxdist threshold distance.
  * \param[in] seedlist (optional) list of cells to starting narrow band search.
@@ -3944,185 +4375,7 @@ MimmoObject::getCellsNarrowBandToExtSurface(MimmoObject & surface, const double
  */
 bitpit::PiercedVector<double>
 MimmoObject::getCellsNarrowBandToExtSurfaceWDist(MimmoObject & surface, const double & maxdist, livector1D * seedlist){
-
-    //TODO this propagation does not work properly in parallel. Please review it
-    //using propagated distance on ghost.
-    surface.updateAdjacencies();
-
-    if (m_skdTreeSync != SyncStatus::SYNC)
-        buildSkdTree();
-
-    if (surface.getSkdTreeSyncStatus() != SyncStatus::SYNC)
-        surface.buildSkdTree();
-
-    bitpit::PiercedVector<double> result;
-    if(surface.getType() != 1) return result;
-    if(getType() == 3)  return result;
-
-    //use a stack-based search on face cell neighbors of some prescribed seed cells.
-    //You need at least one cell to be near enough to surface
-
-    //First step check seed list and precalculate distance. If dist >= maxdist
-    //the seed candidate is out.
-    int npoints(0);
-    darray3E point;
-    dvecarr3E points;
-    dvector1D distances;
-    livector1D surface_ids;
-    livector1D candidates;
-    double distance, maxdistance(maxdist);
-    long id;
-
-
-
-    if(seedlist){
-        //check if seedlist contains valid cell ids for the current mesh/local rank partition.
-        candidates.reserve(seedlist->size());
-        bitpit::PiercedVector<bitpit::Cell> & cells = getCells();
-        for(long id : *seedlist){
-            if(cells.exists(id))    candidates.push_back(id);
-        }
-        candidates.shrink_to_fit();
-        // Fill points array with seed list
-        npoints = candidates.size();
-        points.reserve(npoints);
-        for(long idseed : candidates){
-            points.emplace_back(getPatch()->evalCellCentroid(idseed));
-        }
-
-    } else {
-
-        // Find the seeds by using all the cells of surface patch
-        // Recover the seeds by selecting by patch the target cells
-        // by using the surface input patch as selection patch.
-        // Then check if the candidate cells are closer than maxdistance,
-        // in this case insert in result as seeds
-
-
-#if MIMMO_ENABLE_MPI
-        if (surface.isParallel()){
-            candidates = skdTreeUtils::selectByGlobalPatch(surface.getSkdTree(), getSkdTree(), maxdistance);
-        } else
-#endif
-        {
-            candidates = skdTreeUtils::selectByPatch(surface.getSkdTree(), getSkdTree(), maxdistance);
-        }
-
-        npoints = candidates.size();
-        points.reserve(npoints);
-        for(long idseed : candidates){
-            points.emplace_back(getPatch()->evalCellCentroid(idseed));
-        }
-
-    } // end if seed list is null
-
-
-    distances.resize(npoints, std::numeric_limits<double>::max());
-    surface_ids.resize(npoints, bitpit::Cell::NULL_ID);
-
-    // Compute distances from surface
-#if MIMMO_ENABLE_MPI
-    if (surface.isParallel()){
-        ivector1D surface_ranks(npoints, -1);
-        skdTreeUtils::globalDistance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), surface_ranks.data(), distances.data(), maxdistance);
-    } else
-#endif
-    {
-        skdTreeUtils::distance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), distances.data(), maxdistance);
-    }
-
-    // Fill seeds (directly in result) if distance < maxdistance
-    for (int ipoint = 0; ipoint < npoints; ipoint++){
-        distance = distances[ipoint];
-        id = candidates[ipoint];
-        if(distance < maxdist){
-            result.insert(id, distance);
-        }
-    }
-
-	// create the stack of neighbours with the seed i have.
-	std::unordered_set<long> visited;
-	livector1D stackNeighs, newStackNeighs;
-	std::unordered_set<long> tt;
-	for(auto it = result.begin(); it != result.end(); ++it){
-		livector1D neighs = getPatch()->findCellNeighs(it.getId(), 1); //only face neighs.
-		for(long id: neighs){
-			if(!result.exists(id))  visited.insert(id);
-		}
-	}
-	stackNeighs.insert(stackNeighs.end(), visited.begin(), visited.end());
-
-	//add as visited also the id already in result;
-	{
-		livector1D temp = result.getIds();
-		visited.insert(temp.begin(), temp.end());
-	}
-
-	// Search until the stack is empty.
-	// In case of parallel and partitioned test the global stack size
-	bool stackEmpty = stackNeighs.empty();
-#if MIMMO_ENABLE_MPI
-    if (isParallel()){
-        MPI_Allreduce(MPI_IN_PLACE, &stackEmpty, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
-    }
-#endif
-    while(!stackEmpty){
-
-        // use all stack neighs as candidates
-        visited.insert(stackNeighs.begin(), stackNeighs.end());
-
-        // evaluate their distances;
-        npoints = stackNeighs.size();
-        points.clear();
-        points.reserve(npoints);
-        distances.clear();
-        distances.resize(npoints, std::numeric_limits<double>::max());
-        surface_ids.clear();
-        surface_ids.resize(npoints, bitpit::Cell::NULL_ID);
-        for (long idtarget : stackNeighs){
-            points.emplace_back(getPatch()->evalCellCentroid(idtarget));
-        }
-
-#if MIMMO_ENABLE_MPI
-        if (surface.isParallel()){
-            ivector1D surface_ranks(npoints, -1);
-            skdTreeUtils::globalDistance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), surface_ranks.data(), distances.data(), maxdistance);
-        } else
-#endif
-        {
-            skdTreeUtils::distance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), distances.data(), maxdistance);
-        }
-
-        // Fill points inside narrow band in result and their neighbours in stack
-        for (int ipoint = 0; ipoint < npoints; ipoint++){
-            distance = distances[ipoint];
-            id = stackNeighs[ipoint];
-            if(distance < maxdist){
-                result.insert(id, distance);
-                livector1D neighs = getPatch()->findCellNeighs(id, 1); //only face neighs.
-                for(long id : neighs){
-                    if(visited.count(id) < 1){
-                        visited.insert(id);
-                        newStackNeighs.push_back(id);
-                    }
-                }
-            }
-        } // end loop on points
-
-        // Empty stack by old targets and push the new stack neighs
-        stackNeighs.swap(newStackNeighs);
-        livector1D().swap(newStackNeighs);
-
-        stackEmpty = stackNeighs.empty();
-#if MIMMO_ENABLE_MPI
-        if (isParallel()){
-            MPI_Allreduce(MPI_IN_PLACE, &stackEmpty, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
-        }
-#endif
-
-    } // end while stack empty
-    return result;
-
+    return distanceFieldUtils::cellsDistance(*this, surface, maxdist, seedlist);
 };
 
 /*!
@@ -4144,7 +4397,8 @@ MimmoObject::getVerticesNarrowBandToExtSurface(MimmoObject & surface, const doub
 /*!
  * Get all the vertices of the current mesh within a prescribed distance
    maxdist w.r.t to a target surface body.
- * Ghost vertices are considered.
+ * Ghost vertices are considered. Distances are computed by fast marching on the point
+   connectivity, see distanceFieldUtils::pointsDistance.
  * \param[in] surface MimmoObject of type surface.
  * \param[in] maxdist threshold distance.
  * \param[in] seedlist (optional) list of vertices to starting narrow band search.
@@ -4153,187 +4407,7 @@ MimmoObject::getVerticesNarrowBandToExtSurface(MimmoObject & surface, const doub
  */
 bitpit::PiercedVector<double>
 MimmoObject::getVerticesNarrowBandToExtSurfaceWDist(MimmoObject & surface, const double & maxdist, livector1D * seedlist){
-
-    //TODO this propagation does not work properly in parallel. Please review it
-    //using propagated distance on ghost.
-
-    bitpit::PiercedVector<double> result;
-    if(surface.getType() != 1) return result;
-
-    surface.updateAdjacencies();
-
-    if (m_skdTreeSync != SyncStatus::SYNC)
-        buildSkdTree();
-
-    if (surface.getSkdTreeSyncStatus() != SyncStatus::SYNC)
-        surface.buildSkdTree();
-
-    if(getPointConnectivitySyncStatus() != SyncStatus::SYNC)
-        buildPointConnectivity();
-
-    //use a stack-based search on ring vertex neighbors of some prescribed seed vertex.
-    //You need at least one vertex to be near enough to surface
-
-    //First step check seed list and precalculate distance. If dist >= maxdist
-    //the seed candidate is out.
-    int npoints(0);
-    darray3E point;
-    dvecarr3E points;
-    dvector1D distances;
-    livector1D surface_ids;
-    livector1D candidates;
-    double distance, maxdistance(maxdist);
-    long id;
-
-    // Fill points candidates with seedlist or found candidates
-    if(seedlist){
-        //check if seedlist contains valid vertex ids for the current mesh/local rank partition.
-        candidates.reserve(seedlist->size());
-        bitpit::PiercedVector<bitpit::Vertex> & verts = getVertices();
-        for(long id : *seedlist){
-            if(verts.exists(id))    candidates.push_back(id);
-        }
-        candidates.shrink_to_fit();
-        // Fill points array with seed list
-        npoints = candidates.size();
-        points.reserve(npoints);
-        for(long idseed : candidates){
-            points.emplace_back(getVertexCoords(idseed));
-        }
-
-    }else if(getType() != 3){
-
-        // Find the seeds by using all the cells of surface patch
-        // Recover the seeds by selecting by patch the target cells
-        // by using the surface input patch as selection patch.
-        // Then check if the candidate cells are closer than maxdistance,
-        // in this case insert in result as seeds
-
-        // Create cell candidates structure
-        livector1D cell_candidates;
-#if MIMMO_ENABLE_MPI
-        if (surface.isParallel()){
-            cell_candidates = skdTreeUtils::selectByGlobalPatch(surface.getSkdTree(), getSkdTree(), maxdistance);
-        } else
-#endif
-        {
-            cell_candidates = skdTreeUtils::selectByPatch(surface.getSkdTree(), getSkdTree(), maxdistance);
-        }
-
-        livector1D candidates = getVertexFromCellList(cell_candidates);
-        // Fill points candidates with all the vertices of the found cells
-        for(long idseed : candidates){
-            points.emplace_back(getVertexCoords(idseed));
-        }
-
-    } // end if seed list is null
-
-    distances.resize(npoints, std::numeric_limits<double>::max());
-    surface_ids.resize(npoints, bitpit::Cell::NULL_ID);
-    // Compute distances from surface
-#if MIMMO_ENABLE_MPI
-    if (surface.isParallel()){
-        ivector1D surface_ranks(npoints, -1);
-        skdTreeUtils::globalDistance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), surface_ranks.data(), distances.data(), maxdistance);
-    } else
-#endif
-    {
-        skdTreeUtils::distance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), distances.data(), maxdistance);
-    }
-
-    // Fill seed points (directly in result) if distance < maxdistance
-    for (int ipoint = 0; ipoint < npoints; ipoint++){
-        distance = distances[ipoint];
-        id = candidates[ipoint];
-        if(distance < maxdist){
-            result.insert(id, distance);
-        }
-    }
-
-    // create the stack of neighbours with the seed i have.
-    std::unordered_set<long> visited;
-    livector1D stackNeighs, newStackNeighs;
-    std::unordered_set<long> tt;
-    for(auto it = result.begin(); it != result.end(); ++it){
-        std::unordered_set<long> neighs = getPointConnectivity(it.getId()); //only edge connected neighbours.
-        for(long id: neighs){
-            if(!result.exists(id))  visited.insert(id);
-        }
-    }
-    stackNeighs.insert(stackNeighs.end(), visited.begin(), visited.end());
-
-    //add as visited also the id already in result;
-    {
-        livector1D temp = result.getIds();
-        visited.insert(temp.begin(), temp.end());
-    }
-
-    // Search until the stack is empty.
-    // In case of parallel and partitioned test the global stack size
-    bool stackEmpty = stackNeighs.empty();
-#if MIMMO_ENABLE_MPI
-    if (isParallel()){
-        MPI_Allreduce(MPI_IN_PLACE, &stackEmpty, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
-    }
-#endif
-    while(!stackEmpty){
-
-        // use all stack neighs as candidates
-        visited.insert(stackNeighs.begin(), stackNeighs.end());
-
-        // evaluate their distances;
-        npoints = stackNeighs.size();
-        points.clear();
-        points.reserve(npoints);
-        distances.clear();
-        distances.resize(npoints, std::numeric_limits<double>::max());
-        surface_ids.clear();
-        surface_ids.resize(npoints, bitpit::Cell::NULL_ID);
-        for (long idtarget : stackNeighs){
-            points.emplace_back(getVertexCoords(idtarget));
-        }
-
-#if MIMMO_ENABLE_MPI
-        if (surface.isParallel()){
-            ivector1D surface_ranks(npoints, -1);
-            skdTreeUtils::globalDistance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), surface_ranks.data(), distances.data(), maxdistance);
-        } else
-#endif
-        {
-            skdTreeUtils::distance(npoints, points.data(), surface.getSkdTree(), surface_ids.data(), distances.data(), maxdistance);
-        }
-
-        // Fill points inside narrow band in result and their neighbours in stack
-        for (int ipoint = 0; ipoint < npoints; ipoint++){
-            distance = distances[ipoint];
-            id = stackNeighs[ipoint];
-            if(distance < maxdist){
-                result.insert(id, distance);
-                std::unordered_set<long int> neighs = getPointConnectivity(id); //only edge connected
-                for(long id : neighs){
-                    if(visited.count(id) < 1){
-                        visited.insert(id);
-                        newStackNeighs.push_back(id);
-                    }
-                }
-            }
-        } // end loop on points
-
-        // Empty stack by old targets and push the new stack neighs
-        stackNeighs.swap(newStackNeighs);
-        livector1D().swap(newStackNeighs);
-
-        stackEmpty = stackNeighs.empty();
-#if MIMMO_ENABLE_MPI
-        if (isParallel()){
-            MPI_Allreduce(MPI_IN_PLACE, &stackEmpty, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
-        }
-#endif
-
-    } // end while stack empty
-
-    return result;
-
+    return distanceFieldUtils::pointsDistance(*this, surface, maxdist, seedlist);
 };
 
 
@@ -4490,9 +4564,44 @@ double MimmoObject::evalInterfaceArea(const long & id){
 	return result;
 }
 
+/*!
+  INTERNAL use. Apply a function to the vertex pairs of the edges of a cell.
+  \param[in] cell target cell
+  \param[in] type type of the geometry the cell belongs to
+  \param[in] f function called with the ids of the two vertices of each edge
+ */
+template<typename Function>
+static void
+forEachCellEdge(const bitpit::Cell & cell, int type, Function f)
+{
+    int ne = 0;
+    if (type == 1)
+        ne = cell.getFaceCount();
+    if (type == 2)
+        ne = cell.getEdgeCount();
+    if (type == 4)
+        ne = 1;
+
+    for (int i=0; i<ne; i++){
+        bitpit::ConstProxyVector<long> ids;
+        if (type == 1)
+            ids = cell.getFaceVertexIds(i);
+        if (type == 2)
+            ids = cell.getEdgeVertexIds(i);
+        if (type == 4)
+            ids = cell.getVertexIds();
+
+        // Edges have always two nodes
+        f(ids[0], ids[1]);
+    }
+}
+
 /*!
   Build the Node-Node connectivity of the tessellated mesh,(nodes connected by edges)
   and store it internally.
+  The connectivity is stored in compressed rows (CSR), one row for each raw index of
+  the vertices in their container, holding the sorted ids of the 1-Ring neighbours.
+  Rows are filled concurrently from the vertex-cell incidence, if OpenMP is enabled.
  */
 void
 MimmoObject::buildPointConnectivity()
@@ -4502,53 +4611,110 @@ MimmoObject::buildPointConnectivity()
 	//No point connectivity for point cloud
 	if(getType() == 3) return;
 
-    m_pointConnectivity.reserve(getNVertices());
-
     // Surface/volume mesh & 3d curve point connectivity
-	if(getType() == 1 || getType() == 2 || getType() == 4){
-
-		// Edge connectivity
-	    // All cells are considered, both interiors and ghosts
-		std::set<std::pair<long,long> > edges;
-		for (bitpit::Cell & cell : getCells()){
-			int ne = 0;
-			if (m_type == 1)
-				ne = cell.getFaceCount();
-			if (m_type == 2)
-				ne = cell.getEdgeCount();
-			if (m_type == 4)
-				ne = 1;
-
-			for (int i=0; i<ne; i++){
-				bitpit::ConstProxyVector<long> ids;
-				if (m_type == 1)
-					ids = cell.getFaceVertexIds(i);
-				if (m_type == 2)
-					ids = cell.getEdgeVertexIds(i);
-				if (m_type == 4)
-					ids = cell.getVertexIds();
-
-				// Edges have always two nodes
-				long id1 = ids[0];
-				long id2 = ids[1];
-				std::pair<long,long> item;
-				if (id1<id2)
-					item=std::pair<long,long>(id1,id2);
-				else
-					item = std::pair<long,long>(id2,id1);
-				if (!edges.count(item)){
-					edges.insert(item);
-					m_pointConnectivity[id1].insert(id2);
-					m_pointConnectivity[id2].insert(id1);
-				}
-			}
-		}
-	}
-	else{
+	if(getType() != 1 && getType() != 2 && getType() != 4){
 		//No allowed type
 		return;
 	}
 
+    const bitpit::PiercedVector<bitpit::Vertex, long> & vertices = getVertices();
+    std::size_t nRows = 0;
+    for (auto it = vertices.cbegin(); it != vertices.cend(); ++it){
+        nRows = std::max(nRows, it.getRawIndex() + 1);
+    }
+
+    // All cells are considered, both interiors and ghosts
+    std::vector<const bitpit::Cell *> cells;
+    cells.reserve(getNCells());
+    for (const bitpit::Cell & cell : getCells()){
+        cells.push_back(&cell);
+    }
+    long nCells = long(cells.size());
+
+    // Vertex-cell incidence in compressed rows
+    std::vector<std::size_t> incidenceOffsets(nRows + 1, 0);
+    for (const bitpit::Cell * cell : cells){
+        for (long idV : cell->getVertexIds()){
+            ++incidenceOffsets[vertices.getRawIndex(idV) + 1];
+        }
+    }
+    for (std::size_t row=0; row<nRows; ++row){
+        incidenceOffsets[row+1] += incidenceOffsets[row];
+    }
+    std::vector<long> incidence(incidenceOffsets[nRows]);
+    std::vector<std::size_t> cursor(incidenceOffsets.begin(), incidenceOffsets.end() - 1);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long icell=0; icell<nCells; ++icell){
+        for (long idV : cells[icell]->getVertexIds()){
+            std::size_t row = vertices.getRawIndex(idV);
+            std::size_t pos;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif
+            pos = cursor[row]++;
+            incidence[pos] = icell;
+        }
+    }
+    std::vector<std::size_t>().swap(cursor);
+
+    // Neighbours of a vertex from the edges of its cells, sorted and unique
+    int type = m_type;
+    auto collectRing = [&](std::size_t row, long id, std::vector<long> & ring){
+        ring.clear();
+        for (std::size_t k=incidenceOffsets[row]; k<incidenceOffsets[row+1]; ++k){
+            forEachCellEdge(*cells[incidence[k]], type, [&](long id1, long id2){
+                if (id1 == id)  ring.push_back(id2);
+                else if (id2 == id)  ring.push_back(id1);
+            });
+        }
+        std::sort(ring.begin(), ring.end());
+        ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+    };
+
+    // Rows of existing vertices; raw holes are left empty
+    std::vector<long> rowIds(nRows, bitpit::Vertex::NULL_ID);
+    for (auto it = vertices.cbegin(); it != vertices.cend(); ++it){
+        rowIds[it.getRawIndex()] = it.getId();
+    }
+    long nRowsL = long(nRows);
+
+    // Count, then fill the rows
+    m_pointConnectivityOffsets.assign(nRows + 1, 0);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<long> ring;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 256)
+#endif
+        for (long row=0; row<nRowsL; ++row){
+            if (rowIds[row] == bitpit::Vertex::NULL_ID) continue;
+            collectRing(row, rowIds[row], ring);
+            m_pointConnectivityOffsets[row+1] = ring.size();
+        }
+    }
+    for (std::size_t row=0; row<nRows; ++row){
+        m_pointConnectivityOffsets[row+1] += m_pointConnectivityOffsets[row];
+    }
+    m_pointConnectivity.resize(m_pointConnectivityOffsets[nRows]);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<long> ring;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 256)
+#endif
+        for (long row=0; row<nRowsL; ++row){
+            if (rowIds[row] == bitpit::Vertex::NULL_ID) continue;
+            collectRing(row, rowIds[row], ring);
+            std::copy(ring.begin(), ring.end(), m_pointConnectivity.begin() + m_pointConnectivityOffsets[row]);
+        }
+    }
+
 	m_pointConnectivitySync = SyncStatus::SYNC;
 }
 
@@ -4558,7 +4724,8 @@ MimmoObject::buildPointConnectivity()
 void
 MimmoObject::cleanPointConnectivity()
 {
-	std::unordered_map<long, std::unordered_set<long> >().swap(m_pointConnectivity);
+	std::vector<std::size_t>().swap(m_pointConnectivityOffsets);
+	std::vector<long>().swap(m_pointConnectivity);
 
     if(m_pointConnectivitySync == SyncStatus::SYNC){
         m_pointConnectivitySync = SyncStatus::UNSYNC;
@@ -4568,13 +4735,26 @@ MimmoObject::cleanPointConnectivity()
 /*!
     Get the connectivity of a target node/vertex
     \param[in] id of target node
-    \return connectivity nodes list of id-target.
+    \return view on the sorted connectivity nodes list of id-target.
  */
-std::unordered_set<long> &
+bitpit::ConstProxyVector<long>
 MimmoObject::getPointConnectivity(const long & id)
 {
-	assert(m_pointConnectivity.count(id) > 0 && "MimmoObject::not valid id in getPointConnectivity call");
-	return m_pointConnectivity[id];
+	return getPointConnectivityRaw(getVertices().getRawIndex(id));
+}
+
+/*!
+    Get the connectivity of a target node/vertex given its raw index in the vertex
+    container, e.g. from a vertex iterator: no id lookup is needed.
+    \param[in] rawIndex raw index of target node
+    \return view on the sorted connectivity nodes list of the target node.
+ */
+bitpit::ConstProxyVector<long>
+MimmoObject::getPointConnectivityRaw(std::size_t rawIndex)
+{
+	assert(rawIndex + 1 < m_pointConnectivityOffsets.size() && "MimmoObject::not valid raw index in getPointConnectivity call");
+	std::size_t begin = m_pointConnectivityOffsets[rawIndex];
+	return bitpit::ConstProxyVector<long>(m_pointConnectivity.data() + begin, m_pointConnectivityOffsets[rawIndex + 1] - begin);
 }
 
 /*!
@@ -4680,6 +4860,7 @@ MimmoObject::triangulate(){
 	    }
 
 	    // Unsync structures and update geometry
+	    m_cellsRevision = newRevision();
 	    m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
         m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
         m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
@@ -4807,6 +4988,7 @@ MimmoObject::degradeDegenerateElements(bitpit::PiercedVector<bitpit::Cell>* degr
     // Unsync structures and update geometry if some cells deleted
     if (!toDelete.empty()){
         // Unsync structures and update geometry
+        m_cellsRevision = newRevision();
         m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
         m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
         m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
@@ -31,6 +31,7 @@
 #include <bitpit_SA.hpp>
 #include <surface_skd_tree.hpp>
 #include <volume_skd_tree.hpp>
+#include <mutex>
 #if MIMMO_ENABLE_MPI==1
 #	include <mpi.h>
 #endif
@@ -108,6 +109,26 @@ enum class SyncStatus: long {
     SYNC = 2               /**< structure synchronized with geometry status */
 };
 
+/*!
+   \ingroup core
+ * \brief Contiguous structure-of-arrays view of the coordinates of the vertices of a MimmoObject.
+ *
+ * Vertices are stored in the order of the container of the patch: position i of x, y, z
+ * refers to the vertex ids[i], stored at raw index rawIndices[i] of the container.
+ * The inverse map indices returns the position of a vertex given its id.
+ */
+struct VertexCoordsSoA{
+    dvector1D                               x;          /**< x coordinates of the vertices.*/
+    dvector1D                               y;          /**< y coordinates of the vertices.*/
+    dvector1D                               z;          /**< z coordinates of the vertices.*/
+    livector1D                              ids;        /**< ids of the vertices.*/
+    std::vector<std::size_t>                rawIndices; /**< raw indices of the vertices in the patch container.*/
+    std::unordered_map<long, std::size_t>   indices;    /**< map vertex id -> position in the arrays.*/
+
+    /*! \return number of vertices in the view.*/
+    std::size_t size() const { return ids.size(); }
+};
+
 /*!
 * \class MimmoObject
   \ingroup core
@@ -120,6 +141,9 @@ enum class SyncStatus: long {
   It supports PID convention to mark subparts of geometry as well as building the search-trees
   KdTree (3D point spatial ordering) and skdTree(Cell-AABB spatial ordering) to quickly retrieve
   vertices and cells in the data structure.
+  A built KdTree can be written together with the geometry by dump (or in a separate
+  stream by dumpTrees) and taken back at restore without rebuilding it. The SkdTree is not
+  persisted and has to be built again after restore.
 */
 class MimmoObject{
 
@@ -143,6 +167,7 @@ protected:
     SyncStatus                                              m_AdjSync;      /**< Synchronization status of adjacencies along with geometry modifications */
     SyncStatus                                              m_IntSync;      /**< Synchronization status of interfaces  along with geometry modifications */
     bitpit::Logger*                                         m_log;          /**< Pointer to logger.*/
+    std::map<std::string, double>                           m_updateTimes;  /**< Wall time [s] spent on each structure by the last update() call.*/
 
     int							m_nprocs;									/**< Total number of processors.*/
     int							m_rank;										/**< Current rank number.*/
@@ -162,9 +187,16 @@ protected:
 
     SyncStatus                  m_boundingBoxSync;      /**< Synchronization status of patch bounding box along with geometry modifications */
 
-    std::unordered_map<long, std::unordered_set<long> >	m_pointConnectivity;		/**< Point-Point connectivity. 1-Ring neighbours of each vertex.*/
+    std::vector<std::size_t>                            m_pointConnectivityOffsets; /**< CSR offsets of Point-Point connectivity, one row for each raw index of vertices.*/
+    std::vector<long>                                   m_pointConnectivity;		/**< CSR Point-Point connectivity. Sorted 1-Ring neighbours of each vertex.*/
     SyncStatus                     						m_pointConnectivitySync;	/**< Track correct building of points connectivity along with geometry modifications */
 
+    std::size_t                 m_verticesRevision = newRevision(); /**< Revision of the vertices, renewed at each modification of the vertices, unique in the process.*/
+    std::size_t                 m_cellsRevision = newRevision();    /**< Revision of the cells, renewed at each insertion or deletion of cells, unique in the process.*/
+    std::size_t                 m_verticesCoordsRevision = 0;   /**< Revision of the vertices the coordinates view is built on.*/
+    VertexCoordsSoA             m_verticesCoords;               /**< Cached contiguous view of the vertices coordinates.*/
+    std::mutex                  m_verticesCoordsMutex;          /**< Lock serializing the lazy build of the coordinates view.*/
+
 public:
     MimmoObject(int type = 1);
     MimmoObject(int type, dvecarr3E & vertex, livector2D * connectivity = nullptr);
@@ -190,6 +222,9 @@ public:
 #endif
     dvecarr3E                                       getVerticesCoords(lilimap* mapDataInv = nullptr);
     const darray3E &                                getVertexCoords(long i) const;
+    const VertexCoordsSoA &                         getVerticesCoordsSoA();
+    std::size_t                                     getVerticesRevision() const;
+    std::size_t                                     getCellsRevision() const;
     bitpit::PiercedVector<bitpit::Vertex> &         getVertices();
     const bitpit::PiercedVector<bitpit::Vertex> &   getVertices() const ;
 
@@ -253,6 +288,7 @@ public:
     long        addVertex(const darray3E & vertex, const long idtag = bitpit::Vertex::NULL_ID);
     long        addVertex(const bitpit::Vertex & vertex, const long idtag = bitpit::Vertex::NULL_ID);
     bool        modifyVertex(const darray3E & vertex, const long & id);
+    void        modifyVerticesCoords(dvector1D x, dvector1D y, dvector1D z);
 
     long        addConnectedCell(const livector1D & locConn, bitpit::ElementType type, int rank = -1);
     long        addConnectedCell(const livector1D & locConn, bitpit::ElementType type, long idtag, int rank = -1);
@@ -315,8 +351,10 @@ public:
     void    	cleanKdTree();
     void        cleanSkdTree();
     void        cleanBoundingBox();
+    void        cleanVerticesCoordsSoA();
 
     void        update();
+    const std::map<std::string, double> & getUpdateTimes() const;
 
     SyncStatus        getAdjacenciesSyncStatus();
     SyncStatus        getInterfacesSyncStatus();
@@ -326,8 +364,10 @@ public:
 
     bitpit::ElementType desumeElement(const livector1D &);
 
-    void        dump(std::ostream & stream);
+    void        dump(std::ostream & stream, bool trees = false);
     void        restore(std::istream & stream);
+    void        dumpTrees(std::ostream & stream);
+    bool        restoreTrees(std::istream & stream);
 
     void   evalCellVolumes(bitpit::PiercedVector<double> &);
     void   evalCellAspectRatio(bitpit::PiercedVector<double> &);
@@ -360,7 +400,8 @@ public:
 
     void						buildPointConnectivity();
     void						cleanPointConnectivity();
-    std::unordered_set<long> &	getPointConnectivity(const long & id);
+    bitpit::ConstProxyVector<long>	getPointConnectivity(const long & id);
+    bitpit::ConstProxyVector<long>	getPointConnectivityRaw(std::size_t rawIndex);
     SyncStatus  				getPointConnectivitySyncStatus();
 
     void						triangulate();
@@ -373,6 +414,7 @@ protected:
     void    reset(int type);
 
     std::unordered_set<int> elementsMap(bitpit::PatchKernel & obj);
+    uint64_t    evalTreesSignature();
 
 #if MIMMO_ENABLE_MPI
     void    initializeMPI();
@@ -385,6 +427,7 @@ private:
     MimmoObject & operator=(MimmoObject other);
 
     bool    checkCellConnCoherence(const bitpit::ElementType & type, const livector1D & conn_);
+    static std::size_t  newRevision();
 
 	/*!
         \struct VertexPositionLess
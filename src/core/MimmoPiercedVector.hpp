@@ -55,6 +55,10 @@ enum class MPVLocation: long {
  * It supports a string name attribute to mark the field as well as a location enum to
  * understand to which structures of geometry refers the data (UNDEFINED no-info, POINT-vertices,
  * CELL-cells, INTERFACE-interfaces).
+ *
+ * In MPI runs ghost data are updated with communicateData, or with the pair
+ * beginCommunicateData/endCommunicateData to overlap the exchange with local work;
+ * the exchange may be restricted to the entries changed since the previous one.
  */
 template<typename mpv_t>
 class MimmoPiercedVector: public bitpit::PiercedVector<mpv_t, long int> {
@@ -63,6 +67,10 @@ private:
     MPVLocation                              m_loc;         /**< MPVLocation enum */
     bitpit::Logger*                          m_log;         /**<Pointer to logger.*/
     std::string								 m_name;		/**<Field name. */
+#if MIMMO_ENABLE_MPI
+    std::unique_ptr<bitpit::DataCommunicator> m_dataCommunicator; /**<Communicator of the ghost data exchange in progress, if any. */
+    bool                                     m_changedOnly; /**<True if the exchange in progress carries changed entries only. */
+#endif
 
 public:
     MimmoPiercedVector(MimmoSharedPointer<MimmoObject> geo = nullptr, MPVLocation loc = MPVLocation::UNDEFINED);
@@ -110,6 +118,9 @@ public:
 
 #if MIMMO_ENABLE_MPI
     void communicateData();
+    void beginCommunicateData(const livector1D * changed = nullptr);
+    void endCommunicateData();
+    bool isCommunicatingData() const;
 #endif
 
 private:
@@ -93,6 +93,9 @@ MimmoPiercedVector<mpv_t>::MimmoPiercedVector(MimmoSharedPointer<MimmoObject> ge
 	m_loc = loc;
 	m_log = &bitpit::log::cout(MIMMO_LOG_FILE);
 	m_name = "data";
+#if MIMMO_ENABLE_MPI
+	m_changedOnly = false;
+#endif
 }
 
 /*!
@@ -111,6 +114,10 @@ MimmoPiercedVector<mpv_t>::MimmoPiercedVector(const MimmoPiercedVector<mpv_t> &
 	this->m_loc = other.m_loc;
 	this->m_name = other.m_name;
 	m_log = &bitpit::log::cout(MIMMO_LOG_FILE);
+#if MIMMO_ENABLE_MPI
+	//exchanges in progress are not copied.
+	m_changedOnly = false;
+#endif
 };
 
 /*!
@@ -145,6 +152,10 @@ void MimmoPiercedVector<mpv_t>::swap(MimmoPiercedVector<mpv_t> & x) noexcept
 	std::swap(this->m_geometry, x.m_geometry);
 	std::swap(this->m_loc, x.m_loc);
 	this->m_name.swap(x.m_name);
+#if MIMMO_ENABLE_MPI
+	std::swap(this->m_dataCommunicator, x.m_dataCommunicator);
+	std::swap(this->m_changedOnly, x.m_changedOnly);
+#endif
 	this->bitpit::PiercedVector<mpv_t, long int>::swap(x);
 }
 
@@ -936,11 +947,37 @@ MimmoPiercedVector<mpv_t>::squeezeOutExcept(const std::unordered_set<long int> &
  * If data on ghost sources/targets points/cells are not defined, the constructor default
  * data value is used and insert in the vector with the missing ids.
  * The linked geometry has to be previously updated before call this function.
+ * Blocking version of beginCommunicateData/endCommunicateData.
  *
 */
 template<typename mpv_t>
 void
 MimmoPiercedVector<mpv_t>::communicateData(){
+    beginCommunicateData();
+    endCommunicateData();
+}
+
+/*!
+ * Start the communication of the data from ghost sources to targets, see communicateData.
+ * Sends and receives are posted and the method returns: the data of the source entries
+ * can be modified and local work not involving the ghost entries can be done until
+ * endCommunicateData is called. Collective over the geometry communicator.
+ *
+ * If a list of changed ids is given, only the source entries in the list are sent and
+ * only the related ghost entries are updated; processes with no changed entry to send
+ * to a neighbour skip the message. Ghost entries have to exist already, e.g. from a
+ * previous complete exchange.
+ *
+ * \param[in] changed pointer to the list of the ids of the entries changed since the
+ * previous exchange; if null all the source entries are sent.
+*/
+template<typename mpv_t>
+void
+MimmoPiercedVector<mpv_t>::beginCommunicateData(const livector1D * changed){
+
+    if (m_dataCommunicator){
+        throw std::runtime_error("MimmoPiercedVector::beginCommunicateData : data exchange already in progress");
+    }
 
     // If geometry not linked return
     if (getGeometry() == nullptr){
@@ -957,72 +994,142 @@ MimmoPiercedVector<mpv_t>::communicateData(){
 
     // The linked geometry has to be updated before to call the communication method
 
-    // Instantiate data communicator
-    std::unique_ptr<bitpit::DataCommunicator> dataCommunicator(new bitpit::DataCommunicator(geometry->getCommunicator()));
-
-    // Set sources and targets lists
-    MPVLocation location = getDataLocation();
-    std::unordered_map<int, std::vector<long>> sources, targets;
-    switch (location){
+    // Set sources lists
+    const std::unordered_map<int, std::vector<long>> * sources;
+    switch (getDataLocation()){
     case MPVLocation::POINT :
-        sources = getGeometry()->getPatch()->getGhostVertexExchangeSources();
-        targets = getGeometry()->getPatch()->getGhostVertexExchangeTargets();
+        sources = &(geometry->getPatch()->getGhostVertexExchangeSources());
         break;
     case MPVLocation::CELL :
-        sources = getGeometry()->getPatch()->getGhostCellExchangeSources();
-        targets = getGeometry()->getPatch()->getGhostCellExchangeTargets();
+        sources = &(geometry->getPatch()->getGhostCellExchangeSources());
         break;
     default :
-        break;
+        return;
     }
 
+    // Instantiate data communicator
+    m_dataCommunicator.reset(new bitpit::DataCommunicator(geometry->getCommunicator()));
+    m_changedOnly = (changed != nullptr);
+
     // Recover data size
     size_t exchangeDataSize = sizeof(mpv_t);
 
     // Set and start the sends
-    for (const auto entry : sources) {
-        const int rank = entry.first;
-        auto &list = entry.second;
-        dataCommunicator->setSend(rank, list.size() * exchangeDataSize);
-        bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(rank);
-        for (long id : list) {
-            if (this->count(id)){
-                buffer << this->at(id);
-            }else{
-                // If data id doesn't exist use default constructor value
-                buffer << mpv_t();
+    if (m_changedOnly){
+        // Changed entries are sent as their position in the exchange list and value
+        std::unordered_set<long> changedIds(changed->begin(), changed->end());
+        std::vector<long> positions;
+        for (const auto & entry : *sources) {
+            const int rank = entry.first;
+            auto &list = entry.second;
+            positions.clear();
+            for (std::size_t i = 0; i < list.size(); ++i) {
+                if (changedIds.count(list[i])){
+                    positions.push_back(long(i));
+                }
             }
+            if (positions.empty()){
+                continue;
+            }
+            m_dataCommunicator->setSend(rank, sizeof(long) + positions.size() * (sizeof(long) + exchangeDataSize));
+            bitpit::SendBuffer &buffer = m_dataCommunicator->getSendBuffer(rank);
+            buffer << long(positions.size());
+            for (long pos : positions) {
+                long id = list[pos];
+                buffer << pos;
+                if (this->count(id)){
+                    buffer << this->at(id);
+                }else{
+                    buffer << mpv_t();
+                }
+            }
+            m_dataCommunicator->startSend(rank);
+        }
+    }else{
+        for (const auto & entry : *sources) {
+            const int rank = entry.first;
+            auto &list = entry.second;
+            m_dataCommunicator->setSend(rank, list.size() * exchangeDataSize);
+            bitpit::SendBuffer &buffer = m_dataCommunicator->getSendBuffer(rank);
+            for (long id : list) {
+                if (this->count(id)){
+                    buffer << this->at(id);
+                }else{
+                    // If data id doesn't exist use default constructor value
+                    buffer << mpv_t();
+                }
+            }
+            m_dataCommunicator->startSend(rank);
         }
-        dataCommunicator->startSend(rank);
     }
 
     // Discover & start all the receives
-    dataCommunicator->discoverRecvs();
-    dataCommunicator->startAllRecvs();
+    m_dataCommunicator->discoverRecvs();
+    m_dataCommunicator->startAllRecvs();
+}
+
+/*!
+ * Complete the communication of the data started with beginCommunicateData: ghost
+ * entries are updated with the received data as they arrive. Nothing is done if no
+ * exchange is in progress.
+*/
+template<typename mpv_t>
+void
+MimmoPiercedVector<mpv_t>::endCommunicateData(){
+
+    if (!m_dataCommunicator){
+        return;
+    }
+
+    // Set targets lists
+    const std::unordered_map<int, std::vector<long>> & targets = (getDataLocation() == MPVLocation::POINT) ?
+                    getGeometry()->getPatch()->getGhostVertexExchangeTargets() :
+                    getGeometry()->getPatch()->getGhostCellExchangeTargets();
 
     // Receive the data of the ghosts
     mpv_t value;
     int nCompletedRecvs = 0;
-    while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
-        int rank = dataCommunicator->waitAnyRecv();
+    while (nCompletedRecvs < m_dataCommunicator->getRecvCount()) {
+        int rank = m_dataCommunicator->waitAnyRecv();
         const auto &list = targets.at(rank);
-        bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(rank);
-        for (long id : list) {
-            buffer >> value;
-            if (this->count(id)){
-                this->at(id) = value;
+        bitpit::RecvBuffer &buffer = m_dataCommunicator->getRecvBuffer(rank);
+        if (m_changedOnly){
+            long count, pos;
+            buffer >> count;
+            for (long i = 0; i < count; ++i) {
+                buffer >> pos;
+                buffer >> value;
+                this->at(list[pos]) = value;
             }
-            else{
-                // If element id doesn't exist create it
-                this->insert(id, value);
+        }else{
+            for (long id : list) {
+                buffer >> value;
+                if (this->count(id)){
+                    this->at(id) = value;
+                }
+                else{
+                    // If element id doesn't exist create it
+                    this->insert(id, value);
+                }
             }
         }
         ++nCompletedRecvs;
     }
 
     // Wait for the sends to finish
-    dataCommunicator->waitAllSends();
-    dataCommunicator->finalize();
+    m_dataCommunicator->waitAllSends();
+    m_dataCommunicator->finalize();
+    m_dataCommunicator.reset();
+    m_changedOnly = false;
+}
+
+/*!
+ * \return true if a data exchange started with beginCommunicateData is in progress.
+*/
+template<typename mpv_t>
+bool
+MimmoPiercedVector<mpv_t>::isCommunicatingData() const{
+    return bool(m_dataCommunicator);
 }
 #endif
 
@@ -112,6 +112,7 @@ Module::clear(){
  */
 void
 Module::setField(dmpvecarr3E *field){
+    setDirty();
     if(!field)  return;
     m_field = *field;
 }
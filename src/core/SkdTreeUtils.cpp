@@ -28,6 +28,7 @@
 # include <surface_skd_tree.hpp>
 # include <CG.hpp>
 # include <queue>
+# include <algorithm>
 
 namespace mimmo{
 
@@ -101,6 +102,301 @@ double signedDistance(const std::array<double,3> *point, const bitpit::PatchSkdT
 
 }
 
+/*!
+ * \brief INTERNAL use. Cells of the visited leaves of a surface skd-tree, packed leaf by leaf
+ * for the batched distance queries. Triangles are stored as structure of arrays (first vertex
+ * and the two edges from it), so that the point-triangle distances of a leaf are vectorized;
+ * other elements are evaluated one by one.
+ */
+struct PackedLeaves{
+    std::vector<long>   leafIndex;  /**< packed leaf of each tree node, -1 if not packed yet.*/
+    std::vector<long>   triOffsets; /**< offsets of the triangles of each packed leaf.*/
+    std::vector<long>   polyOffsets;/**< offsets of the other elements of each packed leaf.*/
+    std::vector<long>   triIds;     /**< ids of the triangles.*/
+    std::vector<long>   polyIds;    /**< ids of the other elements.*/
+    dvector1D           ax, ay, az; /**< first vertex of the triangles.*/
+    dvector1D           ux, uy, uz; /**< first edge of the triangles.*/
+    dvector1D           vx, vy, vz; /**< second edge of the triangles.*/
+};
+
+/*!
+ * INTERNAL use. Pack the cells of a leaf node of the tree, if not already done.
+ * \param[in] tree surface skd-tree
+ * \param[in] nodeId id of the leaf node
+ * \param[in,out] pack packed leaves
+ * \return index of the packed leaf
+ */
+static long
+packLeaf(const bitpit::PatchSkdTree *tree, long nodeId, PackedLeaves & pack)
+{
+    if (pack.leafIndex[nodeId] >= 0) return pack.leafIndex[nodeId];
+
+    const bitpit::PatchKernel & patch = tree->getPatch();
+    for (long cellId : tree->getNode(nodeId).getCells()){
+        bitpit::ConstProxyVector<long> vertIds = patch.getCell(cellId).getVertexIds();
+        if (vertIds.size() == 3){
+            const std::array<double,3> & a = patch.getVertexCoords(vertIds[0]);
+            std::array<double,3> u = patch.getVertexCoords(vertIds[1]) - a;
+            std::array<double,3> v = patch.getVertexCoords(vertIds[2]) - a;
+            pack.triIds.push_back(cellId);
+            pack.ax.push_back(a[0]); pack.ay.push_back(a[1]); pack.az.push_back(a[2]);
+            pack.ux.push_back(u[0]); pack.uy.push_back(u[1]); pack.uz.push_back(u[2]);
+            pack.vx.push_back(v[0]); pack.vy.push_back(v[1]); pack.vz.push_back(v[2]);
+        } else {
+            pack.polyIds.push_back(cellId);
+        }
+    }
+    pack.triOffsets.push_back(pack.triIds.size());
+    pack.polyOffsets.push_back(pack.polyIds.size());
+    pack.leafIndex[nodeId] = long(pack.triOffsets.size()) - 2;
+    return pack.leafIndex[nodeId];
+}
+
+/*!
+ * INTERNAL use. Squared distances of a point from a range of packed triangles.
+ * The closest point is the projection on the triangle plane if it falls inside the
+ * triangle, the closest point of the three edges otherwise: all the cases are computed
+ * and selected without branches, so that the loop is vectorized.
+ * \param[in] point point coordinates
+ * \param[in] pack packed leaves
+ * \param[in] begin first triangle
+ * \param[in] end past-the-end triangle
+ * \param[out] d2 squared distances, of size end-begin at least
+ */
+static void
+evalTrianglesSquaredDistance(const std::array<double,3> & point, const PackedLeaves & pack, long begin, long end, double *d2)
+{
+    const double *ax = pack.ax.data(), *ay = pack.ay.data(), *az = pack.az.data();
+    const double *ux = pack.ux.data(), *uy = pack.uy.data(), *uz = pack.uz.data();
+    const double *vx = pack.vx.data(), *vy = pack.vy.data(), *vz = pack.vz.data();
+    const double px = point[0], py = point[1], pz = point[2];
+    const long n = end - begin;
+    const double tiny = std::numeric_limits<double>::min();
+
+#if MIMMO_ENABLE_OPENMP
+#pragma omp simd
+#endif
+    for (long k = 0; k < n; ++k){
+        long t = begin + k;
+        double wx = px - ax[t], wy = py - ay[t], wz = pz - az[t];
+        double uu = ux[t]*ux[t] + uy[t]*uy[t] + uz[t]*uz[t];
+        double uv = ux[t]*vx[t] + uy[t]*vy[t] + uz[t]*vz[t];
+        double vv = vx[t]*vx[t] + vy[t]*vy[t] + vz[t]*vz[t];
+        double wu = wx*ux[t] + wy*uy[t] + wz*uz[t];
+        double wv = wx*vx[t] + wy*vy[t] + wz*vz[t];
+
+        // projection on the plane, in barycentric coordinates (s,q)
+        double det = uu*vv - uv*uv;
+        bool valid = det > 1.0e-12 * uu * vv;
+        double invDet = 1.0 / std::max(det, tiny);
+        double s = (vv*wu - uv*wv) * invDet;
+        double q = (uu*wv - uv*wu) * invDet;
+        double fx = wx - s*ux[t] - q*vx[t], fy = wy - s*uy[t] - q*vy[t], fz = wz - s*uz[t] - q*vz[t];
+        double dPlane = fx*fx + fy*fy + fz*fz;
+        bool inside = valid & (s >= 0.0) & (q >= 0.0) & (s + q <= 1.0);
+
+        // edge from the first to the second vertex
+        double c = std::min(std::max(wu / std::max(uu, tiny), 0.0), 1.0);
+        fx = wx - c*ux[t]; fy = wy - c*uy[t]; fz = wz - c*uz[t];
+        double dEdge = fx*fx + fy*fy + fz*fz;
+
+        // edge from the first to the third vertex
+        c = std::min(std::max(wv / std::max(vv, tiny), 0.0), 1.0);
+        fx = wx - c*vx[t]; fy = wy - c*vy[t]; fz = wz - c*vz[t];
+        dEdge = std::min(dEdge, fx*fx + fy*fy + fz*fz);
+
+        // edge from the second to the third vertex
+        double ex = vx[t] - ux[t], ey = vy[t] - uy[t], ez = vz[t] - uz[t];
+        double gx = wx - ux[t], gy = wy - uy[t], gz = wz - uz[t];
+        double ee = ex*ex + ey*ey + ez*ez;
+        c = std::min(std::max((gx*ex + gy*ey + gz*ez) / std::max(ee, tiny), 0.0), 1.0);
+        fx = gx - c*ex; fy = gy - c*ey; fz = gz - c*ez;
+        dEdge = std::min(dEdge, fx*fx + fy*fy + fz*fz);
+
+        d2[k] = inside ? dPlane : dEdge;
+    }
+}
+
+/*!
+ * INTERNAL use. Morton code of a point, quantized on 21 bits per direction
+ * inside a bounding box.
+ * \param[in] point point coordinates
+ * \param[in] bmin minimum corner of the bounding box
+ * \param[in] scale quantization scale factors of the directions
+ * \return Morton code
+ */
+static uint64_t
+mortonCode(const std::array<double,3> & point, const std::array<double,3> & bmin, const std::array<double,3> & scale)
+{
+    uint64_t code = 0;
+    for (int i = 0; i < 3; ++i){
+        uint64_t x = uint64_t(std::min(std::max((point[i] - bmin[i]) * scale[i], 0.0), 2097151.0));
+        x = (x | x << 32) & 0x1f00000000ffffULL;
+        x = (x | x << 16) & 0x1f0000ff0000ffULL;
+        x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+        x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+        x = (x | x << 2)  & 0x1249249249249249ULL;
+        code |= x << i;
+    }
+    return code;
+}
+
+/*!
+ * INTERNAL use. Batched search of the closest cells of a set of points in a surface skd-tree.
+ * Points are sorted along a Morton curve and grouped in packets of close points; each packet
+ * descends the tree once (nearest child first), pruning the nodes farther than the current
+ * distance estimate of all its points. Leaf cells are packed on first visit and triangles
+ * are processed by a vectorized kernel. Results are the ones of SurfaceSkdTree::findPointClosestCell.
+ * If OpenMP is enabled, packets are distributed among the threads.
+ * \param[in] nP number of points
+ * \param[in] points points coordinates
+ * \param[in] tree surface skd-tree
+ * \param[out] ids closest cells, NULL_ID if none is found within the search radius
+ * \param[out] distances distances from the closest cells, std::numeric_limits<double>::max() if none is found
+ * \param[in] r search radius of each point
+ */
+static void
+batchedClosestCell(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, double *distances, const double *r)
+{
+    if (nP < 1) return;
+    const bitpit::PatchKernel & patch = tree->getPatch();
+    const long rootId = 0;
+
+    // Sort the points along a Morton curve
+    std::array<double,3> bmin = points[0], bmax = points[0], scale;
+    for (int ip = 1; ip < nP; ++ip){
+        for (int i = 0; i < 3; ++i){
+            bmin[i] = std::min(bmin[i], points[ip][i]);
+            bmax[i] = std::max(bmax[i], points[ip][i]);
+        }
+    }
+    for (int i = 0; i < 3; ++i){
+        scale[i] = (bmax[i] > bmin[i]) ? 2097151.0 / (bmax[i] - bmin[i]) : 0.0;
+    }
+    std::vector<std::pair<uint64_t,int> > order(nP);
+    for (int ip = 0; ip < nP; ++ip){
+        order[ip] = std::make_pair(mortonCode(points[ip], bmin, scale), ip);
+    }
+    std::sort(order.begin(), order.end());
+
+    const int packetSize = 8;
+    const int nPackets = (nP + packetSize - 1) / packetSize;
+
+    // Packets are shared among the threads; the tree is only read, while each
+    // thread packs the leaves it visits in its own structure.
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel
+#endif
+    {
+    PackedLeaves pack;
+    pack.leafIndex.assign(tree->getNodeCount(), -1);
+    pack.triOffsets.push_back(0);
+    pack.polyOffsets.push_back(0);
+
+    std::array<int, packetSize> pIds;
+    std::array<double, packetSize> bound, best, minDist;
+    std::array<long, packetSize> bestIds;
+    std::array<bool, packetSize> active;
+    std::vector<long> nodeStack;
+    dvector1D d2;
+    std::array<double,3> foot;
+
+#if MIMMO_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int packet = 0; packet < nPackets; ++packet){
+        int begin = packet * packetSize;
+        int np = std::min(packetSize, nP - begin);
+        for (int k = 0; k < np; ++k){
+            pIds[k] = order[begin + k].second;
+            bestIds[k] = bitpit::Cell::NULL_ID;
+            best[k] = std::numeric_limits<double>::max();
+            // the real distance will be lesser than or equal to the estimate
+            bound[k] = std::min(tree->getNode(rootId).evalPointMaxDistance(points[pIds[k]]), r[pIds[k]]);
+        }
+
+        nodeStack.push_back(rootId);
+        while (!nodeStack.empty()){
+            long nodeId = nodeStack.back();
+            nodeStack.pop_back();
+            const bitpit::SkdNode & node = tree->getNode(nodeId);
+
+            // Do not consider nodes with a minimum distance greater than
+            // the distance estimate of all the points
+            bool any = false;
+            for (int k = 0; k < np; ++k){
+                minDist[k] = node.evalPointMinDistance(points[pIds[k]]);
+                active[k] = (minDist[k] <= bound[k]);
+                any = any || active[k];
+            }
+            if (!any) continue;
+
+            for (int k = 0; k < np; ++k){
+                if (active[k]) bound[k] = std::min(bound[k], node.evalPointMaxDistance(points[pIds[k]]));
+            }
+
+            long children[2];
+            int nChildren = 0;
+            for (int i = bitpit::SkdNode::CHILD_BEGIN; i != bitpit::SkdNode::CHILD_END; ++i) {
+                long childId = node.getChildId(static_cast<bitpit::SkdNode::ChildLocation>(i));
+                if (childId != bitpit::SkdNode::NULL_ID) children[nChildren++] = childId;
+            }
+
+            if (nChildren > 0){
+                // push the nearest child last to visit it first
+                if (nChildren == 2){
+                    int k0 = 0;
+                    while (!active[k0]) ++k0;
+                    const std::array<double,3> & p0 = points[pIds[k0]];
+                    if (tree->getNode(children[0]).evalPointMinDistance(p0) < tree->getNode(children[1]).evalPointMinDistance(p0)){
+                        std::swap(children[0], children[1]);
+                    }
+                }
+                for (int i = 0; i < nChildren; ++i) nodeStack.push_back(children[i]);
+                continue;
+            }
+
+            // Leaf node: evaluate the distances of its cells
+            long leaf = packLeaf(tree, nodeId, pack);
+            long triBegin = pack.triOffsets[leaf], triEnd = pack.triOffsets[leaf+1];
+            if (long(d2.size()) < triEnd - triBegin) d2.resize(triEnd - triBegin);
+            for (int k = 0; k < np; ++k){
+                if (!active[k]) continue;
+                const std::array<double,3> & point = points[pIds[k]];
+                double limit = std::min(best[k], r[pIds[k]]);
+
+                evalTrianglesSquaredDistance(point, pack, triBegin, triEnd, d2.data());
+                for (long t = triBegin; t < triEnd; ++t){
+                    double d = d2[t - triBegin];
+                    if (d < limit*limit){
+                        d = std::sqrt(d);
+                        if (d < limit){
+                            limit = d;
+                            best[k] = d;
+                            bestIds[k] = pack.triIds[t];
+                        }
+                    }
+                }
+                for (long c = pack.polyOffsets[leaf]; c < pack.polyOffsets[leaf+1]; ++c){
+                    double d = distanceFromSurfaceCell(point, patch, pack.polyIds[c], foot);
+                    if (d < limit){
+                        limit = d;
+                        best[k] = d;
+                        bestIds[k] = pack.polyIds[c];
+                    }
+                }
+                bound[k] = std::min(bound[k], best[k]);
+            }
+        }
+
+        for (int k = 0; k < np; ++k){
+            ids[pIds[k]] = bestIds[k];
+            distances[pIds[k]] = best[k];
+        }
+    }
+    }
+}
+
 /*!
  * It computes the unsigned distance of a set of points to a geometry linked in a SkdTree
  * object. The geometry has to be a surface mesh, in particular an object of type
@@ -136,6 +432,9 @@ void distance(int nP, const std::array<double,3> *points, const bitpit::PatchSkd
  * \param[out] ids Label of the elements found as minimum distance elements in the skd-tree.
  * \param[in] r Length of the side of the box or radius of the sphere used to search for each
  * input point. (The algorithm checks every element encountered inside the box/sphere).
+ *
+ * Points are searched in packets of close points, with vectorized point-triangle distances
+ * (see batchedClosestCell): results are the ones of the single point method.
  */
 void distance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, double *distances, double *r)
 {
@@ -152,13 +451,7 @@ void distance(int nP, const std::array<double,3> *points, const bitpit::PatchSkd
         throw std::runtime_error("Invalid use of skdTreeUtils::distance method: a not surface patch tree is detected.");
     }
 
-    for (int ip = 0; ip < nP; ip++){
-        const std::array<double,3> *point = &points[ip];
-        long *id = &ids[ip];
-        double *distance = &distances[ip];
-        double rpoint = r[ip];
-        static_cast<const bitpit::SurfaceSkdTree*>(tree)->findPointClosestCell(*point, rpoint, id, distance);
-    }
+    batchedClosestCell(nP, points, tree, ids, distances, r);
 
 }
 
@@ -209,6 +502,9 @@ void signedDistance(int nP, const std::array<double,3> *points, const bitpit::Pa
  * the projection of P on the plane of the simplex.
  * \param[in] r Length of the side of the box or radius of the sphere used to search for each input
  * point. (The algorithm checks every element encountered inside the box/sphere).
+ *
+ * Points are searched in packets of close points, with vectorized point-triangle distances
+ * (see batchedClosestCell): results are the ones of the single point method.
  */
 void signedDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, double *distances, std::array<double,3> *normals, double *r)
 {
@@ -226,14 +522,13 @@ void signedDistance(int nP, const std::array<double,3> *points, const bitpit::Pa
         throw std::runtime_error("Invalid use of skdTreeUtils::signedDistance method: a not surface patch tree is detected.");
     }
 
+    batchedClosestCell(nP, points, tree, ids, distances, r);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for (int ip = 0; ip < nP; ip++){
-        const std::array<double,3> *point = &points[ip];
-        long *id = &ids[ip];
-        double *distance = &distances[ip];
-        double rpoint = r[ip];
-        static_cast<const bitpit::SurfaceSkdTree*>(tree)->findPointClosestCell(*point, rpoint, id, distance);
-        double s = computePseudoNormal(*point, spatch, *id, normals[ip]);
-        *distance *= s;
+        double s = computePseudoNormal(points[ip], spatch, ids[ip], normals[ip]);
+        distances[ip] *= s;
     }
 
 }
@@ -417,26 +712,52 @@ void projectPoint(int nP, const std::array<double,3> *points, const bitpit::Patc
 {
     if(nP == 0) return;
     // Initialize ids and ranks
+    std::vector<int> pending(nP);
     for (int ip = 0; ip < nP; ip++){
         ids[ip] = bitpit::Cell::NULL_ID;
         r[ip] = std::max(r[ip], tree->getPatch().getTol());
+        pending[ip] = ip;
     }
     std::vector<darray3E>    normals(nP);
-
     std::vector<double> dist(nP, std::numeric_limits<double>::max());
-    double max_dist = std::numeric_limits<double>::max();
-    while (max_dist == std::numeric_limits<double>::max()){
+
+    // Search again only the points without elements inside their sphere, with increased radius.
+    std::vector<darray3E> pendingPoints, pendingNormals;
+    std::vector<double> pendingRadii, pendingDist;
+    std::vector<long> pendingIds;
+    while (!pending.empty()){
+        int nPending = pending.size();
+        pendingPoints.resize(nPending);
+        pendingNormals.resize(nPending);
+        pendingRadii.resize(nPending);
+        pendingDist.resize(nPending);
+        pendingIds.resize(nPending);
+        for (int k = 0; k < nPending; k++){
+            pendingPoints[k] = points[pending[k]];
+            pendingRadii[k] = r[pending[k]];
+        }
+
         //use method sphere by default
-        signedDistance(nP, points, tree, ids, dist.data(), normals.data(), r);
-        for (int ip = 0; ip < nP; ip++){
-            if (std::abs(dist[ip]) >= max_dist){
+        signedDistance(nPending, pendingPoints.data(), tree, pendingIds.data(), pendingDist.data(), pendingNormals.data(), pendingRadii.data());
+
+        std::vector<int> notFound;
+        for (int k = 0; k < nPending; k++){
+            int ip = pending[k];
+            if (pendingIds[k] == bitpit::Cell::NULL_ID){
                 r[ip] *= 1.5;
+                notFound.push_back(ip);
+            } else {
+                ids[ip] = pendingIds[k];
+                dist[ip] = pendingDist[k];
+                normals[ip] = pendingNormals[k];
             }
         }
-        max_dist = std::abs(*std::max_element(dist.begin(), dist.end()));
-        max_dist = std::max(max_dist, std::abs(*std::min_element(dist.begin(), dist.end())));
+        pending.swap(notFound);
     }
 
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for (int ip = 0; ip < nP; ip++){
         projected_points[ip] = points[ip] - dist[ip] * normals[ip];
     }
@@ -499,6 +820,57 @@ long locatePointOnPatch(const std::array<double, 3> &point, const bitpit::PatchS
     return id;
 }
 
+/*!
+ * Given the specified points find the cells of a surface patch they are into.
+ * The method works only with trees generated with bitpit::SurfUnstructured mesh.
+ * Points are searched in packets of close points (see skdTreeUtils::distance),
+ * distributed among the threads if OpenMP is enabled.
+ *
+ * \param[in] nP number of points
+ * \param[in] points points coordinates
+ * \param[in] tree pointer to SkdTree relative to the target surface geometry.
+ * \param[out] ids ids of the geometry cells the points are into, bitpit::Cell::NULL_ID
+ * for the points not found on any cell.
+ */
+void locatePointOnPatch(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids)
+{
+    const bitpit::SurfUnstructured *spatch = dynamic_cast<const bitpit::SurfUnstructured*>(&(tree->getPatch()));
+    if(!spatch){
+        throw std::runtime_error("Invalid use of skdTreeUtils::locatePointOnPatch method: a non surface patch or void patch was detected.");
+    }
+
+    // Find the closest cells to the input points
+    std::vector<long> cellIds(nP, bitpit::Cell::NULL_ID);
+    std::vector<double> distances(nP, std::numeric_limits<double>::max());
+    std::vector<double> rs(nP, std::numeric_limits<double>::max());
+    batchedClosestCell(nP, points, tree, cellIds.data(), distances.data(), rs.data());
+
+    // Check if the points belong to their closest cells.
+    // Exceptions cannot leave the parallel region: they are thrown after it.
+    bool unsupported = false;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int ip = 0; ip < nP; ip++){
+        ids[ip] = bitpit::Cell::NULL_ID;
+        if (cellIds[ip] == bitpit::Cell::NULL_ID) continue;
+        try{
+            if (checkPointBelongsToCell(points[ip], spatch, cellIds[ip])){
+                ids[ip] = cellIds[ip];
+            }
+        }catch(std::exception & e){
+            BITPIT_UNUSED(e);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp atomic write
+#endif
+            unsupported = true;
+        }
+    }
+    if (unsupported){
+        throw std::runtime_error("Not supported cell type");
+    }
+}
+
 /*!
  * It computes the pseudo-normal of a cell of a surface mesh from an input point,
  * i.e. the unit vector with direction (P-xP), where P is the input point and
@@ -615,6 +987,43 @@ checkPointBelongsToCell(const std::array<double, 3> &point, const bitpit::SurfUn
     return checkBelong;
 }
 
+/*!
+ * Compute the distance of a point from a cell of a surface patch.
+ * \param[in] point point coordinates
+ * \param[in] surface surface patch
+ * \param[in] id id of the surface cell
+ * \param[out] foot closest point of the cell to the point
+ * \return distance of the point from the cell
+ */
+double
+distanceFromSurfaceCell(const std::array<double,3> & point, const bitpit::PatchKernel & surface, long id, std::array<double,3> & foot)
+{
+    const bitpit::Cell & cell = surface.getCell(id);
+    bitpit::ConstProxyVector<long> vertIds = cell.getVertexIds();
+    std::size_t nv = vertIds.size();
+    dvecarr3E VS(nv);
+    for (std::size_t k = 0; k < nv; ++k){
+        VS[k] = surface.getVertexCoords(vertIds[k]);
+    }
+
+    double dist;
+    foot.fill(0.0);
+    if (nv == 3){
+        darray3E lambda;
+        dist = bitpit::CGElem::distancePointTriangle(point, VS[0], VS[1], VS[2], lambda);
+        for (std::size_t k = 0; k < nv; ++k)   foot += lambda[k] * VS[k];
+    } else if (nv == 2){
+        darray2E lambda;
+        dist = bitpit::CGElem::distancePointSegment(point, VS[0], VS[1], lambda);
+        for (std::size_t k = 0; k < nv; ++k)   foot += lambda[k] * VS[k];
+    } else {
+        std::vector<double> lambda;
+        dist = bitpit::CGElem::distancePointPolygon(point, VS, lambda);
+        for (std::size_t k = 0; k < nv; ++k)   foot += lambda[k] * VS[k];
+    }
+    return dist;
+}
+
 #if MIMMO_ENABLE_MPI
 /*!
  * It computes the unsigned distance of a set of points to a distributed geometry linked in a SkdTree
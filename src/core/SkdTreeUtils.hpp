@@ -48,9 +48,11 @@ namespace skdTreeUtils{
     void projectPoint(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, std::array<double,3> *projected_points, long *ids, double r = std::numeric_limits<double>::max());
     void projectPoint(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, std::array<double,3> *projected_points, long *ids, double* r);
     long locatePointOnPatch(const std::array<double, 3> &point, const bitpit::PatchSkdTree *tree);
+    void locatePointOnPatch(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids);
 
     double computePseudoNormal(const std::array<double,3> &point, const bitpit::SurfUnstructured *surface_mesh, long id, std::array<double, 3> & pseudo_normal);
     bool checkPointBelongsToCell(const std::array<double, 3> &point, const bitpit::SurfUnstructured *surface_mesh, long id);
+    double distanceFromSurfaceCell(const std::array<double,3> & point, const bitpit::PatchKernel & surface, long id, std::array<double,3> & foot);
 
 #if MIMMO_ENABLE_MPI
     void globalDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, int *ranks, double *distances, double r, bool shared = false);
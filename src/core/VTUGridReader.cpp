@@ -23,9 +23,48 @@
 \*---------------------------------------------------------------------------*/
 
 #include "VTUGridReader.hpp"
+#include <unordered_set>
 
 namespace mimmo{
 
+/*!
+ * INTERNAL use. Convert a VTK cell type to the corresponding bitpit element type.
+ * \param[in] vtkType VTK cell type
+ * \return bitpit element type, UNDEFINED if not supported.
+ */
+static bitpit::ElementType
+decodeVTKElementType(long vtkType)
+{
+    switch (vtkType)  {
+        case 1:
+            return bitpit::ElementType::VERTEX;
+        case 3:
+            return bitpit::ElementType::LINE;
+        case 5:
+            return bitpit::ElementType::TRIANGLE;
+        case 7:
+            return bitpit::ElementType::POLYGON;
+        case 8:
+            return bitpit::ElementType::PIXEL;
+        case 9:
+            return bitpit::ElementType::QUAD;
+        case 10:
+            return bitpit::ElementType::TETRA;
+        case 11:
+            return bitpit::ElementType::VOXEL;
+        case 12:
+            return bitpit::ElementType::HEXAHEDRON;
+        case 13:
+            return bitpit::ElementType::WEDGE;
+        case 14:
+            return bitpit::ElementType::PYRAMID;
+        case 42:
+            return bitpit::ElementType::POLYHEDRON;
+        default:
+            return bitpit::ElementType::UNDEFINED;
+    }
+}
+
 /*!
  * Base Constructor
  */
@@ -51,6 +90,15 @@ void VTUAbsorbStreamer::absorbData(std::fstream &stream, const std::string &name
     bitpit::VTKBaseStreamer::absorbData(stream, name, format, entries, components, datatype);
 }
 
+/*!
+ * \return true if the streamer reads a distributed slice of the file on each process,
+ * false (default) if the whole file is read by the process(es) calling it.
+ */
+bool VTUAbsorbStreamer::isDistributed() const
+{
+    return false;
+}
+
 /*!
  * Base Constructor
  */
@@ -93,61 +141,7 @@ void VTUGridStreamer::absorbData(std::fstream &stream, const std::string &name,
         for (auto & vtype : types) {
             long dumType;
             readIntegerPod(stream, format, datatype, dumType);
-            //find ElementType
-            switch (dumType)  {
-                case 1:
-                    vtype = bitpit::ElementType::VERTEX;
-                    break;
-
-                case 3:
-                    vtype = bitpit::ElementType::LINE;
-                    break;
-
-                case 5:
-                    vtype = bitpit::ElementType::TRIANGLE;
-                    break;
-
-                case 7:
-                    vtype = bitpit::ElementType::POLYGON;
-                    break;
-
-                case 8:
-                    vtype = bitpit::ElementType::PIXEL;
-                    break;
-
-                case 9:
-                    vtype = bitpit::ElementType::QUAD;
-                    break;
-
-                case 10:
-                    vtype = bitpit::ElementType::TETRA;
-                    break;
-
-                case 11:
-                    vtype = bitpit::ElementType::VOXEL;
-                    break;
-
-                case 12:
-                    vtype = bitpit::ElementType::HEXAHEDRON;
-                    break;
-
-                case 13:
-                    vtype = bitpit::ElementType::WEDGE;
-                    break;
-
-                case 14:
-                    vtype = bitpit::ElementType::PYRAMID;
-                    break;
-
-                case 42:
-                    vtype = bitpit::ElementType::POLYHEDRON;
-                    break;
-
-                default:
-                    vtype = bitpit::ElementType::UNDEFINED;
-                    break;
-
-            }
+            vtype = decodeVTKElementType(dumType);
         }
     } else if (name == "connectivity") {
         connectivitylist.resize(sizeData);
@@ -452,6 +446,499 @@ VTUGridStreamer::readDoublePod(std::fstream & stream, bitpit::VTKFormat& format,
 }
 
 
+#if MIMMO_ENABLE_MPI
+/*!
+ * INTERNAL use. Size in bytes of a binary VTK entry.
+ * \param[in] datatype type of the entry
+ * \return size of the entry
+ */
+static std::size_t
+vtkDataTypeSize(bitpit::VTKDataType datatype)
+{
+    switch(datatype){
+        case bitpit::VTKDataType::Int8 :
+        case bitpit::VTKDataType::UInt8 :
+            return 1;
+        case bitpit::VTKDataType::Int16 :
+        case bitpit::VTKDataType::UInt16 :
+            return 2;
+        case bitpit::VTKDataType::Int32 :
+        case bitpit::VTKDataType::UInt32 :
+        case bitpit::VTKDataType::Float32 :
+            return 4;
+        case bitpit::VTKDataType::Int64 :
+        case bitpit::VTKDataType::UInt64 :
+        case bitpit::VTKDataType::Float64 :
+            return 8;
+        default:
+            throw std::runtime_error("VTUDistributedGridStreamer : VTKDataType format unavailable");
+    }
+}
+
+/*!
+ * INTERNAL use. Exchange variable size lists of longs among all the processes.
+ * \param[in] sends lists to be sent to each process
+ * \param[out] recvs lists received from each process
+ * \param[in] comm communicator
+ */
+static void
+exchangeLists(const std::vector<livector1D> & sends, std::vector<livector1D> & recvs, MPI_Comm comm)
+{
+    int nprocs = int(sends.size());
+    std::vector<int> sendCounts(nprocs), recvCounts(nprocs), sendDispls(nprocs, 0), recvDispls(nprocs, 0);
+    for (int i=0; i<nprocs; ++i){
+        sendCounts[i] = int(sends[i].size());
+    }
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+    for (int i=1; i<nprocs; ++i){
+        sendDispls[i] = sendDispls[i-1] + sendCounts[i-1];
+        recvDispls[i] = recvDispls[i-1] + recvCounts[i-1];
+    }
+    livector1D sendBuffer;
+    sendBuffer.reserve(sendDispls[nprocs-1] + sendCounts[nprocs-1]);
+    for (const livector1D & list : sends){
+        sendBuffer.insert(sendBuffer.end(), list.begin(), list.end());
+    }
+    livector1D recvBuffer(recvDispls[nprocs-1] + recvCounts[nprocs-1]);
+    MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_LONG,
+                  recvBuffer.data(), recvCounts.data(), recvDispls.data(), MPI_LONG, comm);
+
+    recvs.assign(nprocs, livector1D());
+    for (int i=0; i<nprocs; ++i){
+        recvs[i].assign(recvBuffer.begin() + recvDispls[i], recvBuffer.begin() + recvDispls[i] + recvCounts[i]);
+    }
+}
+
+/*!
+ * INTERNAL use. Vertices of a cell record, as positions in file.
+ * \param[in] type cell type
+ * \param[in] conn vertex list, or face stream for polyhedra
+ * \return vertices of the cell, with repetitions for polyhedra
+ */
+static livector1D
+recordVertices(bitpit::ElementType type, const livector1D & conn)
+{
+    if (type != bitpit::ElementType::POLYHEDRON){
+        return conn;
+    }
+    livector1D vertices;
+    std::size_t pos = 1;
+    while (pos < conn.size()){
+        std::size_t posEnd = pos + conn[pos] + 1;
+        vertices.insert(vertices.end(), conn.begin() + pos + 1, conn.begin() + posEnd);
+        pos = posEnd;
+    }
+    return vertices;
+}
+
+/*!
+ * Base Constructor
+ * \param[in] filename path of the *.vtu file to be read.
+ */
+VTUDistributedGridStreamer::VTUDistributedGridStreamer(const std::string & filename):VTUGridStreamer(){
+    m_filename = filename;
+}
+
+/*!
+ * Base Destructor
+ */
+VTUDistributedGridStreamer::~VTUDistributedGridStreamer(){}
+
+/*!
+ * \return true, the streamer reads a distributed slice of the file on each process.
+ */
+bool VTUDistributedGridStreamer::isDistributed() const
+{
+    return true;
+}
+
+/*!
+ * Absorber of VTU mesh data. Reimplemented from bitpit::VTKBaseStreamer class.
+ * Data are not read: the position and the format of the mesh data arrays are recorded
+ * for decoding. Rank info are ignored, cells are owned by the processes reading them.
+ * \param[in] stream    stream to read from
+ * \param[in] name      name of the geometry field
+ * \param[in] format    ASCII or APPENDED
+ * \param[in] entries   number of entries for data container
+ * \param[in] components number of components of current data container
+ * \param[in] datatype   data format for binary casting
+ */
+void VTUDistributedGridStreamer::absorbData(std::fstream &stream, const std::string &name, bitpit::VTKFormat format,
+                                            uint64_t entries, uint8_t components, bitpit::VTKDataType datatype)
+{
+    if (name == "cellRank" || name == "vertexRank" || name == "cellGlobalIndex")   return;
+
+    FieldInfo info;
+    info.position = stream.tellg();
+    info.format = format;
+    info.entries = entries;
+    info.components = components;
+    info.datatype = datatype;
+    m_fields[name] = info;
+}
+
+/*!
+ * Read a contiguous range of entries of an integer data array.
+ * \param[in] stream file stream
+ * \param[in] name name of the data array
+ * \param[in] first first entry to be read
+ * \param[in] count number of entries to be read
+ * \param[out] values entries read
+ */
+void VTUDistributedGridStreamer::readIntegerRange(std::fstream & stream, const std::string & name, std::size_t first, std::size_t count, livector1D & values)
+{
+    values.resize(count);
+    if (count == 0)  return;
+
+    FieldInfo info = m_fields.at(name);
+    stream.clear();
+    if (info.format == bitpit::VTKFormat::ASCII){
+        stream.seekg(info.position);
+        long dummy;
+        for (std::size_t i=0; i<first; ++i){
+            readIntegerPod(stream, info.format, info.datatype, dummy);
+        }
+    }else{
+        stream.seekg(info.position + std::streamoff(first * vtkDataTypeSize(info.datatype)));
+    }
+    for (long & value : values){
+        readIntegerPod(stream, info.format, info.datatype, value);
+    }
+}
+
+/*!
+ * Read selected entries of an integer data array.
+ * \param[in] stream file stream
+ * \param[in] name name of the data array
+ * \param[in] entries entries to be read, sorted in ascending order
+ * \param[out] values entries read
+ */
+void VTUDistributedGridStreamer::readIntegerEntries(std::fstream & stream, const std::string & name, const livector1D & entries, livector1D & values)
+{
+    values.resize(entries.size());
+    if (entries.empty())  return;
+
+    FieldInfo info = m_fields.at(name);
+    stream.clear();
+    if (info.format == bitpit::VTKFormat::ASCII){
+        //single sequential pass
+        stream.seekg(info.position);
+        long dummy, current = 0;
+        for (std::size_t i=0; i<entries.size(); ++i){
+            for (; current<entries[i]; ++current){
+                readIntegerPod(stream, info.format, info.datatype, dummy);
+            }
+            readIntegerPod(stream, info.format, info.datatype, values[i]);
+            ++current;
+        }
+    }else{
+        std::size_t size = vtkDataTypeSize(info.datatype);
+        for (std::size_t i=0; i<entries.size(); ++i){
+            stream.seekg(info.position + std::streamoff(entries[i] * size));
+            readIntegerPod(stream, info.format, info.datatype, values[i]);
+        }
+    }
+}
+
+/*!
+ * Read selected mesh nodes.
+ * \param[in] stream file stream
+ * \param[in] entries nodes to be read, sorted in ascending order
+ * \param[out] values coordinates of the nodes read
+ */
+void VTUDistributedGridStreamer::readPointEntries(std::fstream & stream, const livector1D & entries, dvecarr3E & values)
+{
+    values.resize(entries.size());
+    if (entries.empty())  return;
+
+    FieldInfo info = m_fields.at("Points");
+    stream.clear();
+    if (info.format == bitpit::VTKFormat::ASCII){
+        //single sequential pass
+        stream.seekg(info.position);
+        double dummy;
+        long current = 0;
+        for (std::size_t i=0; i<entries.size(); ++i){
+            for (; current<entries[i]; ++current){
+                for (int j=0; j<3; ++j)  readDoublePod(stream, info.format, info.datatype, dummy);
+            }
+            for (double & val : values[i])  readDoublePod(stream, info.format, info.datatype, val);
+            ++current;
+        }
+    }else{
+        std::size_t size = 3 * vtkDataTypeSize(info.datatype);
+        for (std::size_t i=0; i<entries.size(); ++i){
+            stream.seekg(info.position + std::streamoff(entries[i] * size));
+            for (double & val : values[i])  readDoublePod(stream, info.format, info.datatype, val);
+        }
+    }
+}
+
+/*!
+ * Read a contiguous slice of cells.
+ * \param[in] stream file stream
+ * \param[in] begin first cell of the slice
+ * \param[in] end past the end cell of the slice
+ * \param[in] rank rank owning the cells of the slice
+ * \param[out] cells cells read
+ */
+void VTUDistributedGridStreamer::readCellSlice(std::fstream & stream, std::size_t begin, std::size_t end, int rank, std::vector<CellRecord> & cells)
+{
+    std::size_t nCells = end - begin;
+    cells.resize(nCells);
+    if (nCells == 0)  return;
+
+    //offsets of the slice and of the previous cell, to locate the slice connectivity.
+    livector1D sliceOffsets, connectivity, vtkTypes, labels, cellPids;
+    long connBegin = 0;
+    if (begin > 0){
+        readIntegerRange(stream, "offsets", begin - 1, nCells + 1, sliceOffsets);
+        connBegin = sliceOffsets.front();
+        sliceOffsets.erase(sliceOffsets.begin());
+    }else{
+        readIntegerRange(stream, "offsets", begin, nCells, sliceOffsets);
+    }
+    readIntegerRange(stream, "connectivity", connBegin, sliceOffsets.back() - connBegin, connectivity);
+    readIntegerRange(stream, "types", begin, nCells, vtkTypes);
+    bool checkCellsID = (m_fields.count("cellIndex") > 0);
+    bool checkPID = (m_fields.count("PID") > 0);
+    if (checkCellsID)  readIntegerRange(stream, "cellIndex", begin, nCells, labels);
+    if (checkPID)      readIntegerRange(stream, "PID", begin, nCells, cellPids);
+
+    //face streams of polyhedra, if any.
+    bool checkPolyhedra = false;
+    for (long vtkType : vtkTypes){
+        checkPolyhedra = checkPolyhedra || (decodeVTKElementType(vtkType) == bitpit::ElementType::POLYHEDRON);
+    }
+    livector1D sliceFaceOffsets, sliceFaces;
+    long faceBegin = 0;
+    if (checkPolyhedra){
+        if (m_fields.count("faces") == 0 || m_fields.count("faceoffsets") == 0){
+            throw std::runtime_error("Error VTUDistributedGridStreamer : trying to acquire POLYHEDRON info without faces and faceoffsets data");
+        }
+        readIntegerRange(stream, "faceoffsets", begin, nCells, sliceFaceOffsets);
+        //face stream of the slice begins after the last polyhedron of the previous cells
+        livector1D previous;
+        for (long i = long(begin) - 1; i >= 0; --i){
+            readIntegerRange(stream, "faceoffsets", std::size_t(i), 1, previous);
+            if (previous[0] > 0){
+                faceBegin = previous[0];
+                break;
+            }
+        }
+        long faceEnd = faceBegin;
+        for (long off : sliceFaceOffsets){
+            faceEnd = std::max(faceEnd, off);
+        }
+        readIntegerRange(stream, "faces", faceBegin, faceEnd - faceBegin, sliceFaces);
+    }
+
+    long posCellBegin = connBegin, posFaceBegin = faceBegin;
+    for (std::size_t i=0; i<nCells; ++i){
+        CellRecord & cell = cells[i];
+        cell.index = long(begin + i);
+        cell.id = checkCellsID ? labels[i] : cell.index;
+        cell.pid = checkPID ? cellPids[i] : 0;
+        cell.owner = rank;
+        cell.type = decodeVTKElementType(vtkTypes[i]);
+        if (cell.type == bitpit::ElementType::UNDEFINED){
+            throw std::runtime_error("Error VTUDistributedGridStreamer : found unsupported cell elements. Impossible to absorb mesh");
+        }
+        if (cell.type == bitpit::ElementType::POLYHEDRON){
+            cell.conn.assign(sliceFaces.begin() + (posFaceBegin - faceBegin), sliceFaces.begin() + (sliceFaceOffsets[i] - faceBegin));
+        }else{
+            cell.conn.assign(connectivity.begin() + (posCellBegin - connBegin), connectivity.begin() + (sliceOffsets[i] - connBegin));
+        }
+        posCellBegin = sliceOffsets[i];
+        if (checkPolyhedra && sliceFaceOffsets[i] > 0)  posFaceBegin = sliceFaceOffsets[i];
+    }
+}
+
+/*!
+ * Read the slice of cells of the current process from the file, and fill vertices and cells
+ * of the target bitpit::PatchKernel container with them and with one layer of ghost cells.
+ * Please notice, container must be empty. Collective over the patch communicator.
+ * \param[in] patch    container for mesh
+ */
+void VTUDistributedGridStreamer::decodeRawData(bitpit::PatchKernel & patch)
+{
+    if (m_fields.count("Points") == 0 || m_fields.count("offsets") == 0 ||
+            m_fields.count("types") == 0 || m_fields.count("connectivity") == 0){
+        throw std::runtime_error("Error VTUDistributedGridStreamer : no valid connectivity info detected while reading *.vtu file.");
+    }
+
+    MPI_Comm comm = patch.getCommunicator();
+    int rank = patch.getRank();
+    int nprocs = patch.getProcessorCount();
+
+    std::fstream stream(m_filename, std::ios::in | std::ios::binary);
+    if (!stream.is_open()){
+        throw std::runtime_error("Error VTUDistributedGridStreamer : cannot open file " + m_filename);
+    }
+
+    //read the slice of cells of the current process
+    const FieldInfo & offsetsInfo = m_fields.at("offsets");
+    std::size_t nCells = std::size_t(offsetsInfo.entries / offsetsInfo.components);
+    std::size_t begin = (nCells * std::size_t(rank)) / std::size_t(nprocs);
+    std::size_t end = (nCells * std::size_t(rank + 1)) / std::size_t(nprocs);
+    std::vector<CellRecord> cells;
+    readCellSlice(stream, begin, end, rank, cells);
+
+    //vertices of the local cells; the ranks sharing each vertex are collected by
+    //the owner of the vertex, assigned by blocks of vertex positions.
+    const FieldInfo & pointsInfo = m_fields.at("Points");
+    long nPoints = long(pointsInfo.entries / pointsInfo.components);
+    livector1D localVertices;
+    for (const CellRecord & cell : cells){
+        livector1D vertices = recordVertices(cell.type, cell.conn);
+        localVertices.insert(localVertices.end(), vertices.begin(), vertices.end());
+    }
+    std::sort(localVertices.begin(), localVertices.end());
+    localVertices.erase(std::unique(localVertices.begin(), localVertices.end()), localVertices.end());
+
+    auto vertexOwner = [nPoints, nprocs](long vertex){
+        return int((vertex * long(nprocs)) / std::max(nPoints, 1L));
+    };
+
+    std::vector<livector1D> sends(nprocs), recvs;
+    for (long vertex : localVertices){
+        sends[vertexOwner(vertex)].push_back(vertex);
+    }
+    exchangeLists(sends, recvs, comm);
+
+    std::unordered_map<long, std::vector<int>> vertexRanks;
+    for (int i=0; i<nprocs; ++i){
+        for (long vertex : recvs[i]){
+            vertexRanks[vertex].push_back(i);
+        }
+    }
+    //reply, for each requested vertex, with the other ranks sharing it: count, ranks...
+    std::vector<livector1D> replies(nprocs);
+    for (int i=0; i<nprocs; ++i){
+        for (long vertex : recvs[i]){
+            const std::vector<int> & ranks = vertexRanks.at(vertex);
+            replies[i].push_back(long(ranks.size()) - 1);
+            for (int r : ranks){
+                if (r != i)  replies[i].push_back(r);
+            }
+        }
+    }
+    exchangeLists(replies, recvs, comm);
+
+    std::unordered_map<long, std::vector<int>> sharingRanks;
+    for (int i=0; i<nprocs; ++i){
+        std::size_t pos = 0;
+        for (long vertex : sends[i]){
+            long count = recvs[i][pos++];
+            if (count > 0){
+                sharingRanks[vertex].assign(recvs[i].begin() + pos, recvs[i].begin() + pos + count);
+            }
+            pos += count;
+        }
+    }
+
+    //send the local cells touching shared vertices to the sharing ranks, as
+    //index, id, pid, vtk type, size of conn, conn...
+    std::vector<livector1D> ghostSends(nprocs);
+    std::vector<int> lastSent(nprocs, -1);
+    for (std::size_t icell=0; icell<cells.size(); ++icell){
+        const CellRecord & cell = cells[icell];
+        for (long vertex : recordVertices(cell.type, cell.conn)){
+            auto it = sharingRanks.find(vertex);
+            if (it == sharingRanks.end())  continue;
+            for (int r : it->second){
+                if (lastSent[r] == int(icell))  continue;
+                lastSent[r] = int(icell);
+                livector1D & buffer = ghostSends[r];
+                buffer.push_back(cell.index);
+                buffer.push_back(cell.id);
+                buffer.push_back(cell.pid);
+                buffer.push_back(long(cell.type));
+                buffer.push_back(long(cell.conn.size()));
+                buffer.insert(buffer.end(), cell.conn.begin(), cell.conn.end());
+            }
+        }
+    }
+    exchangeLists(ghostSends, recvs, comm);
+
+    std::unordered_set<long> ghostIndices;
+    std::size_t nInterior = cells.size();
+    for (int i=0; i<nprocs; ++i){
+        std::size_t pos = 0;
+        while (pos < recvs[i].size()){
+            CellRecord cell;
+            cell.index = recvs[i][pos++];
+            cell.id = recvs[i][pos++];
+            cell.pid = recvs[i][pos++];
+            cell.type = static_cast<bitpit::ElementType>(recvs[i][pos++]);
+            long size = recvs[i][pos++];
+            cell.conn.assign(recvs[i].begin() + pos, recvs[i].begin() + pos + size);
+            pos += size;
+            cell.owner = i;
+            if (ghostIndices.insert(cell.index).second){
+                cells.push_back(std::move(cell));
+            }
+        }
+    }
+
+    //read the nodes of interior and ghost cells
+    livector1D vertices = localVertices;
+    for (std::size_t icell=nInterior; icell<cells.size(); ++icell){
+        livector1D cellVertices = recordVertices(cells[icell].type, cells[icell].conn);
+        vertices.insert(vertices.end(), cellVertices.begin(), cellVertices.end());
+    }
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+    dvecarr3E coords;
+    readPointEntries(stream, vertices, coords);
+    livector1D vertexLabels;
+    bool checkPointsID = (m_fields.count("vertexIndex") > 0);
+    if (checkPointsID)  readIntegerEntries(stream, "vertexIndex", vertices, vertexLabels);
+    stream.close();
+
+    //fill the patch
+    patch.reserveVertices(vertices.size());
+    patch.reserveCells(cells.size());
+
+    std::unordered_map<long, long> mapVert;
+    mapVert.reserve(vertices.size());
+    for (std::size_t i=0; i<vertices.size(); ++i){
+        long idV = checkPointsID ? vertexLabels[i] : vertices[i];
+        bitpit::PatchKernel::VertexIterator it = patch.addVertex(coords[i], idV);
+        mapVert[vertices[i]] = (*it).getId();
+    }
+
+    livector1D conn;
+    for (const CellRecord & cell : cells){
+        if (cell.type == bitpit::ElementType::POLYHEDRON){
+            conn = cell.conn;
+            std::size_t posfbegin = 1, posfend;
+            while (posfbegin < conn.size()){
+                posfend = posfbegin + conn[posfbegin] + 1;
+                for (std::size_t i=posfbegin+1; i<posfend; ++i){
+                    conn[i] = mapVert.at(conn[i]);
+                }
+                posfbegin = posfend;
+            }
+        }else if (cell.type == bitpit::ElementType::POLYGON){
+            conn.resize(cell.conn.size() + 1);
+            conn[0] = long(cell.conn.size());
+            for (std::size_t i=0; i<cell.conn.size(); ++i){
+                conn[i+1] = mapVert.at(cell.conn[i]);
+            }
+        }else{
+            conn.resize(cell.conn.size());
+            for (std::size_t i=0; i<cell.conn.size(); ++i){
+                conn[i] = mapVert.at(cell.conn[i]);
+            }
+        }
+        bitpit::PatchKernel::CellIterator it = patch.addCell(cell.type, conn, cell.owner, cell.id);
+        (*it).setPID(cell.pid);
+    }
+}
+#endif
+
 /*!
  * Base constructor. Linked reference bitpit::PatchKernel container must be empty. If not,
  * class will provide to destroy its previous contents and fill it with new read values.
@@ -511,8 +998,8 @@ void VTUGridReader::read(){
     m_patch.reset();
 
 #if MIMMO_ENABLE_MPI
-    //MPI version, check if master rank only reading is forced.
-    if (!m_masterRankOnly){ //all ranks do the calls
+    //MPI version, check if master rank only reading is forced (not for distributed streamers).
+    if (!m_masterRankOnly || m_streamer.isDistributed()){ //all ranks do the calls
         VTKUnstructuredGrid::read();
         m_streamer.decodeRawData(m_patch);
     }else{
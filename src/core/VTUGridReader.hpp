@@ -50,6 +50,7 @@ public:
     virtual void absorbData(std::fstream &stream, const std::string & name, bitpit::VTKFormat format, uint64_t entries, uint8_t components, bitpit::VTKDataType datatype);
     /*! Decode read raw data and fill a bitpit::PatchKernel structure with them */
     virtual void decodeRawData(bitpit::PatchKernel &) = 0;
+    virtual bool isDistributed() const;
 };
 
 /*!
@@ -90,6 +91,68 @@ public:
     void readDoublePod(std::fstream & stream, bitpit::VTKFormat& format, bitpit::VTKDataType& datatype, double&target);
 };
 
+#if MIMMO_ENABLE_MPI
+/*!
+ * \class VTUDistributedGridStreamer
+ * \brief Distributed mesh absorber for unstructured grids given by a single external file *.vtu
+   \ingroup core
+ *
+ * All the processes of the target patch read the same *.vtu file, each one a contiguous slice
+ * of its cells and the vertices they need only: no process holds the whole mesh.
+ * While the file is parsed the streamer only records where mesh data are stored; decodeRawData
+ * reads the slices and builds collectively one layer of ghost cells, i.e. the cells of other
+ * slices sharing vertices with the local ones, owned by the processes reading them.
+ * Cells and vertices are labeled with cellIndex/vertexIndex fields, if any, otherwise with
+ * their position in the file.
+ * Decoding is collective over the patch communicator.
+ */
+class VTUDistributedGridStreamer: public VTUGridStreamer{
+
+protected:
+    /*!
+     * \brief Position and format of a data array in the file.
+     */
+    struct FieldInfo{
+        std::streampos      position;   /**< position of the first entry in file */
+        bitpit::VTKFormat   format;     /**< ASCII or APPENDED */
+        uint64_t            entries;    /**< number of entries (components included) */
+        uint8_t             components; /**< number of components */
+        bitpit::VTKDataType datatype;   /**< type of the entries */
+    };
+
+    /*!
+     * \brief Cell read from file, with vertices referred to their position in file.
+     */
+    struct CellRecord{
+        long                index;      /**< position of the cell in file */
+        long                id;         /**< label of the cell */
+        long                pid;        /**< PID of the cell */
+        bitpit::ElementType type;       /**< type of the cell */
+        int                 owner;      /**< rank owning the cell */
+        livector1D          conn;       /**< vertex list, or face stream for polyhedra */
+    };
+
+    std::string                                 m_filename; /**< path of the file to be read */
+    std::unordered_map<std::string, FieldInfo>  m_fields;   /**< data arrays found in file */
+
+public:
+    VTUDistributedGridStreamer(const std::string & filename);
+    virtual ~VTUDistributedGridStreamer();
+    /*! Copy Constructor*/
+    VTUDistributedGridStreamer(const VTUDistributedGridStreamer&) = default;
+
+    virtual void absorbData(std::fstream &stream, const std::string &name, bitpit::VTKFormat format, uint64_t entries, uint8_t components, bitpit::VTKDataType datatype);
+    void decodeRawData(bitpit::PatchKernel & patch);
+    bool isDistributed() const;
+
+protected:
+    void readIntegerRange(std::fstream & stream, const std::string & name, std::size_t first, std::size_t count, livector1D & values);
+    void readIntegerEntries(std::fstream & stream, const std::string & name, const livector1D & entries, livector1D & values);
+    void readPointEntries(std::fstream & stream, const livector1D & entries, dvecarr3E & values);
+    void readCellSlice(std::fstream & stream, std::size_t begin, std::size_t end, int rank, std::vector<CellRecord> & cells);
+};
+#endif
+
 /*!
  * \class VTUGridReader
  * \brief Custom reader of unstructured grids from external files *.vtu
@@ -98,6 +161,8 @@ public:
  * Reader of unstructured grids from external files *.vtu. if successfull reading,
  * store the mesh fields in target bitpit::Patchkernel data structure.
  * Need in construction to specify a streamer of type VTUAbsorbStreamer.
+ * Streamers reading distributed slices of the file (see VTUDistributedGridStreamer) are run by
+ * all the processes, whatever the masterRankOnly option.
  */
 class VTUGridReader: protected bitpit::VTKUnstructuredGrid
 {
@@ -38,6 +38,7 @@
 #include "BasicMeshes.hpp"
 #include "BasicShapes.hpp"
 #include "Chain.hpp"
+#include "DistanceFieldUtils.hpp"
 #include "InOut.hpp"
 #include "IOConnections.hpp"
 #include "Lattice.hpp"
@@ -128,6 +128,7 @@ ClipGeometry::getClipPlane(){
  */
 void
 ClipGeometry::setClipPlane(darray4E plane){
+    setDirty();
     m_plane = plane;
     m_implicit = true;
 };
@@ -140,6 +141,7 @@ ClipGeometry::setClipPlane(darray4E plane){
  */
 void
 ClipGeometry::setClipPlane(darray3E origin, darray3E normal){
+    setDirty();
 
     normal /= norm2(normal);
     double b = -1.0*dotProduct(origin, normal);
@@ -160,6 +162,7 @@ ClipGeometry::setClipPlane(darray3E origin, darray3E normal){
  */
 void
 ClipGeometry::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
 };
 
@@ -170,6 +173,7 @@ ClipGeometry::setOrigin(darray3E origin){
  */
 void
 ClipGeometry::setNormal(darray3E normal){
+    setDirty();
     m_normal = normal;
 };
 
@@ -181,6 +185,7 @@ ClipGeometry::setNormal(darray3E normal){
  */
 void
 ClipGeometry::setInsideOut(bool flag){
+    setDirty();
     m_insideout = flag;
 };
 
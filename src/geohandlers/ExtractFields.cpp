@@ -87,6 +87,7 @@ ExtractField::buildPorts(){
  */
 void
 ExtractField::setMode(ExtractMode mode){
+    setDirty();
     setMode(static_cast<int>(mode));
 };
 
@@ -96,6 +97,7 @@ ExtractField::setMode(ExtractMode mode){
  */
 void
 ExtractField::setMode(int mode){
+    setDirty();
     if(mode < 1 ||mode > 3)    return;
     m_mode = static_cast<ExtractMode>(mode);
 };
@@ -106,6 +108,7 @@ ExtractField::setMode(int mode){
  */
 void
 ExtractField::setTolerance(double tol){
+    setDirty();
     m_tol = std::max(1.0e-12, tol);
 };
 
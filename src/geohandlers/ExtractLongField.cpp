@@ -130,6 +130,7 @@ ExtractLongField::getOriginalField(){
  */
 void
 ExtractLongField::setField(MimmoPiercedVector<long> *field){
+    setDirty();
     if(!field) return;
     m_field = *field;
 }
@@ -130,6 +130,7 @@ ExtractScalarField::getOriginalField(){
  */
 void
 ExtractScalarField::setField(dmpvector1D *field){
+    setDirty();
     if(!field) return;
     m_field = *field;
 }
@@ -130,6 +130,7 @@ ExtractStringField::getOriginalField(){
  */
 void
 ExtractStringField::setField(MimmoPiercedVector<std::string> *field){
+    setDirty();
     if(!field) return;
     m_field = *field;
 }
@@ -129,6 +129,7 @@ ExtractVectorField::getOriginalField(){
  */
 void
 ExtractVectorField::setField(dmpvecarr3E *field){
+    setDirty();
     if(!field)  return;
     m_field = *field;
 }
@@ -105,6 +105,7 @@ FVGenericSelection::buildPorts(){
  */
 void
 FVGenericSelection::setGeometry( mimmo::MimmoSharedPointer<MimmoObject> target){
+    setDirty();
     if(target == nullptr)  return;
     int type = target->getType();
     if(m_topo == 1 && type != 2) return;
@@ -118,6 +119,7 @@ FVGenericSelection::setGeometry( mimmo::MimmoSharedPointer<MimmoObject> target){
  */
 void
 FVGenericSelection::setBoundaryGeometry( mimmo::MimmoSharedPointer<MimmoObject> target){
+    setDirty();
     if(target == nullptr)  return;
     int type = target->getType();
     if(m_topo == 1 && type != 1) return;
@@ -135,6 +137,7 @@ FVGenericSelection::setBoundaryGeometry( mimmo::MimmoSharedPointer<MimmoObject>
  */
 void
 FVGenericSelection::setDual(bool flag ){
+    setDirty();
     m_dual = flag;
 }
 
@@ -144,6 +147,7 @@ FVGenericSelection::setDual(bool flag ){
  */
 void
 FVGenericSelection::setSelection(MimmoSharedPointer<GenericSelection> selectBlock){
+    setDirty();
     if(selectBlock == nullptr) return;
     m_selectEngine = selectBlock;
 }
@@ -134,6 +134,7 @@ FVSelectionByBox::buildPorts(){
  * \param[in] origin new origin point
  */
 void FVSelectionByBox::setOrigin(darray3E origin){
+    setDirty();
     static_cast<SelectionByBox *>(m_selectEngine.get())->setOrigin(origin);
 }
 
@@ -142,6 +143,7 @@ void FVSelectionByBox::setOrigin(darray3E origin){
  * \param[in] span
  */
 void FVSelectionByBox::setSpan(darray3E span){
+    setDirty();
     static_cast<SelectionByBox *>(m_selectEngine.get())->setSpan(span);
 }
 
@@ -151,6 +153,7 @@ void FVSelectionByBox::setSpan(darray3E span){
  * \param[in] axes
  */
 void FVSelectionByBox::setRefSystem(dmatrix33E axes){
+    setDirty();
     static_cast<SelectionByBox *>(m_selectEngine.get())->setRefSystem(axes);
 }
 
@@ -141,6 +141,7 @@ FVSelectionByCylinder::buildPorts(){
  * \param[in] origin new origin point
  */
 void FVSelectionByCylinder::setOrigin(darray3E origin){
+    setDirty();
     static_cast<SelectionByCylinder *>(m_selectEngine.get())->setOrigin(origin);
 }
 
@@ -150,6 +151,7 @@ void FVSelectionByCylinder::setOrigin(darray3E origin){
  * \param[in] span
  */
 void FVSelectionByCylinder::setSpan(darray3E span){
+    setDirty();
     static_cast<SelectionByCylinder *>(m_selectEngine.get())->setSpan(span);
 }
 
@@ -159,6 +161,7 @@ void FVSelectionByCylinder::setSpan(darray3E span){
  * \param[in] axes
  */
 void FVSelectionByCylinder::setRefSystem(dmatrix33E axes){
+    setDirty();
     static_cast<SelectionByCylinder *>(m_selectEngine.get())->setRefSystem(axes);
 }
 
@@ -168,6 +171,7 @@ void FVSelectionByCylinder::setRefSystem(dmatrix33E axes){
  * \param[in] val lower value origin for all three coordinates
  */
 void FVSelectionByCylinder::setInfLimits(darray3E val){
+    setDirty();
     static_cast<SelectionByCylinder *>(m_selectEngine.get())->setInfLimits(val);
 }
 /*!
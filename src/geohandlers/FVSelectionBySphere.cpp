@@ -140,6 +140,7 @@ FVSelectionBySphere::buildPorts(){
  * \param[in] origin new origin point
  */
 void FVSelectionBySphere::setOrigin(darray3E origin){
+    setDirty();
     static_cast<SelectionBySphere *>(m_selectEngine.get())->setOrigin(origin);
 }
 
@@ -149,6 +150,7 @@ void FVSelectionBySphere::setOrigin(darray3E origin){
  * \param[in] span
  */
 void FVSelectionBySphere::setSpan(darray3E span){
+    setDirty();
     static_cast<SelectionBySphere *>(m_selectEngine.get())->setSpan(span);
 }
 
@@ -158,6 +160,7 @@ void FVSelectionBySphere::setSpan(darray3E span){
  * \param[in] axes
  */
 void FVSelectionBySphere::setRefSystem(dmatrix33E axes){
+    setDirty();
     static_cast<SelectionBySphere *>(m_selectEngine.get())->setRefSystem(axes);
 }
 
@@ -167,6 +170,7 @@ void FVSelectionBySphere::setRefSystem(dmatrix33E axes){
  * \param[in] val lower value origin for all three coordinates
  */
 void FVSelectionBySphere::setInfLimits(darray3E val){
+    setDirty();
     static_cast<SelectionBySphere *>(m_selectEngine.get())->setInfLimits(val);
 }
 
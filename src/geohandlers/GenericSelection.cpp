@@ -128,6 +128,7 @@ GenericSelection::getPatch() const{
  */
 void
 GenericSelection::setGeometry( mimmo::MimmoSharedPointer<MimmoObject> target){
+    setDirty();
     if(target == nullptr)  return;
     m_geometry = target;
     /*set topology informations*/
@@ -150,6 +151,7 @@ GenericSelection::setGeometry( mimmo::MimmoSharedPointer<MimmoObject> target){
  */
 void
 GenericSelection::setDual(bool flag ){
+    setDirty();
     m_dual = flag;
 }
 
@@ -157,6 +157,7 @@ ReconstructScalar::getResultFields(){
  */
 void
 ReconstructScalar::setOverlapCriteriumENUM( OverlapMethod funct){
+    setDirty();
     setOverlapCriterium(static_cast<int>(funct));
 };
 
@@ -167,6 +168,7 @@ ReconstructScalar::setOverlapCriteriumENUM( OverlapMethod funct){
  */
 void
 ReconstructScalar::setOverlapCriterium( int funct){
+    setDirty();
     if(funct <1 ||funct > 4)    return;
     m_overlapCriterium = static_cast<OverlapMethod>(funct);
 };
@@ -178,6 +180,7 @@ ReconstructScalar::setOverlapCriterium( int funct){
  */
 void
 ReconstructScalar::addData( dmpvector1D  * field){
+    setDirty();
     if(!field)  return;
     if(field->getGeometry()== nullptr && field->getDataLocation() != m_loc) return;
     if(field->getGeometry()->getType()==3 && m_loc==MPVLocation::CELL){
@@ -194,6 +197,7 @@ ReconstructScalar::addData( dmpvector1D  * field){
  */
 void
 ReconstructScalar::removeData(mimmo::MimmoSharedPointer<MimmoObject> patch){
+    setDirty();
     //in m_subpatch remove progressively all pierced vector elements in last position
     //which links towards a geometry of type patch.
     while(m_subpatch.back().getGeometry() == patch){
@@ -222,6 +226,7 @@ ReconstructScalar::removeData(mimmo::MimmoSharedPointer<MimmoObject> patch){
  */
 void
 ReconstructScalar::removeAllData(){
+    setDirty();
     m_subpatch.clear();
     m_result.clear();
     m_subresults.clear();
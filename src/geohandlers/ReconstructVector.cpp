@@ -157,6 +157,7 @@ ReconstructVector::getResultFields(){
  */
 void
 ReconstructVector::setOverlapCriteriumENUM( OverlapMethod funct){
+    setDirty();
     setOverlapCriterium(static_cast<int>(funct));
 };
 
@@ -167,6 +168,7 @@ ReconstructVector::setOverlapCriteriumENUM( OverlapMethod funct){
  */
 void
 ReconstructVector::setOverlapCriterium( int funct){
+    setDirty();
     if(funct<1 ||funct>4)    return;
     m_overlapCriterium = static_cast<OverlapMethod>(funct);
 };
@@ -177,6 +179,7 @@ ReconstructVector::setOverlapCriterium( int funct){
  */
 void
 ReconstructVector::addData(dmpvecarr3E *field){
+    setDirty();
     if(!field) return;
     if(field->getGeometry()== nullptr && field->getDataLocation() != m_loc) return;
     if(field->getGeometry()->getType()==3 && m_loc==MPVLocation::CELL){
@@ -192,6 +195,7 @@ ReconstructVector::addData(dmpvecarr3E *field){
  */
 void
 ReconstructVector::removeData(mimmo::MimmoSharedPointer<MimmoObject> patch){
+    setDirty();
     //in m_subpatch remove progressively all pierced vector elements in last position
     //which links towards a geometry of type patch.
     while(m_subpatch.back().getGeometry() == patch){
@@ -220,6 +224,7 @@ ReconstructVector::removeData(mimmo::MimmoSharedPointer<MimmoObject> patch){
  */
 void
 ReconstructVector::removeAllData(){
+    setDirty();
     m_subpatch.clear();
     m_result.clear();
     m_subresults.clear();
@@ -124,6 +124,7 @@ RefineGeometry::getRefineType(){
  */
 void
 RefineGeometry::setRefineType(RefineType type){
+	setDirty();
 	if (type != RefineType::TERNARY && type != RefineType::REDGREEN)
 		throw std::runtime_error(m_name + " : refinement method not allowed");
 	m_type = type;
@@ -135,6 +136,7 @@ RefineGeometry::setRefineType(RefineType type){
  */
 void
 RefineGeometry::setRefineType(int type){
+	setDirty();
 	if (type != 0 && type != 1)
 		throw std::runtime_error(m_name + " : refinement method not allowed");
 
@@ -148,6 +150,7 @@ RefineGeometry::setRefineType(int type){
  */
 void
 RefineGeometry::setRefineSteps(int steps){
+	setDirty();
 	m_refinements = std::max(0, steps);
 };
 
@@ -158,6 +161,7 @@ RefineGeometry::setRefineSteps(int steps){
  */
 void
 RefineGeometry::setSmoothingSteps(int steps){
+	setDirty();
 	m_steps = std::max(0, steps);
 };
 
@@ -170,6 +174,14 @@ RefineGeometry::clear(){
 };
 
 
+/*!
+ * \return true, RefineGeometry always modifies in place its linked geometry.
+ */
+bool
+RefineGeometry::isModifyingGeometry(){
+    return true;
+}
+
 /*!Execution command.
  * It refines the target surface geometry.
  */
@@ -1013,7 +1025,7 @@ RefineGeometry::smoothing(std::set<long> * constrainedVertices)
 		{
 			// First sub-step (positive) of laplacian smoothing
 			std::unordered_map<long, std::array<double,3>> newcoordinates;
-			std::unordered_set<long> pointconnectivity;
+			bitpit::ConstProxyVector<long> pointconnectivity;
 			std::array<double,3> newcoords, oldcoords, neighcoords;
 			double weight, sumweights;
 			newcoordinates.reserve(geometry->getNVertices());
@@ -1054,35 +1066,47 @@ RefineGeometry::smoothing(std::set<long> * constrainedVertices)
 
                 // Update ghost new coordinates
 
-                // Fill with sources and targets values
-                for (auto source_tuple : geometry->getPointGhostExchangeSources()){
-                    int rank = source_tuple.first;
+                // Fill with sources values, tracking the changed ones
+                livector1D changed;
+                for (auto & source_tuple : geometry->getPointGhostExchangeSources()){
                     for (long id : source_tuple.second){
-                        newCoordinatesCommunicated.at(id) = newcoordinates.at(id);
+                        if (newCoordinatesCommunicated.at(id) != newcoordinates.at(id)){
+                            newCoordinatesCommunicated.at(id) = newcoordinates.at(id);
+                            changed.push_back(id);
+                        }
                     }
                 }
 
-                // Communicate new coordinates
-                newCoordinatesCommunicated.communicateData();
+                // Start communication of changed new coordinates, overlapped with the update of interior vertices
+                newCoordinatesCommunicated.beginCommunicateData(&changed);
+
+            } // end if geometry is parallel
+#endif
+
+			//Set new coordinates of interior vertices
+            for (const bitpit::Vertex & vert : geometry->getVertices()){
+                long id = vert.getId();
+                if (geometry->isPointInterior(id)){
+                    geometry->modifyVertex(newcoordinates[id], id);
+                }
+			}
+
+#if MIMMO_ENABLE_MPI
+            if (geometry->isParallel()){
+
+                // Complete communication of new coordinates
+                newCoordinatesCommunicated.endCommunicateData();
 
                 // Update coordinates of ghost vertices with communicated ones
-                for (auto target_tuple : geometry->getPointGhostExchangeTargets()){
-                    int rank = target_tuple.first;
+                for (auto & target_tuple : geometry->getPointGhostExchangeTargets()){
                     for (long id : target_tuple.second){
-                        newcoordinates[id] = newCoordinatesCommunicated.at(id);
+                        geometry->modifyVertex(newCoordinatesCommunicated.at(id), id);
                     } // end id
                 } // end tuple
 
             } // end if geometry is parallel
 #endif
 
-			//Set new coordinates
-//			for (long id : geometry->getVertices().getIds()){
-            for (const bitpit::Vertex & vert : geometry->getVertices()){
-                long id = vert.getId();
-				geometry->modifyVertex(newcoordinates[id], id);
-			}
-
 			//Update geometry
 			geometry->update();
 
@@ -1091,7 +1115,7 @@ RefineGeometry::smoothing(std::set<long> * constrainedVertices)
 		{
 			//Second sub-step (negative) of laplacian anti-smoothing
 			std::unordered_map<long, std::array<double,3>> newcoordinates;
-			std::unordered_set<long> pointconnectivity;
+			bitpit::ConstProxyVector<long> pointconnectivity;
 			std::array<double,3> newcoords, oldcoords, neighcoords;
 			double weight, sumweights;
 			newcoordinates.reserve(geometry->getNVertices());
@@ -1126,36 +1150,48 @@ RefineGeometry::smoothing(std::set<long> * constrainedVertices)
             if (geometry->isParallel()){
 
                 // Update ghost new coordinates
-                // The if needed insert new edges and put new reds in stack
 
-                // Fill with sources and targets values
-                for (auto source_tuple : geometry->getPointGhostExchangeSources()){
-                    int rank = source_tuple.first;
+                // Fill with sources values, tracking the changed ones
+                livector1D changed;
+                for (auto & source_tuple : geometry->getPointGhostExchangeSources()){
                     for (long id : source_tuple.second){
-                        newCoordinatesCommunicated.at(id) = newcoordinates.at(id);
+                        if (newCoordinatesCommunicated.at(id) != newcoordinates.at(id)){
+                            newCoordinatesCommunicated.at(id) = newcoordinates.at(id);
+                            changed.push_back(id);
+                        }
                     }
                 }
 
-                // Communicate new coordinates
-                newCoordinatesCommunicated.communicateData();
-
-                // Update coordinates of ghost vertices with communicated ones
-                for (auto target_tuple : geometry->getPointGhostExchangeTargets()){
-                    for (long id : target_tuple.second){
-                        newcoordinates.at(id) = newCoordinatesCommunicated.at(id);
-                    } // end id iteration
-                } // end tuple iteration
+                // Start communication of changed new coordinates, overlapped with the update of interior vertices
+                newCoordinatesCommunicated.beginCommunicateData(&changed);
 
             } // end if geometry is parallel
 #endif
 
-			//Set new coordinates
-//			for (long id : geometry->getVertices().getIds()){
+			//Set new coordinates of interior vertices
             for (const bitpit::Vertex & vert : geometry->getVertices()){
                 long id = vert.getId();
-				geometry->modifyVertex(newcoordinates[id], id);
+                if (geometry->isPointInterior(id)){
+                    geometry->modifyVertex(newcoordinates[id], id);
+                }
 			}
 
+#if MIMMO_ENABLE_MPI
+            if (geometry->isParallel()){
+
+                // Complete communication of new coordinates
+                newCoordinatesCommunicated.endCommunicateData();
+
+                // Update coordinates of ghost vertices with communicated ones
+                for (auto & target_tuple : geometry->getPointGhostExchangeTargets()){
+                    for (long id : target_tuple.second){
+                        geometry->modifyVertex(newCoordinatesCommunicated.at(id), id);
+                    } // end id
+                } // end tuple
+
+            } // end if geometry is parallel
+#endif
+
 			//Update geometry
 			geometry->update();
 
@@ -117,6 +117,8 @@ public:
     void	clear();
     void	execute();
 
+    bool    isModifyingGeometry();
+
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name="");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name="");
 
@@ -82,6 +82,7 @@ SelectField::buildPorts(){
  */
 void
 SelectField::setFieldName(std::string fieldname){
+	setDirty();
 	m_fieldname = fieldname;
 };
 
@@ -91,6 +92,7 @@ SelectField::setFieldName(std::string fieldname){
  */
 void
 SelectField::setMode(SelectType mode){
+    setDirty();
     m_mode = mode;
 };
 
@@ -100,6 +102,7 @@ SelectField::setMode(SelectType mode){
  */
 void
 SelectField::setMode(int mode){
+	setDirty();
 	setMode(static_cast<SelectType>(mode));
 };
 
@@ -109,6 +112,7 @@ SelectField::setMode(int mode){
  */
 void
 SelectField::setTolerance(double tol){
+    setDirty();
     m_tol = std::max(1.0e-12, tol);
 };
 
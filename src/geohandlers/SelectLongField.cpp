@@ -126,6 +126,7 @@ SelectLongField::getSelectedField(){
  */
 void
 SelectLongField::setFields(std::vector<MimmoPiercedVector<long>*> fields){
+	setDirty();
 	m_fields.clear();
 	m_fields.reserve(fields.size());
 	for(MimmoPiercedVector<long> * ff : fields){
@@ -143,6 +144,7 @@ SelectLongField::setFields(std::vector<MimmoPiercedVector<long>*> fields){
  */
 void
 SelectLongField::addField(MimmoPiercedVector<long> *field){
+	setDirty();
 	if(!field) return;
 	if(field->getDataLocation() == m_loc && field->getGeometry() != nullptr){
 		m_fields.push_back(*field);
@@ -126,6 +126,7 @@ SelectScalarField::getSelectedField(){
  */
 void
 SelectScalarField::setFields(std::vector<dmpvector1D*> fields){
+	setDirty();
 	m_fields.clear();
 	m_fields.reserve(fields.size());
 	for(dmpvector1D * ff : fields){
@@ -143,6 +144,7 @@ SelectScalarField::setFields(std::vector<dmpvector1D*> fields){
  */
 void
 SelectScalarField::addField(dmpvector1D *field){
+	setDirty();
 	if(!field) return;
 	if(field->getDataLocation() == m_loc && field->getGeometry() != nullptr){
 		m_fields.push_back(*field);
@@ -126,6 +126,7 @@ SelectStringField::getSelectedField(){
  */
 void
 SelectStringField::setFields(std::vector<MimmoPiercedVector<std::string>*> fields){
+	setDirty();
 	m_fields.clear();
 	m_fields.reserve(fields.size());
 	for(MimmoPiercedVector<std::string> * ff : fields){
@@ -143,6 +144,7 @@ SelectStringField::setFields(std::vector<MimmoPiercedVector<std::string>*> field
  */
 void
 SelectStringField::addField(MimmoPiercedVector<std::string> *field){
+	setDirty();
 	if(!field) return;
 	if(field->getDataLocation() == m_loc && field->getGeometry() != nullptr){
 		m_fields.push_back(*field);
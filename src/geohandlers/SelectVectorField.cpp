@@ -125,6 +125,7 @@ SelectVectorField::getSelectedField(){
  */
 void
 SelectVectorField::setFields(std::vector<dmpvecarr3E*> fields){
+    setDirty();
     m_fields.clear();
     m_fields.reserve(fields.size());
     for(dmpvecarr3E * ff : fields){
@@ -142,6 +143,7 @@ SelectVectorField::setFields(std::vector<dmpvecarr3E*> fields){
  */
 void
 SelectVectorField::addField(dmpvecarr3E *field){
+    setDirty();
     if(!field) return;
     if(field->getDataLocation() == m_loc && field->getGeometry() != nullptr){
         m_fields.push_back(*field);
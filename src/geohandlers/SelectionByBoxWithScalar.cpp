@@ -127,6 +127,7 @@ SelectionByBoxWithScalar::clear(){
  */
 void
 SelectionByBoxWithScalar::setField(dmpvector1D * field){
+    setDirty();
     if(!field) return;
     m_field = *field;
 }
@@ -95,6 +95,7 @@ SelectionByElementList::buildPorts(){
 */
 void
 SelectionByElementList::addAnnotatedCellList(MimmoPiercedVector<long> * celldata){
+    setDirty();
     if(!celldata) return;
     if(celldata->getDataLocation() != MPVLocation::CELL)   return;
     m_annotatedcells.push_back(celldata);
@@ -108,6 +109,7 @@ SelectionByElementList::addAnnotatedCellList(MimmoPiercedVector<long> * celldata
 */
 void
 SelectionByElementList::addAnnotatedVertexList(MimmoPiercedVector<long> * vertexdata){
+    setDirty();
     if(!vertexdata) return;
     if(vertexdata->getDataLocation() != MPVLocation::POINT)   return;
     m_annotatedvertices.push_back(vertexdata);
@@ -120,6 +122,7 @@ SelectionByElementList::addAnnotatedVertexList(MimmoPiercedVector<long> * vertex
 */
 void
 SelectionByElementList::addRawCellList(std::vector<long> celldata){
+    setDirty();
     if(celldata.empty())    return;
     m_rawcells.push_back(celldata);
 }
@@ -132,6 +135,7 @@ SelectionByElementList::addRawCellList(std::vector<long> celldata){
 */
 void
 SelectionByElementList::addRawVertexList(std::vector<long> vertexdata){
+    setDirty();
     if(vertexdata.empty())    return;
     m_rawvertices.push_back(vertexdata);
 }
@@ -231,6 +231,7 @@ SelectionByMapping::getTolerance(){
  */
 void
 SelectionByMapping::setTolerance(double tol){
+    setDirty();
     if(tol < 0.0){
         tol = 1.e-8;
     }
@@ -244,6 +245,7 @@ SelectionByMapping::setTolerance(double tol){
  */
 void
 SelectionByMapping::setGeometry( mimmo::MimmoSharedPointer<MimmoObject> target){
+    setDirty();
 
     if(target == nullptr){
         (*m_log)<< m_name << " attempt to link null target geometry. Do nothing." << std::endl;
@@ -278,6 +280,7 @@ SelectionByMapping::getFiles() const{
  */
 void
 SelectionByMapping::setFiles(std::unordered_map<std::string, int>  files){
+    setDirty();
     for(auto && val : files){
         addFile(val);
     }
@@ -289,6 +292,7 @@ SelectionByMapping::setFiles(std::unordered_map<std::string, int>  files){
  */
 void
 SelectionByMapping::addFile(std::pair<std::string, int> file){
+    setDirty();
     int type = m_topo;
     if(m_allowedType[type].find(file.second) != m_allowedType[type].end()){
         m_geolist.insert(file);
@@ -301,6 +305,7 @@ SelectionByMapping::addFile(std::pair<std::string, int> file){
  */
 void
 SelectionByMapping::addMappingGeometry(mimmo::MimmoSharedPointer<MimmoObject> obj){
+    setDirty();
     if(m_allowedTopology[m_topo].count(obj->getType()) > 0){
         m_mimmolist.insert(obj);
     }
@@ -312,6 +317,7 @@ SelectionByMapping::addMappingGeometry(mimmo::MimmoSharedPointer<MimmoObject> ob
  */
 void
 SelectionByMapping::removeFile(std::string file){
+     setDirty();
      if(m_geolist.find(file) != m_geolist.end())    m_geolist.erase(file);
 };
 
@@ -320,6 +326,7 @@ SelectionByMapping::removeFile(std::string file){
  */
 void
 SelectionByMapping::removeFiles(){
+    setDirty();
     m_geolist.clear();
 };
 
@@ -328,6 +335,7 @@ SelectionByMapping::removeFiles(){
  */
 void
 SelectionByMapping::removeMappingGeometries(){
+    setDirty();
     m_mimmolist.clear();
 };
 
@@ -147,6 +147,7 @@ SelectionByPID::getActivePID(bool active){
  */
 void
 SelectionByPID::setGeometry(mimmo::MimmoSharedPointer<MimmoObject> target ){
+    setDirty();
     if(target == nullptr) return;
     if(target->getType() == 3)  return; //does not work with point cloud for now.
     m_geometry = target;
@@ -167,6 +168,7 @@ SelectionByPID::setGeometry(mimmo::MimmoSharedPointer<MimmoObject> target ){
  */
 void
 SelectionByPID::setPID(long i){
+    setDirty();
     if(m_setPID.count(-1) >0 || (!m_setPID.empty() && i==-1))    m_setPID.clear();
     m_setPID.insert(i);
 
@@ -179,6 +181,7 @@ SelectionByPID::setPID(long i){
  */
 void
 SelectionByPID::setPID(livector1D list){
+    setDirty();
     for(auto && index : list){
         setPID(index);
     }
@@ -192,6 +195,7 @@ SelectionByPID::setPID(livector1D list){
 
 void
 SelectionByPID::removePID(long i){
+    setDirty();
     if(i>0){
         if(m_setPID.count(i) >0) m_setPID.erase(i);
     }else{
@@ -206,6 +210,7 @@ SelectionByPID::removePID(long i){
  */
 void
 SelectionByPID::removePID(livector1D list){
+    setDirty();
     for(auto && index : list){
         removePID(index);
     }
@@ -148,6 +148,7 @@ StitchGeometry::getGeometry(){
  */
 void
 StitchGeometry::addGeometry(mimmo::MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(geo == nullptr) return;
     if(geo->getType() != m_topo)    return;
     if(m_extgeo.count(geo)    > 0)    return;
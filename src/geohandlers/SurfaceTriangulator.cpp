@@ -119,6 +119,7 @@ bool  SurfaceTriangulator::isWorkingOnTarget(){
  * \param[in] geo pointer to target geometry
  */
 void SurfaceTriangulator::setGeometry(mimmo::MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(!geo)    return;
     BaseManipulation::setGeometry(geo);
 };
@@ -130,6 +131,7 @@ void SurfaceTriangulator::setGeometry(mimmo::MimmoSharedPointer<MimmoObject> geo
  * \param[in] flag activation flag
  */
 void        SurfaceTriangulator::setWorkOnTarget(bool flag){
+    setDirty();
     m_workOnTarget = flag;
 };
 
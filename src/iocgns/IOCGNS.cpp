@@ -125,6 +125,7 @@ void IOCGNS::swap(IOCGNS & x) noexcept
  */
 void
 IOCGNS::setDefaults(){
+    setDirty();
 
     m_name      = "mimmo.IOCGNS";
     m_mode      = IOCGNS_Mode::READ;
@@ -285,6 +286,7 @@ bool    IOCGNS::isWritingMultiZone(){
  */
 void
 IOCGNS::setDir(const std::string &dir){
+    setDirty();
     m_dir = dir;
 }
 
@@ -302,6 +304,7 @@ IOCGNS::setDir(const std::string &dir){
  */
 void
 IOCGNS::setFilename(const std::string & filename){
+    setDirty();
     m_filename = filename;
 }
 
@@ -314,6 +317,7 @@ IOCGNS::setFilename(const std::string & filename){
  */
 void
 IOCGNS::setWriteOnFileMeshInfo(bool write){
+    setDirty();
     m_writeOnFile = write;
 }
 
@@ -323,6 +327,7 @@ IOCGNS::setWriteOnFileMeshInfo(bool write){
  */
 void
 IOCGNS::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(geo == nullptr )    return;
     if(geo->getType() != 2)    return;
     switch(m_mode){
@@ -343,6 +348,7 @@ IOCGNS::setGeometry(MimmoSharedPointer<MimmoObject> geo){
  */
 void
 IOCGNS::setSurfaceBoundary(MimmoSharedPointer<MimmoObject> geosurf){
+    setDirty();
     if(geosurf == nullptr)    return;
     if(geosurf->getType() != 1)      return;
     switch(m_mode){
@@ -364,6 +370,7 @@ IOCGNS::setSurfaceBoundary(MimmoSharedPointer<MimmoObject> geosurf){
  */
 void
 IOCGNS::setBoundaryConditions(BCCGNS* bccgns){
+    setDirty();
     if(bccgns != nullptr){
         std::unique_ptr<BCCGNS> temp(new BCCGNS(*bccgns));
         m_storedBC = std::move(temp);
@@ -378,6 +385,7 @@ IOCGNS::setBoundaryConditions(BCCGNS* bccgns){
     \param[in] type of writing format
 */
 void    IOCGNS::setWritingFormat(IOCGNS::IOCGNS_WriteType type){
+    setDirty();
     m_wtype = type;
 }
 /*!
@@ -388,6 +396,7 @@ void    IOCGNS::setWritingFormat(IOCGNS::IOCGNS_WriteType type){
 */
 
 void    IOCGNS::setWritingMultiZone(bool multizone){
+    setDirty();
     //TODO uncomment
     //m_multizone = multizone;
     BITPIT_UNUSED(multizone);
@@ -400,6 +409,7 @@ void    IOCGNS::setWritingMultiZone(bool multizone){
  */
 void
 IOCGNS::setTolerance(double tol){
+    setDirty();
     m_tolerance = std::max(1.0e-15, tol);
 }
 
@@ -156,6 +156,7 @@ Create3DCurve::getVectorField(){
  */
 void
 Create3DCurve::setRawPoints(dmpvecarr3E * rawPoints){
+    setDirty();
     if(rawPoints)    m_rawpoints = *rawPoints;
 };
 
@@ -165,6 +166,7 @@ Create3DCurve::setRawPoints(dmpvecarr3E * rawPoints){
  */
 void
 Create3DCurve::setRawPoints(dvecarr3E rawPoints){
+    setDirty();
     m_rawpoints.clear();
     m_rawpoints.reserve(rawPoints.size());
     long count(0);
@@ -180,6 +182,7 @@ Create3DCurve::setRawPoints(dvecarr3E rawPoints){
  */
 void
 Create3DCurve::setRawVectorField(dmpvecarr3E *rawVectorField){
+    setDirty();
     if(rawVectorField)  m_rawvector = *rawVectorField;
 };
 
@@ -189,6 +192,7 @@ Create3DCurve::setRawVectorField(dmpvecarr3E *rawVectorField){
  */
 void
 Create3DCurve::setRawVectorField(dvecarr3E rawVectorField){
+    setDirty();
     m_rawvector.clear();
     m_rawvector.reserve(rawVectorField.size());
     long count(0);
@@ -204,6 +208,7 @@ Create3DCurve::setRawVectorField(dvecarr3E rawVectorField){
  */
 void
 Create3DCurve::setRawScalarField(dmpvector1D * rawScalarField){
+    setDirty();
     if(rawScalarField)  m_rawscalar = *rawScalarField;
 };
 
@@ -213,6 +218,7 @@ Create3DCurve::setRawScalarField(dmpvector1D * rawScalarField){
  */
 void
 Create3DCurve::setRawScalarField(dvector1D rawScalarField){
+    setDirty();
     m_rawscalar.clear();
     m_rawscalar.reserve(rawScalarField.size());
     long count(0);
@@ -252,6 +258,7 @@ Create3DCurve::isClosedLoop(){
  */
 void
 Create3DCurve::setClosedLoop(bool flag){
+    setDirty();
     m_closed = flag;
 }
 
@@ -264,6 +271,7 @@ Create3DCurve::setClosedLoop(bool flag){
  */
 void
 Create3DCurve::setNCells(int ncells){
+    setDirty();
     m_nCells = ncells;
 }
 
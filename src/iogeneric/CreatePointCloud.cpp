@@ -133,6 +133,7 @@ CreatePointCloud::getVectorField(){
  */
 void
 CreatePointCloud::setRawPoints(dmpvecarr3E * rawPoints){
+    setDirty();
     if(rawPoints)    m_rawpoints = *rawPoints;
 };
 
@@ -142,6 +143,7 @@ CreatePointCloud::setRawPoints(dmpvecarr3E * rawPoints){
  */
 void
 CreatePointCloud::setRawPoints(dvecarr3E rawPoints){
+    setDirty();
     m_rawpoints.clear();
     m_rawpoints.reserve(rawPoints.size());
     long count(0);
@@ -157,6 +159,7 @@ CreatePointCloud::setRawPoints(dvecarr3E rawPoints){
  */
 void
 CreatePointCloud::setRawVectorField(dmpvecarr3E *rawVectorField){
+    setDirty();
     if(rawVectorField)  m_rawvector = *rawVectorField;
 };
 
@@ -166,6 +169,7 @@ CreatePointCloud::setRawVectorField(dmpvecarr3E *rawVectorField){
  */
 void
 CreatePointCloud::setRawVectorField(dvecarr3E rawVectorField){
+    setDirty();
     m_rawvector.clear();
     m_rawvector.reserve(rawVectorField.size());
     long count(0);
@@ -181,6 +185,7 @@ CreatePointCloud::setRawVectorField(dvecarr3E rawVectorField){
  */
 void
 CreatePointCloud::setRawScalarField(dmpvector1D * rawScalarField){
+    setDirty();
     if(rawScalarField)  m_rawscalar = *rawScalarField;
 };
 
@@ -190,6 +195,7 @@ CreatePointCloud::setRawScalarField(dmpvector1D * rawScalarField){
  */
 void
 CreatePointCloud::setRawScalarField(dvector1D rawScalarField){
+    setDirty();
     m_rawscalar.clear();
     m_rawscalar.reserve(rawScalarField.size());
     long count(0);
@@ -166,6 +166,7 @@ GenericDispls::isTemplate(){
  */
 void
 GenericDispls::setReadDir(std::string dir){
+    setDirty();
     if(!m_read)    return;
     m_dir = dir;
 };
@@ -176,6 +177,7 @@ GenericDispls::setReadDir(std::string dir){
  */
 void
 GenericDispls::setReadFilename(std::string filename){
+    setDirty();
     if(!m_read)    return;
     m_filename = filename;
 };
@@ -186,6 +188,7 @@ GenericDispls::setReadFilename(std::string filename){
  */
 void
 GenericDispls::setWriteDir(std::string dir){
+    setDirty();
     if(m_read)    return;
     m_dir = dir;
 };
@@ -196,6 +199,7 @@ GenericDispls::setWriteDir(std::string dir){
  */
 void
 GenericDispls::setWriteFilename(std::string filename){
+    setDirty();
     if(m_read)    return;
     m_filename = filename;
 };
@@ -208,6 +212,7 @@ GenericDispls::setWriteFilename(std::string filename){
  */
 void
 GenericDispls::setNDispl(int nD){
+    setDirty();
     if(m_read) return;
     m_nDispl = nD;
 };
@@ -219,6 +224,7 @@ GenericDispls::setNDispl(int nD){
  */
 void
 GenericDispls::setLabels(livector1D labels){
+    setDirty();
     if(m_read) return;
     m_labels.clear();
     m_labels = labels;
@@ -232,6 +238,7 @@ GenericDispls::setLabels(livector1D labels){
  */
 void
 GenericDispls::setDispl(dvecarr3E displs){
+    setDirty();
     if(m_read) return;
     m_displ.clear();
     m_displ = displs;
@@ -244,6 +251,7 @@ GenericDispls::setDispl(dvecarr3E displs){
  */
 void
 GenericDispls::setTemplate(bool flag){
+    setDirty();
     if(m_read) return;
     m_template = flag;
 };
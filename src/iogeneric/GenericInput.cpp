@@ -121,6 +121,7 @@ void GenericInput::swap(GenericInput & x) noexcept
  */
 void
 GenericInput::setReadFromFile(bool readFromFile){
+    setDirty();
     m_readFromFile = readFromFile;
 };
 
@@ -129,6 +130,7 @@ GenericInput::setReadFromFile(bool readFromFile){
  */
 void
 GenericInput::setFilename(std::string filename){
+    setDirty();
     m_filename = filename;
 };
 
@@ -137,6 +139,7 @@ GenericInput::setFilename(std::string filename){
  */
 void
 GenericInput::setReadDir(std::string dir){
+    setDirty();
     m_dir = dir;
 };
 
@@ -145,6 +148,7 @@ GenericInput::setReadDir(std::string dir){
  */
 void
 GenericInput::setCSV(bool csv){
+    setDirty();
     m_csv = csv;
 };
 
@@ -350,6 +354,7 @@ void GenericInputMPVData::swap(GenericInputMPVData & x) noexcept
  */
 void
 GenericInputMPVData::setCSV(bool csv){
+    setDirty();
     m_csv = csv;
 };
 
@@ -358,6 +363,7 @@ GenericInputMPVData::setCSV(bool csv){
  */
 void
 GenericInputMPVData::setBinary(bool binary){
+    setDirty();
     m_binary = binary;
 };
 
@@ -366,6 +372,7 @@ GenericInputMPVData::setBinary(bool binary){
  */
 void
 GenericInputMPVData::setFilename(std::string filename){
+    setDirty();
     m_filename = filename;
 };
 
@@ -374,6 +381,7 @@ GenericInputMPVData::setFilename(std::string filename){
  */
 void
 GenericInputMPVData::setReadDir(std::string dir){
+    setDirty();
     m_dir = dir;
 };
 
@@ -204,6 +204,7 @@ std::fstream&  ifstreamcsv(std::fstream &in, MimmoPiercedVector< std::array< T,d
 template<typename T>
 void
 GenericInput::setInput(T* data){
+    setDirty();
     _setInput(data);
     _setResult(data);
 }
@@ -216,6 +217,7 @@ GenericInput::setInput(T* data){
 template<typename T>
 void
 GenericInput::setInput(T& data){
+    setDirty();
     _setInput(data);
     _setResult(data);
 }
@@ -237,6 +239,7 @@ GenericInput::getInput(){
 template<typename T>
 void
 GenericInput::setResult(T* data){
+    setDirty();
     m_result = std::move(std::unique_ptr<IOData>(new IODataT<T>(*data)));
 }
 
@@ -246,6 +249,7 @@ GenericInput::setResult(T* data){
 template<typename T>
 void
 GenericInput::setResult(T& data){
+    setDirty();
     m_result = std::move(std::unique_ptr<IOData>(new IODataT<T>(data)));
 }
 
@@ -123,6 +123,7 @@ GenericOutput::buildPorts(){
  */
 void
 GenericOutput::setWriteDir(std::string dir){
+    setDirty();
     m_dir = dir;
 };
 
@@ -132,6 +133,7 @@ GenericOutput::setWriteDir(std::string dir){
  */
 void
 GenericOutput::setFilename(std::string filename){
+    setDirty();
     m_filename = filename;
 };
 
@@ -141,6 +143,7 @@ GenericOutput::setFilename(std::string filename){
  */
 void
 GenericOutput::setCSV(bool csv){
+    setDirty();
     m_csv = csv;
 };
 
@@ -315,6 +318,7 @@ GenericOutputMPVData::buildPorts(){
  */
 void
 GenericOutputMPVData::setWriteDir(std::string dir){
+    setDirty();
     m_dir = dir;
 };
 
@@ -324,6 +328,7 @@ GenericOutputMPVData::setWriteDir(std::string dir){
  */
 void
 GenericOutputMPVData::setFilename(std::string filename){
+    setDirty();
     m_filename = filename;
 };
 
@@ -333,6 +338,7 @@ GenericOutputMPVData::setFilename(std::string filename){
  */
 void
 GenericOutputMPVData::setCSV(bool csv){
+    setDirty();
     m_csv = csv;
 };
 
@@ -341,6 +347,7 @@ GenericOutputMPVData::setCSV(bool csv){
  */
 void
 GenericOutputMPVData::setBinary(bool binary){
+    setDirty();
     m_binary = binary;
 };
 
@@ -168,6 +168,7 @@ namespace outputCSVStream {
 template<typename T>
 void
 GenericOutput::setInput(T* data){
+    setDirty();
     _setInput(*data);
     std::fstream file;
 #if MIMMO_ENABLE_MPI
@@ -195,6 +196,7 @@ GenericOutput::setInput(T* data){
 template<typename T>
 void
 GenericOutput::setInput(T data){
+    setDirty();
     setInput(&data);
 }
 
@@ -225,6 +227,7 @@ GenericOutput::_setInput(T & data){
 template<typename T>
 void
 GenericOutputMPVData::setInput(MimmoPiercedVector< T > * data){
+    setDirty();
     _setInput(*data);
     if(m_csv)   m_binary = false;
     std::string name = data->getName();
@@ -337,6 +340,7 @@ GenericOutputMPVData::collectDataFromAllProcs(MimmoPiercedVector<T> & locdata, M
 template<typename T>
 void
 GenericOutputMPVData::setInput(MimmoPiercedVector< T > data){
+    setDirty();
     setInput(&data);
 }
 
@@ -157,6 +157,7 @@ IOCloudPoints::isTemplate(){
  */
 void
 IOCloudPoints::setReadDir(std::string dir){
+    setDirty();
     if(!m_read)    return;
     m_dir = dir;
 };
@@ -167,6 +168,7 @@ IOCloudPoints::setReadDir(std::string dir){
  */
 void
 IOCloudPoints::setReadFilename(std::string filename){
+    setDirty();
     if(!m_read)    return;
     m_filename = filename;
 };
@@ -177,6 +179,7 @@ IOCloudPoints::setReadFilename(std::string filename){
  */
 void
 IOCloudPoints::setWriteDir(std::string dir){
+    setDirty();
     if(m_read)    return;
     m_dir = dir;
 };
@@ -187,6 +190,7 @@ IOCloudPoints::setWriteDir(std::string dir){
  */
 void
 IOCloudPoints::setGeometry(MimmoSharedPointer<MimmoObject> geometry){
+    setDirty();
     // Check if geometry is a point cloud
     if (geometry->getType() != 3) return;
     m_geometry = geometry;
@@ -198,6 +202,7 @@ IOCloudPoints::setGeometry(MimmoSharedPointer<MimmoObject> geometry){
  */
 void
 IOCloudPoints::setWriteFilename(std::string filename){
+    setDirty();
     if(m_read)    return;
     m_filename = filename;
 };
@@ -209,6 +214,7 @@ IOCloudPoints::setWriteFilename(std::string filename){
  */
 void
 IOCloudPoints::setScalarField(dmpvector1D* scalarfield){
+    setDirty();
     if(m_read) return;
     m_scalarfield = *scalarfield;
 };
@@ -220,6 +226,7 @@ IOCloudPoints::setScalarField(dmpvector1D* scalarfield){
  */
 void
 IOCloudPoints::setVectorField(dmpvecarr3E* vectorfield){
+    setDirty();
     if(m_read) return;
     m_vectorfield = *vectorfield;
 };
@@ -231,6 +238,7 @@ IOCloudPoints::setVectorField(dmpvecarr3E* vectorfield){
  */
 void
 IOCloudPoints::setTemplate(bool flag){
+    setDirty();
     if(m_read) return;
     m_template = flag;
 };
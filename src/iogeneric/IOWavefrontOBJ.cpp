@@ -22,9 +22,16 @@
  *
 \*---------------------------------------------------------------------------*/
 #include "IOWavefrontOBJ.hpp"
+#include "ParallelIOUtils.hpp"
 #include "bitpit_common.hpp"
 #include "customOperators.hpp"
 #include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <exception>
+#if MIMMO_ENABLE_OPENMP
+#include <omp.h>
+#endif
 
 namespace mimmo{
 
@@ -452,6 +459,7 @@ ManipulateWFOBJData::getPinnedObjectGroup(){
     The class perform recomputation only if a valid cellList is linked, otherwise it does nothing.
 */
 void    ManipulateWFOBJData::setRecomputeNormalsCells(MimmoPiercedVector<long>* cellList){
+    setDirty();
     m_normalsCells.clear();
     if(!cellList)  return;
     m_normalsCells = *cellList;
@@ -463,6 +471,7 @@ void    ManipulateWFOBJData::setRecomputeNormalsCells(MimmoPiercedVector<long>*
     \param[in] data attached to the Wavefront mesh
 */
 void  ManipulateWFOBJData::setData(WavefrontOBJData * data){
+    setDirty();
     if(!data)   return;
     if(!data->refGeometry){
         *(m_log)<<"Error in "<<m_name<<" : cannot connect WavefrontOBJData with nullptr refGeometry member"<<std::endl;
@@ -479,6 +488,7 @@ void  ManipulateWFOBJData::setData(WavefrontOBJData * data){
     BEWARE: Annotation name/string mark must be specified as name of the MimmoPiercedVector structure.
 */
 void    ManipulateWFOBJData::addAnnotation(MimmoPiercedVector<long>* data){
+    setDirty();
     if(!data)  return;
     if (data->getName().empty())    return;
     m_annotations.push_back(*data);
@@ -491,6 +501,7 @@ void    ManipulateWFOBJData::addAnnotation(MimmoPiercedVector<long>* data){
 */
 
 void    ManipulateWFOBJData::setCheckNormalsMagnitude(bool flag){
+    setDirty();
     m_checkNormalsMag = flag;
 };
 
@@ -503,6 +514,7 @@ void    ManipulateWFOBJData::setCheckNormalsMagnitude(bool flag){
 */
 
 void    ManipulateWFOBJData::setMultipleAnnotationStrategy(ManipulateWFOBJData::OverlapAnnotationMode mode){
+    setDirty();
     m_annMode = mode;
 };
 
@@ -514,6 +526,7 @@ void    ManipulateWFOBJData::setMultipleAnnotationStrategy(ManipulateWFOBJData::
 */
 
 void    ManipulateWFOBJData::setNormalsComputeStrategy(ManipulateWFOBJData::NormalsComputeMode mode){
+    setDirty();
     m_normalsMode = mode;
 };
 /*!
@@ -523,6 +536,7 @@ void    ManipulateWFOBJData::setNormalsComputeStrategy(ManipulateWFOBJData::Norm
 */
 void
 ManipulateWFOBJData::setPinMaterials(const std::vector<std::string> & materialsList){
+    setDirty();
     m_pinMaterials.clear();
     std::string temp;
     for(const std::string & val : materialsList){
@@ -540,6 +554,7 @@ ManipulateWFOBJData::setPinMaterials(const std::vector<std::string> & materialsL
 */
 void
 ManipulateWFOBJData::setPinCellGroups(const std::vector<std::string> & cellgroupsList){
+    setDirty();
     m_pinCellGroups.clear();
     std::string temp;
     for(const std::string & val : cellgroupsList){
@@ -556,6 +571,7 @@ ManipulateWFOBJData::setPinCellGroups(const std::vector<std::string> & cellgroup
 */
 void
 ManipulateWFOBJData::setPinSmoothIds(const std::vector<int> & smoothidsList){
+    setDirty();
     m_pinSmoothIds.clear();
     m_pinSmoothIds.insert(smoothidsList.begin(), smoothidsList.end());
 }
@@ -567,6 +583,7 @@ ManipulateWFOBJData::setPinSmoothIds(const std::vector<int> & smoothidsList){
 */
 void
 ManipulateWFOBJData::setPinObjects(const std::vector<std::string> & objectsList){
+    setDirty();
     m_pinObjects.clear();
     std::string temp;
     for(const std::string & val : objectsList){
@@ -757,6 +774,13 @@ void    ManipulateWFOBJData::flushSectionXML(bitpit::Config::Section & slotXML,
     slotXML.set("PinObjects", towrite);
 }
 
+/*!
+    \return true, the class always modifies in place the linked geometry and its data.
+*/
+bool   ManipulateWFOBJData::isModifyingGeometry(){
+    return true;
+}
+
 /*!
     Class workflow execution
 */
@@ -1168,6 +1192,7 @@ IOWavefrontOBJ::IOWavefrontOBJ(IOWavefrontOBJ::IOMode mode){
     m_cleanDoubleVertices = false;
     m_ignoringCellGroups = false;
     m_textureUVMode = false;
+    m_readChunks = 0;
     m_extData = nullptr;
 }
 
@@ -1185,6 +1210,7 @@ IOWavefrontOBJ::IOWavefrontOBJ(const bitpit::Config::Section & rootXML){
     m_cleanDoubleVertices = false;
     m_ignoringCellGroups = false;
     m_textureUVMode = false;
+    m_readChunks = 0;
     m_extData = nullptr;
 
     std::string fallback_name = "ClassNONE";
@@ -1225,6 +1251,7 @@ void IOWavefrontOBJ::swap(IOWavefrontOBJ & x) noexcept{
     std::swap(m_cleanDoubleVertices, x.m_cleanDoubleVertices);
     std::swap(m_ignoringCellGroups, x.m_ignoringCellGroups);
     std::swap(m_textureUVMode, x.m_textureUVMode);
+    std::swap(m_readChunks, x.m_readChunks);
 
     std::swap(m_intData, x.m_intData);
     std::swap(m_extData, x.m_extData);
@@ -1381,6 +1408,7 @@ IOWavefrontOBJ::getNormals()
     \param[in] geo MimmoObject surface mesh of type 1
 */
 void    IOWavefrontOBJ::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(!geo) return;
     if(geo->getType() != 1) return;
     m_geometry = geo;
@@ -1401,6 +1429,7 @@ void    IOWavefrontOBJ::setGeometry(MimmoSharedPointer<MimmoObject> geo){
     \param[in] data.
 */
 void    IOWavefrontOBJ::setData(WavefrontOBJData* data){
+    setDirty();
     if(!data || whichModeInt()<2) return;
     m_extData = data;
     m_intData = nullptr;
@@ -1413,6 +1442,7 @@ void    IOWavefrontOBJ::setData(WavefrontOBJData* data){
 //     \param[in] materialfile Name of the material file related to obj file
 //  */
 // void    IOWavefrontOBJ::setMaterialFile(std::string materialfile){
+    setDirty();
 //     if(whichModeInt()<2) return;
 //     // I can test extData pointer during port communications in an execution chain
 //     // because in the ports this method has a lower priority than setData (i.e. this port is executed after)
@@ -1433,6 +1463,7 @@ void    IOWavefrontOBJ::setData(WavefrontOBJData* data){
     \param[in] dir path to reference directory for I/O purposes
 */
 void    IOWavefrontOBJ::setDir(const std::string & pathdir){
+    setDirty();
     m_dir= pathdir;
 }
 
@@ -1442,6 +1473,7 @@ void    IOWavefrontOBJ::setDir(const std::string & pathdir){
     \param[in] name of the file
 */
 void    IOWavefrontOBJ::setFilename(const std::string & name){
+    setDirty();
     m_filename= name;
 }
 
@@ -1450,6 +1482,7 @@ void    IOWavefrontOBJ::setFilename(const std::string & name){
     \param[in] tolerance
 */
 void    IOWavefrontOBJ::setGeometryTolerance(double tolerance){
+    setDirty();
     m_tol= std::max(std::numeric_limits<double>::min(), tolerance);
 }
 
@@ -1461,6 +1494,7 @@ void    IOWavefrontOBJ::setGeometryTolerance(double tolerance){
     \param[in] clean true/false
 */
 void    IOWavefrontOBJ::setCleanDoubleMeshVertices(bool clean){
+    setDirty();
     m_cleanDoubleVertices= clean;
 }
 
@@ -1469,6 +1503,7 @@ void    IOWavefrontOBJ::setCleanDoubleMeshVertices(bool clean){
     \param[in] ignore true/false
 */
 void    IOWavefrontOBJ::setIgnoreCellGroups(bool ignore){
+    setDirty();
     m_ignoringCellGroups= ignore;
 }
 /*!
@@ -1477,9 +1512,21 @@ void    IOWavefrontOBJ::setIgnoreCellGroups(bool ignore){
     \param[in] UVmode true/false to activate/deactivate texture UV mode.
 */
 void    IOWavefrontOBJ::setTextureUVMode(bool UVmode){
+    setDirty();
     m_textureUVMode= UVmode;
 }
 
+/*!
+    For READ mode only, set the number of chunks of lines the file is split in to be parsed
+    concurrently. By default (0) it is evaluated on the file size and the number of threads;
+    the mesh read does not depend on it.
+    \param[in] nchunks number of chunks, 0 for automatic
+*/
+void    IOWavefrontOBJ::setReadChunkCount(int nchunks){
+    setDirty();
+    m_readChunks = std::max(0, nchunks);
+}
+
 /*!
     If set to true print a resume file of the data referenced by the mesh.
     \param[in] print true/false
@@ -1569,6 +1616,17 @@ void    IOWavefrontOBJ::absorbSectionXML(const bitpit::Config::Section & slotXML
         }
         setIgnoreCellGroups(value);
     };
+
+    if(slotXML.hasOption("ReadChunkCount")){
+        input = slotXML.get("ReadChunkCount");
+        int value = 0;
+        if(!input.empty()){
+            input = bitpit::utils::string::trim(input);
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setReadChunkCount(value);
+    };
 }
 
 /*!
@@ -1589,6 +1647,7 @@ void    IOWavefrontOBJ::flushSectionXML(bitpit::Config::Section & slotXML, std::
     slotXML.set("CleanDoubleMeshVertices", std::to_string(m_cleanDoubleVertices));
     slotXML.set("IgnoreCellGroups", std::to_string(m_ignoringCellGroups));
     slotXML.set("TextureUVMode", std::to_string(m_textureUVMode));
+    slotXML.set("ReadChunkCount", std::to_string(m_readChunks));
 }
 
 
@@ -1674,20 +1733,59 @@ void IOWavefrontOBJ::read(const std::string & filename){
 #endif
     {
         if(in.is_open()){
+            in.close();
 
-            //search and store the material file fullpath.
-            m_intData->materialfile = searchMaterialFile(in);
-            //search and store the stream position of the sub-objects
-            std::vector<std::streampos> objectPositions; //streampos of each new object
-            std::vector<std::string> objectNames; // name of the new object
-            std::vector<std::array<long,3>> objectVCounters; //number of v, vt, and vn in each object
-            std::array<long,3>  totVCounters; //total number of v, vt, and vn
-            long nCellTot; // number of total facet f
+            // map the file and parse its chunks of lines concurrently
+            parallelIOUtils::MappedFile file(filename);
+            const char * data = file.data();
+            std::size_t size = file.size();
+            std::size_t nsplit = (m_readChunks > 0) ? std::size_t(m_readChunks) : parallelIOUtils::evalChunkCount(size);
+            std::vector<std::size_t> offsets = parallelIOUtils::splitLines(data, size, nsplit);
+            std::size_t nchunks = offsets.size() - 1;
+
+            std::vector<WavefrontOBJChunk> chunks(nchunks);
+            std::vector<std::exception_ptr> errors(nchunks);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (long k = 0; k < long(nchunks); ++k){
+                try{
+                    readChunk(data + offsets[k], data + offsets[k+1], chunks[k]);
+                }catch(...){
+                    errors[k] = std::current_exception();
+                }
+            }
+            for (const std::exception_ptr & error : errors){
+                if (error) std::rethrow_exception(error);
+            }
 
-            // open the file and fill the information required.
-            searchObjectPosition(in, objectPositions, objectNames, objectVCounters, totVCounters, nCellTot);
+            //reserve geometry vertices and cells, report unsupported declarations.
+            std::array<long,3> totVCounters({{0,0,0}});
+            long nCellTot(0), nSkipped(0);
+            std::vector<std::string> unsupported;
+            m_intData->materialfile = "";
+            for(const WavefrontOBJChunk & chunk : chunks){
+                for(int kind=0; kind<3; ++kind){
+                    totVCounters[kind] += long(chunk.vertices[kind].size());
+                }
+                nCellTot += long(chunk.facetSizes.size());
+                nSkipped += chunk.skipped;
+                for(const std::string & key : chunk.unsupported){
+                    if(std::find(unsupported.begin(), unsupported.end(), key) == unsupported.end()){
+                        unsupported.push_back(key);
+                    }
+                }
+                if(m_intData->materialfile.empty()){
+                    m_intData->materialfile = chunk.materialfile;
+                }
+            }
+            for(const std::string & key : unsupported){
+                *(m_log)<<"WARNING "<<m_name<<" : unsupported flag "<<key<<" declaration while reading obj file. Ignoring..."<<std::endl;
+            }
+            if(nSkipped > 0){
+                *(m_log)<<"WARNING "<<m_name<<" : skipping "<<nSkipped<<" unsupported facets while reading obj file. "<<std::endl;
+            }
 
-            //reserve geometry vertices and cells
             m_geometry->getVertices().reserve(totVCounters[0]);
             m_geometry->getCells().reserve(nCellTot);
             m_intData->materials.reserve(nCellTot);
@@ -1695,27 +1793,112 @@ void IOWavefrontOBJ::read(const std::string & filename){
             m_intData->smoothids.reserve(nCellTot);
 
             // prepare textures and normals
+            MimmoSharedPointer<MimmoObject> textures = m_intData->textures;
+            MimmoSharedPointer<MimmoObject> normals = m_intData->normals;
             if(totVCounters[1]> 0){
-                m_intData->textures->getVertices().reserve(totVCounters[1]);
-                m_intData->textures->getCells().reserve(nCellTot);
+                textures->getVertices().reserve(totVCounters[1]);
+                textures->getCells().reserve(nCellTot);
             }
             if(totVCounters[2]> 0){
-                m_intData->normals->getVertices().reserve(totVCounters[2]);
-                m_intData->normals->getCells().reserve(nCellTot);
+                normals->getVertices().reserve(totVCounters[2]);
+                normals->getCells().reserve(nCellTot);
             }
+            std::array<MimmoObject*,3> targets({{m_geometry.get(), textures.get(), normals.get()}});
+
+            // absorb the chunks in file order. Cell attributes not declared in a chunk are
+            // inherited from the previous ones.
+            std::vector<std::string> objectNames;
+            std::array<long,3> vOffsets({{1,1,1}});
+            long cOffset(1);
+            long activeObject(-1), activeSmooth(0);
+            std::string activeMaterial(""), activeGroup("");
+            std::vector<long> locConn, txtConn, normalConn;
+
+            for(WavefrontOBJChunk & chunk : chunks){
+
+                std::size_t objectOffset = objectNames.size();
+                objectNames.insert(objectNames.end(), chunk.objects.begin(), chunk.objects.end());
+
+                //vertices declared before the first object of the file are ignored.
+                std::array<long,3> vBase;
+                for(int kind=0; kind<3; ++kind){
+                    long dropped = (activeObject < 0) ? chunk.preObject[kind] : 0;
+                    vBase[kind] = vOffsets[kind] - 1 - dropped;
+                    for(std::size_t i=std::size_t(dropped); i<chunk.vertices[kind].size(); ++i){
+                        targets[kind]->addVertex(chunk.vertices[kind][i], vOffsets[kind]);
+                        ++vOffsets[kind];
+                    }
+                }
+                for(const std::pair<std::size_t,int> & entry : chunk.relative){
+                    chunk.connectivity[entry.first] += vBase[entry.second];
+                }
 
-            long pidObject(0);
-            long vOffset(1), vnOffset(1), vTxtOffset(1), cOffset(1);
-            //read file object by object
-            for(std::streampos & pos : objectPositions){
+                //resolve the attributes of the facets
+                std::vector<long> stateObjects(chunk.states.size());
+                std::vector<long> stateSmooths(chunk.states.size());
+                std::vector<const std::string *> stateMaterials(chunk.states.size());
+                std::vector<const std::string *> stateGroups(chunk.states.size());
+                for(std::size_t i=0; i<chunk.states.size(); ++i){
+                    const WavefrontOBJState & state = chunk.states[i];
+                    stateObjects[i] = (state.object < 0) ? activeObject : long(objectOffset) + state.object;
+                    stateMaterials[i] = (state.material < 0) ? &activeMaterial : &chunk.labels[state.material];
+                    stateGroups[i] = (state.group < 0) ? &activeGroup : &chunk.labels[state.group];
+                    stateSmooths[i] = (state.smooth < 0) ? activeSmooth : state.smooth;
+                }
 
-                readObjectData(in, pos, pidObject,objectNames[pidObject], objectVCounters[pidObject],
-                        vOffset, vnOffset, vTxtOffset, cOffset);
-                m_geometry->setPIDName(pidObject, objectNames[pidObject]);
-                ++pidObject;
+                std::size_t pos(0);
+                for(std::size_t i=0; i<chunk.facetSizes.size(); ++i){
+                    int definition = chunk.facetTypes[i];
+                    int stride = (definition == 0) ? 1 : ((definition == 2) ? 3 : 2);
+                    long nv = chunk.facetSizes[i];
+                    long PID = stateObjects[chunk.facetStates[i]];
+                    if(PID < 0){
+                        //facet declared before the first object of the file
+                        pos += stride*nv;
+                        continue;
+                    }
+
+                    locConn.resize(nv);
+                    txtConn.resize((definition == 1 || definition == 2) ? nv : 0);
+                    normalConn.resize((definition == 2 || definition == 3) ? nv : 0);
+                    for(long j=0; j<nv; ++j){
+                        locConn[j] = chunk.connectivity[pos];
+                        if(!txtConn.empty())     txtConn[j] = chunk.connectivity[pos + 1];
+                        if(!normalConn.empty())  normalConn[j] = chunk.connectivity[pos + stride - 1];
+                        pos += stride;
+                    }
+
+                    //adding cell desuming cell type from locConn.
+                    if(pushCell(getGeometry(), locConn, PID, cOffset, -1) == bitpit::Cell::NULL_ID){
+                        *(m_log)<<"WARNING "<<m_name<<" : skipping unsupported facet while reading obj file. "<<std::endl;
+                        continue;
+                    }
+                    if(!txtConn.empty())     pushCell(textures, txtConn, PID, cOffset, -1);
+                    if(!normalConn.empty())  pushCell(normals, normalConn, PID, cOffset, -1);
+
+                    //adjusting data; the cell group named as the object is the default one.
+                    const std::string & group = *stateGroups[chunk.facetStates[i]];
+                    m_intData->materials.insert(cOffset, *stateMaterials[chunk.facetStates[i]]);
+                    m_intData->smoothids.insert(cOffset, stateSmooths[chunk.facetStates[i]]);
+                    m_intData->cellgroups.insert(cOffset, (group == objectNames[PID]) ? std::string("") : group);
+                    //increment the final coffset
+                    ++cOffset;
+                }
+
+                //update the attributes active at the end of the chunk
+                const WavefrontOBJState & last = chunk.lastState;
+                if(last.object >= 0)    activeObject = long(objectOffset) + last.object;
+                if(last.material >= 0)  activeMaterial = chunk.labels[last.material];
+                if(last.group >= 0)     activeGroup = chunk.labels[last.group];
+                if(last.smooth >= 0)    activeSmooth = last.smooth;
+
+                //release chunk memory
+                chunk = WavefrontOBJChunk();
             }
 
-            in.close();
+            for(std::size_t pid=0; pid<objectNames.size(); ++pid){
+                m_geometry->setPIDName(long(pid), objectNames[pid]);
+            }
 
         }else{
             *(m_log)<<m_name<<" : impossible to read from obj file "<<filename<<std::endl;
@@ -1935,9 +2118,6 @@ void IOWavefrontOBJ::write(const std::string & filename){
     objData->autoCompleteCellFields();
     objData->syncListsOnData();
 
-    std::array<std::vector<long>,3> vertexLists;
-    std::vector<long> cellList;
-    long cOffset(1);
     std::array<long,3> vOffsets;
     vOffsets.fill(1);
     std::array<std::unordered_map<long,long>,3> vinsertion_maps; // key long id, written id.
@@ -1945,11 +2125,6 @@ void IOWavefrontOBJ::write(const std::string & filename){
     if(objData->textures)     vinsertion_maps[1].reserve(objData->textures->getNVertices());
     if(objData->normals)     vinsertion_maps[2].reserve(objData->normals->getNVertices());
 
-    long activeMaterial = 0;
-    long activeSmoothId = 0;
-    long activeGroup;
-    std::string defaultGroup;
-
 #if MIMMO_ENABLE_MPI
     // Get only master rank 0 to write
     if(getRank() == 0)
@@ -1964,42 +2139,100 @@ void IOWavefrontOBJ::write(const std::string & filename){
             out<<"mtllib "<< materialfile<<'\n';
 
             std::map<long, livector1D> pidSubdivision = m_geometry->extractPIDSubdivision();
-            std::map<long, std::string> mapParts;
+            std::vector<std::pair<long, std::string>> parts;
             {
                 std::unordered_map<long, std::string> mapParts_temp = getSubParts();
-                mapParts.insert(mapParts_temp.begin(), mapParts_temp.end());
+                std::map<long, std::string> mapParts(mapParts_temp.begin(), mapParts_temp.end());
+                parts.assign(mapParts.begin(), mapParts.end());
             }
 
-            long refPid;
-
-            //write object by object
-            for(auto & entryPart : mapParts){
-                //write header object;
-                out<<"o "<<entryPart.second<<'\n';
+            // objects are formatted concurrently in batches of text buffers, flushed in order.
+            long nthreads = 1;
+#if MIMMO_ENABLE_OPENMP
+            nthreads = long(omp_get_max_threads());
+#endif
+            long batchSize = 4*nthreads;
+            long nparts = long(parts.size());
+
+            long activeMaterial = 0;
+            long activeSmoothId = 0;
+
+            for(long batchStart = 0; batchStart < nparts; batchStart += batchSize){
+                long batchEnd = std::min(nparts, batchStart + batchSize);
+                long nbatch = batchEnd - batchStart;
+
+                //select the vertices written for the first time by each object,
+                //in object order, and assign their written ids.
+                std::vector<std::array<std::vector<long>,3>> vertexLists(nbatch);
+                for(long k=0; k<nbatch; ++k){
+                    const livector1D & cellList = pidSubdivision[parts[batchStart + k].first];
+                    std::array<std::vector<long>,3> candidates;
+                    candidates[0] = m_geometry->getVertexFromCellList(cellList);
+                    if(objData->textures)   candidates[1] = objData->textures->getVertexFromCellList(cellList);
+                    if(objData->normals)    candidates[2] = objData->normals->getVertexFromCellList(cellList);
+                    for(int kind=0; kind<3; ++kind){
+                        vertexLists[k][kind].reserve(candidates[kind].size());
+                        for(long id : candidates[kind]){
+                            if(vinsertion_maps[kind].insert({{id, vOffsets[kind]}}).second){
+                                vertexLists[k][kind].push_back(id);
+                                ++vOffsets[kind];
+                            }
+                        }
+                    }
+                }
 
-                refPid = entryPart.first;
-                defaultGroup = entryPart.second;
+                //regroup the cells of each object by cellgroups-materials
+                std::vector<TreeGroups> trees(nbatch);
+                std::vector<std::exception_ptr> errors(nbatch);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for(long k=0; k<nbatch; ++k){
+                    try{
+                        trees[k] = regroupCells(objData, pidSubdivision.at(parts[batchStart + k].first));
+                    }catch(...){
+                        errors[k] = std::current_exception();
+                    }
+                }
+                for(const std::exception_ptr & error : errors){
+                    if (error) std::rethrow_exception(error);
+                }
 
-                //select list of vertices and cells referring to this pid.
-                cellList = pidSubdivision[refPid];
-                vertexLists[0] = m_geometry->getVertexFromCellList(cellList);
+                //material and smooth id active at each object start.
+                std::vector<std::array<long,2>> activeStates(nbatch);
+                for(long k=0; k<nbatch; ++k){
+                    activeStates[k] = {{activeMaterial, activeSmoothId}};
+                    for(auto & cgList : trees[k]){
+                        for(auto & matList : cgList.second){
+                            activeMaterial = matList.first;
+                            if(!matList.second.empty()){
+                                activeSmoothId = objData->smoothids.at(matList.second.back());
+                            }
+                        }
+                    }
+                }
 
-                if (objData->textures){
-                    vertexLists[1] = objData->textures->getVertexFromCellList(cellList);
-                }else{
-                    vertexLists[1].clear();
+                //format the objects
+                std::vector<std::string> buffers(nbatch);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for(long k=0; k<nbatch; ++k){
+                    try{
+                        buffers[k] = "o " + parts[batchStart + k].second + '\n';
+                        writeObjectData(objData, buffers[k], vertexLists[k], trees[k], vinsertion_maps,
+                                        parts[batchStart + k].second, activeStates[k][0], activeStates[k][1]);
+                    }catch(...){
+                        errors[k] = std::current_exception();
+                    }
                 }
-                if (objData->normals){
-                    vertexLists[2] = objData->normals->getVertexFromCellList(cellList);
-                }else{
-                    vertexLists[2].clear();
+                for(const std::exception_ptr & error : errors){
+                    if (error) std::rethrow_exception(error);
                 }
 
-                //force writing g defaultGroup for each new object.
-                activeGroup = -1000;
-                writeObjectData(objData, out, vertexLists, cellList, vOffsets,
-                        cOffset, vinsertion_maps, defaultGroup, activeGroup,
-                        activeMaterial, activeSmoothId);
+                for(const std::string & buffer : buffers){
+                    out.write(buffer.data(), std::streamsize(buffer.size()));
+                }
             }
 
             out.close();
@@ -2142,359 +2375,178 @@ void    IOWavefrontOBJ::writeResumeFile(){
 }
 
 /*!
-    Search for material file name marked with entry key "mtllib".
-    If none, return an empty string
-    \return materials file name
-*/
-std::string IOWavefrontOBJ::searchMaterialFile(std::ifstream & in)
-{
-    if(!in.good()){
-        in.clear();
-        in.seekg(0);
-    };
-
-    std::string line,key("mtllib"), result("");
-    bool breakloop = false;
-    while(in && !breakloop){
-        std::getline(in, line);
-        std::size_t fsplit = line.find(key);
-        if(fsplit == std::string::npos) continue;
-
-        result = line.substr(fsplit+key.length());
-        result = bitpit::utils::string::trim(result);
-        breakloop = true;
-    }
-    //restore stream to its beggining;
-    in.clear();
-    in.seekg(0);
-    return result;
-}
-
-/*!
-    While reading, scan the obj file to get the number of subparts, their stream positions
-    and names eventually. Restore the stream to file begin after searching.
-    \param[in] in reading obj file stream
-    \param[in,out] mapPos map pid/streampos to be filled
-    \param[in,out] mapNames map pid/names to be filled
-    \param[in,out] mapVCountObject map pid vs 3elements array containing number of v, vt,and vn for each sub-part.
-    \param[out] nVertTot total vertices in the obj file
-    \param[out] nCellTot total cells in the obj file
-*/
-void IOWavefrontOBJ::searchObjectPosition(std::ifstream & in,
-                          std::vector<std::streampos> & mapPos,
-                          std::vector<std::string>& mapNames,
-                          std::vector<std::array<long,3>>& mapVCountObject,
-                          std::array<long,3>& mapVCountTotal,
-                          long &nCellTot)
-{
-    mapVCountTotal.fill(0);
-    nCellTot = 0;
-    if(!in.good()){
-        in.clear();
-        in.seekg(0);
-    };
-
-    std::string line;
-    char key;
-    std::array<long,3> vCounter({{0,0,0}});
-    std::vector<std::array<long,3> > workingCounter;
-    while(in){
-        std::getline(in, line);
-        if(line.length()< 2) continue; //ignore lines with less then 2 characters into.
-
-        key = line.at(0);
-        if(key == 'o'){
-            mapPos.push_back(in.tellg());
-            std::string nameobject = line.substr(1);
-            nameobject = bitpit::utils::string::trim(nameobject);
-            mapNames.push_back(nameobject);
-            workingCounter.push_back(vCounter);
-            vCounter.fill(0);
-        }
-        else if(key == 'v' && line.at(1) == ' '){
-            ++mapVCountTotal[0];
-            ++vCounter[0];
-        }
-        else if(key == 'v' && line.at(1) == 't'){
-            ++mapVCountTotal[1];
-            ++vCounter[1];
-        }
-        else if(key == 'v' && line.at(1) == 'n'){
-            ++mapVCountTotal[2];
-            ++vCounter[2];
-        }
-        else if(key == 'f') {
-             ++nCellTot;
-        }
-    }
-    workingCounter.push_back(vCounter);
-
-    //stash the first useless entry of working counter;
-    std::size_t sizeWC = workingCounter.size();
-    if(sizeWC > 1){
-        mapVCountObject.resize(sizeWC-1);
-        memcpy(mapVCountObject.data(), &workingCounter[1], 3*(sizeWC-1)*sizeof(long));
-    }
-
-    mapPos.shrink_to_fit();
-    mapNames.shrink_to_fit();
-
-    //restore stream to its beggining;
-    in.clear();
-    in.seekg(0);
-}
-
-/*!
-    Get the stream to the begin of a Object section and start absorb its data, i.e.
+    Parse a chunk of whole lines of the obj file, i.e.
     - v: vertices coordinates
     - vt: texture coordinates (if any)
     - vn: normals referred to vertices (if any)
-    - f : facet connectivity
+    - f : facet connectivity, in any of the forms v, v/vt, v/vt/vn, v//vn
+    - o : new sub-object; materials, cell groups and smoothing groups are reset.
     - usemtl : all the cells after the keyword will be assigned to the material specified by mtllib file (if any)
     - g: all the cells after the keyword will be assigned to cell group specified by g (if any)
     - s: all the cells after the keyword will be assigned to smooth group specified by s (if any)
+    - mtllib: materials file.
+
+    Comments are skipped; vp, l, p and all other keywords are ignored and collected
+    in the chunk unsupported list.
 
-    - vp, vertex in free form statement, is ignored. A warning will be raised on logger.
-    - l, line connectivity, is ignored. A warning will be raised on logger.
-    - p, point connectivity, is ignored. A warning will be raised on logger.
-
-    all other keywords are ignored.
-
-    Data are directly stored in m_intPatch (for main mesh), m_intTexture(for texture) and
-    m_intData(for attached WavefrontOBJData datatypes)
-    \param[in] in reading stream
-    \param[in] begObjectStream position of the stream to start absorbing data
-    \param[in] PID part identifier assigned to the current object.
-    \param[in] defaultGroup track the name of the current object.
-    \param[in] vCounter 3 element array carrying the number of v, vt and vn currently present in this sub-part.
-    \param[in, out] vOffset i/o current id of the next-to-be inserted mesh vertex.
-    \param[in, out] vnOffset i/o current id of the next-to-be inserted mesh vertex normal.
-    \param[in, out] vTxtOffset i/o current id of the next-to-be inserted texture vertex.
-    \param[in, out] cOffset i/o current id of the next-to-be inserted mesh cell (same for mesh and texture)
-*/
-void IOWavefrontOBJ::readObjectData(std::ifstream & in, const std::streampos &begObjectStream, const long &PID,
-                     const std::string & defaultGroup, const std::array<long,3> & vCounter,
-                     long &vOffset, long &vnOffset, long &vTxtOffset, long &cOffset)
+    The chunk does not know the declarations of the previous chunks: relative (negative)
+    indices are stored w.r.t. the chunk start, and cell attributes not declared yet in the chunk
+    are marked as inherited (see WavefrontOBJChunk). It is safe to parse different chunks concurrently.
+    \param[in] begin start of the chunk, at the beginning of a line
+    \param[in] end end of the chunk
+    \param[out] chunk data read from the chunk
+*/
+void IOWavefrontOBJ::readChunk(const char * begin, const char * end, WavefrontOBJChunk & chunk)
 {
-    if (!in.good()){
-        in.clear();
-    }
-    in.seekg(begObjectStream);
-    std::string line;
-    char key = ' ';
-
-    std::string activeMaterial(""), activeGroup(""), stringsmooth;
-    long activeSmooth = 0;
-    //std::vector<long> locConn;
-    std::string connEntry, txtEntry, normalEntry;
-
-    MimmoSharedPointer<MimmoObject> textures = m_intData->textures;
-    MimmoSharedPointer<MimmoObject> normals = m_intData->normals;
-
-
-    // the idea is v, vt, vn are always compacted in block and not sparsed in the file.
-    // I have already calculated the number of lines for each one and stored in the input vCounter[0,1,2],
-    // so i can read the block of v lines (that are vCounter[0] lines) without controlling the typ of line each time.
-    // same scheme for vt and vn if any.
-    // connectivity info and other stuff are sparse. so i need the switch control on them.
-    std::stringstream ss;
-    std::string dummy, dummy2, cast_stod;
-    long connvalue;
-
-    int facetdefinition = -1;
-    // this variable is set once the first occurrence of facet is read in this object chunk.
-    // no need to check it every facet line. I'm sure all the facet are written the same.
-    // cases are:
-    // -1: undefined. Something wrong here.
-    //  0: v v v           (facet made by only vertices - classic connectivity)
-    //  1: v/vt v/vt v/vt   (texture prop attached. Be aware vt index has uniquely correspondence with v index)
-    //  2: v/vt/vn v/vt/vn v/vt/vn (complete form)
-    //  3: v//vn v//vn v//vn (normal prop attached. Be aware vn index has uniquely correspondence with v index)
-
-    while(in.good() && key != 'o'){
-        std::getline(in, line);
-
-        if(line.length() < 2) continue; //ignore all lines with less then 2 characters into.
-        key = line.at(0);
-
-        if(key == 'v' && line.at(1) == ' '){
-            //absorb mesh vertices for a number of lines = vCounter[0].
-            std::array<double,3> temp;
-            for(long i=0; i<vCounter[0]; ++i){
-                ss.str(line);
-                temp.fill(0.0);
-                ss>>dummy;
-                for(double & val : temp){
-                    ss>>cast_stod;
-                    val = std::stod(cast_stod);
+    chunk = WavefrontOBJChunk();
+    chunk.preObject.fill(0);
+    chunk.skipped = 0;
+    chunk.labels.push_back("");
+
+    WavefrontOBJState state = {-1, -1, -1, -1};
+    bool newState = true;
+    std::array<long,3> vCounters({{0,0,0}});
+
+    // components of the facet entries for each facet definition, and their kind (v, vt, vn)
+    static const std::array<std::vector<int>,4> entryKinds = {{ {0}, {0,1}, {0,1,2}, {0,2} }};
+
+    const char * p = begin;
+    while(p < end){
+        const char * eol = parallelIOUtils::lineEnd(p, end);
+        const char * key = parallelIOUtils::skipBlanks(p, eol);
+        const char * keyEnd = parallelIOUtils::tokenEnd(key, eol);
+        const char * q = keyEnd;
+        std::string keyword(key, keyEnd);
+        p = eol + 1;
+
+        if(keyword.empty() || keyword[0] == '#')   continue;
+
+        // rest of the line, trimmed
+        const char * rest = parallelIOUtils::skipBlanks(q, eol);
+        const char * restEnd = eol;
+        while(restEnd > rest && std::isspace(static_cast<unsigned char>(restEnd[-1])))  --restEnd;
+
+        if(keyword == "v" || keyword == "vt" || keyword == "vn"){
+            int kind = (keyword == "v") ? 0 : ((keyword == "vt") ? 1 : 2);
+            std::array<double,3> temp({{0.0,0.0,0.0}});
+            for(int i=0; i<3; ++i){
+                if(!parallelIOUtils::parseDouble(q, eol, temp[i])){
+                    //textures can have less than 3 components
+                    if(kind == 1 && i > 0 && parallelIOUtils::skipBlanks(q, eol) == eol)  break;
+                    throw std::runtime_error("IOWavefrontOBJ::read(), invalid declaration " + std::string(key, restEnd) + " in obj file");
                 }
-                getGeometry()->addVertex(temp, vOffset + i );
-                std::getline(in, line);
-                key = line.at(0);
-                ss.clear();
             }
-            vOffset += vCounter[0];
+            chunk.vertices[kind].push_back(temp);
+            ++vCounters[kind];
+            if(chunk.objects.empty())   ++chunk.preObject[kind];
         }
-
-        if(key == 'v' && line.at(1) == 't'){
-            //absorb mesh textures for a number of lines = vCounter[1].
-            std::array<double,3> temp;
-            for(long i=0; i<vCounter[1]; ++i){
-                ss.str(line);
-                temp.fill(0.0);
-                ss>>dummy;
-                std::array<double,3>::iterator it_temp = temp.begin();
-                while(ss.good() && it_temp != temp.end()){
-                    ss>>cast_stod;
-                    *it_temp = std::stod(cast_stod);
-                    ++it_temp;
+        else if(keyword == "f"){
+            int definition = -1;
+            long nv = 0;
+            std::size_t start = chunk.connectivity.size();
+            std::size_t startRelative = chunk.relative.size();
+            const char * entry = parallelIOUtils::skipBlanks(q, eol);
+            while(entry < eol){
+                const char * entryEnd = parallelIOUtils::tokenEnd(entry, eol);
+                if(definition < 0){
+                    definition = checkFacetDefinition(std::string(entry, entryEnd));
+                }
+                const char * c = entry;
+                bool valid = (definition >= 0 && definition <= 3);
+                std::size_t ncomponents = valid ? entryKinds[definition].size() : 0;
+                for(std::size_t i=0; i<ncomponents && valid; ++i){
+                    if(i > 0){
+                        // separator, double for v//vn
+                        valid = (c < entryEnd && *c == '/');
+                        ++c;
+                        if(definition == 3){
+                            valid = valid && (c < entryEnd && *c == '/');
+                            ++c;
+                        }
+                    }
+                    long value;
+                    valid = valid && parallelIOUtils::parseLong(c, entryEnd, value);
+                    if(!valid)  break;
+                    int kind = entryKinds[definition][i];
+                    if(value < 0){
+                        //relative index w.r.t. the chunk start
+                        chunk.relative.push_back(std::make_pair(chunk.connectivity.size(), kind));
+                        value += vCounters[kind] + 1;
+                    }
+                    chunk.connectivity.push_back(value);
                 }
-                textures->addVertex(temp, vTxtOffset + i );
-                std::getline(in, line);
-                key = line.at(0);
-                ss.clear();
+                if(!valid || c != entryEnd){
+                    throw std::runtime_error("IOWavefrontOBJ::read(), invalid facet " + std::string(key, restEnd) + " in obj file");
+                }
+                ++nv;
+                entry = parallelIOUtils::skipBlanks(entryEnd, eol);
             }
-            vTxtOffset += vCounter[1];
-        }
 
-        if(key == 'v' && line.at(1) == 'n'){
-            //absorb vertex normals for a number of lines = vCounter[2].
-            std::array<double,3> temp;
-            for(long i=0; i<vCounter[2]; ++i){
-                ss.str(line);
-                temp.fill(0.0);
-                ss>>dummy;
-                for(double & val: temp){
-                    ss>>cast_stod;
-                    val = std::stod(cast_stod);
-                }
-                normals->addVertex(temp, vnOffset + i );
-                std::getline(in, line);
-                key = line.at(0);
-                ss.clear();
+            if(nv < 3){
+                chunk.connectivity.resize(start);
+                chunk.relative.resize(startRelative);
+                ++chunk.skipped;
+                continue;
             }
-            vnOffset += vCounter[2];
+            if(newState){
+                chunk.states.push_back(state);
+                newState = false;
+            }
+            chunk.facetStates.push_back(long(chunk.states.size()) - 1);
+            chunk.facetTypes.push_back(definition);
+            chunk.facetSizes.push_back(nv);
         }
-
-        switch( convertKeyEntryToInt(key) ){
-            case 0: //facet cell fn
-                {
-                    // be sure to have a facet definition.
-                    if(facetdefinition < 0){
-                        ss.str(line);
-                        ss>>dummy>>dummy2;
-                        ss.clear();
-
-                        facetdefinition = checkFacetDefinition(dummy2);
-                        if(facetdefinition<0) break;
-                    }
-
-                    std::replace(line.begin(), line.end(), '/', ' ');
-                    ss.str(line);
-                    //resize the local connectivity.
-                    std::vector<long> locConn, txtConn, normalConn;
-                    //read first f and first connectivity entry.
-                    ss>>dummy>>connEntry;
-                    while (ss.good()){
-                        connvalue = std::stol(connEntry);
-                        if(connvalue < 0) connvalue += vOffset;
-                        locConn.push_back(connvalue);
-
-                        switch(facetdefinition){
-                            case 1:
-                                ss>> txtEntry;
-                                connvalue = std::stol(txtEntry);
-                                if(connvalue < 0) connvalue += vTxtOffset;
-                                txtConn.push_back(connvalue);
-                                break;
-                            case 2:
-                                ss>> txtEntry >> normalEntry;
-                                connvalue = std::stol(txtEntry);
-                                if(connvalue < 0) connvalue += vTxtOffset;
-                                txtConn.push_back(connvalue);
-
-                                connvalue = std::stol(normalEntry);
-                                if(connvalue < 0) connvalue += vnOffset;
-                                normalConn.push_back(connvalue);
-
-                                break;
-                            case 3:
-                                ss >> normalEntry;
-                                connvalue = std::stol(normalEntry);
-                                if(connvalue < 0) connvalue += vnOffset;
-                                normalConn.push_back(connvalue);
-                                break;
-                            default:
-                                //do nothing
-                                break;
-                        }//end switch
-                        //advance stream and get rubbish of eof
-                        ss>>connEntry;
-                    }//end while
-                    ss.clear();
-
-                    //adding cell desuming cell type from locConn.
-                    if(pushCell(getGeometry(), locConn, PID, cOffset, -1) == bitpit::Cell::NULL_ID){
-                        *(m_log)<<"WARNING "<<m_name<<" : skipping unsupported facet while reading obj file. "<<std::endl;
-                    }else{
-                        if(textures)    pushCell(textures, txtConn, PID, cOffset, -1);
-                        if(normals)     pushCell(normals, normalConn, PID, cOffset, -1);
-
-                        //adjusting data;
-                        m_intData->materials.insert(cOffset, activeMaterial);
-                        m_intData->smoothids.insert(cOffset, activeSmooth);
-                        m_intData->cellgroups.insert(cOffset, activeGroup);
-                        //increment the final coffset
-                        ++cOffset;
-                    }
-                }
-                break;
-            case 1: //usemtl material name
-                ss.str(line);
-                ss>>dummy>> activeMaterial;
-                activeMaterial = bitpit::utils::string::trim(activeMaterial);
-                ss.clear();
-                break;
-            case 2: //g cellgroup string labels
-
-                if(!m_ignoringCellGroups){
-                    ss.str(line);
-                    ss>>dummy>> activeGroup;
-                    activeGroup = bitpit::utils::string::trim(activeGroup);
-                    if(activeGroup == defaultGroup){
-                        activeGroup = "";
-                    }
-                    ss.clear();
-                };
-                break;
-            case 3: //s smoothgroup id
-                stringsmooth = "";
-                ss.str(line);
-                ss>>dummy >>stringsmooth;
-                stringsmooth = bitpit::utils::string::trim(stringsmooth);
-                if(stringsmooth.empty() || stringsmooth == "off"){
-                    activeSmooth = 0;
-                }else{
-                    activeSmooth = std::stol(stringsmooth);
+        else if(keyword == "o"){
+            chunk.objects.push_back(std::string(rest, restEnd));
+            state = {long(chunk.objects.size()) - 1, 0, 0, 0};
+            newState = true;
+        }
+        else if(keyword == "usemtl"){
+            chunk.labels.push_back(std::string(rest, parallelIOUtils::tokenEnd(rest, restEnd)));
+            state.material = long(chunk.labels.size()) - 1;
+            newState = true;
+        }
+        else if(keyword == "g"){
+            if(!m_ignoringCellGroups){
+                chunk.labels.push_back(std::string(rest, parallelIOUtils::tokenEnd(rest, restEnd)));
+                state.group = long(chunk.labels.size()) - 1;
+                newState = true;
+            }
+        }
+        else if(keyword == "s"){
+            std::string smooth(rest, parallelIOUtils::tokenEnd(rest, restEnd));
+            long value = 0;
+            if(!smooth.empty() && smooth != "off"){
+                const char * c = rest;
+                if(!parallelIOUtils::parseLong(c, restEnd, value)){
+                    throw std::runtime_error("IOWavefrontOBJ::read(), invalid smoothing group " + smooth + " in obj file");
                 }
-                ss.clear();
-                break;
-            case 99: // o entry
-                //DO NOTHING.
-                break;
-            case 4: //l conn line
-            case 5: //p conn point
-            default: //unsupported flag
-                *(m_log)<<"WARNING "<<m_name<<" : unsupported flag "<<key<<" declaration while reading obj file. Ignoring..."<<std::endl;
-                break;
+            }
+            state.smooth = value;
+            newState = true;
+        }
+        else if(keyword == "mtllib"){
+            if(chunk.materialfile.empty())  chunk.materialfile = std::string(rest, restEnd);
+        }
+        else if(std::find(chunk.unsupported.begin(), chunk.unsupported.end(), keyword) == chunk.unsupported.end()){
+            chunk.unsupported.push_back(keyword);
         }
+    }
 
-    } //end of stream chunk reading.
+    chunk.lastState = state;
+}
 
+/*!
+    INTERNAL use. Append a coordinate to a text buffer, with 6 decimal digits.
+*/
+static void appendCoordinate(std::string & buffer, double value){
+    char text[64];
+    int length = std::snprintf(text, sizeof(text), "%.6f", value);
+    buffer.append(text, std::size_t(std::max(0, std::min(length, int(sizeof(text)) - 1))));
 }
 
 /*!
-    Write data of an object to OBJ output stream. Write, only:
+    Format data of an object in OBJ text and append it to a buffer. Write, only:
     - v: vertices coordinates
     - vt: texture coordinates (if any)
     - vn: normals referred to vertices
@@ -2504,27 +2556,23 @@ void IOWavefrontOBJ::readObjectData(std::ifstream & in, const std::streampos &be
     - s: all the cells after the keyword will be assigned to smooth group specified by s (if any)
 
     Data are taken from m_geometry (for main mesh), m_extTexture(for texture) and
-    m_extData(for attached WavefrontOBJData datatypes)
+    m_extData(for attached WavefrontOBJData datatypes). The method only reads shared data:
+    it is safe to format different objects concurrently.
     \param[in] objData source object data structure
-    \param[in] out writing stream
-    \param[in] vertexLists list of points involved for the object for all 3 type v, vt, vn
-    \param[in] cellList list of cells involved for the object
-    \param[in,out] vOffsets offset for local v,vt,vn counting
-    \param[in,out] cOffset offset for local facet/cell counting
-    \param[in,out] vinsertion_maps local map id-written insertion index for v,vt,vn (to avoid rewrite vertices)
+    \param[in,out] buffer text buffer
+    \param[in] vertexLists list of points written for the first time by the object, for all 3 type v, vt, vn
+    \param[in] tree cells of the object, grouped by cellgroups-materials (see regroupCells)
+    \param[in] vinsertion_maps map id-written insertion index for v,vt,vn
     \param[in] defaultGroup name of the current object part (save all empty cellgroups entry in defaultGroup).
-    \param[in,out] activeGroup currently active cellgroup for the mesh
-    \param[in,out] activeMaterial currently active material for the mesh
-    \param[in,out] activeSmoothIds currently active smoothids for the mesh
+    \param[in] activeMaterial material active at the object start
+    \param[in] activeSmoothId smoothids active at the object start
 */
-void IOWavefrontOBJ::writeObjectData(WavefrontOBJData* objData, std::ofstream & out,
+void IOWavefrontOBJ::writeObjectData(WavefrontOBJData* objData, std::string & buffer,
                                      const std::array<std::vector<long>,3> & vertexLists,
-                                     const std::vector<long> & cellList,
-                                     std::array<long,3> &vOffsets,
-                                     long &cOffset,
-                                     std::array<std::unordered_map<long,long>,3> & vinsertion_maps,
+                                     const TreeGroups & tree,
+                                     const std::array<std::unordered_map<long,long>,3> & vinsertion_maps,
                                      const std::string & defaultGroup,
-                                     long & activeGroup, long & activeMaterial, long &activeSmoothId)
+                                     long activeMaterial, long activeSmoothId)
 {
     int facetType = 0; //only mesh present;
     if(objData->textures && objData->normals)   facetType = 2;
@@ -2533,54 +2581,57 @@ void IOWavefrontOBJ::writeObjectData(WavefrontOBJData* objData, std::ofstream &
 
     //writing mesh vertices
     for(long id: vertexLists[0]){
-        if(vinsertion_maps[0].count(id) > 0) continue;
-
-        bitpit::Vertex & point = m_geometry->getVertices().at(id);
-        out<<"v "<<std::fixed<<std::setprecision(6)<<point[0]<<" "<<point[1]<<" "<<point[2]<<'\n';
-        vinsertion_maps[0].insert({{id, vOffsets[0]}});
-        ++vOffsets[0];
+        const bitpit::Vertex & point = m_geometry->getVertices().at(id);
+        buffer += "v ";
+        appendCoordinate(buffer, point[0]);
+        buffer += ' ';
+        appendCoordinate(buffer, point[1]);
+        buffer += ' ';
+        appendCoordinate(buffer, point[2]);
+        buffer += '\n';
     }
     //write texture vertices
     for(long id: vertexLists[1]){
-        if(vinsertion_maps[1].count(id) > 0) continue;
-
-        bitpit::Vertex &point = objData->textures->getVertices().at(id);
-        out<<"vt "<<std::fixed<<std::setprecision(6)<<point[0]<<" "<<point[1]<<" ";
-        if(!m_textureUVMode)    out<<std::fixed<<std::setprecision(6)<<point[2];
-        out<<'\n';
-        vinsertion_maps[1].insert({{id, vOffsets[1]}});
-        ++vOffsets[1];
+        const bitpit::Vertex & point = objData->textures->getVertices().at(id);
+        buffer += "vt ";
+        appendCoordinate(buffer, point[0]);
+        buffer += ' ';
+        appendCoordinate(buffer, point[1]);
+        buffer += ' ';
+        if(!m_textureUVMode)    appendCoordinate(buffer, point[2]);
+        buffer += '\n';
     }
     //write vnormals
     for(long id: vertexLists[2]){
-        if(vinsertion_maps[2].count(id) > 0) continue;
-
-        bitpit::Vertex &point = objData->normals->getVertices().at(id);
-        out<<"vn "<<std::fixed<<std::setprecision(6)<<point[0]<<" "<<point[1]<<" "<<point[2]<<'\n';
-        vinsertion_maps[2].insert({{id, vOffsets[2]}});
-        ++vOffsets[2];
-    }
-
-    //connectivity time. Use insertion maps and regroup by cellgroups-materials if any in m_extData.
-    TreeGroups tree = regroupCells(objData, cellList);
-
-    //enter the material key subtree
+        const bitpit::Vertex & point = objData->normals->getVertices().at(id);
+        buffer += "vn ";
+        appendCoordinate(buffer, point[0]);
+        buffer += ' ';
+        appendCoordinate(buffer, point[1]);
+        buffer += ' ';
+        appendCoordinate(buffer, point[2]);
+        buffer += '\n';
+    }
+
+    //connectivity time. Use insertion maps, cells are regrouped by cellgroups-materials.
+    //force writing g defaultGroup for each new object.
+    long activeGroup = -1000;
     for(auto & cgList : tree){
         //write cellgroup
         if(activeGroup != cgList.first){
             activeGroup = cgList.first;
-            if(activeGroup == 0){
-                out<<"g "<<defaultGroup<<'\n';
-            }else{
-                out<<"g "<<objData->inv_cellgroupsList.at(cgList.first)<<'\n';
-            }
+            buffer += "g ";
+            buffer += (activeGroup == 0) ? defaultGroup : objData->inv_cellgroupsList.at(cgList.first);
+            buffer += '\n';
         }
         // access submap of materials
         for(auto & matList : cgList.second){
             //write material
             if(activeMaterial != matList.first){
                 activeMaterial = matList.first;
-                out<<"usemtl "<<objData->inv_materialsList.at(matList.first)<<'\n';
+                buffer += "usemtl ";
+                buffer += objData->inv_materialsList.at(matList.first);
+                buffer += '\n';
             }
             // access and finally write the chunk of facets/cells
             for(long idCell : matList.second){
@@ -2589,61 +2640,43 @@ void IOWavefrontOBJ::writeObjectData(WavefrontOBJData* objData, std::ofstream &
                 long currentsid = objData->smoothids.at(idCell);
                 if(activeSmoothId != currentsid){
                     activeSmoothId = currentsid;
-                    out<<"s "<<objData->inv_smoothidsList.at(currentsid)<<'\n';
+                    buffer += "s ";
+                    buffer += objData->inv_smoothidsList.at(currentsid);
+                    buffer += '\n';
                 }
 
-
                 // prepare to write facets
-                bitpit::ConstProxyVector<long> meshIds = m_geometry->getCells()[idCell].getVertexIds();
-                std::size_t countV = meshIds.size(); //it should be the same for  textures and normals also
-
-                switch(facetType){
-                    case 1: //v and vt
-                        {
-                            bitpit::ConstProxyVector<long> txtIds= objData->textures->getCells().at(idCell).getVertexIds();
-                            out<<"f ";
-                            for(int i=0; i<countV; ++i){
-                                out<<vinsertion_maps[0].at(meshIds[i])<<"/";
-                                out<<vinsertion_maps[1].at(txtIds[i])<<" ";
-                            }
-                            out<<'\n';
-                        }
-
-                        break;
-                    case 2: //v vt and vn
-                        {
-                            bitpit::ConstProxyVector<long> txtIds= objData->textures->getCells().at(idCell).getVertexIds();
-                            bitpit::ConstProxyVector<long> normalIds= objData->normals->getCells().at(idCell).getVertexIds();
-                            out<<"f ";
-                            for(int i=0; i<countV; ++i){
-                                out<<vinsertion_maps[0].at(meshIds[i])<<"/";
-                                out<<vinsertion_maps[1].at(txtIds[i])<<"/";
-                                out<<vinsertion_maps[2].at(normalIds[i])<<" ";
-                            }
-                            out<<'\n';
-
-                        }
-
-                        break;
-                    case 3: //v and vn
-                        {
-                            bitpit::ConstProxyVector<long> normalIds= objData->normals->getCells().at(idCell).getVertexIds();
-                            out<<"f ";
-                            for(int i=0; i<countV; ++i){
-                                out<<vinsertion_maps[0].at(meshIds[i])<<"//";
-                                out<<vinsertion_maps[2].at(normalIds[i])<<" ";
-                            }
-                            out<<'\n';
-                        }
-                        break;
-                    default: // v only
-                            out<<"f ";
-                            for(int i=0; i<countV; ++i){
-                                out<<vinsertion_maps[0].at(meshIds[i])<<" ";
-                            }
-                            out<<'\n';
-                        break;
-                } //end switch
+                const bitpit::Cell & meshCell = m_geometry->getCells().at(idCell);
+                int countV = meshCell.getVertexCount(); //it should be the same for  textures and normals also
+                const bitpit::Cell * txtCell = nullptr;
+                const bitpit::Cell * normalCell = nullptr;
+                if(facetType == 1 || facetType == 2)    txtCell = &(objData->textures->getCells().at(idCell));
+                if(facetType == 2 || facetType == 3)    normalCell = &(objData->normals->getCells().at(idCell));
+
+                buffer += "f ";
+                for(int i=0; i<countV; ++i){
+                    buffer += std::to_string(vinsertion_maps[0].at(meshCell.getVertexId(i)));
+                    switch(facetType){
+                        case 1: //v and vt
+                            buffer += '/';
+                            buffer += std::to_string(vinsertion_maps[1].at(txtCell->getVertexId(i)));
+                            break;
+                        case 2: //v vt and vn
+                            buffer += '/';
+                            buffer += std::to_string(vinsertion_maps[1].at(txtCell->getVertexId(i)));
+                            buffer += '/';
+                            buffer += std::to_string(vinsertion_maps[2].at(normalCell->getVertexId(i)));
+                            break;
+                        case 3: //v and vn
+                            buffer += "//";
+                            buffer += std::to_string(vinsertion_maps[2].at(normalCell->getVertexId(i)));
+                            break;
+                        default: // v only
+                            break;
+                    } //end switch
+                    buffer += ' ';
+                }
+                buffer += '\n';
             }//ending leaflist - chunk of cells.
         }// ending sublist of materials
     }  // ending cellgroups
@@ -212,6 +212,8 @@ public:
     void clearPinLists();
     void clear();
 
+    bool isModifyingGeometry();
+
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name = "");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name= "");
 
@@ -250,6 +252,41 @@ private:
     void setGeometry(MimmoSharedPointer<MimmoObject> geo){BITPIT_UNUSED(geo);};
 };
 
+/*!
+ * \ingroup iogeneric
+ * \brief Attributes of the cells read from a chunk of an obj file by IOWavefrontOBJ.
+ *
+ * Object, material and group are indices in the chunk lists (objects, labels); negative
+ * values mark attributes inherited from the previous chunks.
+ */
+struct WavefrontOBJState{
+    long object;    /**< index of the object in the chunk */
+    long material;  /**< index of the material label in the chunk */
+    long group;     /**< index of the cell group label in the chunk */
+    long smooth;    /**< smoothing group id */
+};
+
+/*!
+ * \ingroup iogeneric
+ * \brief Vertices and facets read from a chunk of an obj file by IOWavefrontOBJ.
+ */
+struct WavefrontOBJChunk{
+    std::array<dvecarr3E,3>     vertices;       /**< coordinates of v, vt and vn declared in the chunk */
+    std::array<long,3>          preObject;      /**< number of v, vt and vn declared before the first object of the chunk */
+    std::vector<std::string>    objects;        /**< names of the objects declared in the chunk */
+    std::vector<std::string>    labels;         /**< material and cell group labels declared in the chunk */
+    std::vector<WavefrontOBJState> states;      /**< distinct attributes of the facets of the chunk */
+    WavefrontOBJState           lastState;      /**< attributes active at the end of the chunk */
+    std::vector<long>           facetStates;    /**< index of the attributes of each facet */
+    std::vector<int>            facetTypes;     /**< facet definition of each facet (see checkFacetDefinition) */
+    std::vector<long>           facetSizes;     /**< number of vertices of each facet */
+    std::vector<long>           connectivity;   /**< v[/vt][/vn] indices of the facets, one-based */
+    std::vector<std::pair<std::size_t,int>> relative; /**< connectivity entries given as relative indices, with their kind (v, vt, vn) */
+    std::string                 materialfile;   /**< materials file declared in the chunk, if any */
+    std::vector<std::string>    unsupported;    /**< unsupported keys found in the chunk */
+    long                        skipped;        /**< number of facets skipped, having less than 3 vertices */
+};
+
 /*!
 \class IOWavefrontOBJ
 \ingroup iogeneric
@@ -282,15 +319,18 @@ are the same in all 3 objects (reference mesh, textures and normals).
 fields attached to the MimmoObject mesh cells-ids.
 
 
-WARNING 1: for reading/writing of v,vt,vn data chunks, the class supposes that the three of them
-are organized in the file in blocks of consecutive entries, i.e. after 'o' sub-object declaration
-all the v's of the object are written, then the vt's if any, and finally the vn's if any.
-This may be not true for the general Wavefront format(in which declarations can be random and not organized at all),
-but meet quite well with the practice of well known OBJ file exporter like the Blender's one.
+WARNING 1: while reading, only data following the first 'o' sub-object declaration are absorbed.
+v, vt, vn declarations can be placed anywhere in the sub-objects, their ids are assigned
+by order of declaration in the file.
 
 WARNING 2: During OBJ writing if empty cellgroup entry is encountered, it will be assigned the
 object name (o) by default.
 
+The obj file is read in a single pass: it is memory-mapped and split in chunks of lines, which are
+parsed concurrently (if OpenMP is enabled) and then absorbed in the mesh in file order.
+While writing, the sub-objects are formatted concurrently in memory buffers, flushed
+to file in order. Read and written files do not depend on the number of threads.
+
 \n
 Ports available in IOWaveFrontOBJ Class :
 
@@ -331,6 +371,7 @@ Ports available in IOWaveFrontOBJ Class :
      - <B>CleanDoubleMeshVertices</B>: for READ Mode only, boolean 0/1 if 1, force mesh vertices collapsing after reading with GeomTolerance.
      - <B>IgnoreCellGroups</B>: for READ Mode only, boolean 0/1 if 1, ignore cellgroups labeling of the OBJ mesh.
      - <B>TextureUVMode</B>: for WRITE Mode only, boolean 0/1 if 1, force writing textures with first 2 components only.
+     - <B>ReadChunkCount</B>: for READ Mode only, number of chunks of lines the file is split in, 0 automatic (default).
      - <B>PrintResumeFile</B>: 0/1 print a resume file of the mesh contents after execution.
 
      Geometry and additional fields have to be mandatorily passed through ports.
@@ -377,6 +418,7 @@ public:
     void    setCleanDoubleMeshVertices(bool clean);
     void    setIgnoreCellGroups(bool ignore);
     void    setTextureUVMode(bool UVmode);
+    void    setReadChunkCount(int nchunks);
     void    printResumeFile(bool print);
 
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name = "");
@@ -394,27 +436,14 @@ protected:
     void dump(std::ostream &);
     void writeResumeFile();
 
-    std::string searchMaterialFile(std::ifstream & in);
-
-    void searchObjectPosition(std::ifstream & in,
-                              std::vector<std::streampos> & mapPos,
-                              std::vector<std::string>& mapNames,
-                              std::vector<std::array<long,3>>& mapVCountObject,
-                              std::array<long,3>& mapVCountTotal,
-                              long &nCellTot);
-
-    void readObjectData(std::ifstream & in, const std::streampos &begObjectStream, const long &PID,
-                        const std::string & defaultGroup, const std::array<long,3> & vCounter,
-                        long &vOffset, long &vnOffset, long &vTxtOffset, long &cOffset);
+    void readChunk(const char * begin, const char * end, WavefrontOBJChunk & chunk);
 
-    void writeObjectData(WavefrontOBJData* objData, std::ofstream & out,
+    void writeObjectData(WavefrontOBJData* objData, std::string & buffer,
                          const std::array<std::vector<long>,3> & vertexLists,
-                         const std::vector<long> & cellList,
-                         std::array<long,3> &vOffsets,
-                         long &cOffset,
-                         std::array<std::unordered_map<long,long>,3> & vinsertion_maps,
+                         const TreeGroups & tree,
+                         const std::array<std::unordered_map<long,long>,3> & vinsertion_maps,
                          const std::string & defaultGroup,
-                         long & activeGroup, long & activeMaterial, long &activeSmoothId);
+                         long activeMaterial, long activeSmoothId);
 
     TreeGroups regroupCells(const WavefrontOBJData* objData, const livector1D & cellList);
 
@@ -432,9 +461,9 @@ private:
     bool m_cleanDoubleVertices; /**< valid for read mode only, clean repeated mesh vertices if required */
     bool m_ignoringCellGroups; /**< boolean to skip absorbing cell groups g while reading */
     bool m_textureUVMode;  /**< true to force writing textures in UV mode (first two components only) */
+    int m_readChunks;      /**< number of chunks of lines the file is split in while reading, 0 for automatic */
 
     //INTERNAL METHODS
-    int convertKeyEntryToInt(char key);
     long pushCell(MimmoSharedPointer<MimmoObject> geo, std::vector<long> &conn, long PID, long id, int rank = -1 );
     int checkFacetDefinition(const std::string & str);
 };
@@ -24,7 +24,11 @@
 #include "MimmoGeometry.hpp"
 #include "VTUGridReader.hpp"
 #include "VTUGridWriterASCII.hpp"
+#include "ParallelIOUtils.hpp"
 #include <iostream>
+#include <cstring>
+#include <exception>
+#include <iterator>
 
 namespace mimmo {
 
@@ -90,6 +94,8 @@ MimmoGeometry::MimmoGeometry(const MimmoGeometry & other):BaseManipulation(other
     m_codex = other.m_codex;
     m_buildSkdTree = other.m_buildSkdTree;
     m_buildKdTree = other.m_buildKdTree;
+    m_dumpTrees = other.m_dumpTrees;
+    m_distributedRead = other.m_distributedRead;
     m_refPID = other.m_refPID;
     m_multiSolidSTL = other.m_multiSolidSTL;
     m_tolerance = other.m_tolerance;
@@ -120,6 +126,8 @@ void MimmoGeometry::swap(MimmoGeometry & x) noexcept
     std::swap(m_codex, x.m_codex);
     std::swap(m_buildSkdTree, x.m_buildSkdTree);
     std::swap(m_buildKdTree, x.m_buildKdTree);
+    std::swap(m_dumpTrees, x.m_dumpTrees);
+    std::swap(m_distributedRead, x.m_distributedRead);
     std::swap(m_refPID, x.m_refPID);
     std::swap(m_multiSolidSTL, x.m_multiSolidSTL);
     std::swap(m_tolerance, x.m_tolerance);
@@ -151,6 +159,7 @@ const MimmoGeometry * MimmoGeometry::getCopy(){
  */
 void
 MimmoGeometry::setDefaults(){
+    setDirty();
 
     m_read            = false;
     m_rinfo.fname    = "mimmoGeometry";
@@ -166,6 +175,8 @@ MimmoGeometry::setDefaults(){
     m_codex            = true;
     m_buildSkdTree    = false;
     m_buildKdTree    = false;
+    m_dumpTrees    = false;
+    m_distributedRead = false;
     m_refPID = 0;
     m_multiSolidSTL = false;
     m_tolerance = 1.0e-06;
@@ -187,6 +198,7 @@ MimmoGeometry::_setRead(bool read){
  */
 void
 MimmoGeometry::setReadFileType(FileType type){
+    setDirty();
     m_rinfo.ftype = type._to_integral();
 }
 
@@ -196,6 +208,7 @@ MimmoGeometry::setReadFileType(FileType type){
  */
 void
 MimmoGeometry::setReadFileType(int type){
+    setDirty();
     auto maybe_type = FileType::_from_integral_nothrow(type);
     if(!maybe_type) type = 0;
     m_rinfo.ftype = type;
@@ -207,6 +220,7 @@ MimmoGeometry::setReadFileType(int type){
  */
 void
 MimmoGeometry::setReadDir(std::string dir){
+    setDirty();
     m_rinfo.fdir = dir;
 }
 
@@ -216,6 +230,7 @@ MimmoGeometry::setReadDir(std::string dir){
  */
 void
 MimmoGeometry::setReadFilename(std::string filename){
+    setDirty();
     m_rinfo.fname = filename;
 }
 
@@ -225,6 +240,7 @@ MimmoGeometry::setReadFilename(std::string filename){
  */
 void
 MimmoGeometry::setWriteFileType(FileType type){
+    setDirty();
     m_winfo.ftype = type._to_integral();
 }
 
@@ -234,6 +250,7 @@ MimmoGeometry::setWriteFileType(FileType type){
  */
 void
 MimmoGeometry::setWriteFileType(int type){
+    setDirty();
     auto maybe_type = FileType::_from_integral_nothrow(type);
     if(!maybe_type) type = 0;
     m_winfo.ftype = type;
@@ -254,6 +271,7 @@ MimmoGeometry::_setWrite(bool write){
  */
 void
 MimmoGeometry::setWriteDir(std::string dir){
+    setDirty();
     m_winfo.fdir = dir;
 }
 
@@ -263,6 +281,7 @@ MimmoGeometry::setWriteDir(std::string dir){
  */
 void
 MimmoGeometry::setWriteFilename(std::string filename){
+    setDirty();
     m_winfo.fname = filename;
 
 }
@@ -275,6 +294,7 @@ MimmoGeometry::setWriteFilename(std::string filename){
  */
 void
 MimmoGeometry::setIOMode(MimmoGeometry::IOMode mode){
+    setDirty();
     switch(mode){
         case MimmoGeometry::IOMode::READ :
             _setRead();
@@ -302,6 +322,7 @@ MimmoGeometry::setIOMode(MimmoGeometry::IOMode mode){
  */
 void
 MimmoGeometry::setIOMode(int mode){
+    setDirty();
     setIOMode(static_cast<MimmoGeometry::IOMode>(mode));
 }
 
@@ -310,6 +331,7 @@ MimmoGeometry::setIOMode(int mode){
  */
 void
 MimmoGeometry::setDir(std::string dir){
+    setDirty();
     m_rinfo.fdir = dir;
     m_winfo.fdir = dir;
 }
@@ -319,6 +341,7 @@ MimmoGeometry::setDir(std::string dir){
  */
 void
 MimmoGeometry::setFilename(std::string filename){
+    setDirty();
     m_winfo.fname = filename;
     m_rinfo.fname = filename;
 }
@@ -329,6 +352,7 @@ MimmoGeometry::setFilename(std::string filename){
  */
 void
 MimmoGeometry::setFileType(FileType type){
+    setDirty();
     m_winfo.ftype = type._to_integral();
     m_rinfo.ftype = type._to_integral();
 }
@@ -339,6 +363,7 @@ MimmoGeometry::setFileType(FileType type){
  */
 void
 MimmoGeometry::setFileType(int type){
+    setDirty();
     auto maybe_type = FileType::_from_integral_nothrow(type);
     if(!maybe_type) type = 0;
     m_winfo.ftype = type;
@@ -352,6 +377,7 @@ MimmoGeometry::setFileType(int type){
  * \param[in] binary codex flag.
  */
 void MimmoGeometry::setCodex(bool binary){
+    setDirty();
     m_codex = binary;
 }
 
@@ -361,6 +387,7 @@ void MimmoGeometry::setCodex(bool binary){
  * \param[in] multi boolean, true activate Multi Solid STL writing.
  */
 void MimmoGeometry::setMultiSolidSTL(bool multi){
+    setDirty();
     m_multiSolidSTL = multi;
 }
 
@@ -370,6 +397,7 @@ void MimmoGeometry::setMultiSolidSTL(bool multi){
  */
 void
 MimmoGeometry::setTolerance(double tol){
+	setDirty();
 	m_tolerance = std::max(1.0e-15, tol);
 }
 
@@ -379,6 +407,7 @@ MimmoGeometry::setTolerance(double tol){
  */
 void
 MimmoGeometry::setClean(bool clean){
+	setDirty();
 	m_clean = clean;
 }
 
@@ -390,6 +419,7 @@ MimmoGeometry::setClean(bool clean){
  */
 void
 MimmoGeometry::setGeometry(int type){
+    setDirty();
     if(type > 4)    type = 1;
     int type_ = std::max(type,1);
     m_geometry.reset(new MimmoObject(type_));
@@ -420,6 +450,7 @@ bitpit::PiercedVector<bitpit::Cell> * MimmoGeometry::getCells(){
  */
 void
 MimmoGeometry::setPID(livector1D pids){
+    setDirty();
     getGeometry()->setPID(pids);
 };
 
@@ -428,6 +459,7 @@ MimmoGeometry::setPID(livector1D pids){
  */
 void
 MimmoGeometry::setPID(std::unordered_map<long, long> pidsMap){
+    setDirty();
     getGeometry()->setPID(pidsMap);
 };
 
@@ -440,6 +472,7 @@ MimmoGeometry::setPID(std::unordered_map<long, long> pidsMap){
  */
 void
 MimmoGeometry::setReferencePID(long pid){
+    setDirty();
     m_refPID = std::max(long(0),pid);
 }
 
@@ -450,6 +483,7 @@ MimmoGeometry::setReferencePID(long pid){
  */
 void
 MimmoGeometry::setBuildSkdTree(bool build){
+    setDirty();
     m_buildSkdTree = build;
 }
 
@@ -459,9 +493,35 @@ MimmoGeometry::setBuildSkdTree(bool build){
  */
 void
 MimmoGeometry::setBuildKdTree(bool build){
+    setDirty();
     m_buildKdTree = build;
 }
 
+/*!It sets if the search trees of the geometry have to be written in mimmo dump format
+ * files (FileType::MIMMO). The KdTree enabled by setBuildKdTree is built before writing
+ * and, when the file is read back, restored instead of being rebuilt. The SkdTree is not
+ * persisted and it is built again after reading if enabled by setBuildSkdTree.
+ * \param[in] dump If true the search trees are written in the dump file.
+ */
+void
+MimmoGeometry::setDumpTrees(bool dump){
+    setDirty();
+    m_dumpTrees = dump;
+}
+
+/*!It sets if serial *.vtu files have to be read in parallel by all the processes.
+ * If active, each process reads a contiguous slice of the cells of the file plus one
+ * layer of ghost cells, instead of reading the whole mesh on the master rank and
+ * partitioning it afterwards. Active only in MPI runs with more than one process and
+ * when no *.pvtu file is found; *.pvtu files are always read by all the processes.
+ * \param[in] distributed If true serial vtu files are read distributed.
+ */
+void
+MimmoGeometry::setDistributedRead(bool distributed){
+    setDirty();
+    m_distributedRead = distributed;
+}
+
 /*!
  * Check if geometry is not linked or not locally instantiated in your class.
  * True - no geometry present, False otherwise.
@@ -486,6 +546,7 @@ MimmoGeometry::clear(){
  */
 void
 MimmoGeometry::setFormatNAS(WFORMAT wform){
+    setDirty();
     m_wformat = wform;
 }
 
@@ -638,7 +699,10 @@ MimmoGeometry::write(){
 #else
     	bitpit::OBinaryArchive binaryWriter(filename, "geomimmo", archiveVersion, header);
 #endif
-    	getGeometry()->dump(binaryWriter.getStream());
+    	if (m_dumpTrees && m_buildKdTree){
+    	    getGeometry()->buildKdTree();
+    	}
+    	getGeometry()->dump(binaryWriter.getStream(), m_dumpTrees);
     	binaryWriter.close();
     	return true;
     }
@@ -663,6 +727,9 @@ MimmoGeometry::read(){
         return false;
     }
 
+    // True if the coincident vertices are merged while reading
+    bool verticesMerged = false;
+
     switch(FileType::_from_integral(m_rinfo.ftype)){
 
     //Import STL
@@ -683,28 +750,46 @@ MimmoGeometry::read(){
         		}
         	}
 
-        	std::ifstream in(name);
-        	std::string    ss, sstype;
-        	std::getline(in,ss);
-        	std::stringstream ins;
-        	ins << ss;
-        	ins >> sstype;
-        	bool binary = true;
-        	if (sstype == "solid" || sstype == "SOLID") binary = false;
-        	in.close();
-
-        	std::unordered_map<int,std::string> mapPIDSolid;
-        	dynamic_cast<bitpit::SurfUnstructured*>(getGeometry()->getPatch())->importSTL(name, binary, 0, false, &mapPIDSolid);
-
-        	//count PID if multi-solid
-        	auto & mapset = getGeometry()->getPIDTypeList();
-        	for(const auto & cell : getGeometry()->getCells() ){
-        		mapset.insert(cell.getPID());
-        	}
-        	std::unordered_map<long, std::string> & mapWNames = getGeometry()->getPIDTypeListWNames();
-        	for(const auto & val :mapset ){
-        		mapWNames[val] = mapPIDSolid[val];
-        	}
+            // Parse the memory-mapped file, merge the vertices of adjacent facets (if
+            // cleaning is active) and fill the geometry
+            dvecarr3E points;
+            livector1D pids;
+            std::unordered_map<long, std::string> mapPIDSolid;
+            parallelIOUtils::readSTL(name, points, pids, mapPIDSolid);
+
+            std::vector<std::size_t> vertexMap;
+            std::size_t nvertices = points.size();
+            if (m_clean){
+                nvertices = parallelIOUtils::mergeCoincidentPoints(points, m_tolerance, vertexMap);
+                verticesMerged = true;
+            }
+
+            MimmoSharedPointer<MimmoObject> geometry = getGeometry();
+            geometry->getPatch()->reserveVertices(nvertices);
+            geometry->getPatch()->reserveCells(pids.size());
+            long nadded = 0;
+            for (std::size_t i = 0; i < points.size(); ++i){
+                long id = verticesMerged ? long(vertexMap[i]) : long(i);
+                if (id == nadded){
+                    geometry->addVertex(points[i], id);
+                    ++nadded;
+                }
+            }
+            dvecarr3E().swap(points);
+
+            livector1D conn(3);
+            for (std::size_t i = 0; i < pids.size(); ++i){
+                for (std::size_t j = 0; j < 3; ++j){
+                    conn[j] = verticesMerged ? long(vertexMap[3*i+j]) : long(3*i+j);
+                }
+                geometry->addConnectedCell(conn, bitpit::ElementType::TRIANGLE, pids[i], long(i));
+            }
+
+            //name the solids
+            std::unordered_map<long, std::string> & mapWNames = geometry->getPIDTypeListWNames();
+            for(const auto & val : geometry->getPIDTypeList()){
+                mapWNames[val] = mapPIDSolid[val];
+            }
 #if MIMMO_ENABLE_MPI
         }
 #endif
@@ -733,10 +818,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTUGrid(masterRankOnly);
 
         getGeometry()->resyncPID();
     }
@@ -764,10 +846,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTUGrid(masterRankOnly);
 
         getGeometry()->resyncPID();
     }
@@ -796,18 +875,38 @@ MimmoGeometry::read(){
 
         bitpit::ElementType eltype;
 
-        int sizeV, sizeC;
-        sizeV = Ipoints.size();
-        sizeC = Iconnectivity.size();
+        // Merge coincident points (if cleaning is active): each point is replaced in the
+        // connectivity by the first point coincident with it.
+        std::vector<std::size_t> vertexMap;
+        std::size_t sizeV = Ipoints.size();
+        std::size_t sizeC = Iconnectivity.size();
+        if (m_clean){
+            sizeV = parallelIOUtils::mergeCoincidentPoints(Ipoints, m_tolerance, vertexMap);
+            verticesMerged = true;
+        }
         getGeometry()->getPatch()->reserveVertices(sizeV);
         getGeometry()->getPatch()->reserveCells(sizeC);
 
-        int counter = 0;
-        for(const auto & vv : Ipoints){
-            getGeometry()->addVertex(vv, pointsID[counter]);
-            ++counter;
+        std::vector<long> mergedID;
+        std::unordered_map<long, long> renumber;
+        for(std::size_t i = 0; i < Ipoints.size(); ++i){
+            if (!verticesMerged || vertexMap[i] == mergedID.size()){
+                getGeometry()->addVertex(Ipoints[i], pointsID[i]);
+                mergedID.push_back(pointsID[i]);
+            }else{
+                renumber[pointsID[i]] = mergedID[vertexMap[i]];
+            }
         }
-        counter = 0;
+        if (!renumber.empty()){
+            for(auto & cc : Iconnectivity){
+                // polygons store the number of vertices first
+                for(std::size_t j = (cc.size() > 4 ? 1 : 0); j < cc.size(); ++j){
+                    auto it = renumber.find(cc[j]);
+                    if (it != renumber.end())   cc[j] = it->second;
+                }
+            }
+        }
+        int counter = 0;
         for(const auto & cc : Iconnectivity)    {
             eltype = bitpit::ElementType::UNDEFINED;
             std::size_t ccsize = cc.size();
@@ -849,10 +948,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTUGrid(masterRankOnly);
         getGeometry()->resyncPID();
     }
     break;
@@ -879,10 +975,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTUGrid(masterRankOnly);
 
         getGeometry()->resyncPID();
     }
@@ -909,9 +1002,12 @@ MimmoGeometry::read(){
 
     }
 
-    // set Tolerance and clean geometry
+    // set Tolerance and clean geometry (vertices merged while reading do not need it)
 	getGeometry()->setTolerance(m_tolerance);
-	if (m_clean){
+#if MIMMO_ENABLE_MPI
+	MPI_Bcast(&verticesMerged, 1, MPI_C_BOOL, 0, m_communicator);
+#endif
+	if (m_clean && !verticesMerged){
 		getGeometry()->cleanGeometry();
 	}
 
@@ -926,12 +1022,34 @@ MimmoGeometry::read(){
     //action completed, reset m_refPID to zero.
     m_refPID = 0;
 
-    // Set all the sync status variables to unsync
-    getGeometry()->setUnsyncAll();
+    // Set all the sync status variables to unsync. Restored mimmo dumps are already
+    // synchronized, search trees included (cleanGeometry unsyncs them if it modifies the mesh).
+    if (FileType::_from_integral(m_rinfo.ftype) != FileType::MIMMO){
+        getGeometry()->setUnsyncAll();
+    }
 
     return true;
 };
 
+/*!
+ * Read the current *.vtu/*.pvtu file in the linked geometry.
+ * \param[in] masterRankOnly if true only the master rank reads the file (serial vtu file).
+ */
+void
+MimmoGeometry::readVTUGrid(bool masterRankOnly){
+#if MIMMO_ENABLE_MPI
+    if (masterRankOnly && m_distributedRead && getGeometry()->getProcessorCount() > 1){
+        VTUDistributedGridStreamer vtustreamer(m_rinfo.fdir+"/"+m_rinfo.fname+".vtu");
+        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
+        input.read() ;
+        return;
+    }
+#endif
+    VTUGridStreamer vtustreamer;
+    VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
+    input.read() ;
+}
+
 /*!
     Return true if a file exists on the filesystem and it is readable
     (check successfull opening with ifstream)
@@ -1119,6 +1237,26 @@ MimmoGeometry::absorbSectionXML(const bitpit::Config::Section & slotXML, std::st
         setBuildKdTree(value);
     };
 
+    if(slotXML.hasOption("DumpTrees")){
+        input = slotXML.get("DumpTrees");
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(bitpit::utils::string::trim(input));
+            ss >> value;
+        }
+        setDumpTrees(value);
+    };
+
+    if(slotXML.hasOption("DistributedRead")){
+        input = slotXML.get("DistributedRead");
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(bitpit::utils::string::trim(input));
+            ss >> value;
+        }
+        setDistributedRead(value);
+    };
+
     if(slotXML.hasOption("AssignRefPID")){
         input = slotXML.get("AssignRefPID");
         long value = 0;
@@ -1230,6 +1368,8 @@ MimmoGeometry::flushSectionXML(bitpit::Config::Section & slotXML, std::string na
 
     output = std::to_string(m_buildKdTree);
     slotXML.set("KdTree", output);
+    slotXML.set("DumpTrees", std::to_string(m_dumpTrees));
+    slotXML.set("DistributedRead", std::to_string(m_distributedRead));
     slotXML.set("AssignRefPID", std::to_string(m_refPID));
     slotXML.set("WriteMultiSolidSTL", std::to_string(m_multiSolidSTL));
 
@@ -1547,7 +1687,9 @@ void NastranInterface::write(std::string& outputDir, std::string& surfaceName, d
 
 //========READ====//
 /*!
- * Read a bdf nastran file
+ * Read a bdf nastran file.
+ * The file is memory-mapped and split in chunks of whole cards, which are read
+ * concurrently if OpenMP is enabled. Points and elements are returned in file order.
  * \param[in] inputDir    input directory
  * \param[in] surfaceName    input filename
  * \param[out] points    reference of a point container that has to be filled
@@ -1559,153 +1701,150 @@ void NastranInterface::write(std::string& outputDir, std::string& surfaceName, d
 void NastranInterface::read(std::string& inputDir, std::string& surfaceName, dvecarr3E& points, livector1D & pointsID,
                             livector2D& faces, livector1D & facesID, livector1D& PIDS){
 
-    std::ifstream is(inputDir +"/"+surfaceName + ".nas");
-
     points.clear();
     pointsID.clear();
     faces.clear();
     facesID.clear();
     PIDS.clear();
 
-    long ipoint = 0;
-    long iface  = 0;
+    parallelIOUtils::MappedFile file(inputDir +"/"+surfaceName + ".nas");
+    const char * data = file.data();
+    std::size_t size = file.size();
+
+    // Split the file in chunks of lines, moving each chunk start after the continuation
+    // lines of multi-line cards
+    std::vector<std::size_t> offsets = parallelIOUtils::splitLines(data, size, parallelIOUtils::evalChunkCount(size));
+    std::size_t nchunks = offsets.size() - 1;
+    for (std::size_t k = 1; k < nchunks; ++k){
+        std::size_t pos = std::max(offsets[k], offsets[k-1]);
+        while (pos < size && isContinuationLine(data + pos, data + size)){
+            const void * newline = std::memchr(data + pos, '\n', size - pos);
+            pos = (newline == nullptr) ? size : std::size_t(static_cast<const char *>(newline) - data) + 1;
+        }
+        offsets[k] = pos;
+    }
+
+    std::vector<NastranChunk> chunks(nchunks);
+    std::vector<std::exception_ptr> errors(nchunks);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long k = 0; k < long(nchunks); ++k){
+        try{
+            readChunk(data + offsets[k], data + offsets[k+1], chunks[k]);
+        }catch(...){
+            errors[k] = std::current_exception();
+        }
+    }
+    for (const std::exception_ptr & error : errors){
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Concatenate the chunks in file order
+    std::size_t npoints = 0, nfaces = 0;
+    for (const NastranChunk & chunk : chunks){
+        npoints += chunk.points.size();
+        nfaces += chunk.faces.size();
+    }
+    points.reserve(npoints);
+    pointsID.reserve(npoints);
+    faces.reserve(nfaces);
+    facesID.reserve(nfaces);
+    PIDS.reserve(nfaces);
+    for (NastranChunk & chunk : chunks){
+        points.insert(points.end(), chunk.points.begin(), chunk.points.end());
+        pointsID.insert(pointsID.end(), chunk.pointsID.begin(), chunk.pointsID.end());
+        std::move(chunk.faces.begin(), chunk.faces.end(), std::back_inserter(faces));
+        facesID.insert(facesID.end(), chunk.facesID.begin(), chunk.facesID.end());
+        PIDS.insert(PIDS.end(), chunk.PIDS.begin(), chunk.PIDS.end());
+        chunk = NastranChunk();
+    }
+}
+
+/*!
+ * Check if a line of a nas file is the continuation of a multi-line card, i.e. if its
+ * first record is blank or it starts with the character '+'.
+ * \param[in] begin start of the line
+ * \param[in] end end of the file buffer
+ * \return true if the line is a continuation line
+ */
+bool
+NastranInterface::isContinuationLine(const char * begin, const char * end){
+    if (begin < end && *begin == '+') return true;
+    if (end - begin < 8) return false;
+    for (int i = 0; i < 8; ++i){
+        if (begin[i] != ' ') return false;
+    }
+    return true;
+}
+
+/*!
+ * Read the cards of a chunk of a nas file. The chunk starts at the beginning of a card and
+ * includes all the continuation lines of its last card. It is safe to read different chunks
+ * concurrently.
+ * \param[in] begin start of the chunk
+ * \param[in] end end of the chunk
+ * \param[out] chunk points and elements read from the chunk
+ */
+void
+NastranInterface::readChunk(const char * begin, const char * end, NastranChunk & chunk){
+
+    bool gridEnabled = m_enabled.count(NastranElementType::GRID) && m_enabled.at(NastranElementType::GRID);
+    bool ctriaEnabled = m_enabled.count(NastranElementType::CTRIA) && m_enabled.at(NastranElementType::CTRIA);
+    bool cquadEnabled = m_enabled.count(NastranElementType::CQUAD) && m_enabled.at(NastranElementType::CQUAD);
+    bool cbarEnabled = m_enabled.count(NastranElementType::CBAR) && m_enabled.at(NastranElementType::CBAR);
+    bool rbe2Enabled = m_enabled.count(NastranElementType::RBE2) && m_enabled.at(NastranElementType::RBE2);
+    bool rbe3Enabled = m_enabled.count(NastranElementType::RBE3) && m_enabled.at(NastranElementType::RBE3);
+
+    auto lineEnd = [end](const char * p){
+        const void * newline = std::memchr(p, '\n', std::size_t(end - p));
+        return (newline == nullptr) ? end : static_cast<const char *>(newline);
+    };
+
     darray3E point;
     livector1D face;
-    long pid;
-    std::string sread;
-    std::string ssub = trim(sread.substr(0,8));
-
-    while(!is.eof()){
-        while(((ssub != "GRID" && ssub != "GRID*") || !isEnabled(NastranElementType::GRID)) &&
-                ((ssub != "CTRIA3" && ssub != "CTRIA3*") || !isEnabled(NastranElementType::CTRIA)) &&
-                ((ssub != "CQUAD4" && ssub != "CQUAD4*") || !isEnabled(NastranElementType::CQUAD)) &&
-                (ssub != "RBE2" || !isEnabled(NastranElementType::RBE2)) &&
-                (ssub != "RBE3" || !isEnabled(NastranElementType::RBE3)) &&
-                (ssub != "CBAR" || !isEnabled(NastranElementType::CBAR)) &&
-                !is.eof()){
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
-        }
-        if(ssub == "GRID"){
-            ipoint = stoi(sread.substr(8,8));
+    const char * p = begin;
+    while (p < end){
+        const char * eol = lineEnd(p);
+        std::string sread(p, eol);
+        p = eol + 1;
+        std::string ssub = trim(sread.substr(0,8));
+
+        if(ssub == "GRID" && gridEnabled){
+            chunk.pointsID.push_back(stoi(sread.substr(8,8)));
             point[0] = stod(convertVertex(trim(sread.substr(24,8))));
             point[1] = stod(convertVertex(trim(sread.substr(32,8))));
             point[2] = stod(convertVertex(trim(sread.substr(40,8))));
-            points.push_back(point);
-            pointsID.push_back(ipoint);
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
+            chunk.points.push_back(point);
         }
-        else if(ssub == "GRID*"){
-            ipoint = stoi(sread.substr(16,16));
+        else if(ssub == "GRID*" && gridEnabled){
+            chunk.pointsID.push_back(stoi(sread.substr(16,16)));
             point[0] = stod(convertVertex(trim(sread.substr(48,16))));
             point[1] = stod(convertVertex(trim(sread.substr(64,16))));
             point[2] = stod(convertVertex(trim(sread.substr(80,16))));
-            points.push_back(point);
-            pointsID.push_back(ipoint);
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
-        }
-        else if(ssub == "CTRIA3"){
-            face.resize(3);
-            iface = stoi(sread.substr(8,8));
-            pid   = stoi(sread.substr(16,8));
-            face[0] = stoi(sread.substr(24,8));
-            face[1] = stoi(sread.substr(32,8));
-            face[2] = stoi(sread.substr(40,8));
-            faces.push_back(face);
-            facesID.push_back(iface);
-            PIDS.push_back(pid);
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
-        }
-        else if(ssub == "CTRIA3*"){
-            face.resize(3);
-            iface = stoi(sread.substr(16,16));
-            pid   = stoi(sread.substr(32,16));
-            face[0] = stoi(sread.substr(48,16));
-            face[1] = stoi(sread.substr(64,16));
-            face[2] = stoi(sread.substr(80,16));
-            faces.push_back(face);
-            facesID.push_back(iface);
-            PIDS.push_back(pid);
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
-        }
-        else if(ssub == "CQUAD4"){
-            face.resize(4);
-            iface = stoi(sread.substr(8,8));
-            pid = stoi(sread.substr(16,8));
-            face[0] = stoi(sread.substr(24,8));
-            face[1] = stoi(sread.substr(32,8));
-            face[2] = stoi(sread.substr(40,8));
-            face[3] = stoi(sread.substr(48,8));
-            faces.push_back(face);
-            facesID.push_back(iface);
-            PIDS.push_back(pid);
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
+            chunk.points.push_back(point);
         }
-        else if(ssub == "CQUAD4*"){
-            face.resize(4);
-            iface = stoi(sread.substr(16,16));
-            pid = stoi(sread.substr(32,16));
-            face[0] = stoi(sread.substr(48,16));
-            face[1] = stoi(sread.substr(64,16));
-            face[2] = stoi(sread.substr(80,16));
-            face[3] = stoi(sread.substr(96,16));
-            faces.push_back(face);
-            facesID.push_back(iface);
-            PIDS.push_back(pid);
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
-        }
-        else if(ssub == "CBAR"){
-            face.resize(2);
-            iface = stoi(sread.substr(8,8));
-            pid = stoi(sread.substr(16,8));
-            face[0] = stoi(sread.substr(24,8));
-            face[1] = stoi(sread.substr(32,8));
-            faces.push_back(face);
-            facesID.push_back(iface);
-            PIDS.push_back(pid);
-            std::getline(is,sread);
-            ssub = trim(sread.substr(0,8));
-        }
-        else if(ssub == "RBE3"){
-
-            long ID;
-            std::vector<long> conn;
-            long PID;
-            std::string components;
-
-            std::vector<std::string> records;
-            bool toexit = false;
-            while (!toexit){
-                appendLineRecords(sread, 8, records);
-                getline(is,sread);
-                ssub = sread.substr(0,8);
-                if ((ssub != "        " && ssub[0] != '+'))
-                    toexit = true;
+        else if((ssub == "CTRIA3" && ctriaEnabled) || (ssub == "CQUAD4" && cquadEnabled) || (ssub == "CBAR" && cbarEnabled)){
+            std::size_t nv = (ssub == "CTRIA3") ? 3 : ((ssub == "CQUAD4") ? 4 : 2);
+            face.resize(nv);
+            chunk.facesID.push_back(stoi(sread.substr(8,8)));
+            chunk.PIDS.push_back(stoi(sread.substr(16,8)));
+            for (std::size_t i = 0; i < nv; ++i){
+                face[i] = stoi(sread.substr(24+8*i,8));
             }
-
-            absorbRBE3(records, ID, PID, conn, components);
-
-            //If surface elements build polygon
-            std::size_t nv = conn.size();
-
-            int ispolygon = int(nv > 4);
-            face.resize(nv+ispolygon);
-            face[0] = nv;
-            for (int i=0; i<nv; i++){
-                face[i+ispolygon] = conn[i];
+            chunk.faces.push_back(face);
+        }
+        else if((ssub == "CTRIA3*" && ctriaEnabled) || (ssub == "CQUAD4*" && cquadEnabled)){
+            std::size_t nv = (ssub == "CTRIA3*") ? 3 : 4;
+            face.resize(nv);
+            chunk.facesID.push_back(stoi(sread.substr(16,16)));
+            chunk.PIDS.push_back(stoi(sread.substr(32,16)));
+            for (std::size_t i = 0; i < nv; ++i){
+                face[i] = stoi(sread.substr(48+16*i,16));
             }
-            faces.push_back(face);
-            facesID.push_back(ID);
-            PIDS.push_back(PID);
-
+            chunk.faces.push_back(face);
         }
-        else if(ssub == "RBE2"){
+        else if((ssub == "RBE3" && rbe3Enabled) || (ssub == "RBE2" && rbe2Enabled)){
 
             long ID;
             std::vector<long> conn;
@@ -1713,36 +1852,34 @@ void NastranInterface::read(std::string& inputDir, std::string& surfaceName, dve
             std::string components;
 
             std::vector<std::string> records;
-            bool toexit = false;
-            while (!toexit){
+            appendLineRecords(sread, 8, records);
+            while (p < end && isContinuationLine(p, end)){
+                eol = lineEnd(p);
+                sread = std::string(p, eol);
+                p = eol + 1;
                 appendLineRecords(sread, 8, records);
-                getline(is,sread);
-                ssub = sread.substr(0,8);
-                if ((ssub != "        " && ssub[0] != '+')){
-                    toexit = true;
-                }
             }
 
-            absorbRBE2(records, ID, PID, conn, components);
+            if (ssub == "RBE3"){
+                absorbRBE3(records, ID, PID, conn, components);
+            }else{
+                absorbRBE2(records, ID, PID, conn, components);
+            }
 
-            // build polygon
+            //If surface elements build polygon
             std::size_t nv = conn.size();
 
             int ispolygon = int(nv > 4);
             face.resize(nv+ispolygon);
-            face[0] = nv;
-            for (int i=0; i<nv; i++){
+            if (ispolygon) face[0] = nv;
+            for (std::size_t i=0; i<nv; i++){
                 face[i+ispolygon] = conn[i];
             }
-            faces.push_back(face);
-            facesID.push_back(ID);
-            PIDS.push_back(PID);
-
+            chunk.faces.push_back(face);
+            chunk.facesID.push_back(ID);
+            chunk.PIDS.push_back(PID);
         }
-
     }
-    is.close();
-
 }
 
 /*!
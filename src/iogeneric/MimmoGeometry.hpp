@@ -68,6 +68,9 @@ enum WFORMAT{
  * Nastran files are always written in serial mode, i.e. only the master rank 0 writes on file its partition. In order
  * to write a distributed mesh in a Nastran format, the user has to serialize it before to pass the MimmoObject
  * to the MimmoGeometry block.
+ * STL and Nastran files are memory-mapped and parsed in chunks, concurrently if OpenMP is enabled.
+ * If cleaning is active, their coincident vertices are merged while reading, within the
+ * geometric tolerance, by a multithreaded spatial hashing (see parallelIOUtils).
  *
  *  \n
  *  It can be used in three modes reader/writer/converter. To set the mode it uses an enum
@@ -129,6 +132,8 @@ enum WFORMAT{
  * - <B>Codex</B>: boolean to write ascii/binary;
  * - <B>SkdTree</B>: evaluate SkdTree true 1/false 0;
  * - <B>KdTree</B>: evaluate kdTree true 1/false 0.
+ * - <B>DumpTrees</B>: write the KdTree in mimmo dump files (FileType MIMMO) and restore it when reading, true 1/false 0.
+ * - <B>DistributedRead</B>: read serial vtu files distributed over the processes (MPI only), true 1/false 0.
  * - <B>AssignRefPID</B>: assign a reference PID on the whole geometry, after reading or just before writing. If the geometry is already pidded,
  *                     translate all existent PIDs w.r.t. the reference PID assigned. Default value is RefPID = 0.
  * - <B>Tolerance</B>:value of the geometric tolerance to be used;
@@ -154,6 +159,8 @@ protected:
 
     bool        m_buildSkdTree;             /**<If true the simplex ordered SkdTree of the geometry is built in execution, whenever geometry support simplicies. */
     bool        m_buildKdTree;                /**<If true the vertex ordered KdTree of the geometry is built in execution*/
+    bool        m_dumpTrees;                  /**<If true the KdTree is written in mimmo dump files*/
+    bool        m_distributedRead;            /**<If true serial vtu files are read distributed over the processes*/
     long        m_refPID;                     /**<Reference PID, to be assigned on all cells of geometry in read/convert mode*/
     bool        m_multiSolidSTL;            /**< activate or not MultiSolid STL writing if STL writing Filetype is selected */
 
@@ -217,6 +224,8 @@ public:
 
     void        setBuildSkdTree(bool build);
     void        setBuildKdTree(bool build);
+    void        setDumpTrees(bool dump);
+    void        setDistributedRead(bool distributed);
 
     bool         isEmpty();
     void         clear();
@@ -235,10 +244,23 @@ protected:
     void    setDefaults();
     void    _setRead(bool read = true);
     void    _setWrite(bool write = true);
+    void    readVTUGrid(bool masterRankOnly);
     bool   fileExist(const std::string & filename);
 
 };
 
+/*!
+ * \ingroup iogeneric
+ * \brief Points and elements read from a chunk of a nas file by NastranInterface.
+ */
+struct NastranChunk{
+    dvecarr3E   points;     /**< coordinates of the points */
+    livector1D  pointsID;   /**< ids of the points */
+    livector2D  faces;      /**< element-point connectivity */
+    livector1D  facesID;    /**< ids of the elements */
+    livector1D  PIDS;       /**< PIDs of the elements */
+};
+
 /*!
  * \class NastranInterface
  * \ingroup iogeneric
@@ -274,6 +296,8 @@ public:
     bool isEnabled(NastranElementType type);
 
 protected:
+    bool isContinuationLine(const char * begin, const char * end);
+    void readChunk(const char * begin, const char * end, NastranChunk & chunk);
     void enable(NastranElementType type);
     void disable(NastranElementType type);
 
@@ -0,0 +1,682 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+# include "ParallelIOUtils.hpp"
+# include <algorithm>
+# include <cctype>
+# include <cmath>
+# include <cstdint>
+# include <cstdlib>
+# include <cstring>
+# include <exception>
+# include <fstream>
+# include <limits>
+# include <stdexcept>
+# if !defined(_WIN32)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+# endif
+# if MIMMO_ENABLE_OPENMP
+# include <omp.h>
+# endif
+
+namespace mimmo{
+
+namespace parallelIOUtils{
+
+/*!
+ * Constructor. Map the file in memory (POSIX systems only, the file is read in a
+ * memory buffer otherwise).
+ * \param[in] filename path to the file
+ */
+MappedFile::MappedFile(const std::string & filename)
+    : m_data(nullptr), m_size(0), m_mapped(false)
+{
+#if !defined(_WIN32)
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0){
+        throw std::runtime_error("MappedFile : unable to open file " + filename);
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0){
+        m_size = std::size_t(info.st_size);
+        void * address = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED){
+            madvise(address, m_size, MADV_WILLNEED);
+            m_data = static_cast<const char *>(address);
+            m_mapped = true;
+        }
+    }
+    close(fd);
+#endif
+
+    //fallback to a buffered read
+    if (!m_mapped){
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        if (!in.is_open()){
+            throw std::runtime_error("MappedFile : unable to open file " + filename);
+        }
+        m_size = std::size_t(std::max(std::streamoff(0), std::streamoff(in.tellg())));
+        m_buffer.resize(m_size);
+        in.seekg(0);
+        in.read(m_buffer.data(), m_size);
+        m_size = std::size_t(in.gcount());
+        m_data = m_buffer.data();
+    }
+}
+
+/*!
+ * Destructor. Unmap the file.
+ */
+MappedFile::~MappedFile(){
+#if !defined(_WIN32)
+    if (m_mapped){
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+#endif
+}
+
+/*!
+ * \return pointer to the contents of the file
+ */
+const char *
+MappedFile::data() const{
+    return m_data;
+}
+
+/*!
+ * \return size of the file in bytes
+ */
+std::size_t
+MappedFile::size() const{
+    return m_size;
+}
+
+/*!
+ * Evaluate the number of chunks a file is split in for parsing: a few chunks per
+ * thread, to balance the load, and no chunk smaller than 1 MB.
+ * \param[in] size size of the file in bytes
+ * \return number of chunks
+ */
+std::size_t
+evalChunkCount(std::size_t size){
+    std::size_t nthreads = 1;
+#if MIMMO_ENABLE_OPENMP
+    nthreads = std::size_t(omp_get_max_threads());
+#endif
+    std::size_t minChunkSize = std::size_t(1) << 20;
+    return std::max(std::size_t(1), std::min(4*nthreads, size / minChunkSize));
+}
+
+/*!
+ * Split a text buffer in chunks of whole lines of about the same size.
+ * \param[in] data text buffer
+ * \param[in] size size of the buffer
+ * \param[in] nchunks number of chunks
+ * \return nchunks+1 offsets of the chunks in the buffer. Each offset but the last
+ * one is the start of a line; chunks can be empty.
+ */
+std::vector<std::size_t>
+splitLines(const char * data, std::size_t size, std::size_t nchunks){
+    nchunks = std::max(std::size_t(1), nchunks);
+    std::vector<std::size_t> offsets(nchunks+1, size);
+    offsets[0] = 0;
+    for (std::size_t k = 1; k < nchunks; ++k){
+        std::size_t pos = std::max(size / nchunks * k, offsets[k-1]);
+        if (pos > 0 && pos < size && data[pos-1] != '\n'){
+            const void * newline = std::memchr(data + pos, '\n', size - pos);
+            pos = (newline == nullptr) ? size : std::size_t(static_cast<const char *>(newline) - data) + 1;
+        }
+        offsets[k] = pos;
+    }
+    return offsets;
+}
+
+/*!
+ * \brief INTERNAL use. Facets parsed from a chunk of an ascii STL file.
+ */
+struct STLChunk{
+    dvecarr3E                   points;     /**< vertices of the facets, three for each facet.*/
+    std::vector<long>           solids;     /**< number of solids opened in the chunk before each facet.*/
+    std::vector<std::string>    names;      /**< names of the solids opened in the chunk.*/
+};
+
+/*!
+ * Return the end of the line starting at a position of a text buffer.
+ * \param[in] p position in the buffer
+ * \param[in] end end of the buffer
+ * \return position of the next newline character, or end
+ */
+const char *
+lineEnd(const char * p, const char * end){
+    const void * newline = std::memchr(p, '\n', std::size_t(end - p));
+    return (newline == nullptr) ? end : static_cast<const char *>(newline);
+}
+
+/*!
+ * Skip blank characters (spaces, tabs and carriage returns) from a position of a line.
+ * \param[in] p position in the line
+ * \param[in] end end of the line
+ * \return position of the first non-blank character, or end
+ */
+const char *
+skipBlanks(const char * p, const char * end){
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+/*!
+ * Return the end of the token starting at a position of a line.
+ * \param[in] p position in the line
+ * \param[in] end end of the line
+ * \return position of the first blank character after p, or end
+ */
+const char *
+tokenEnd(const char * p, const char * end){
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+    return p;
+}
+
+/*!
+ * INTERNAL use. Check if a token is equal to a keyword, ignoring the case.
+ */
+static bool
+isKeyword(const char * begin, const char * end, const char * keyword){
+    std::size_t length = std::strlen(keyword);
+    if (std::size_t(end - begin) != length) return false;
+    for (std::size_t i = 0; i < length; ++i){
+        if (std::tolower(static_cast<unsigned char>(begin[i])) != keyword[i]) return false;
+    }
+    return true;
+}
+
+/*!
+ * Parse a floating point token of a line, skipping the blanks before it, and move
+ * the position after it.
+ *
+ * Decimal numbers with up to 19 significant digits, whose mantissa is exactly
+ * representable and whose exponent is in [-22,22], are converted by a single
+ * floating point multiplication or division, which is correctly rounded. Other
+ * tokens (long mantissas, large exponents, inf, nan, hexadecimal) are converted
+ * by strtod. The result is the same as strtod in any case.
+ * \param[in,out] p position in the line
+ * \param[in] end end of the line
+ * \param[out] value parsed value
+ * \return false if the token is not a valid number; the position is not moved.
+ */
+bool
+parseDouble(const char * & p, const char * end, double & value){
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+                                    1e20, 1e21, 1e22};
+
+    const char * begin = skipBlanks(p, end);
+    const char * last = tokenEnd(begin, end);
+    if (begin == last) return false;
+
+    //fast path
+    const char * q = begin;
+    bool negative = (*q == '-');
+    if (*q == '-' || *q == '+') ++q;
+    uint64_t mantissa = 0;
+    int nsignificant = 0, exponent = 0, ndigits = 0;
+    while (q < last && *q >= '0' && *q <= '9'){
+        if (mantissa > 0 || *q != '0') ++nsignificant;
+        mantissa = 10*mantissa + uint64_t(*q - '0');
+        ++ndigits;
+        ++q;
+    }
+    if (q < last && *q == '.'){
+        ++q;
+        while (q < last && *q >= '0' && *q <= '9'){
+            if (mantissa > 0 || *q != '0') ++nsignificant;
+            mantissa = 10*mantissa + uint64_t(*q - '0');
+            --exponent;
+            ++ndigits;
+            ++q;
+        }
+    }
+    bool valid = (ndigits > 0 && nsignificant <= 19);
+    if (valid && q < last && (*q == 'e' || *q == 'E')){
+        ++q;
+        bool negativeExp = (q < last && *q == '-');
+        if (q < last && (*q == '-' || *q == '+')) ++q;
+        int exp = 0;
+        valid = (q < last);
+        while (q < last && *q >= '0' && *q <= '9' && exp < 10000){
+            exp = 10*exp + (*q - '0');
+            ++q;
+        }
+        exponent += negativeExp ? -exp : exp;
+    }
+    if (valid && q == last && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22){
+        value = double(mantissa);
+        value = (exponent < 0) ? value / powers[-exponent] : value * powers[exponent];
+        if (negative) value = -value;
+        p = last;
+        return true;
+    }
+
+    //general case, the token is copied since the buffer is not null-terminated
+    std::string token(begin, last);
+    char * parsed;
+    double result = std::strtod(token.c_str(), &parsed);
+    if (parsed != token.c_str() + token.size()) return false;
+    value = result;
+    p = last;
+    return true;
+}
+
+/*!
+ * Parse an integer of a line, skipping the blanks before it, and move the position
+ * after its last digit. Unlike parseDouble, the integer can be followed by any
+ * character (e.g. a separator).
+ * \param[in,out] p position in the line
+ * \param[in] end end of the line
+ * \param[out] value parsed value
+ * \return false if no digit is found; the position is not moved.
+ */
+bool
+parseLong(const char * & p, const char * end, long & value){
+    const char * q = skipBlanks(p, end);
+    bool negative = (q < end && *q == '-');
+    if (q < end && (*q == '-' || *q == '+')) ++q;
+    if (q == end || *q < '0' || *q > '9') return false;
+    long result = 0;
+    while (q < end && *q >= '0' && *q <= '9'){
+        result = 10*result + long(*q - '0');
+        ++q;
+    }
+    value = negative ? -result : result;
+    p = q;
+    return true;
+}
+
+/*!
+ * INTERNAL use. Parse a coordinate of a vertex line of an ascii STL file.
+ */
+static double
+parseSTLCoordinate(const char * & p, const char * end){
+    double value;
+    if (!parseDouble(p, end, value)){
+        const char * begin = skipBlanks(p, end);
+        throw std::runtime_error("readSTL : invalid number " + std::string(begin, tokenEnd(begin, end)) + " in ascii STL file");
+    }
+    return value;
+}
+
+/*!
+ * INTERNAL use. Parse the facets of a chunk of an ascii STL file.
+ */
+static void
+parseSTLChunk(const char * begin, const char * end, STLChunk & chunk){
+    std::array<std::array<double,3>,3> facet;
+    int nvertices = 0;
+    long nsolids = 0;
+    const char * p = begin;
+    while (p < end){
+        const char * eol = lineEnd(p, end);
+        const char * token = skipBlanks(p, eol);
+        const char * last = tokenEnd(token, eol);
+        if (isKeyword(token, last, "vertex")){
+            if (nvertices < 3){
+                const char * q = last;
+                for (int i = 0; i < 3; ++i){
+                    facet[nvertices][i] = parseSTLCoordinate(q, eol);
+                }
+                ++nvertices;
+                if (nvertices == 3){
+                    chunk.points.insert(chunk.points.end(), facet.begin(), facet.end());
+                    chunk.solids.push_back(nsolids);
+                }
+            }
+        }
+        else if (isKeyword(token, last, "facet")){
+            nvertices = 0;
+        }
+        else if (isKeyword(token, last, "solid")){
+            ++nsolids;
+            const char * name = skipBlanks(last, eol);
+            const char * nameEnd = eol;
+            while (nameEnd > name && std::isspace(static_cast<unsigned char>(nameEnd[-1]))) --nameEnd;
+            chunk.names.push_back(std::string(name, nameEnd));
+        }
+        p = eol + 1;
+    }
+}
+
+/*!
+ * Read a triangulation from an ascii or binary STL file. The file is memory-mapped;
+ * facets of binary files are decoded concurrently, ascii files are split in chunks
+ * starting at facet or solid boundaries and parsed concurrently, if OpenMP is enabled.
+ *
+ * Vertices are not merged: each facet owns its three vertices (see mergeCoincidentPoints).
+ * Facets of the i-th solid of multi-solid ascii files are marked with PID i; binary
+ * files hold a single solid with PID 0.
+ * \param[in] filename path to the STL file
+ * \param[out] points vertices of the facets, three for each facet
+ * \param[out] pids PID of each facet
+ * \param[out] solidNames names of the solids, for each PID
+ */
+void
+readSTL(const std::string & filename, dvecarr3E & points, livector1D & pids,
+        std::unordered_map<long, std::string> & solidNames){
+
+    points.clear();
+    pids.clear();
+    solidNames.clear();
+
+    MappedFile file(filename);
+    const char * data = file.data();
+    std::size_t size = file.size();
+
+    //ascii files start with the solid keyword; binary files whose header starts with it
+    //are recognized by their size.
+    const char * first = skipBlanks(data, data + size);
+    bool ascii = isKeyword(first, tokenEnd(first, data + size), "solid");
+    if (ascii && size >= 84){
+        uint32_t nfacets;
+        std::memcpy(&nfacets, data + 80, sizeof(uint32_t));
+        ascii = (84 + 50*uint64_t(nfacets) != uint64_t(size));
+    }
+
+    if (!ascii){
+        if (size < 84){
+            throw std::runtime_error("readSTL : invalid binary STL file " + filename);
+        }
+        uint32_t nfacets;
+        std::memcpy(&nfacets, data + 80, sizeof(uint32_t));
+        if (uint64_t(size) < 84 + 50*uint64_t(nfacets)){
+            throw std::runtime_error("readSTL : truncated binary STL file " + filename);
+        }
+        points.resize(3*std::size_t(nfacets));
+        pids.assign(nfacets, 0);
+        solidNames[0] = "";
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long i = 0; i < long(nfacets); ++i){
+            //skip the normal, read the vertices
+            float coords[9];
+            std::memcpy(coords, data + 84 + 50*i + 12, sizeof(coords));
+            for (int j = 0; j < 3; ++j){
+                points[3*i+j] = {{double(coords[3*j]), double(coords[3*j+1]), double(coords[3*j+2])}};
+            }
+        }
+        return;
+    }
+
+    //split in chunks of lines, moving each chunk start to a facet/solid boundary
+    std::vector<std::size_t> offsets = splitLines(data, size, evalChunkCount(size));
+    std::size_t nchunks = offsets.size() - 1;
+    for (std::size_t k = 1; k < nchunks; ++k){
+        std::size_t pos = std::max(offsets[k], offsets[k-1]);
+        while (pos < size){
+            const char * token = skipBlanks(data + pos, data + size);
+            const char * last = tokenEnd(token, data + size);
+            if (isKeyword(token, last, "facet") || isKeyword(token, last, "solid") || isKeyword(token, last, "endsolid")) break;
+            pos = std::size_t(lineEnd(data + pos, data + size) - data) + 1;
+        }
+        offsets[k] = std::min(pos, size);
+    }
+
+    std::vector<STLChunk> chunks(nchunks);
+    std::vector<std::exception_ptr> errors(nchunks);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long k = 0; k < long(nchunks); ++k){
+        try{
+            parseSTLChunk(data + offsets[k], data + offsets[k+1], chunks[k]);
+        }catch(...){
+            errors[k] = std::current_exception();
+        }
+    }
+    for (const std::exception_ptr & error : errors){
+        if (error) std::rethrow_exception(error);
+    }
+
+    //concatenate the chunks in file order. Facets preceding the first solid of a chunk
+    //belong to the last solid opened in the previous chunks.
+    std::vector<std::size_t> facetOffsets(nchunks+1, 0);
+    std::vector<long> solidOffsets(nchunks+1, 0);
+    for (std::size_t k = 0; k < nchunks; ++k){
+        facetOffsets[k+1] = facetOffsets[k] + chunks[k].solids.size();
+        solidOffsets[k+1] = solidOffsets[k] + long(chunks[k].names.size());
+        for (std::size_t j = 0; j < chunks[k].names.size(); ++j){
+            solidNames[solidOffsets[k] + long(j)] = chunks[k].names[j];
+        }
+    }
+    points.resize(3*facetOffsets[nchunks]);
+    pids.resize(facetOffsets[nchunks]);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long k = 0; k < long(nchunks); ++k){
+        std::copy(chunks[k].points.begin(), chunks[k].points.end(), points.begin() + 3*facetOffsets[k]);
+        for (std::size_t i = 0; i < chunks[k].solids.size(); ++i){
+            pids[facetOffsets[k] + i] = std::max(long(0), solidOffsets[k] + chunks[k].solids[i] - 1);
+        }
+        dvecarr3E().swap(chunks[k].points);
+    }
+}
+
+/*!
+ * INTERNAL use. Hash of the integer coordinates of a cell of the spatial grid.
+ */
+static uint64_t
+hashCell(int64_t i, int64_t j, int64_t k){
+    uint64_t h = uint64_t(i)*UINT64_C(0x9E3779B97F4A7C15) ^ uint64_t(j)*UINT64_C(0xC2B2AE3D27D4EB4F) ^ uint64_t(k)*UINT64_C(0x165667B19E3779F9);
+    h ^= h >> 33;
+    h *= UINT64_C(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    h *= UINT64_C(0xc4ceb9fe1a85ec53);
+    h ^= h >> 33;
+    return h;
+}
+
+/*!
+ * Merge the points of a list closer than a tolerance, using a spatial hash.
+ *
+ * Points are hashed on a grid of cells a few times wider than tol and sorted by hash,
+ * bucketing them concurrently on the highest bits of the hash; each bucket indexes its
+ * cells with its own hash table. Each point is then merged, concurrently, with the point
+ * of lowest index within tolerance among those of its cell and of the neighbour cells
+ * closer than tol, if lower than its own. The merges are chained in index order: the
+ * result is the same for any number of threads.
+ * \param[in] points list of points
+ * \param[in] tol merge tolerance
+ * \param[out] map index of each point in the list of the merged points, which are
+ * numbered in order of first occurrence in the input list
+ * \return number of merged points
+ */
+std::size_t
+mergeCoincidentPoints(const dvecarr3E & points, double tol, std::vector<std::size_t> & map){
+
+    std::size_t npoints = points.size();
+    map.assign(npoints, 0);
+    if (npoints == 0) return 0;
+
+    tol = std::max(tol, 0.0);
+    double h = 16.0*std::max(tol, 1.0e-12);
+    double tol2 = tol*tol;
+    auto cellOf = [h](const std::array<double,3> & point){
+        return std::array<int64_t,3>({{int64_t(std::floor(point[0]/h)), int64_t(std::floor(point[1]/h)), int64_t(std::floor(point[2]/h))}});
+    };
+
+    std::vector<uint64_t> keys(npoints);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < long(npoints); ++i){
+        std::array<int64_t,3> cell = cellOf(points[i]);
+        keys[i] = hashCell(cell[0], cell[1], cell[2]);
+    }
+
+    //bucket the points on the highest bits of the hash (stable counting sort on blocks of
+    //consecutive points), then sort each bucket by hash and index: the whole list is sorted.
+    const int nbits = 10;
+    const std::size_t nbuckets = std::size_t(1) << nbits;
+    std::size_t nblocks = 1;
+#if MIMMO_ENABLE_OPENMP
+    nblocks = std::size_t(omp_get_max_threads());
+#endif
+    std::vector<std::size_t> blockOffsets(nblocks+1);
+    for (std::size_t b = 0; b <= nblocks; ++b){
+        blockOffsets[b] = npoints / nblocks * b + std::min(b, npoints % nblocks);
+    }
+    std::vector<std::size_t> counts(nblocks*nbuckets, 0);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for (long b = 0; b < long(nblocks); ++b){
+        for (std::size_t i = blockOffsets[b]; i < blockOffsets[b+1]; ++i){
+            ++counts[b*nbuckets + (keys[i] >> (64 - nbits))];
+        }
+    }
+    std::vector<std::size_t> bucketOffsets(nbuckets+1, 0);
+    std::size_t offset = 0;
+    for (std::size_t bucket = 0; bucket < nbuckets; ++bucket){
+        bucketOffsets[bucket] = offset;
+        for (std::size_t b = 0; b < nblocks; ++b){
+            std::size_t count = counts[b*nbuckets + bucket];
+            counts[b*nbuckets + bucket] = offset;
+            offset += count;
+        }
+    }
+    bucketOffsets[nbuckets] = npoints;
+
+    std::vector<std::pair<uint64_t, std::size_t>> entries(npoints);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for (long b = 0; b < long(nblocks); ++b){
+        for (std::size_t i = blockOffsets[b]; i < blockOffsets[b+1]; ++i){
+            entries[counts[b*nbuckets + (keys[i] >> (64 - nbits))]++] = std::make_pair(keys[i], i);
+        }
+    }
+    std::vector<uint64_t>().swap(keys);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long bucket = 0; bucket < long(nbuckets); ++bucket){
+        std::sort(entries.begin() + bucketOffsets[bucket], entries.begin() + bucketOffsets[bucket+1]);
+    }
+
+    //index the runs of equal hash with a hash table, split in the same buckets of the list
+    const std::size_t empty = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> tableOffsets(nbuckets+1, 0);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long bucket = 0; bucket < long(nbuckets); ++bucket){
+        std::size_t nruns = 0;
+        for (std::size_t p = bucketOffsets[bucket]; p < bucketOffsets[bucket+1]; ++p){
+            if (p == bucketOffsets[bucket] || entries[p].first != entries[p-1].first) ++nruns;
+        }
+        std::size_t tableSize = 0;
+        if (nruns > 0){
+            tableSize = 1;
+            while (tableSize < 2*nruns) tableSize <<= 1;
+        }
+        tableOffsets[bucket+1] = tableSize;
+    }
+    for (std::size_t bucket = 0; bucket < nbuckets; ++bucket){
+        tableOffsets[bucket+1] += tableOffsets[bucket];
+    }
+    std::vector<std::pair<uint64_t, std::size_t>> table(tableOffsets[nbuckets], std::make_pair(uint64_t(0), empty));
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long bucket = 0; bucket < long(nbuckets); ++bucket){
+        std::size_t mask = tableOffsets[bucket+1] - tableOffsets[bucket] - 1;
+        for (std::size_t p = bucketOffsets[bucket]; p < bucketOffsets[bucket+1]; ++p){
+            if (p != bucketOffsets[bucket] && entries[p].first == entries[p-1].first) continue;
+            std::size_t slot = entries[p].first & mask;
+            while (table[tableOffsets[bucket] + slot].second != empty) slot = (slot + 1) & mask;
+            table[tableOffsets[bucket] + slot] = std::make_pair(entries[p].first, p);
+        }
+    }
+    auto findRun = [&](uint64_t key){
+        std::size_t bucket = std::size_t(key >> (64 - nbits));
+        std::size_t tableSize = tableOffsets[bucket+1] - tableOffsets[bucket];
+        if (tableSize == 0) return empty;
+        std::size_t mask = tableSize - 1;
+        std::size_t slot = key & mask;
+        while (table[tableOffsets[bucket] + slot].second != empty){
+            if (table[tableOffsets[bucket] + slot].first == key) return table[tableOffsets[bucket] + slot].second;
+            slot = (slot + 1) & mask;
+        }
+        return empty;
+    };
+
+    //lowest index point within tolerance of each point. Cells are wider than the tolerance:
+    //only the neighbour cells closer than the tolerance (with a safety margin) are visited.
+    std::vector<std::size_t> target(npoints);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < long(npoints); ++i){
+        const std::array<double,3> & point = points[i];
+        std::array<int64_t,3> cell = cellOf(point);
+        std::array<int64_t,3> lower, upper;
+        for (int k = 0; k < 3; ++k){
+            lower[k] = (point[k] - double(cell[k])*h <= 2.0*tol) ? -1 : 0;
+            upper[k] = (double(cell[k]+1)*h - point[k] <= 2.0*tol) ? 1 : 0;
+        }
+        std::size_t best = std::size_t(i);
+        for (int64_t di = lower[0]; di <= upper[0]; ++di){
+            for (int64_t dj = lower[1]; dj <= upper[1]; ++dj){
+                for (int64_t dk = lower[2]; dk <= upper[2]; ++dk){
+                    uint64_t key = hashCell(cell[0]+di, cell[1]+dj, cell[2]+dk);
+                    std::size_t p = findRun(key);
+                    if (p == empty) continue;
+                    for (; p < npoints && entries[p].first == key && entries[p].second < best; ++p){
+                        const std::array<double,3> & other = points[entries[p].second];
+                        double dx = other[0] - point[0];
+                        double dy = other[1] - point[1];
+                        double dz = other[2] - point[2];
+                        if (dx*dx + dy*dy + dz*dz <= tol2){
+                            best = entries[p].second;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        target[i] = best;
+    }
+
+    //chain the merges in index order
+    std::size_t nmerged = 0;
+    for (std::size_t i = 0; i < npoints; ++i){
+        map[i] = (target[i] == i) ? nmerged++ : map[target[i]];
+    }
+    return nmerged;
+}
+
+}; //end namespace parallelIOUtils
+
+} //end namespace mimmo
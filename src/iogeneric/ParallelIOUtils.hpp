@@ -0,0 +1,87 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+# ifndef __PARALLELIOUTILS_HPP__
+# define __PARALLELIOUTILS_HPP__
+
+# include "mimmoTypeDef.hpp"
+# include <string>
+# include <unordered_map>
+
+namespace mimmo{
+
+/*!
+ * \brief Utilities for the multithreaded import of geometry files.
+ * \ingroup iogeneric
+ *
+ * Files are memory-mapped and split in chunks of whole lines (or records), which
+ * are parsed concurrently if OpenMP is enabled. Chunk results are concatenated in
+ * file order, so that the output does not depend on the number of threads.
+ */
+namespace parallelIOUtils{
+
+/*!
+ * \class MappedFile
+ * \ingroup iogeneric
+ * \brief Read-only memory mapping of a file.
+ *
+ * If the file cannot be mapped, or on systems without POSIX mmap (Windows), it is read
+ * in a memory buffer.
+ */
+class MappedFile{
+
+public:
+    MappedFile(const std::string & filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    const char *    data() const;
+    std::size_t     size() const;
+
+private:
+    const char *        m_data;     /**< start of the file contents.*/
+    std::size_t         m_size;     /**< size of the file in bytes.*/
+    bool                m_mapped;   /**< true if the contents are memory-mapped.*/
+    std::vector<char>   m_buffer;   /**< contents of the file, if not memory-mapped.*/
+};
+
+    std::size_t                 evalChunkCount(std::size_t size);
+    std::vector<std::size_t>    splitLines(const char * data, std::size_t size, std::size_t nchunks);
+
+    const char *    lineEnd(const char * p, const char * end);
+    const char *    skipBlanks(const char * p, const char * end);
+    const char *    tokenEnd(const char * p, const char * end);
+    bool            parseDouble(const char * & p, const char * end, double & value);
+    bool            parseLong(const char * & p, const char * end, long & value);
+
+    void        readSTL(const std::string & filename, dvecarr3E & points, livector1D & pids,
+                        std::unordered_map<long, std::string> & solidNames);
+    std::size_t mergeCoincidentPoints(const dvecarr3E & points, double tol, std::vector<std::size_t> & map);
+
+}; //end namespace parallelIOUtils
+
+} //end namespace mimmo
+
+#endif
@@ -115,6 +115,7 @@ void IOOFOAM_Kernel::swap(IOOFOAM_Kernel & x) noexcept
  */
 void
 IOOFOAM_Kernel::setDefaults(){
+	setDirty();
 
 	m_path   = ".";
     m_fieldname = "";
@@ -158,6 +159,7 @@ IOOFOAM_Kernel::getBoundaryGeometry(){
  */
 void
 IOOFOAM_Kernel::setDir(const std::string &dir){
+	setDirty();
 	m_path = dir;
 }
 
@@ -170,6 +172,7 @@ IOOFOAM_Kernel::setDir(const std::string &dir){
  */
 void
 IOOFOAM_Kernel::setGeometry(MimmoSharedPointer<MimmoObject> bulk){
+    setDirty();
     if(!bulk) return;
     if(bulk->getInterfacesSyncStatus() != SyncStatus::SYNC) {
         *(m_log)<<"Warning IOOFOAM_Kernel:: linked MimmoObject bulk mesh can be not coherent with an OpenFoam mesh"<<std::endl;
@@ -188,6 +191,7 @@ IOOFOAM_Kernel::setGeometry(MimmoSharedPointer<MimmoObject> bulk){
  */
 void
 IOOFOAM_Kernel::setBoundaryGeometry(MimmoSharedPointer<MimmoObject> boundary){
+    setDirty();
     if(!boundary) return;
     if (boundary->getType() != 1 && boundary->getType() != 4){
         *(m_log)<<"Warning IOOFOAM_Kernel:: linked MimmoObject boundary mesh can be only surface or 3D-curve mesh. Continue without boundary geometry."<<std::endl;
@@ -202,6 +206,7 @@ IOOFOAM_Kernel::setBoundaryGeometry(MimmoSharedPointer<MimmoObject> boundary){
  */
 void
 IOOFOAM_Kernel::setFacesMap(std::unordered_map<long,long> mapFaces){
+    setDirty();
     m_OFbitpitmapfaces = mapFaces;
 }
 
@@ -211,6 +216,7 @@ IOOFOAM_Kernel::setFacesMap(std::unordered_map<long,long> mapFaces){
  */
 void
 IOOFOAM_Kernel::setFieldName(const std::string & fieldname){
+	setDirty();
 	m_fieldname = fieldname;
 }
 
@@ -406,6 +412,7 @@ void IOOFOAM::swap(IOOFOAM & x) noexcept
  */
 void
 IOOFOAM::setDefaults(){
+	setDirty();
 	m_overwrite = false;
     m_writepointsonly = true;
     IOOFOAM_Kernel::setDefaults();
@@ -448,6 +455,7 @@ IOOFOAM::buildPorts(){
  */
 void
 IOOFOAM::setWritePointsOnly(bool flag){
+	setDirty();
 	//m_writepointsonly = flag;
     m_writepointsonly = true; //TODO set to flag once write() is coded
 }
@@ -469,6 +477,7 @@ IOOFOAM::getWritePointsOnly(){
  */
 void
 IOOFOAM::setOverwrite(bool flag){
+	setDirty();
 	m_overwrite = flag;
 }
 
@@ -126,6 +126,7 @@ Apply::buildPorts(){
  */
 void
 Apply::setInput(dmpvecarr3E *input){
+    setDirty();
     if(!input)  return;
 	m_input = *input;
 };
@@ -136,6 +137,7 @@ Apply::setInput(dmpvecarr3E *input){
  */
 void
 Apply::setScalarInput(dmpvector1D *input){
+    setDirty();
     if(!input) return;
     m_scalarinput = *input;
 };
@@ -146,6 +148,7 @@ Apply::setScalarInput(dmpvector1D *input){
  */
 void
 Apply::setFilter(dmpvector1D *input){
+    setDirty();
     if(!input) return;
     m_filter = *input;
 };
@@ -156,6 +159,7 @@ Apply::setFilter(dmpvector1D *input){
  */
 void
 Apply::setScaling(double alpha){
+	setDirty();
 	m_factor = alpha;
 };
 
@@ -167,6 +171,7 @@ Apply::setScaling(double alpha){
  */
 void
 Apply::setAnnotation(bool activate){
+    setDirty();
     m_annotation = activate;
 }
 
@@ -177,6 +182,7 @@ Apply::setAnnotation(bool activate){
  */
 void
 Apply::setAnnotationThreshold(double threshold){
+    setDirty();
     m_annotationThres = std::max(1.0E-18, threshold);
 }
 
@@ -187,6 +193,7 @@ Apply::setAnnotationThreshold(double threshold){
  */
 void
 Apply::setCellsAnnotationName(const std::string & label){
+    setDirty();
     if(label.empty()){
         m_annCellLabel = "DeformedCells";
     }else{
@@ -201,6 +208,7 @@ Apply::setCellsAnnotationName(const std::string & label){
  */
 void
 Apply::setVerticesAnnotationName(const std::string & label){
+    setDirty();
     if(label.empty()){
         m_annVertexLabel = "DeformedVertices";
     }else{
@@ -236,6 +244,14 @@ MimmoPiercedVector<long> * Apply::getAnnotatedCells(){
     return &m_cellAnnotation;
 }
 
+/*!
+ * \return true, Apply always modifies in place its linked geometry.
+ */
+bool
+Apply::isModifyingGeometry(){
+    return true;
+}
+
 /*!Execution command.
  * It applies the deformation stored in the input of base class (casting the input
  * for apply object to dvecarr3E) to the linked geometry.
@@ -252,16 +268,18 @@ Apply::execute(){
 
 	m_output = m_input;
 
-	darray3E vertexcoords;
-	long int ID;
-	for (const auto & vertex : m_geometry->getVertices()){
-		vertexcoords = vertex.getCoords();
-		ID = vertex.getId();
+	//displace a copy of the contiguous coordinates view and write it back in one pass.
+	const VertexCoordsSoA & coords = getGeometry()->getVerticesCoordsSoA();
+	dvector1D x(coords.x), y(coords.y), z(coords.z);
+	for (std::size_t i = 0; i < coords.size(); ++i){
+		long int ID = coords.ids[i];
 		std::array<double,3> val = m_factor*m_input[ID];
 		m_output[ID] = val;
-		vertexcoords += val;
-		getGeometry()->modifyVertex(vertexcoords, ID);
+		x[i] += val[0];
+		y[i] += val[1];
+		z[i] += val[2];
 	}
+	getGeometry()->modifyVerticesCoords(std::move(x), std::move(y), std::move(z));
 
     //step 2: produce annotations.
     if(m_annotation){
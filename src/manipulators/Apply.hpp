@@ -116,6 +116,8 @@ public:
     MimmoPiercedVector<long> * getAnnotatedVertices();
     MimmoPiercedVector<long> * getAnnotatedCells();
 
+    bool    isModifyingGeometry();
+
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name="");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name="");
 
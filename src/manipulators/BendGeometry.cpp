@@ -165,6 +165,7 @@ BendGeometry::getDisplacements(){
  */
 void
 BendGeometry::setDegree(umatrix33E degree){
+    setDirty();
     for(int i=0; i<3; ++i){
         for(int j=0; j<3; ++j){
             setDegree(i,j, degree[i][j]);
@@ -180,6 +181,7 @@ BendGeometry::setDegree(umatrix33E degree){
  */
 void
 BendGeometry::setDegree(int i, int j, uint32_t degree){
+    setDirty();
     m_degree[i][j] = degree;
     m_coeffs[i][j].resize(degree+1, 0.0);
 };
@@ -192,6 +194,7 @@ BendGeometry::setDegree(int i, int j, uint32_t degree){
  */
 void
 BendGeometry::setCoeffs(dmat33Evec * coeffs){
+    setDirty();
     if(!coeffs) return;
     m_coeffs = *coeffs;
 };
@@ -204,6 +207,7 @@ BendGeometry::setCoeffs(dmat33Evec * coeffs){
  */
 void
 BendGeometry::setCoeffs(int i, int j, dvector1D coeffs){
+    setDirty();
     m_coeffs[i][j] = coeffs;
 };
 
@@ -213,6 +217,7 @@ It sets the origin of the local reference system.
  */
 void
 BendGeometry::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
     m_local = true;
 }
@@ -223,6 +228,7 @@ BendGeometry::setOrigin(darray3E origin){
  */
 void
 BendGeometry::setRefSystem(dmatrix33E axes){
+    setDirty();
     m_system[0] = axes[0];
     m_system[1] = axes[1];
     m_system[2] = axes[2];
@@ -235,6 +241,7 @@ BendGeometry::setRefSystem(dmatrix33E axes){
  */
 void
 BendGeometry::setFilter(dmpvector1D * filter){
+    setDirty();
     m_filter = *filter;
 }
 
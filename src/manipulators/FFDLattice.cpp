@@ -34,6 +34,10 @@ FFDLattice::FFDLattice(){
     m_mapNodes.resize(3);
     m_globalDispl = false;
     m_bfilter = false;
+    m_basisCache = false;
+    m_cacheValid = false;
+    m_cacheRevision = 0;
+    m_cacheRowSize = 0;
     m_name = "mimmo.FFDlattice";
 };
 
@@ -49,6 +53,10 @@ FFDLattice::FFDLattice(const bitpit::Config::Section & rootXML){
     m_mapNodes.resize(3);
     m_globalDispl = false;
     m_bfilter = false;
+    m_basisCache = false;
+    m_cacheValid = false;
+    m_cacheRevision = 0;
+    m_cacheRowSize = 0;
     m_name = "mimmo.FFDlattice";
 
     std::string fallback_name = "ClassNONE";
@@ -79,6 +87,10 @@ FFDLattice::FFDLattice(const FFDLattice & other):Lattice(other){
     m_bfilter = other.m_bfilter;
     m_filter = other.m_filter;
     m_collect_wg = other.m_collect_wg;
+    m_basisCache = other.m_basisCache;
+    m_cacheValid = false;
+    m_cacheRevision = 0;
+    m_cacheRowSize = 0;
 };
 
 
@@ -107,6 +119,14 @@ void FFDLattice::swap(FFDLattice & x) noexcept
    std::swap(m_bfilter, x.m_bfilter);
    m_filter.swap(x.m_filter);
    std::swap(m_collect_wg, x.m_collect_wg);
+   std::swap(m_basisCache, x.m_basisCache);
+   std::swap(m_cacheValid, x.m_cacheValid);
+   std::swap(m_cacheRevision, x.m_cacheRevision);
+   std::swap(m_cacheList, x.m_cacheList);
+   std::swap(m_cachePoints, x.m_cachePoints);
+   std::swap(m_cacheRowSize, x.m_cacheRowSize);
+   std::swap(m_cacheNodes, x.m_cacheNodes);
+   std::swap(m_cacheCoeffs, x.m_cacheCoeffs);
    m_gdispl.swap(x.m_gdispl);
    Lattice::swap(x);
 }
@@ -142,6 +162,7 @@ FFDLattice::clearLattice(){
     Lattice::clearLattice();
     clearKnots(); //clear all knots stuff;
     clearFilter();
+    clearBasisCache();
     m_displ.clear();
 
 };
@@ -263,6 +284,13 @@ FFDLattice::getDeformation(){
 bool
 FFDLattice::isDisplGlobal(){return(m_globalDispl);}
 
+/*! Check if the cache of the NURBS basis coefficients of geometry vertices is enabled.
+   See setBasisCache method
+ * \return basis cache flag
+ */
+bool
+FFDLattice::isBasisCacheEnabled(){return(m_basisCache);}
+
 
 /*! Set the degree of nurbs curve in each direction. If the number of control nodes are
  * not initialized, they are set to the minimum number admissible.
@@ -271,6 +299,7 @@ FFDLattice::isDisplGlobal(){return(m_globalDispl);}
  */
 void
 FFDLattice::setDegrees(iarray3E degrees){
+    setDirty();
     m_deg = degrees;
     m_isBuild = false;
 };
@@ -283,6 +312,7 @@ FFDLattice::setDegrees(iarray3E degrees){
 void
 FFDLattice::setDisplacements(dvecarr3E displacements){
     m_displ = displacements;
+    setDirty();
 };
 
 /*! Set if displacements are meant as global-true or local-false.
@@ -295,7 +325,33 @@ FFDLattice::setDisplacements(dvecarr3E displacements){
  *
  */
 void
-FFDLattice::setDisplGlobal(bool flag){m_globalDispl = flag;}
+FFDLattice::setDisplGlobal(bool flag){setDirty(); m_globalDispl = flag;}
+
+/*! Enable/disable the cache of the NURBS basis coefficients of the geometry vertices.
+    Useful when the same geometry is deformed repeatedly by the same lattice changing
+    only the control nodes displacements. Disabling the cache releases its memory.
+ * \param[in]  enable true to enable the cache
+ */
+void
+FFDLattice::setBasisCache(bool enable){
+    setDirty();
+    m_basisCache = enable;
+    if(!enable) clearBasisCache();
+}
+
+/*! Release the cache of the NURBS basis coefficients. The cache will be filled again
+    at the next execution, if enabled.
+ */
+void
+FFDLattice::clearBasisCache(){
+    m_cacheValid = false;
+    m_cacheRevision = 0;
+    m_cacheRowSize = 0;
+    livector1D().swap(m_cacheList);
+    dvecarr3E().swap(m_cachePoints);
+    ivector1D().swap(m_cacheNodes);
+    dvector1D().swap(m_cacheCoeffs);
+}
 
 
 /*! Set lattice mesh, dimensions and curve degree for Nurbs trivariate parameterization.
@@ -314,6 +370,7 @@ FFDLattice::setDisplGlobal(bool flag){m_globalDispl = flag;}
  */
 void
 FFDLattice::setLattice(darray3E &origin,darray3E & span, ShapeType type, iarray3E & dimensions, iarray3E & degrees){
+    setDirty();
 
     if(m_shape){m_shape.reset(nullptr);}
 
@@ -340,6 +397,7 @@ FFDLattice::setLattice(darray3E &origin,darray3E & span, ShapeType type, iarray3
  */
 void
 FFDLattice::setLattice(darray3E &origin,darray3E & span, ShapeType type, dvector1D & spacing, iarray3E & degrees ){
+    setDirty();
 
     ivector1D dimLimit(3,2);
     //create internal shape using unique_ptr member.
@@ -389,6 +447,7 @@ FFDLattice::setLattice(darray3E &origin,darray3E & span, ShapeType type, dvector
  */
 void
 FFDLattice::setLattice(BasicShape * shape, iarray3E & dimensions, iarray3E & degrees){
+    setDirty();
 
     setShape(shape);
     setDimension(dimensions);
@@ -410,6 +469,7 @@ FFDLattice::setLattice(BasicShape * shape, iarray3E & dimensions, iarray3E & deg
  */
 void
 FFDLattice::setLattice(BasicShape * shape, dvector1D & spacing, iarray3E & degrees){
+    setDirty();
 
     ivector1D dimLimit(3,2);
     //create internal shape using unique_ptr member.
@@ -451,6 +511,7 @@ FFDLattice::setLattice(BasicShape * shape, dvector1D & spacing, iarray3E & degre
  */
 void
 FFDLattice::setNodalWeight(double val, int index){
+    setDirty();
     int ind = accessDOFFromGrid(index);
     m_collect_wg[ind] =  val;
     m_isBuild = false;
@@ -464,6 +525,7 @@ FFDLattice::setNodalWeight(double val, int index){
  */
 void
 FFDLattice::setNodalWeight(double val, int i, int j, int k){
+    setDirty();
     int index = accessPointIndex(i,j,k);
     setNodalWeight(val, index);
 };
@@ -473,6 +535,7 @@ FFDLattice::setNodalWeight(double val, int i, int j, int k){
  */
 void
 FFDLattice::setNodalWeight(dvector1D wg){
+    setDirty();
     int counter = 0;
     for(auto & val : wg){
         setNodalWeight(val, counter);
@@ -487,6 +550,7 @@ FFDLattice::setNodalWeight(dvector1D wg){
  */
 void
 FFDLattice::setFilter(dmpvector1D *filter){
+    setDirty();
     if(!filter) return;
     m_filter.clear();
     m_bfilter = !(filter->empty());
@@ -655,11 +719,28 @@ FFDLattice::apply(livector1D & list){
     if(!isBuilt()) return dvecarr3E(0);
 
 
-    //check simplex included and extract their vertex in global IDs;
-    if(container->isSkdTreeSupported()) list= container->getVertexFromCellList(getShape()->includeGeometry(container));
-    else                               list= getShape()->includeCloudPoints(container);
-    //return deformation
-    dvecarr3E result = nurbsEvaluator(list);
+    dvecarr3E result;
+    //invalidate the basis cache if the vertices of the geometry have been modified
+    //since it was filled or if it is a different one (revisions are unique among geometries).
+    if(m_cacheValid && m_cacheRevision != container->getVerticesRevision()){
+        clearBasisCache();
+    }
+    if(m_basisCache && m_cacheValid){
+        //vertices and basis coefficients already available
+        list = m_cacheList;
+        result = evalBasisCache();
+    }else{
+        //check simplex included and extract their vertex in global IDs;
+        if(container->isSkdTreeSupported()) list= container->getVertexFromCellList(getShape()->includeGeometry(container));
+        else                               list= getShape()->includeCloudPoints(container);
+        //return deformation
+        if(m_basisCache){
+            fillBasisCache(list);
+            result = evalBasisCache();
+        }else{
+            result = nurbsEvaluator(list);
+        }
+    }
     if(m_bfilter){
 
         checkFilter();
@@ -690,9 +771,13 @@ FFDLattice::apply(dvecarr3E * point){
     result.resize(point->size(), darray3E{{0,0,0}});
     livector1D list = getShape()->includeCloudPoints(*point);
 
-    for(const auto & index : list){
-        darray3E target = (*point)[index];
-        result[index] = nurbsEvaluator(target);
+    long lsize = list.size();
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(long i=0; i<lsize; ++i){
+        darray3E target = (*point)[list[i]];
+        result[list[i]] = nurbsEvaluator(target);
     }
 
     return(result);
@@ -849,139 +934,331 @@ FFDLattice::nurbsEvaluator(darray3E & pointOr){
 /*! Return displacement of a list of points,
  * under the deformation effect of the whole Lattice.
  *
+ * Points are evaluated in batch: local coordinates and knot intervals are computed
+ * first, then points are bucketed by knot span so that points sharing the same
+ * control nodes are evaluated together. Control nodes weights and displacements
+ * are stored in a contiguous SoA layout following the knots theoretical indexing,
+ * so that the innermost loop of the evaluation walks contiguous memory.
+ * Basis functions are evaluated on per-thread buffers, without heap allocations
+ * per point. If OpenMP is enabled points are evaluated concurrently;
+ * results do not depend on the number of threads.
+ *
  * \param[in] list 3D points
  * \return points displacements
  */
 dvecarr3E
 FFDLattice::nurbsEvaluator(livector1D & list){
 
-    bitpit::PatchKernel * tri = getGeometry()->getPatch();
-    long int id;
-    int lsize = list.size();
-    livector1D::iterator it, itend = list.end();
-    darray3E target, point;
-    ivector1D knotInterval(3,0);
-    dvector1D BSbasisi0, BSbasisi1, BSbasisi2;
-    dvector1D valH(4,0), temp1(4,0),temp2(4,0);
-
-    dvecarr3E displ = recoverFullGridDispl();
-    dvector1D weig = recoverFullNodeWeights();
-
-    int uind, vind, wind, index;
-
-    int intv, i, j, k;
+    long lsize = list.size();
+    dvecarr3E outres(lsize);
+    if(lsize == 0) return(outres);
 
     int i0 = m_mapdeg[0];
     int i1 = m_mapdeg[1];
     int i2 = m_mapdeg[2];
-    iarray3E mappedIndex;
 
     int md0 = m_deg[i0];
     int md1 = m_deg[i1];
     int md2 = m_deg[i2];
 
-    dvecarr3E outres(lsize);
-    dvecarr3E::iterator itout = outres.begin();
     darray3E scaling = getShape()->getScaling();
-
-    double bbasisw2;
-    double bbasis1, bbasis0;
-
-    for(it = list.begin(); it != itend; ++it){
-
-        for(intv=0; intv<4; ++intv){
-            valH[intv] = 0.0;
+    bool displGlobal = isDisplGlobal();
+
+    //control nodes in SoA layout (weight, displacements x,y,z), indexed by
+    //knots theoretical indices in the evaluation loop order (i0 slowest, i2 fastest).
+    int n0 = m_mapNodes[i0].size();
+    int n1 = m_mapNodes[i1].size();
+    int n2 = m_mapNodes[i2].size();
+    long ctrlSize = long(n0)*n1*n2;
+    std::vector<double> ctrl(4*ctrlSize);
+    {
+        dvecarr3E displ = recoverFullGridDispl();
+        dvector1D weig = recoverFullNodeWeights();
+        iarray3E mappedIndex;
+        long pos = 0;
+        for(int i=0; i<n0; ++i){
+            mappedIndex[i0] = i;
+            for(int j=0; j<n1; ++j){
+                mappedIndex[i1] = j;
+                for(int k=0; k<n2; ++k){
+                    mappedIndex[i2] = k;
+                    int index = accessMapNodes(mappedIndex[0], mappedIndex[1], mappedIndex[2]);
+                    ctrl[pos] = weig[index];
+                    for(int intv=0; intv<3; ++intv){
+                        ctrl[(intv+1)*ctrlSize + pos] = displ[index][intv];
+                    }
+                    ++pos;
+                }
+            }
         }
-        id  = *it;
-        target = tri->getVertex(id).getCoords();
-        point = transfToLocal(target);
+    }
 
-        // get reference Interval int the knot matrix
-        for(i=0; i<3; i++){
-            knotInterval[i] = getKnotInterval(point[i],i);
+    //local coordinates and knot intervals of each point, read from the contiguous
+    //coordinates view of the geometry.
+    const VertexCoordsSoA & coords = getGeometry()->getVerticesCoordsSoA();
+    std::vector<std::size_t> coordsIndex(lsize);
+    dvecarr3E localPoints(lsize);
+    std::vector<iarray3E> knotIntervals(lsize);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(long p=0; p<lsize; ++p){
+        std::size_t index = coords.indices.at(list[p]);
+        coordsIndex[p] = index;
+        darray3E target = {{coords.x[index], coords.y[index], coords.z[index]}};
+        localPoints[p] = transfToLocal(target);
+        for(int i=0; i<3; ++i){
+            knotIntervals[p][i] = getKnotInterval(localPoints[p][i], i);
         }
-        BSbasisi0 = basisITS0(knotInterval[i0], i0, point[i0]);
-        BSbasisi1 = basisITS0(knotInterval[i1], i1, point[i1]);
-        BSbasisi2 = basisITS0(knotInterval[i2], i2, point[i2]);
+    }
+
+    //bucket the points by knot span (counting sort on the span key).
+    std::array<long,3> nspans;
+    for(int i=0; i<3; ++i){
+        nspans[i] = m_mapEff[i].size() + 1;
+    }
+    std::vector<long> spanKey(lsize);
+    std::vector<long> bucketOffsets(nspans[0]*nspans[1]*nspans[2]+1, 0);
+    for(long p=0; p<lsize; ++p){
+        spanKey[p] = (knotIntervals[p][i0]*nspans[i1] + knotIntervals[p][i1])*nspans[i2] + knotIntervals[p][i2];
+        ++bucketOffsets[spanKey[p]+1];
+    }
+    for(std::size_t b=1; b<bucketOffsets.size(); ++b){
+        bucketOffsets[b] += bucketOffsets[b-1];
+    }
+    std::vector<long> order(lsize);
+    for(long p=0; p<lsize; ++p){
+        order[bucketOffsets[spanKey[p]]++] = p;
+    }
+    std::vector<long>().swap(spanKey);
+    std::vector<long>().swap(bucketOffsets);
 
-        uind = knotInterval[i0] - md0;
-        vind = knotInterval[i1] - md1;
-        wind = knotInterval[i2] - md2;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel
+#endif
+    {
+        //per-thread buffers for basis functions evaluation.
+        dvector1D BSbasisi0(md0+1), BSbasisi1(md1+1), BSbasisi2(md2+1);
+        dvector1D work(2*(std::max(md0, std::max(md1, md2))+1));
+        double valH[4], temp1[4], temp2[4];
 
+#if MIMMO_ENABLE_OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(long q=0; q<lsize; ++q){
 
-        for(i=0; i<=md0; ++i){
+            long p = order[q];
+            darray3E point = localPoints[p];
+            const iarray3E & knotInterval = knotIntervals[p];
 
-            mappedIndex[i0] = uind + i;
+            basisITS0(knotInterval[i0], i0, point[i0], BSbasisi0.data(), work.data());
+            basisITS0(knotInterval[i1], i1, point[i1], BSbasisi1.data(), work.data());
+            basisITS0(knotInterval[i2], i2, point[i2], BSbasisi2.data(), work.data());
+
+            int uind = knotInterval[i0] - md0;
+            int vind = knotInterval[i1] - md1;
+            int wind = knotInterval[i2] - md2;
 
             for(int intv=0; intv<4; ++intv){
-                temp1[intv] = 0.0;
+                valH[intv] = 0.0;
             }
 
-            for(j=0; j<=md1; ++j){
-
-                mappedIndex[i1] = vind + j;
+            for(int i=0; i<=md0; ++i){
 
-                for(intv=0; intv<4; ++intv){
-                    temp2[intv] = 0.0;
+                for(int intv=0; intv<4; ++intv){
+                    temp1[intv] = 0.0;
                 }
 
-                for(k=0; k<=md2; ++k){
+                for(int j=0; j<=md1; ++j){
 
-                    mappedIndex[i2] = wind + k;
+                    for(int intv=0; intv<4; ++intv){
+                        temp2[intv] = 0.0;
+                    }
 
-                    index = accessMapNodes(mappedIndex[0], mappedIndex[1], mappedIndex[2]);
+                    long pos = (long(uind + i)*n1 + (vind + j))*n2 + wind;
+                    const double * w  = ctrl.data() + pos;
+                    const double * dx = w + ctrlSize;
+                    const double * dy = dx + ctrlSize;
+                    const double * dz = dy + ctrlSize;
+
+                    for(int k=0; k<=md2; ++k){
+                        double bbasisw2 = BSbasisi2[k]* w[k];
+                        temp2[0] += bbasisw2 * dx[k];
+                        temp2[1] += bbasisw2 * dy[k];
+                        temp2[2] += bbasisw2 * dz[k];
+                        temp2[3] += bbasisw2;
+                    }
+                    double bbasis1 = BSbasisi1[j];
+                    for(int intv=0; intv<4; ++intv){
+                        temp1[intv] += bbasis1*temp2[intv];
+                    }
 
-                    bbasisw2 = BSbasisi2[k]* weig[index];
+                }
+                double bbasis0 = BSbasisi0[i];
+                for(int intv=0; intv<4; ++intv){
+                    valH[intv] += bbasis0*temp1[intv];
+                }
+            }
 
-                    for(intv=0; intv<3; ++intv){
-                        temp2[intv] += bbasisw2 * displ[index][intv];
-                    }
-                    temp2[3] += bbasisw2;
+            if(displGlobal){
 
+                for(int i=0; i<3; ++i){
+                    outres[p][i] = valH[i]/valH[3];
                 }
-                bbasis1 = BSbasisi1[j];
-                for(intv=0; intv<4; ++intv){
-                    temp1[intv] += bbasis1*temp2[intv];
+
+            }else{
+
+                //adding to local point displ rescaled
+                for(int i=0; i<3; ++i){
+                    point[i]+= valH[i]/(valH[3]*scaling[i]);
                 }
 
+                //get absolute displ as difference of
+                std::size_t index = coordsIndex[p];
+                darray3E target = {{coords.x[index], coords.y[index], coords.z[index]}};
+                outres[p] = transfToGlobal(point) - target;
+
             }
-            bbasis0 = BSbasisi0[i];
-            for(intv=0; intv<4; ++intv){
-                valH[intv] += bbasis0*temp1[intv];
-            }
-        }
 
+        }//next point
+    }
 
-        if(isDisplGlobal()){
+    return(outres);
 
-            //adding to local point displ rescaled
-            for(i=0; i<3; ++i){
-                (*itout)[i] = valH[i]/valH[3];
-            }
+};
 
-        }else{
+/*! Fill the cache of the NURBS basis coefficients for a list of geometry vertices.
+ * For each vertex the local coordinates and the rational basis coefficients
+ * B_i*B_j*B_k*w_n / sum(B_i*B_j*B_k*w_n) of the (deg0+1)*(deg1+1)*(deg2+1) control
+ * nodes n influencing it are stored, so that its displacement is the weighted sum of
+ * the control nodes displacements.
+ * \param[in] list ids of the geometry vertices included in the lattice
+ */
+void
+FFDLattice::fillBasisCache(livector1D & list){
 
-            //adding to local point displ rescaled
-            for(i=0; i<3; ++i){
-                point[i]+= valH[i]/(valH[3]*scaling[i]);
-            }
+    clearBasisCache();
 
-            //get absolute displ as difference of
-            for(i=0; i<3; ++i){
-                (*itout)[i] = transfToGlobal(point)[i] - target[i];
-            }
+    MimmoSharedPointer<MimmoObject> container = getGeometry();
+    bitpit::PatchKernel * tri = container->getPatch();
+    long lsize = list.size();
+
+    int i0 = m_mapdeg[0];
+    int i1 = m_mapdeg[1];
+    int i2 = m_mapdeg[2];
+
+    int md0 = m_deg[i0];
+    int md1 = m_deg[i1];
+    int md2 = m_deg[i2];
+
+    dvector1D weig = recoverFullNodeWeights();
+
+    m_cacheRowSize = (md0+1)*(md1+1)*(md2+1);
+    m_cacheList = list;
+    m_cachePoints.resize(lsize);
+    m_cacheNodes.resize(lsize*m_cacheRowSize);
+    m_cacheCoeffs.resize(lsize*m_cacheRowSize);
+
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel
+#endif
+    {
+        //per-thread buffers for basis functions evaluation.
+        dvector1D BSbasisi0(md0+1), BSbasisi1(md1+1), BSbasisi2(md2+1);
+        dvector1D work(2*(std::max(md0, std::max(md1, md2))+1));
+        iarray3E knotInterval, mappedIndex;
 
+#if MIMMO_ENABLE_OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(long p=0; p<lsize; ++p){
+
+            darray3E target = tri->getVertex(list[p]).getCoords();
+            darray3E point = transfToLocal(target);
+            m_cachePoints[p] = point;
+
+            for(int i=0; i<3; ++i){
+                knotInterval[i] = getKnotInterval(point[i],i);
+            }
+            basisITS0(knotInterval[i0], i0, point[i0], BSbasisi0.data(), work.data());
+            basisITS0(knotInterval[i1], i1, point[i1], BSbasisi1.data(), work.data());
+            basisITS0(knotInterval[i2], i2, point[i2], BSbasisi2.data(), work.data());
+
+            int uind = knotInterval[i0] - md0;
+            int vind = knotInterval[i1] - md1;
+            int wind = knotInterval[i2] - md2;
+
+            int    * nodes  = m_cacheNodes.data() + p*m_cacheRowSize;
+            double * coeffs = m_cacheCoeffs.data() + p*m_cacheRowSize;
+            double sum = 0.0;
+            int pos = 0;
+            for(int i=0; i<=md0; ++i){
+                mappedIndex[i0] = uind + i;
+                for(int j=0; j<=md1; ++j){
+                    mappedIndex[i1] = vind + j;
+                    for(int k=0; k<=md2; ++k){
+                        mappedIndex[i2] = wind + k;
+                        int index = accessMapNodes(mappedIndex[0], mappedIndex[1], mappedIndex[2]);
+                        nodes[pos] = index;
+                        coeffs[pos] = BSbasisi0[i]*BSbasisi1[j]*BSbasisi2[k]*weig[index];
+                        sum += coeffs[pos];
+                        ++pos;
+                    }
+                }
+            }
+            for(pos=0; pos<m_cacheRowSize; ++pos){
+                coeffs[pos] /= sum;
+            }
         }
+    }
 
-        itout++;
+    m_cacheRevision = container->getVerticesRevision();
+    m_cacheValid = true;
+}
 
-    }//next list id
+/*! Evaluate the displacements of the cached vertices as sparse matrix-vector
+ * product of the cached basis coefficients with the current control nodes displacements.
+ * \return displacements of the vertices listed in the cache.
+ */
+dvecarr3E
+FFDLattice::evalBasisCache(){
 
-    itout = outres.end();
+    bitpit::PatchKernel * tri = getGeometry()->getPatch();
+    long lsize = m_cacheList.size();
+    dvecarr3E outres(lsize);
 
-    return(outres);
+    dvecarr3E displ = recoverFullGridDispl();
+    darray3E scaling = getShape()->getScaling();
+    bool displGlobal = isDisplGlobal();
 
-};
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(long p=0; p<lsize; ++p){
+        const int    * nodes  = m_cacheNodes.data() + p*m_cacheRowSize;
+        const double * coeffs = m_cacheCoeffs.data() + p*m_cacheRowSize;
+        darray3E val = {{0.0, 0.0, 0.0}};
+        for(int pos=0; pos<m_cacheRowSize; ++pos){
+            const darray3E & d = displ[nodes[pos]];
+            for(int intv=0; intv<3; ++intv){
+                val[intv] += coeffs[pos]*d[intv];
+            }
+        }
+
+        if(displGlobal){
+            outres[p] = val;
+        }else{
+            darray3E point = m_cachePoints[p];
+            for(int i=0; i<3; ++i){
+                point[i] += val[i]/scaling[i];
+            }
+            darray3E target = tri->getVertex(m_cacheList[p]).getCoords();
+            outres[p] = transfToGlobal(point) - target;
+        }
+    }
+
+    return(outres);
+}
 
 /*! Return a specified component of a displacement of a given point, under the deformation effect of the whole Lattice.
  * \param[in] coordOr 3D point
@@ -1069,11 +1346,34 @@ FFDLattice::nurbsEvaluatorScalar(darray3E & coordOr, int targ){
 dvector1D
 FFDLattice::basisITS0(int k, int pos, double coord){
 
+    int dd1 = m_deg[pos]+1;
+    dvector1D basis(dd1);
+    dvector1D work(2*dd1);
+    basisITS0(k, pos, coord, basis.data(), work.data());
+    return(basis);
+};
+
+/*!Evaluate the local basis function of a Nurbs Curve on caller provided buffers,
+ * without any memory allocation. See basisITS0(int k, int pos, double coord).
+ *\param[in] k  local knot interval in which coord resides -> theoretical knot indexing,
+ *\param[in] pos identifies which nurbs curve of lattice (3 curve for 3 box direction) you are pointing
+ *\param[in] coord the evaluation point on the curve
+ *\param[out] basis buffer of size degree+1 of curve pos, filled with the local basis
+ *\param[in] work working buffer of size 2*(degree+1) of curve pos
+ */
+void
+FFDLattice::basisITS0(int k, int pos, double coord, double * basis, double * work){
+
     //return local basis function given the local interval in theoretical knot index,
     //local degree of the curve -> Please refer to NURBS book of PEIGL for this Inverted Triangular Scheme Algorithm (pag 74);
     int dd1 = m_deg[pos]+1;
-    dvector1D basis(dd1,1);
-    dvector1D left(dd1,0), right(dd1,0);
+    double * left = work;
+    double * right = work + dd1;
+    for(int j = 0; j < dd1; ++j){
+        basis[j] = 1.0;
+        left[j] = 0.0;
+        right[j] = 0.0;
+    }
     double saved, tmp;
 
     for(int j = 1; j < dd1; ++j){
@@ -1089,8 +1389,6 @@ FFDLattice::basisITS0(int k, int pos, double coord){
 
         basis[j] = saved;
     }//next j
-
-    return(basis);
 };
 
 /*!Return list of equally spaced knots for the Nurbs curve in a specific lattice direction
@@ -1182,6 +1480,7 @@ FFDLattice::clearKnots(){
 /*! Apply knots structure after modifications to Nurbs curve degrees member */
 void
 FFDLattice::setKnotsStructure(){
+    setDirty();
     for(int i=0; i<3; i++){
         setKnotsStructure(i,getCoordType(i));
     }
@@ -1194,6 +1493,7 @@ FFDLattice::setKnotsStructure(){
  */
 void
 FFDLattice::setKnotsStructure(int dir,CoordType type){
+    setDirty();
 
     //recover number of node for direction dir;
     iarray3E dim = getDimension();
@@ -1476,6 +1776,7 @@ dvector1D FFDLattice::recoverFullNodeWeights(){
  * theoretical knot indexing*/
 void
 FFDLattice::setMapNodes( int ind){
+    setDirty();
 
     int dimdir = getDimension()[ind];
     int nn,preNNumb,postNNumb, pInd;
@@ -1584,6 +1885,9 @@ FFDLattice::build(){
 
     setKnotsStructure();
     orderDimension();
+
+    //lattice, degrees, knots or weights may be changed
+    clearBasisCache();
     return check;
 };
 
@@ -1640,6 +1944,17 @@ FFDLattice::absorbSectionXML(const bitpit::Config::Section & slotXML, std::strin
         setDisplGlobal(temp);
     };
 
+    if(slotXML.hasOption("BasisCache")){
+        std::string input = slotXML.get("BasisCache");
+        input = bitpit::utils::string::trim(input);
+        bool temp = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss>>temp;
+        }
+        setBasisCache(temp);
+    };
+
 };
 
 /*!
@@ -1678,6 +1993,10 @@ FFDLattice::flushSectionXML(bitpit::Config::Section & slotXML, std::string name)
         slotXML.set("DisplGlobal", std::to_string(int(isDisplGlobal())));
     }
 
+    if(isBasisCacheEnabled()){
+        slotXML.set("BasisCache", std::to_string(1));
+    }
+
 };
 
 }
@@ -40,6 +40,17 @@ namespace mimmo{
     the geometry inside the shape by means of a NURBS volumetric parameterization.
     Deformation will be applied only to those portion of geometry encased into
     the 3D shape.
+ *
+    When the same geometry is deformed many times with the same lattice and only the
+    control nodes displacements change (e.g. in shape optimization loops), the basis
+    cache can be enabled (setBasisCache). The vertices included in the lattice and their
+    rational basis coefficients are stored at the first execution; later executions
+    reduce to a sparse matrix-vector product of the coefficients with the control
+    nodes displacements. The cache is invalidated when the lattice is rebuilt (shape,
+    dimensions, degrees, knots, nodal weights modifications), when a different geometry
+    is linked or when the geometry vertices are modified (detected through the
+    vertices revision of the geometry, see MimmoObject::getVerticesRevision).
+    The cache stores (deg0+1)*(deg1+1)*(deg2+1) coefficients for each included vertex.
  *
  * \n
  * Ports available in FFDLattice Class :
@@ -127,6 +138,7 @@ namespace mimmo{
  * - <B>CoordType</B>: Set Boundary conditions for each NURBS interpolant on their extrema. Available choice are <tt>CLAMPED,SYMMETRIC,UNCLAMPED, PERIODIC</tt>;
  * - <B>Degrees</B>: degrees for NURBS interpolant in each spatial direction;
  * - <B>DisplGlobal</B>:0/1 use shape-local/global x,y,z reference system to define displacements of lattice node;
+ * - <B>BasisCache</B>:0/1 enable the cache of NURBS basis coefficients of the geometry vertices (see setBasisCache);
  *
  * Geometry, displacements field and filter field have to be mandatorily passed through port.
  */
@@ -148,6 +160,15 @@ private:
     dmpvector1D   m_filter;      /**< Filter scalar field defined on geometry nodes for displacements modulation*/
     bool         m_bfilter;      /**< Boolean to recognize if a filter field for for displacements modulation is set or not */
 
+    bool         m_basisCache;       /**< True if the cache of the basis coefficients of geometry vertices is enabled */
+    bool         m_cacheValid;       /**< True if the cache is filled and consistent with lattice and geometry */
+    std::size_t  m_cacheRevision;    /**< Revision of the geometry vertices when the cache was filled, unique among geometries */
+    livector1D   m_cacheList;        /**< Ids of the geometry vertices included in the lattice */
+    dvecarr3E    m_cachePoints;      /**< Local coordinates of the cached vertices */
+    int          m_cacheRowSize;     /**< Number of coefficients stored for each cached vertex */
+    ivector1D    m_cacheNodes;       /**< Control nodes (full grid index) of the coefficients, m_cacheRowSize per vertex */
+    dvector1D    m_cacheCoeffs;      /**< Rational basis coefficients, m_cacheRowSize per vertex */
+
 public:
     FFDLattice();
     FFDLattice(const bitpit::Config::Section & rootXML);
@@ -172,11 +193,14 @@ public:
     dmpvector1D* getFilter();
     dmpvecarr3E* getDeformation();
     bool         isDisplGlobal();
+    bool         isBasisCacheEnabled();
     iarray3E     getDegrees();
 
     void         setDegrees(iarray3E curveDegrees);
     void         setDisplacements(dvecarr3E displacements);
     void         setDisplGlobal(bool flag);
+    void         setBasisCache(bool enable);
+    void         clearBasisCache();
     void         setLattice(darray3E & origin, darray3E & span, ShapeType, iarray3E & dimensions, iarray3E & degrees);
     void         setLattice(darray3E & origin, darray3E & span, ShapeType, dvector1D & spacing, iarray3E & degrees);
     void         setLattice(BasicShape *, iarray3E & dimensions,  iarray3E & degrees);
@@ -222,6 +246,7 @@ private:
 
     //Nurbs utilities
     dvector1D    basisITS0(int k, int pos, double coord);
+    void         basisITS0(int k, int pos, double coord, double * basis, double * work);
     dvector1D    getNodeSpacing(int dir);
 
     //knots mantenaince utilities
@@ -233,6 +258,10 @@ private:
     int          getKnotIndex(int,int);
     int          getTheoreticalKnotIndex(int,int);
 
+    //basis cache utilities
+    void         fillBasisCache(livector1D & list);
+    dvecarr3E    evalBasisCache();
+
     //nodal displacement utility
     dvecarr3E    recoverFullGridDispl();
     dvector1D    recoverFullNodeWeights();
@@ -44,6 +44,12 @@ MRBF::MRBF(MRBFSol mode){
     m_rbfSupportRadii = nullptr;
     m_diagonalFactor = 1.0;
     m_areScalarResults = false;
+    m_gridOrigin.fill(0.0);
+    m_gridDim.fill(0);
+    m_gridSpacing = 0.0;
+    m_hierarchicalTol = 0.0;
+    m_farFieldCount = 0;
+    m_weightsSolver = MRBFWeightsSolver::NONE;
 };
 
 /*!
@@ -66,6 +72,12 @@ MRBF::MRBF(const bitpit::Config::Section & rootXML){
     m_rbfSupportRadii = nullptr;
     m_diagonalFactor = 1.0;
     m_areScalarResults = false;
+    m_gridOrigin.fill(0.0);
+    m_gridDim.fill(0);
+    m_gridSpacing = 0.0;
+    m_hierarchicalTol = 0.0;
+    m_farFieldCount = 0;
+    m_weightsSolver = MRBFWeightsSolver::NONE;
 
     setMode(MRBFSol::NONE);
 
@@ -107,6 +119,12 @@ MRBF::MRBF(const MRBF & other):BaseManipulation(other), bitpit::RBF(other){
     m_rbfSupportRadii = other.m_rbfSupportRadii;
     m_diagonalFactor = other.m_diagonalFactor;
     m_diagonalFactor = other.m_diagonalFactor;
+    m_gridOrigin.fill(0.0);
+    m_gridDim.fill(0);
+    m_gridSpacing = 0.0;
+    m_hierarchicalTol = other.m_hierarchicalTol;
+    m_farFieldCount = 0;
+    m_weightsSolver = MRBFWeightsSolver::NONE;
 };
 
 /*! Assignment operator. Result geometry displacement are not copied.
@@ -141,6 +159,15 @@ void MRBF::swap(MRBF & x) noexcept
     std::swap(m_rbfSupportRadii, x.m_rbfSupportRadii);
     std::swap(m_diagonalFactor, x.m_diagonalFactor);
     std::swap(m_areScalarResults, x.m_areScalarResults);
+    std::swap(m_gridOrigin, x.m_gridOrigin);
+    std::swap(m_gridDim, x.m_gridDim);
+    std::swap(m_gridSpacing, x.m_gridSpacing);
+    std::swap(m_gridOffsets, x.m_gridOffsets);
+    std::swap(m_gridNodes, x.m_gridNodes);
+    std::swap(m_hierarchicalTol, x.m_hierarchicalTol);
+    std::swap(m_nodeTree, x.m_nodeTree);
+    std::swap(m_farFieldCount, x.m_farFieldCount);
+    std::swap(m_weightsSolver, x.m_weightsSolver);
 
     RBF::swap(x);
 
@@ -226,6 +253,40 @@ MRBF::getEffectivelyUsedSupportRadii(){
 	return m_effectiveSR;
 }
 
+/*!
+ * Return the tolerance of the hierarchical evaluation of global support RBF.
+ * \return tolerance (a value <= 0 means hierarchical evaluation disabled)
+ */
+double
+MRBF::getHierarchicalTolerance(){
+    return m_hierarchicalTol;
+}
+
+/*!
+ * Return the number of far-field approximations, i.e. clusters of RBF nodes evaluated through
+ * their centroid, used by the hierarchical evaluation of the deformation on the geometry
+ * vertices during the last execution (see setHierarchicalTolerance).
+   BEWARE : returned result is meaningful only after class execution.
+ * \return number of far-field approximations (0 if hierarchical evaluation is disabled)
+ */
+long
+MRBF::getFarFieldApproximationsCount(){
+    return m_farFieldCount;
+}
+
+/*!
+ * Return the linear solver used to compute the RBF coefficients in MRBFSol::WHOLE mode during
+ * the last execution: the sparse (compact support) or hierarchical (global support, see
+ * setHierarchicalTolerance) iterative solvers, or the dense one, used directly or as fallback
+ * if the iterative solver does not converge.
+   BEWARE : returned result is meaningful only after class execution.
+ * \return solver of the weights (MRBFWeightsSolver::NONE if no system is solved)
+ */
+MRBFWeightsSolver
+MRBF::getWeightsSolver(){
+    return m_weightsSolver;
+}
+
 /*!
  * Return the factor, applied to the diagonal length of the bounding box of the geometry, used
  * to define the threshold, compared to the support radii, to impose the kdtree filtering.
@@ -308,6 +369,7 @@ MRBF::isCompact(){
  */
 int
 MRBF::addNode(darray3E node){
+	setDirty();
 	return(RBF::addNode(node));
 };
 
@@ -318,6 +380,7 @@ MRBF::addNode(darray3E node){
  */
 std::vector<int>
 MRBF::addNode(dvecarr3E nodes){
+	setDirty();
 	return(RBF::addNode(nodes));
 };
 
@@ -326,6 +389,7 @@ MRBF::addNode(dvecarr3E nodes){
  */
 void
 MRBF::setNode(darray3E node){
+	setDirty();
 	removeAllNodes();
 	RBF::addNode(node);
     m_rbfgeometry = nullptr;
@@ -336,6 +400,7 @@ MRBF::setNode(darray3E node){
  */
 void
 MRBF::setNode(dvecarr3E nodes){
+	setDirty();
 	removeAllNodes();
 	RBF::addNode(nodes);
     m_rbfgeometry = nullptr;
@@ -347,6 +412,7 @@ MRBF::setNode(dvecarr3E nodes){
  */
 void
 MRBF::setNode(MimmoSharedPointer<MimmoObject> geometry){
+	setDirty();
 	if(!geometry)    return ;
 	m_rbfgeometry = geometry;
 };
@@ -357,6 +423,7 @@ MRBF::setNode(MimmoSharedPointer<MimmoObject> geometry){
  */
 void
 MRBF::setFilter(dmpvector1D * filter){
+    setDirty();
     if(!filter) return;
     m_filter.clear();
 	m_bfilter = !(filter->empty());
@@ -395,6 +462,7 @@ MRBF::checkDuplicatedNodes(double tol){
  */
 bool
 MRBF::removeDuplicatedNodes(ivector1D * list){
+	setDirty();
 	ivector1D marked;
 	if(list==nullptr){
 		marked = checkDuplicatedNodes();
@@ -416,6 +484,7 @@ MRBF::removeDuplicatedNodes(ivector1D * list){
  */
 void
 MRBF::setSupportRadiusLocal(double suppR_){
+    setDirty();
     suppR_ = std::max(-1.0,suppR_);
     m_supportRadiusValue = suppR_;
     m_srIsReal = false;
@@ -433,6 +502,7 @@ MRBF::setSupportRadiusLocal(double suppR_){
  */
 void
 MRBF::setSupportRadiusReal(double suppR_){
+	setDirty();
 	suppR_ = std::max(-1.0,suppR_);
 	m_supportRadiusValue = suppR_;
 	m_srIsReal = true;
@@ -444,6 +514,7 @@ MRBF::setSupportRadiusReal(double suppR_){
  */
 void
 MRBF::setSupportRadiusValue(double suppR_){
+    setDirty();
     setSupportRadiusReal(suppR_);
 }
 
@@ -459,6 +530,7 @@ MRBF::setSupportRadiusValue(double suppR_){
  */
 void
 MRBF::setVariableSupportRadii(dvector1D sradii){
+    setDirty();
     if(sradii.empty() || m_solver != MRBFSol::NONE) return;
     m_supportRadii = sradii;
     m_supportRadiusValue = -1.0;
@@ -473,12 +545,30 @@ MRBF::setVariableSupportRadii(dvector1D sradii){
  */
 void
 MRBF::setVariableSupportRadii(dmpvector1D* sradii){
+    setDirty();
     if(!sradii || m_solver != MRBFSol::NONE) return;
     m_rbfSupportRadii = sradii;
     m_supportRadiusValue = -1.0;
     m_srIsReal = false;
 }
 
+/*!
+ * Enable the hierarchical (tree-code) evaluation of the RBF, used with global support
+ * basis functions only (compact support ones use the nodes bucket grid).
+ * The nodes are clustered in a binary tree and a cluster is approximated by its centroid,
+ * carrying the sum of the weights of its nodes, if the variation of the basis function
+ * over the cluster, as seen from the evaluation point, is lower than the tolerance.
+ * In MRBFSol::WHOLE mode the approximation is used also to compute the weights with a
+ * matrix-free iterative solver.
+ * \param[in] tol tolerance on the basis function variation; a value <= 0 disables the
+ * hierarchical evaluation (default).
+ */
+void
+MRBF::setHierarchicalTolerance(double tol){
+    m_hierarchicalTol = std::max(0.0, tol);
+    setDirty();
+}
+
 /*!
  * Set the factor, applied to the diagonal length of the bounding box of the geometry, used
  * to define the threshold, compared to the support radii, to impose the kdtree filtering.
@@ -486,6 +576,7 @@ MRBF::setVariableSupportRadii(dmpvector1D* sradii){
  */
 void
 MRBF::setDiagonalFactor(double diagonalFactor){
+    setDirty();
     m_diagonalFactor = std::min(std::max(diagonalFactor, 0.), 1.);
 }
 
@@ -495,6 +586,7 @@ MRBF::setDiagonalFactor(double diagonalFactor){
  */
 void
 MRBF::setTol(double tol){
+	setDirty();
 	m_tol = tol;
 }
 
@@ -525,6 +617,7 @@ MRBF::setDisplacements(dvecarr3E displ){
 
     m_rbfdispl = nullptr;
     m_areScalarResults = false;
+    setDirty();
 }
 
 /*!
@@ -543,6 +636,7 @@ MRBF::setDisplacements(dmpvecarr3E* displ){
     if (!displ) return;
     m_rbfdispl = displ;
     m_areScalarResults = false;
+    setDirty();
 }
 
 
@@ -564,7 +658,7 @@ MRBF::setScalarDisplacements(dvector1D displ){
 
     m_rbfScalarDispl = nullptr;
     m_areScalarResults = true;
-
+    setDirty();
 }
 
 /*!
@@ -582,6 +676,7 @@ void
 MRBF::setScalarDisplacements(dmpvector1D* displ){
     if (!displ) return;
     m_rbfScalarDispl = displ;
+    setDirty();
 }
 
 /*!
@@ -592,6 +687,7 @@ MRBF::setScalarDisplacements(dmpvector1D* displ){
 void
 MRBF::setFunction( const MRBFBasisFunction &bfunc, bool isCompact )
 {
+	setDirty();
 	switch(bfunc){
 
 	case( MRBFBasisFunction::HEAVISIDE10):
@@ -636,6 +732,7 @@ MRBF::setFunction( const MRBFBasisFunction &bfunc, bool isCompact )
 void
 MRBF::setFunction( const bitpit::RBFBasisFunction &bfunc, bool isCompact)
 {
+	setDirty();
 	bitpit::RBF::setFunction(bfunc);
     m_functype = -1;
     m_isCompact = isCompact;
@@ -648,6 +745,7 @@ MRBF::setFunction( const bitpit::RBFBasisFunction &bfunc, bool isCompact)
 void
 MRBF::setCompactSupport(bool isCompact)
 {
+    setDirty();
     m_isCompact = isCompact;
 }
 
@@ -697,6 +795,8 @@ MRBF::execute(){
     //prepare m_displ or m_scalarDispl according to m_areScalarResults;
     m_displ.clear();
     m_scalarDispl.clear();
+    m_farFieldCount = 0;
+    m_weightsSolver = MRBFWeightsSolver::NONE;
     if(m_areScalarResults){
         m_scalarDispl.setDataLocation(mimmo::MPVLocation::POINT);
         m_scalarDispl.reserve(getGeometry()->getNVertices());
@@ -727,11 +827,42 @@ MRBF::execute(){
 	//in case of Mode WHOLE/GREEDY
 	computeEffectiveSupportRadiusList();
 
+	//index the RBF nodes supports on a bucket grid, so that evalRBF
+	//visits only the nodes whose support contains the evaluation point.
+	if (isCompact())    buildNodeGrid();
+
+	//Global support basis functions can be evaluated hierarchically: the tree
+	//is built here and feeds a matrix-free solver in MRBFSol::WHOLE mode.
+	bool hierarchical = (!isCompact() && m_hierarchicalTol > 0.0);
+	if (hierarchical)    buildNodeTree();
+
 	//calculate weights for interpolation modes. This is not required
 	// in parameterization mode MRBFSol::NONE.
-	if (m_solver == MRBFSol::WHOLE)    solve();
+	// With compact support the interpolation matrix is sparse: try the sparse
+	// solver first, falling back to the dense one if it does not converge.
+	// The same fallback holds for the hierarchical solver.
+	if (m_solver == MRBFSol::WHOLE){
+	    bool solved = false;
+	    if (isCompact()){
+	        solved = solveSparse();
+	        m_weightsSolver = MRBFWeightsSolver::SPARSE;
+	    }
+	    if (hierarchical){
+	        solved = solveHierarchical();
+	        m_weightsSolver = MRBFWeightsSolver::HIERARCHICAL;
+	    }
+	    if (!solved){
+	        if (m_weightsSolver != MRBFWeightsSolver::NONE){
+	            (*m_log) << "warning: " << getName() << " : iterative solver of the RBF weights not converged, falling back to the dense solver" << std::endl;
+	        }
+	        solve();
+	        m_weightsSolver = MRBFWeightsSolver::DENSE;
+	    }
+	}
 	if (m_solver == MRBFSol::GREEDY)    greedy(m_tol);
 
+	//aggregate the final weights on the clusters of the tree.
+	if (hierarchical)    updateNodeTreeWeights(m_weight);
 
 	// Prepare the list of vertices to be used during rbf evaluations
 	std::unordered_set<long> activeMeshVertices;
@@ -777,17 +908,36 @@ MRBF::execute(){
 	}
 
 	// get deformation using own class evalRBF.
-    std::array<double,3> tempValue;
-    std::vector<double>  resultValue;
-    for(const long &id: activeMeshVertices){
-	    bitpit::Vertex & vertex = container->getPatch()->getVertex(id);
-        resultValue =evalRBF(vertex.getCoords());
+	// Vertices are evaluated independently into a flat buffer (in parallel if
+	// OpenMP is enabled) and then inserted serially in the same order of the
+	// serial path, so that results do not depend on the number of threads.
+	std::vector<long> activeIds(activeMeshVertices.begin(), activeMeshVertices.end());
+	long nActive = long(activeIds.size());
+	int ncomp = m_areScalarResults ? 1 : 3;
+	std::vector<double> results(std::size_t(nActive)*ncomp);
+	const VertexCoordsSoA & coords = container->getVerticesCoordsSoA();
+	long farField = 0;
+
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static) reduction(+:farField)
+#endif
+	for(long k=0; k<nActive; ++k){
+	    std::size_t index = coords.indices.at(activeIds[k]);
+	    std::array<double,3> point = {{coords.x[index], coords.y[index], coords.z[index]}};
+	    long napprox = 0;
+	    std::vector<double> resultValue = evalRBF(point, napprox);
+	    farField += napprox;
+	    std::copy_n(resultValue.begin(), ncomp, results.begin() + k*ncomp);
+	}
+
+	std::array<double,3> tempValue;
+	for(long k=0; k<nActive; ++k){
 	    if(m_areScalarResults) {
-            m_scalarDispl.insert(id, resultValue[0]);
-        }else{
-            std::copy_n(resultValue.begin(), 3,tempValue.begin());
-            m_displ.insert(id, tempValue);
-        }
+	        m_scalarDispl.insert(activeIds[k], results[k]);
+	    }else{
+	        std::copy_n(results.begin() + 3*k, 3, tempValue.begin());
+	        m_displ.insert(activeIds[k], tempValue);
+	    }
 	}
 
 	//apply m_filter if it's active;
@@ -810,6 +960,10 @@ MRBF::execute(){
     }else{
         m_displ.completeMissingData({{0.0,0.0,0.0}});
     }
+
+    m_farFieldCount = farField;
+    clearNodeGrid();
+    m_nodeTree.clear();
 };
 
 /*!
@@ -958,6 +1112,18 @@ MRBF::absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name
         }
     };
 
+    m_hierarchicalTol = 0.0;
+    if(slotXML.hasOption("HierarchicalTolerance")){
+        input = slotXML.get("HierarchicalTolerance");
+        input = bitpit::utils::string::trim(input);
+        double value = 0.0;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+            setHierarchicalTolerance(value);
+        }
+    };
+
 }
 
 /*!
@@ -1004,6 +1170,12 @@ MRBF::flushSectionXML(bitpit::Config::Section & slotXML, std::string name){
         slotXML.set("DiagonalFactor", ss.str());
     }
 
+    if(m_hierarchicalTol > 0.0){
+        std::stringstream ss;
+        ss<<std::scientific<<m_hierarchicalTol;
+        slotXML.set("HierarchicalTolerance", ss.str());
+    }
+
 }
 
 /*!
@@ -1055,6 +1227,7 @@ MRBF::setWeight(dvector2D value){
 		}
 		addData(temp);
 	}
+	setDirty();
 }
 
 /*! Plot your current rbf nodes as a point cloud to *vtu file.
@@ -1195,10 +1368,588 @@ MRBF::computeEffectiveSupportRadiusList(){
     }
 }
 
+/*!
+ * Index the supports of the RBF nodes on a uniform bucket grid, used by evalRBF
+ * in compact support mode. Each node is stored in every cell overlapped by the
+ * bounding box of its support, so that a point visits only the nodes listed in its own cell.
+ * The cell size is the mean of the effective support radii, enlarged if needed to keep
+ * the number of cells proportional to the number of nodes.
+ * Nodes are stored in each cell in increasing index order: the sum performed by evalRBF
+ * follows the same order of the brute force evaluation.
+ * m_effectiveSR must be already computed.
+ */
+void
+MRBF::buildNodeGrid(){
+
+    clearNodeGrid();
+    int nnodes = m_nodes;
+    if(nnodes == 0 || int(m_effectiveSR.size()) < nnodes)    return;
+
+    std::array<double,3> bmin, bmax;
+    bmin.fill(std::numeric_limits<double>::max());
+    bmax.fill(-1.0*std::numeric_limits<double>::max());
+    double meanRadius = 0.0;
+    for(int i=0; i<nnodes; ++i){
+        double radius = m_effectiveSR[i];
+        for(int j=0; j<3; ++j){
+            bmin[j] = std::min(bmin[j], m_node[i][j] - radius);
+            bmax[j] = std::max(bmax[j], m_node[i][j] + radius);
+        }
+        meanRadius += radius;
+    }
+    meanRadius /= double(nnodes);
+    if(!(meanRadius > 0.0))    return;
+
+    //limit the number of cells to a multiple of the number of nodes.
+    double maxCells = 8.0 * double(nnodes);
+    double spacing = meanRadius;
+    std::array<long,3> dim;
+    while(true){
+        double ncells = 1.0;
+        for(int j=0; j<3; ++j){
+            ncells *= std::max(1.0, std::ceil((bmax[j] - bmin[j]) / spacing));
+        }
+        if(ncells <= maxCells)  break;
+        spacing *= 2.0;
+    }
+    for(int j=0; j<3; ++j){
+        dim[j] = std::max(1L, long(std::ceil((bmax[j] - bmin[j]) / spacing)));
+    }
+
+    //range of cells overlapped by the support of a node.
+    auto cellRange = [&](int i, std::array<long,3> & lo, std::array<long,3> & hi){
+        for(int j=0; j<3; ++j){
+            lo[j] = std::max(0L, long(std::floor((m_node[i][j] - m_effectiveSR[i] - bmin[j]) / spacing)));
+            hi[j] = std::min(dim[j]-1, long(std::floor((m_node[i][j] + m_effectiveSR[i] - bmin[j]) / spacing)));
+        }
+    };
+
+    std::vector<long> offsets(dim[0]*dim[1]*dim[2]+1, 0);
+    std::array<long,3> lo, hi;
+    for(int i=0; i<nnodes; ++i){
+        cellRange(i, lo, hi);
+        for(long ix=lo[0]; ix<=hi[0]; ++ix)
+            for(long iy=lo[1]; iy<=hi[1]; ++iy)
+                for(long iz=lo[2]; iz<=hi[2]; ++iz)
+                    ++offsets[(ix*dim[1] + iy)*dim[2] + iz + 1];
+    }
+    for(std::size_t k=1; k<offsets.size(); ++k){
+        offsets[k] += offsets[k-1];
+    }
+
+    std::vector<int> nodes(offsets.back());
+    std::vector<long> cursor(offsets.begin(), offsets.end()-1);
+    for(int i=0; i<nnodes; ++i){
+        cellRange(i, lo, hi);
+        for(long ix=lo[0]; ix<=hi[0]; ++ix)
+            for(long iy=lo[1]; iy<=hi[1]; ++iy)
+                for(long iz=lo[2]; iz<=hi[2]; ++iz)
+                    nodes[cursor[(ix*dim[1] + iy)*dim[2] + iz]++] = i;
+    }
+
+    m_gridOrigin = bmin;
+    m_gridDim = dim;
+    m_gridSpacing = spacing;
+    m_gridOffsets.swap(offsets);
+    m_gridNodes.swap(nodes);
+}
+
+/*!
+ * Release the bucket grid of RBF nodes. evalRBF falls back to the evaluation of all nodes.
+ */
+void
+MRBF::clearNodeGrid(){
+    m_gridOrigin.fill(0.0);
+    m_gridDim.fill(0);
+    m_gridSpacing = 0.0;
+    std::vector<long>().swap(m_gridOffsets);
+    std::vector<int>().swap(m_gridNodes);
+}
+
+/*!
+ * Find the cell of the RBF nodes bucket grid containing a point.
+ * \param[in] point target point
+ * \return linear index of the cell, -1 if the point is outside the grid or the grid is not built.
+ */
+long
+MRBF::locateNodeGridCell(const std::array<double,3> & point){
+    if(m_gridOffsets.empty())    return -1;
+    long cell = 0;
+    for(int j=0; j<3; ++j){
+        double x = (point[j] - m_gridOrigin[j]) / m_gridSpacing;
+        if(x < 0.0 || x > double(m_gridDim[j]))    return -1;
+        cell = cell * m_gridDim[j] + std::min(long(x), m_gridDim[j]-1);
+    }
+    return cell;
+}
+
+/*!
+ * Compute the RBF weights of MRBFSol::WHOLE mode in compact support mode.
+ * The interpolation matrix A_ij = phi(|x_i - x_j|/r_j) is assembled in compressed
+ * sparse row format, retaining only the nodes j whose support contains the node i
+ * (found through the nodes bucket grid). Each data field is solved up to a relative residual
+ * of 1.0E-12 with a Jacobi preconditioned conjugate gradient if the support radius is uniform
+ * (symmetric matrix), or with a Jacobi preconditioned BiCGSTAB if the support radii of the
+ * nodes differ (non-symmetric matrix).
+ * Memory scales with the number of nonzeros instead of the square of the number of nodes.
+ * All the RBF nodes are activated.
+ * The method requires the nodes bucket grid to be built (see buildNodeGrid).
+ * \return true if all the fields converged, false otherwise (weights are not modified);
+ * in that case the caller is supposed to fall back to the dense solver.
+ */
+bool
+MRBF::solveSparse(){
+
+    int nnodes = m_nodes;
+    int nfields = getDataCount();
+    if(m_gridOffsets.empty() || nnodes == 0)    return false;
+
+    //assemble the CSR matrix, with columns sorted by node index.
+    std::vector<long>   rowOffsets(nnodes+1, 0);
+    std::vector<int>    columns;
+    std::vector<double> coeffs;
+    for(int i=0; i<nnodes; ++i){
+        long cell = locateNodeGridCell(m_node[i]);
+        if(cell >= 0){
+            for(long k=m_gridOffsets[cell]; k<m_gridOffsets[cell+1]; ++k){
+                int j = m_gridNodes[k];
+                double dist = norm2(m_node[i] - m_node[j]) / m_effectiveSR[j];
+                if(dist > 1.0)   continue;
+                columns.push_back(j);
+                coeffs.push_back(evalBasis(dist));
+            }
+        }
+        rowOffsets[i+1] = long(columns.size());
+    }
+
+    //Jacobi preconditioner; a null diagonal is not suitable for this solver.
+    std::vector<double> invDiag(nnodes, 0.0);
+    for(int i=0; i<nnodes; ++i){
+        for(long k=rowOffsets[i]; k<rowOffsets[i+1]; ++k){
+            if(columns[k] == i)    invDiag[i] = coeffs[k];
+        }
+        if(!(std::abs(invDiag[i]) > 0.0))    return false;
+        invDiag[i] = 1.0/invDiag[i];
+    }
+
+    auto matVec = [&](const std::vector<double> & x, std::vector<double> & y){
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(int i=0; i<nnodes; ++i){
+            double sum = 0.0;
+            for(long k=rowOffsets[i]; k<rowOffsets[i+1]; ++k){
+                sum += coeffs[k] * x[columns[k]];
+            }
+            y[i] = sum;
+        }
+    };
+    auto dot = [nnodes](const std::vector<double> & a, const std::vector<double> & b){
+        double sum = 0.0;
+        for(int i=0; i<nnodes; ++i)    sum += a[i]*b[i];
+        return sum;
+    };
+
+    const double tolerance = 1.0E-12;
+    const int maxIterations = std::max(1000, 2*nnodes);
+    dvector2D weights(nfields, dvector1D(nnodes, 0.0));
+    std::vector<double> r(nnodes), z(nnodes), p(nnodes), q(nnodes);
+
+    //the matrix is symmetric only if all the nodes share the same support radius.
+    bool symmetric = true;
+    for(int i=1; i<nnodes && symmetric; ++i){
+        symmetric = (m_effectiveSR[i] == m_effectiveSR[0]);
+    }
+
+    for(int f=0; f<nfields; ++f){
+        std::vector<double> & x = weights[f];
+        const std::vector<double> & b = m_value[f];
+        if(int(b.size()) != nnodes)    return false;
+
+        if(!symmetric){
+            if(!solveBiCGSTAB(matVec, invDiag, b, x, tolerance, maxIterations)){
+                (*m_log)<<"warning: "<<m_name<<" sparse solver of RBF weights not converged for field "<<f<<". Switching to dense solver."<<std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        //x0 = 0 -> r0 = b
+        r = b;
+        double bnorm = std::sqrt(dot(b,b));
+        if(!(bnorm > 0.0))    continue;
+
+        for(int i=0; i<nnodes; ++i)    z[i] = invDiag[i]*r[i];
+        p = z;
+        double rz = dot(r,z);
+        bool converged = false;
+        for(int it=0; it<maxIterations; ++it){
+            matVec(p, q);
+            double pq = dot(p,q);
+            if(!(pq > 0.0))    break;
+            double alpha = rz / pq;
+            for(int i=0; i<nnodes; ++i){
+                x[i] += alpha*p[i];
+                r[i] -= alpha*q[i];
+            }
+            if(std::sqrt(dot(r,r)) <= tolerance*bnorm){
+                converged = true;
+                break;
+            }
+            for(int i=0; i<nnodes; ++i)    z[i] = invDiag[i]*r[i];
+            double rzNew = dot(r,z);
+            double beta = rzNew / rz;
+            rz = rzNew;
+            for(int i=0; i<nnodes; ++i)    p[i] = z[i] + beta*p[i];
+        }
+        if(!converged){
+            (*m_log)<<"warning: "<<m_name<<" sparse solver of RBF weights not converged for field "<<f<<". Switching to dense solver."<<std::endl;
+            return false;
+        }
+    }
+
+    m_weight.swap(weights);
+    m_activeNodes.assign(nnodes, true);
+    return true;
+}
+
+/*!
+ * Default constructor of the tree of RBF nodes clusters.
+ */
+MRBF::NodeTree::NodeTree(){
+    nfields = 0;
+}
+
+/*!
+ * Release the tree of RBF nodes clusters.
+ */
+void
+MRBF::NodeTree::clear(){
+    std::vector<int>().swap(nodes);
+    std::vector<int>().swap(begin);
+    std::vector<int>().swap(end);
+    std::vector<int>().swap(child);
+    dvecarr3E().swap(center);
+    dvector1D().swap(radius);
+    dvector1D().swap(srMin);
+    dvector1D().swap(srMax);
+    dvector1D().swap(srMean);
+    dvector1D().swap(weights);
+    nfields = 0;
+}
+
+/*!
+ * Build the binary tree of clusters of RBF nodes used by the hierarchical evaluation.
+ * Clusters are split at the median of the longest side of their bounding box, down
+ * to leaves of at most 16 nodes. Centroid, radius and support radii range of
+ * each cluster are stored. m_effectiveSR must be already computed.
+ */
+void
+MRBF::buildNodeTree(){
+
+    m_nodeTree.clear();
+    int nnodes = m_nodes;
+    if(nnodes == 0 || int(m_effectiveSR.size()) < nnodes)    return;
+
+    const int leafSize = 16;
+    NodeTree & tree = m_nodeTree;
+    tree.nodes.resize(nnodes);
+    for(int i=0; i<nnodes; ++i)    tree.nodes[i] = i;
+
+    //depth-first construction: the children of a cluster are appended
+    //when it is split, so they are always stored after it.
+    std::vector<int> stack(1, 0);
+    tree.begin.push_back(0);
+    tree.end.push_back(nnodes);
+    tree.child.push_back(-1);
+    while(!stack.empty()){
+        int c = stack.back();
+        stack.pop_back();
+        int b = tree.begin[c], e = tree.end[c];
+        if(e - b <= leafSize)    continue;
+
+        std::array<double,3> bmin, bmax;
+        bmin.fill(std::numeric_limits<double>::max());
+        bmax.fill(-1.0*std::numeric_limits<double>::max());
+        for(int k=b; k<e; ++k){
+            for(int j=0; j<3; ++j){
+                bmin[j] = std::min(bmin[j], m_node[tree.nodes[k]][j]);
+                bmax[j] = std::max(bmax[j], m_node[tree.nodes[k]][j]);
+            }
+        }
+        int dir = 0;
+        for(int j=1; j<3; ++j){
+            if(bmax[j] - bmin[j] > bmax[dir] - bmin[dir])    dir = j;
+        }
+        if(!(bmax[dir] > bmin[dir]))    continue;
+
+        int m = b + (e - b)/2;
+        std::nth_element(tree.nodes.begin()+b, tree.nodes.begin()+m, tree.nodes.begin()+e,
+                         [this, dir](int n1, int n2){return m_node[n1][dir] < m_node[n2][dir];});
+
+        int first = int(tree.begin.size());
+        tree.child[c] = first;
+        tree.begin.push_back(b);
+        tree.end.push_back(m);
+        tree.child.push_back(-1);
+        tree.begin.push_back(m);
+        tree.end.push_back(e);
+        tree.child.push_back(-1);
+        stack.push_back(first+1);
+        stack.push_back(first);
+    }
+
+    int nclusters = int(tree.begin.size());
+    tree.center.assign(nclusters, {{0.0,0.0,0.0}});
+    tree.radius.assign(nclusters, 0.0);
+    tree.srMin.assign(nclusters, std::numeric_limits<double>::max());
+    tree.srMax.assign(nclusters, 0.0);
+    tree.srMean.assign(nclusters, 0.0);
+    for(int c=0; c<nclusters; ++c){
+        int count = tree.end[c] - tree.begin[c];
+        for(int k=tree.begin[c]; k<tree.end[c]; ++k){
+            int n = tree.nodes[k];
+            tree.center[c] += m_node[n];
+            tree.srMin[c] = std::min(tree.srMin[c], m_effectiveSR[n]);
+            tree.srMax[c] = std::max(tree.srMax[c], m_effectiveSR[n]);
+            tree.srMean[c] += m_effectiveSR[n];
+        }
+        tree.center[c] /= double(count);
+        tree.srMean[c] /= double(count);
+        for(int k=tree.begin[c]; k<tree.end[c]; ++k){
+            tree.radius[c] = std::max(tree.radius[c], norm2(m_node[tree.nodes[k]] - tree.center[c]));
+        }
+    }
+}
+
+/*!
+ * Aggregate a set of weights on the clusters of the nodes tree. Only active RBF nodes
+ * contribute to the sums.
+ * \param[in] weights weights of the RBF nodes, one vector of size equal to the number of nodes for each field.
+ */
+void
+MRBF::updateNodeTreeWeights(const dvector2D & weights){
+
+    NodeTree & tree = m_nodeTree;
+    int nclusters = int(tree.begin.size());
+    int nfields = int(weights.size());
+    tree.nfields = nfields;
+    tree.weights.assign(std::size_t(nclusters)*nfields, 0.0);
+
+    //children follow their parent: accumulate from the last cluster.
+    for(int c=nclusters-1; c>=0; --c){
+        double * sum = tree.weights.data() + std::size_t(c)*nfields;
+        if(tree.child[c] < 0){
+            for(int k=tree.begin[c]; k<tree.end[c]; ++k){
+                int n = tree.nodes[k];
+                if(!m_activeNodes[n])    continue;
+                for(int f=0; f<nfields; ++f)    sum[f] += weights[f][n];
+            }
+        }else{
+            const double * sum1 = tree.weights.data() + std::size_t(tree.child[c])*nfields;
+            const double * sum2 = sum1 + nfields;
+            for(int f=0; f<nfields; ++f)    sum[f] = sum1[f] + sum2[f];
+        }
+    }
+}
+
+/*!
+ * Hierarchical evaluation of the RBF in a point. Clusters are visited from the root:
+ * a cluster not containing the point is approximated by its centroid if the variation
+ * of the basis function between its nearest and farthest possible node is within
+ * m_hierarchicalTol, otherwise it is opened. Leaves are evaluated exactly.
+ * The aggregated weights of the tree must correspond to the weights passed
+ * (see updateNodeTreeWeights). The method does not modify the class members,
+ * so it can be called concurrently.
+ * \param[in] point evaluation point
+ * \param[in] weights weights of the RBF nodes, one vector for each field
+ * \param[out] values evaluated fields, resized to the number of fields.
+ * \return number of clusters approximated by their centroid.
+ */
+long
+MRBF::evalNodeTree(const std::array<double,3> & point, const dvector2D & weights, std::vector<double> & values){
+
+    const NodeTree & tree = m_nodeTree;
+    int nfields = tree.nfields;
+    values.assign(nfields, 0.0);
+    if(tree.begin.empty())    return 0;
+
+    long napprox = 0;
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while(!stack.empty()){
+        int c = stack.back();
+        stack.pop_back();
+
+        double dist = norm2(point - tree.center[c]);
+        if(dist > tree.radius[c]){
+            double basis = evalBasis(dist / tree.srMean[c]);
+            double nearest = evalBasis((dist - tree.radius[c]) / tree.srMax[c]);
+            double farthest = evalBasis((dist + tree.radius[c]) / tree.srMin[c]);
+            if(std::max(std::abs(nearest - basis), std::abs(farthest - basis)) <= m_hierarchicalTol){
+                const double * sum = tree.weights.data() + std::size_t(c)*nfields;
+                for(int f=0; f<nfields; ++f)    values[f] += basis * sum[f];
+                ++napprox;
+                continue;
+            }
+        }
+
+        if(tree.child[c] < 0){
+            for(int k=tree.begin[c]; k<tree.end[c]; ++k){
+                int n = tree.nodes[k];
+                if(!m_activeNodes[n])    continue;
+                double basis = evalBasis(norm2(point - m_node[n]) / m_effectiveSR[n]);
+                for(int f=0; f<nfields; ++f)    values[f] += basis * weights[f][n];
+            }
+        }else{
+            stack.push_back(tree.child[c]+1);
+            stack.push_back(tree.child[c]);
+        }
+    }
+
+    return napprox;
+}
+
+/*!
+ * Solve a linear system with the (right) preconditioned BiCGSTAB method, starting from a null
+ * solution. The method is suitable for non-symmetric matrices.
+ * \param[in] matVec matrix-vector product of the system matrix, y = A*x
+ * \param[in] invDiag inverse of the diagonal of the matrix used as Jacobi preconditioner;
+ * if empty, no preconditioner is used
+ * \param[in] b right hand side of the system
+ * \param[out] x solution of the system, resized to the size of b
+ * \param[in] tolerance relative residual to reach
+ * \param[in] maxIterations maximum number of iterations
+ * \return true if the solver converged, false otherwise
+ */
+bool
+MRBF::solveBiCGSTAB(const std::function<void(const std::vector<double> &, std::vector<double> &)> & matVec,
+                    const std::vector<double> & invDiag, const std::vector<double> & b,
+                    std::vector<double> & x, double tolerance, int maxIterations){
+
+    int n = int(b.size());
+    bool precond = !invDiag.empty();
+    auto dot = [n](const std::vector<double> & v1, const std::vector<double> & v2){
+        double sum = 0.0;
+        for(int i=0; i<n; ++i)    sum += v1[i]*v2[i];
+        return sum;
+    };
+
+    //x0 = 0 -> r0 = b
+    x.assign(n, 0.0);
+    double bnorm = std::sqrt(dot(b,b));
+    if(!(bnorm > 0.0))    return true;
+
+    std::vector<double> r(b), r0(b), p(n, 0.0), v(n, 0.0), s(n), t(n), ph(n), sh(n);
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+    for(int it=0; it<maxIterations; ++it){
+        double rhoNew = dot(r0, r);
+        if(!(std::abs(rhoNew) > 0.0))    return false;
+        double beta = (rhoNew / rho) * (alpha / omega);
+        rho = rhoNew;
+        for(int i=0; i<n; ++i){
+            p[i] = r[i] + beta*(p[i] - omega*v[i]);
+            ph[i] = precond ? invDiag[i]*p[i] : p[i];
+        }
+        matVec(ph, v);
+        double r0v = dot(r0, v);
+        if(!(std::abs(r0v) > 0.0))    return false;
+        alpha = rho / r0v;
+        for(int i=0; i<n; ++i)    s[i] = r[i] - alpha*v[i];
+        if(std::sqrt(dot(s,s)) <= tolerance*bnorm){
+            for(int i=0; i<n; ++i)    x[i] += alpha*ph[i];
+            return true;
+        }
+        for(int i=0; i<n; ++i)    sh[i] = precond ? invDiag[i]*s[i] : s[i];
+        matVec(sh, t);
+        double tt = dot(t,t);
+        if(!(tt > 0.0))    return false;
+        omega = dot(t,s) / tt;
+        for(int i=0; i<n; ++i){
+            x[i] += alpha*ph[i] + omega*sh[i];
+            r[i] = s[i] - omega*t[i];
+        }
+        if(std::sqrt(dot(r,r)) <= tolerance*bnorm)    return true;
+        if(!(std::abs(omega) > 0.0))    return false;
+    }
+    return false;
+}
+
+/*!
+ * Compute the RBF weights of MRBFSol::WHOLE mode with global support basis functions,
+ * using the hierarchical approximation of the interpolation matrix in a matrix-free
+ * BiCGSTAB solver. Each data field is solved up to a relative residual of 1.0E-10.
+ * All the RBF nodes are activated. The nodes tree must be built (see buildNodeTree).
+ * \return true if all the fields converged, false otherwise (weights are not modified);
+ * in that case the caller is supposed to fall back to the dense solver.
+ */
+bool
+MRBF::solveHierarchical(){
+
+    int nnodes = m_nodes;
+    int nfields = getDataCount();
+    if(m_nodeTree.begin.empty() || nnodes == 0)    return false;
+
+    decltype(m_activeNodes) activeNodes(nnodes, true);
+    std::swap(m_activeNodes, activeNodes);
+
+    dvector2D xvec(1);
+    auto matVec = [&](const std::vector<double> & x, std::vector<double> & y){
+        xvec[0] = x;
+        updateNodeTreeWeights(xvec);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for(int i=0; i<nnodes; ++i){
+            std::vector<double> value;
+            evalNodeTree(m_node[i], xvec, value);
+            y[i] = value[0];
+        }
+    };
+
+    const double tolerance = 1.0E-10;
+    const int maxIterations = std::max(500, nnodes);
+    dvector2D weights(nfields, dvector1D(nnodes, 0.0));
+
+    bool success = true;
+    for(int f=0; f<nfields && success; ++f){
+        std::vector<double> & x = weights[f];
+        const std::vector<double> & b = m_value[f];
+        if(int(b.size()) != nnodes){
+            success = false;
+            break;
+        }
+
+        bool converged = solveBiCGSTAB(matVec, std::vector<double>(), b, x, tolerance, maxIterations);
+        if(!converged){
+            (*m_log)<<"warning: "<<m_name<<" hierarchical solver of RBF weights not converged for field "<<f<<". Switching to dense solver."<<std::endl;
+            success = false;
+        }
+    }
+
+    //aggregated weights of the tree are not valid anymore.
+    dvector1D().swap(m_nodeTree.weights);
+    m_nodeTree.nfields = 0;
+
+    if(!success){
+        std::swap(m_activeNodes, activeNodes);
+        return false;
+    }
+    m_weight.swap(weights);
+    return true;
+}
+
 /*!
  * Evaluates the displacements value with RBF . Supported in all modes.
  * Use weights, RBF node positions and m_effectiveSR (support radius structure) of each RBF node
   to retrive the deformation field.
+ * In compact support mode, if the nodes bucket grid is built (see buildNodeGrid),
+ * only the nodes whose support contains the point are visited.
+ * With global support, if the nodes tree is built and the weights aggregated on it
+ * (see buildNodeTree and updateNodeTreeWeights), the hierarchical approximation is used.
+ * The method does not modify the class members, so it can be safely called concurrently
+ * on different points (see multithreaded evaluation in execute).
  *
  * \param[in] point point where to evaluate the basis
  * \return array containing interpolated/parameterized values of displacements.
@@ -1206,12 +1957,54 @@ MRBF::computeEffectiveSupportRadiusList(){
  */
 std::vector<double>
 MRBF::evalRBF( const std::array<double,3> &point){
+    long napprox;
+    return evalRBF(point, napprox);
+}
+
+/*!
+ * Evaluates the displacements value with RBF, as evalRBF(point), returning also the
+ * number of clusters approximated by their centroid in the hierarchical evaluation.
+ * The method does not modify the class members, so it can be safely called concurrently
+ * on different points.
+ *
+ * \param[in] point point where to evaluate the basis
+ * \param[out] napprox number of far-field approximations used (0 if the evaluation is exact)
+ * \return array containing interpolated/parameterized values of displacements.
+ *
+ */
+std::vector<double>
+MRBF::evalRBF( const std::array<double,3> &point, long & napprox){
 
+    napprox = 0;
     int datasize = getDataCount();
     std::vector<double> values(datasize, 0.0);
     int                 i, j;
     double              dist, basis;
 
+    // compact support with nodes bucket grid available: visit only the nodes
+    // whose support overlaps the cell containing the point.
+    if(!m_gridOffsets.empty()){
+        long cell = locateNodeGridCell(point);
+        if(cell < 0)    return values;
+        for(long k=m_gridOffsets[cell]; k<m_gridOffsets[cell+1]; ++k){
+            i = m_gridNodes[k];
+            if( !m_activeNodes[i] ) continue;
+            dist = norm2(point - m_node[i]) / m_effectiveSR[i];
+            if( dist > 1.0 ) continue;
+            basis = evalBasis( dist );
+            for( j=0; j<datasize; ++j) {
+                values[j] += basis * m_weight[j][i];
+            }
+        }
+        return values;
+    }
+
+    // global support with nodes tree and aggregated weights available: hierarchical evaluation.
+    if(!m_nodeTree.weights.empty()){
+        napprox = evalNodeTree(point, m_weight, values);
+        return values;
+    }
+
     for( i=0; i<m_nodes; ++i ){
         if( m_activeNodes[i] ) {
 
@@ -1234,6 +2027,7 @@ MRBF::evalRBF( const std::array<double,3> &point){
  */
 void
 MRBF::setMode(MRBFSol solver){
+	setDirty();
 	m_solver = solver;
 	if (m_solver == MRBFSol::NONE)    RBF::setMode(bitpit::RBFMode::PARAM);
 	else                            RBF::setMode(bitpit::RBFMode::INTERP);
@@ -26,6 +26,7 @@
 
 #include "BaseManipulation.hpp"
 #include <bitpit_RBF.hpp>
+#include <functional>
 
 namespace mimmo{
 
@@ -49,10 +50,22 @@ enum class MRBFBasisFunction {
  */
 enum class MRBFSol{
     NONE = 0,     /**< activate class as pure parameterizator. Set freely your RBF coefficients/weights */
-    WHOLE = 1,    /**< activate class as pure interpolator, with RBF coefficients evaluated solving a full linear system for all active nodes.*/
+    WHOLE = 1,    /**< activate class as pure interpolator, with RBF coefficients evaluated solving a full linear system for all active nodes
+                       (sparse system solved iteratively, if compact support is active).*/
     GREEDY= 2   /**< activate class as pure interpolator, with RBF coefficients evaluated using a greedy algorithm on active nodes.*/
 };
 
+/*!
+ * \ingroup manipulators
+ * \brief Linear solver used by MRBF to compute the RBF coefficients in MRBFSol::WHOLE mode
+ */
+enum class MRBFWeightsSolver{
+    NONE = 0,           /**< no linear system solved (MRBFSol::NONE or GREEDY modes, or class not executed).*/
+    DENSE = 1,          /**< dense direct solver of the full system.*/
+    SPARSE = 2,         /**< iterative solver of the sparse system of compact support basis functions.*/
+    HIERARCHICAL = 3    /**< matrix-free iterative solver with the hierarchical evaluation of global support basis functions.*/
+};
+
 /*!
  * \class MRBF
  * \ingroup manipulators
@@ -74,6 +87,14 @@ enum class MRBFSol{
    Use MRBFSol::GREEDY or MRBFSol::WHOLE to activate interpolation features.
  * See bitpit::RBF docs for further information.
 
+    For global support basis functions (non compact) the evaluation of the RBF can be
+    approximated hierarchically (setHierarchicalTolerance): RBF nodes are grouped in a tree
+    of clusters and a cluster is replaced by its centroid whenever the variation of the
+    basis function over it is below the tolerance. The error on a vertex is bounded by the
+    tolerance times the sum of the absolute values of the weights, assuming a monotone
+    basis function. In MRBFSol::WHOLE mode the weights are computed with a matrix-free
+    BiCGSTAB solver using the same approximation (the dense solver is used as fallback).
+
     Support radii of RBF Nodes can be set in 3 different ways:
     - setting x as Local support radius : the effective support radius will be
       calculated as x * bbox_diag, where the last is the diagonal of the RBF set
@@ -134,6 +155,7 @@ enum class MRBFSol{
  * - <B>RBFShape</B>: shape of RBF function see MRBFBasisFunction and bitpit::RBFBasisFunction enums;
  * - <B>Tolerance</B>: greedy engine tolerance (meaningful for Mode 2 only);
  * - <B>DiagonalFactor</B>: factor used to define a threshold to filter geometry vertices (default 1.0);
+ * - <B>HierarchicalTolerance</B>: tolerance of the hierarchical evaluation of global support RBF (default 0.0, i.e. disabled);
  *
     if set, SupportRadiusReal parameter bypass SupportRadiusLocal one.
 
@@ -163,6 +185,39 @@ protected:
     dvector1D    m_effectiveSR; /**< INTERNAL USE list of support radii effectively used for each RBF */
     bool         m_isCompact;   /**< If true the basis function is used with compact support, i.e. it is supposed different from 0 and evaluated only inside the support radius.*/
 
+    std::array<double,3> m_gridOrigin;  /**< INTERNAL USE origin of the bucket grid indexing RBF nodes supports in compact mode.*/
+    std::array<long,3>   m_gridDim;     /**< INTERNAL USE number of cells of the bucket grid in each direction.*/
+    double               m_gridSpacing; /**< INTERNAL USE size of the cells of the bucket grid.*/
+    std::vector<long>    m_gridOffsets; /**< INTERNAL USE offsets of the nodes lists of each cell in m_gridNodes (empty if the grid is not built).*/
+    std::vector<int>     m_gridNodes;   /**< INTERNAL USE indices of the RBF nodes whose support overlaps each cell of the bucket grid.*/
+
+    /*!
+     * \brief INTERNAL USE binary tree of clusters of RBF nodes, used by the hierarchical evaluation
+     * of global support basis functions. Clusters are stored in depth-first order, the children
+     * of a cluster always follow it.
+     */
+    struct NodeTree{
+        std::vector<int>    nodes;      /**< RBF node indices, contiguous for each cluster.*/
+        std::vector<int>    begin;      /**< first position in nodes of each cluster.*/
+        std::vector<int>    end;        /**< past-the-end position in nodes of each cluster.*/
+        std::vector<int>    child;      /**< first child of each cluster (the second one is the next index), -1 for leaves.*/
+        dvecarr3E           center;     /**< centroid of each cluster.*/
+        dvector1D           radius;     /**< maximum distance of the cluster nodes from the centroid.*/
+        dvector1D           srMin;      /**< minimum support radius of the cluster nodes.*/
+        dvector1D           srMax;      /**< maximum support radius of the cluster nodes.*/
+        dvector1D           srMean;     /**< mean support radius of the cluster nodes.*/
+        dvector1D           weights;    /**< sum of the weights of the active cluster nodes, for each field (cluster major).*/
+        int                 nfields;    /**< number of fields stored in weights.*/
+
+        NodeTree();
+        void clear();
+    };
+
+    double       m_hierarchicalTol; /**< Tolerance of the hierarchical evaluation of global support RBF; disabled if <= 0.*/
+    NodeTree     m_nodeTree;        /**< INTERNAL USE tree of RBF nodes clusters used by the hierarchical evaluation.*/
+    long         m_farFieldCount;   /**< Number of far-field cluster approximations used in the last evaluation of the deformation on the geometry.*/
+    MRBFWeightsSolver m_weightsSolver; /**< Linear solver used to compute the weights in the last execution.*/
+
     MimmoSharedPointer<MimmoObject> m_rbfgeometry; /**< RBF geometry. The vertices of this object are used as RBF nodes.*/
     dmpvecarr3E* m_rbfdispl;         /**<RBF nodes displacements as vectors, when a RBF point cloud MimmoObject is linked.*/
     dmpvector1D* m_rbfScalarDispl;  /**< RBF nodes displacements as scalars, when a RBF point cloud MimmoObject is linked.*/
@@ -190,6 +245,9 @@ public:
     bool            isVariableSupportRadiusSet();
     dvector1D &     getEffectivelyUsedSupportRadii();
     double          getDiagonalFactor();
+    double          getHierarchicalTolerance();
+    long            getFarFieldApproximationsCount();
+    MRBFWeightsSolver getWeightsSolver();
 
     int             getFunctionType();
     dmpvecarr3E*    getDisplacements();
@@ -214,6 +272,7 @@ public:
     void            setVariableSupportRadii(dvector1D sradii);
     void            setVariableSupportRadii(dmpvector1D* sradii);
     void            setDiagonalFactor(double diagonalFactor);
+    void            setHierarchicalTolerance(double tol);
 
 BITPIT_DEPRECATED(
     void            setSupportRadiusValue(double suppR_));
@@ -245,12 +304,25 @@ protected:
     virtual void    plotOptionalResults();
 
     void            computeEffectiveSupportRadiusList();
+    void            buildNodeGrid();
+    void            clearNodeGrid();
+    long            locateNodeGridCell(const std::array<double,3> & point);
+    bool            solveSparse();
+
+    void            buildNodeTree();
+    void            updateNodeTreeWeights(const dvector2D & weights);
+    long            evalNodeTree(const std::array<double,3> & point, const dvector2D & weights, std::vector<double> & values);
+    bool            solveHierarchical();
+    bool            solveBiCGSTAB(const std::function<void(const std::vector<double> &, std::vector<double> &)> & matVec,
+                                  const std::vector<double> & invDiag, const std::vector<double> & b,
+                                  std::vector<double> & x, double tolerance, int maxIterations);
 
     bool             initRBFwGeometry();
 
     //reimplemented from RBFKernel
     void            setMode(MRBFSol solver);
     std::vector<double> evalRBF(const std::array<double,3> & val);
+    std::vector<double> evalRBF(const std::array<double,3> & val, long & napprox);
 
 private:
 
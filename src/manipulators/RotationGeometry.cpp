@@ -116,6 +116,7 @@ RotationGeometry::buildPorts(){
  */
 void
 RotationGeometry::setAxis(darray3E origin, darray3E direction){
+    setDirty();
     m_origin = origin;
     m_direction = direction;
 }
@@ -125,6 +126,7 @@ RotationGeometry::setAxis(darray3E origin, darray3E direction){
  */
 void
 RotationGeometry::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
 }
 
@@ -133,6 +135,7 @@ RotationGeometry::setOrigin(darray3E origin){
  */
 void
 RotationGeometry::setDirection(darray3E direction){
+    setDirty();
     m_direction = direction;
     double L = norm2(m_direction);
     for (int i=0; i<3; i++)
@@ -144,6 +147,7 @@ RotationGeometry::setDirection(darray3E direction){
  */
 void
 RotationGeometry::setRotation(double alpha){
+    setDirty();
     m_alpha = alpha;
 }
 
@@ -153,6 +157,7 @@ RotationGeometry::setRotation(double alpha){
  */
 void
 RotationGeometry::setFilter(dmpvector1D *filter){
+    setDirty();
     if(!filter) return;
     m_filter = *filter;
 }
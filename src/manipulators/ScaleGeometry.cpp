@@ -112,6 +112,7 @@ ScaleGeometry::buildPorts(){
  */
 void
 ScaleGeometry::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
 }
 
@@ -120,6 +121,7 @@ ScaleGeometry::setOrigin(darray3E origin){
  */
 void
 ScaleGeometry::setMeanPoint(bool meanP){
+    setDirty();
     m_meanP = meanP;
 }
 
@@ -128,6 +130,7 @@ ScaleGeometry::setMeanPoint(bool meanP){
  */
 void
 ScaleGeometry::setScaling(darray3E scaling){
+    setDirty();
     m_scaling = scaling;
 }
 
@@ -137,6 +140,7 @@ ScaleGeometry::setScaling(darray3E scaling){
  */
 void
 ScaleGeometry::setFilter(dmpvector1D *filter){
+    setDirty();
     if(!filter) return;
     m_filter = *filter;
 }
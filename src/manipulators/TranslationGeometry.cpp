@@ -106,6 +106,7 @@ TranslationGeometry::buildPorts(){
  */
 void
 TranslationGeometry::setDirection(darray3E direction){
+    setDirty();
     m_direction = direction;
     double L = norm2(m_direction);
     for (int i=0; i<3; i++)
@@ -117,6 +118,7 @@ TranslationGeometry::setDirection(darray3E direction){
  */
 void
 TranslationGeometry::setTranslation(double alpha){
+    setDirty();
     m_alpha = alpha;
 }
 
@@ -126,6 +128,7 @@ TranslationGeometry::setTranslation(double alpha){
  */
 void
 TranslationGeometry::setFilter(dmpvector1D *filter){
+    setDirty();
     if(!filter) return;
     m_filter = *filter;
 }
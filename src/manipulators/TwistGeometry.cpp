@@ -120,6 +120,7 @@ TwistGeometry::buildPorts(){
  */
 void
 TwistGeometry::setAxis(darray3E origin, darray3E direction){
+    setDirty();
     m_origin = origin;
     m_direction = direction;
 }
@@ -129,6 +130,7 @@ TwistGeometry::setAxis(darray3E origin, darray3E direction){
  */
 void
 TwistGeometry::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
 }
 
@@ -137,6 +139,7 @@ TwistGeometry::setOrigin(darray3E origin){
  */
 void
 TwistGeometry::setDirection(darray3E direction){
+    setDirty();
     m_direction = direction;
     double L = norm2(m_direction);
     for (int i=0; i<3; i++)
@@ -148,6 +151,7 @@ TwistGeometry::setDirection(darray3E direction){
  */
 void
 TwistGeometry::setTwist(double alpha){
+    setDirty();
     m_alpha = alpha;
 }
 
@@ -156,6 +160,7 @@ TwistGeometry::setTwist(double alpha){
  */
 void
 TwistGeometry::setSym(bool sym){
+    setDirty();
     m_sym = sym;
 }
 
@@ -164,6 +169,7 @@ TwistGeometry::setSym(bool sym){
  */
 void
 TwistGeometry::setMaxDistance(double distance){
+    setDirty();
     m_distance = distance;
 }
 
@@ -173,6 +179,7 @@ TwistGeometry::setMaxDistance(double distance){
  */
 void
 TwistGeometry::setFilter(dmpvector1D *filter){
+    setDirty();
     if(!filter) return;
     m_filter = *filter;
 }
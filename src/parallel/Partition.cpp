@@ -23,6 +23,8 @@
 \*---------------------------------------------------------------------------*/
 #include <Partition.hpp>
 #include <metis.h>
+#include <parmetis.h>
+#include <communications.hpp>
 #include <bitpit_operators.hpp>
 #include <SkdTreeUtils.hpp>
 #include <chrono>
@@ -31,6 +33,71 @@ typedef std::chrono::high_resolution_clock Clock;
 
 namespace mimmo{
 
+/*!
+ * INTERNAL use. Build the dual graph of the cells of a geometry in the compressed format of
+ * METIS/ParMETIS. Graph vertices are the cells in list, graph edges the faces they share with
+ * other cells (ghosts included), mapped to the graph numbering through globalIndex.
+ * \param[in] geometry target geometry, adjacencies built
+ * \param[in] cells local cells, in graph vertex order
+ * \param[in] globalIndex graph index of the cells in list and of their face neighbours
+ * \param[in] cellWeights weights of the cells (default 1)
+ * \param[in] interfaceWeights weights of the interfaces (default 1); interfaces are used only if not empty
+ * \param[in] boundaryConstraint if true a second vertex weight counts the border faces of the cells
+ * \param[out] xadj adjacency offsets
+ * \param[out] adjncy adjacency list
+ * \param[out] vwgt vertex weights, ncon entries per vertex
+ * \param[out] adjwgt edge weights
+ */
+static void
+buildDualGraph(MimmoObject & geometry, const std::vector<long> & cells, const lilimap & globalIndex,
+               const std::unordered_map<long, int> & cellWeights, const std::unordered_map<long, int> & interfaceWeights,
+               bool boundaryConstraint, std::vector<idx_t> & xadj, std::vector<idx_t> & adjncy,
+               std::vector<idx_t> & vwgt, std::vector<idx_t> & adjwgt)
+{
+    bitpit::PatchKernel * patch = geometry.getPatch();
+    bool useInterfaces = !interfaceWeights.empty();
+    if (useInterfaces){
+        geometry.updateInterfaces();
+    }
+
+    int ncon = boundaryConstraint ? 2 : 1;
+    std::size_t nvtxs = cells.size();
+    xadj.assign(nvtxs + 1, 0);
+    vwgt.assign(ncon * nvtxs, 1);
+    adjncy.clear();
+    adjwgt.clear();
+
+    for (std::size_t i = 0; i < nvtxs; ++i){
+        const bitpit::Cell & cell = patch->getCell(cells[i]);
+        auto itW = cellWeights.find(cells[i]);
+        if (itW != cellWeights.end()){
+            vwgt[ncon*i] = idx_t(itW->second);
+        }
+        int nborder = 0;
+        for (int iface = 0; iface < cell.getFaceCount(); ++iface){
+            if (cell.isFaceBorder(iface)){
+                ++nborder;
+                continue;
+            }
+            for (int k = 0; k < cell.getAdjacencyCount(iface); ++k){
+                adjncy.push_back(idx_t(globalIndex.at(cell.getAdjacency(iface, k))));
+                idx_t weight = 1;
+                if (useInterfaces){
+                    auto itI = interfaceWeights.find(cell.getInterface(iface, k));
+                    if (itI != interfaceWeights.end()){
+                        weight = idx_t(itI->second);
+                    }
+                }
+                adjwgt.push_back(weight);
+            }
+        }
+        if (boundaryConstraint){
+            vwgt[ncon*i + 1] = idx_t(nborder);
+        }
+        xadj[i+1] = idx_t(adjncy.size());
+    }
+}
+
 /*!Default constructor of Partition
  */
 Partition::Partition(){
@@ -38,6 +105,9 @@ Partition::Partition(){
 	m_mode = PartitionMethod::NONE;
 	m_partition.clear();
 	m_boundary.reset();
+	m_edgeCut = 0;
+	m_imbalance = 0.0;
+	m_boundaryImbalance = 0.0;
 };
 
 /*!
@@ -50,6 +120,9 @@ Partition::Partition(const bitpit::Config::Section & rootXML){
 	m_mode = PartitionMethod::NONE;
 	m_boundary.reset();
 	m_partition.clear();
+	m_edgeCut = 0;
+	m_imbalance = 0.0;
+	m_boundaryImbalance = 0.0;
 
 	std::string fallback_name = "ClassNONE";
 	std::string input = rootXML.get("ClassName", fallback_name);
@@ -72,6 +145,11 @@ Partition::Partition(const Partition & other):BaseManipulation(other){
 	m_mode = other.m_mode;
 	m_partition = other.m_partition;
 	m_boundary = other.m_boundary;
+	m_cellWeights = other.m_cellWeights;
+	m_interfaceWeights = other.m_interfaceWeights;
+	m_edgeCut = other.m_edgeCut;
+	m_imbalance = other.m_imbalance;
+	m_boundaryImbalance = other.m_boundaryImbalance;
 };
 
 /*! It builds the input/output ports of the object
@@ -103,6 +181,7 @@ Partition::getBoundaryGeometry(){
  */
 void
 Partition::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(geo == nullptr)    return;
     if(m_geometry == geo) return;
     m_geometry = geo;
@@ -113,6 +192,7 @@ Partition::setGeometry(MimmoSharedPointer<MimmoObject> geo){
  */
 void
 Partition::setBoundaryGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(geo == nullptr)    return;
     if(m_boundary == geo) return;
 	m_boundary = geo;
@@ -126,10 +206,64 @@ Partition::setBoundaryGeometry(MimmoSharedPointer<MimmoObject> geo){
  */
 void
 Partition::setPartition(std::unordered_map<long, int> partition){
+	setDirty();
 	m_partition = partition;
 	m_mode = PartitionMethod::CUSTOM;
 };
 
+/*!
+ * It sets the weights of the cells (vertices of the dual graph) used by graph partitioning,
+ * PartitionMethod::PARTGRAPH and PartitionMethod::PARTGEOM. Each process provides the weights
+ * of its own interior cells; cells not in the map have unit weight. The weights of a serial
+ * geometry spread over the processes by PARTGRAPH follow their cells.
+ * \param[in] weights non negative weights of the local cells
+ */
+void
+Partition::setCellWeights(std::unordered_map<long, int> weights){
+	setDirty();
+	m_cellWeights = weights;
+};
+
+/*!
+ * It sets the weights of the interfaces (edges of the dual graph) used by graph partitioning,
+ * PartitionMethod::PARTGRAPH and PartitionMethod::PARTGEOM. The weights are referred to the
+ * local interface ids; interfaces not in the map have unit weight. An interface shared by two
+ * processes has to get the same weight on both of them.
+ * \param[in] weights positive weights of the local interfaces
+ */
+void
+Partition::setInterfaceWeights(std::unordered_map<long, int> weights){
+	setDirty();
+	m_interfaceWeights = weights;
+};
+
+/*!
+ * \return edge-cut (sum of the weights of the cut interfaces) of the last partition computed by
+ * graph partitioning, 0 if not computed.
+ */
+long
+Partition::getEdgeCut(){
+	return m_edgeCut;
+};
+
+/*!
+ * \return imbalance of the last computed partition, as ratio between the maximum and the
+ * average cell weight per process; 0 if not computed.
+ */
+double
+Partition::getImbalance(){
+	return m_imbalance;
+};
+
+/*!
+ * \return imbalance of the boundary geometry cells per process of the last computed partition,
+ * as ratio between maximum and average; 0 if not computed.
+ */
+double
+Partition::getBoundaryImbalance(){
+	return m_boundaryImbalance;
+};
+
 /*!
  * It sets partition method of partition block
  * \param[in] mode partition method
@@ -137,7 +271,8 @@ Partition::setPartition(std::unordered_map<long, int> partition){
  */
 void
 Partition::setPartitionMethod(PartitionMethod mode){
-	if (mode != PartitionMethod::PARTGEOM && mode != PartitionMethod::SERIALIZE &&
+	setDirty();
+	if (mode != PartitionMethod::PARTGEOM && mode != PartitionMethod::PARTGRAPH && mode != PartitionMethod::SERIALIZE &&
 	        mode != PartitionMethod::CUSTOM && mode != PartitionMethod::NONE)
 	    throw std::runtime_error(m_name + " : partition method not allowed");
 
@@ -151,6 +286,7 @@ Partition::setPartitionMethod(PartitionMethod mode){
  */
 void
 Partition::setPartitionMethod(int mode){
+	setDirty();
 	if (mode != -1 && mode != 0 && mode != 1 && mode != 2)
 		throw std::runtime_error(m_name + " : partition method not allowed");
 
@@ -194,13 +330,19 @@ Partition::execute(){
             throw std::runtime_error(m_name + " : partition size different from number of cells");
     }
 
-    if (m_mode == PartitionMethod::PARTGEOM || m_mode == PartitionMethod::SERIALIZE || m_mode == PartitionMethod::CUSTOM)
+    if (m_mode == PartitionMethod::PARTGEOM || m_mode == PartitionMethod::PARTGRAPH ||
+            m_mode == PartitionMethod::SERIALIZE || m_mode == PartitionMethod::CUSTOM)
     {
 
         // Force build adjacencies if not built
         // TODO Reset adjacencies if not already computed?
         getGeometry()->updateAdjacencies();
 
+        // Spread the cells on all the processes before distributed graph partitioning
+        if(m_mode == PartitionMethod::PARTGRAPH){
+            blockPartition();
+        }
+
         // Compute partition if not custom
         if(m_mode != PartitionMethod::CUSTOM){
             computePartition();
@@ -214,79 +356,78 @@ Partition::execute(){
             }
         }
 
-        // Clean structures to be destroyed/reset
-        getGeometry()->cleanPointConnectivity();
-        getGeometry()->cleanPatchInfo();
-        getGeometry()->cleanSkdTree();
-        getGeometry()->cleanKdTree();
-        getGeometry()->cleanBoundingBox();
-#if MIMMO_ENABLE_MPI
-        getGeometry()->resetPointGhostExchangeInfo();
-#endif
-
-        // Partition/Serialize the geometry
-        getGeometry()->getPatch()->partition(m_partition, false, true);
-        if (m_mode == PartitionMethod::SERIALIZE){
-            // Sort cells and vertices with Id
-            //getGeometry()->getPatch()->sortCells();
-            getGeometry()->getPatch()->sortVertices();
+        // Evaluate and report the quality of the partition
+        m_imbalance = evalImbalance(getGeometry(), m_partition, &m_cellWeights);
+        (*m_log)<<m_name<<" : partition imbalance "<<m_imbalance;
+        if (m_mode == PartitionMethod::PARTGEOM || m_mode == PartitionMethod::PARTGRAPH){
+            (*m_log)<<", edge-cut "<<m_edgeCut;
         }
+        (*m_log)<<std::endl;
 
-        // Adjacencies Sync and Interfaces Sync not changed by partition,
-        // the bitpit partitioning maintains adjacencies and
-        // interfaces if already synchronized
-
-        // Update geometry
-        getGeometry()->update();
-
-        // Resync PID
-        //TODO Add resyncPID to update method of mimmoobject with syncstatus of pid
-        getGeometry()->resyncPID();
+        // Partition/Serialize the geometry
+        applyPartition(getGeometry(), m_partition);
 
         // Partition boundary geometry
         if (getBoundaryGeometry() != nullptr){
             if (getGeometry()->getType() == 2 && getBoundaryGeometry()->getType() == 1){
 
+                m_boundaryImbalance = evalImbalance(getBoundaryGeometry(), m_boundarypartition, nullptr);
+                (*m_log)<<m_name<<" : boundary partition imbalance "<<m_boundaryImbalance<<std::endl;
+
                 // Force build adjacencies
                 getBoundaryGeometry()->updateAdjacencies();
 
-                // Clean structures to be destroyed
-                getBoundaryGeometry()->cleanPointConnectivity();
-                getBoundaryGeometry()->cleanPatchInfo();
-                getBoundaryGeometry()->cleanSkdTree();
-                getBoundaryGeometry()->cleanKdTree();
-                getBoundaryGeometry()->cleanBoundingBox();
-        #if MIMMO_ENABLE_MPI
-                getBoundaryGeometry()->resetPointGhostExchangeInfo();
-        #endif
-
-                // Boundary partition
-                getBoundaryGeometry()->getPatch()->partition(m_boundarypartition, false, true);
-                if (m_mode == PartitionMethod::SERIALIZE){
-                    // Sort cells and vertices with Id
-                    //getBoundaryGeometry()->getPatch()->sortCells();
-                    getBoundaryGeometry()->getPatch()->sortVertices();
-                }
-
-                // Adjacencies Sync and Interfaces Sync not changed by partition,
-                // the bitpit partitioning maintains adjacencies and
-                // interfaces if already synchronized
-
                 // Update ID of boundary vertices
                 //NO UPDATE BECAUSE BITPIT ASSIGN THE SAME IDS DURING PARTITION (FROM SERIAL TO PARTITION IS TRUE AND VICEVERSA IF NOT MODIFIED)
                 // updateBoundaryVerticesID();
 
-                // Update boundary geometry
-                getBoundaryGeometry()->update();
-
-                // Resync PID
-                getBoundaryGeometry()->resyncPID();
-
+                // Boundary partition
+                applyPartition(getBoundaryGeometry(), m_boundarypartition);
             }
         }
     } // end if partition mode
 };
 
+/*!
+ * It partitions a geometry according to a partition structure, cleaning and updating
+ * the MimmoObject structures affected.
+ * \param[in] geometry target geometry
+ * \param[in] partition partition structure, final rank of the local cells.
+ */
+void
+Partition::applyPartition(MimmoSharedPointer<MimmoObject> geometry, std::unordered_map<long, int> & partition){
+
+    // Clean structures to be destroyed/reset
+    geometry->cleanPointConnectivity();
+    geometry->cleanPatchInfo();
+    geometry->cleanSkdTree();
+    geometry->cleanKdTree();
+    geometry->cleanBoundingBox();
+    geometry->cleanVerticesCoordsSoA();
+#if MIMMO_ENABLE_MPI
+    geometry->resetPointGhostExchangeInfo();
+#endif
+
+    // Partition/Serialize the geometry
+    geometry->getPatch()->partition(partition, false, true);
+    if (m_mode == PartitionMethod::SERIALIZE){
+        // Sort cells and vertices with Id
+        //geometry->getPatch()->sortCells();
+        geometry->getPatch()->sortVertices();
+    }
+
+    // Adjacencies Sync and Interfaces Sync not changed by partition,
+    // the bitpit partitioning maintains adjacencies and
+    // interfaces if already synchronized
+
+    // Update geometry
+    geometry->update();
+
+    // Resync PID
+    //TODO Add resyncPID to update method of mimmoobject with syncstatus of pid
+    geometry->resyncPID();
+};
+
 /*!
  * It computes the partition structure by using the chosen method.
  * The partition structure if empty is filled after the call.
@@ -300,6 +441,9 @@ Partition::computePartition(){
 	case PartitionMethod::PARTGEOM:
 		parmetisPartGeom();
 		break;
+	case PartitionMethod::PARTGRAPH:
+		parmetisPartGraph();
+		break;
 	default:
 		break;
 	}
@@ -321,6 +465,8 @@ Partition::parmetisPartGeom(){
 		lilimap mapcell = getGeometry()->getMapCell();
 		lilimap mapcellinv = getGeometry()->getMapCellInv();
 
+		// METIS runs on rank 0 only: its status is shared to fail on all the processes.
+		int metisStatus = METIS_OK;
 		if (m_rank == 0){
 
 			// Use cell centers as vertices of graph
@@ -332,35 +478,18 @@ Partition::parmetisPartGeom(){
 
 			//
 			// Number of balancing constraints, which must be at least 1.
+			// The border faces of the cells are balanced too if a boundary geometry is linked.
 			//
-			idx_t ncon = 1;
-
-
-			// Build Adjacencies
-			std::vector<idx_t> xadj(nvtxs+1);
-
-			idx_t duenedges = 0;
-			for (int i=0; i<getGeometry()->getNInternals(); i++){
-				duenedges += getGeometry()->getPatch()->getCell(mapcell[i]).getAdjacencyCount();
-			}
+			bool boundaryConstraint = (getBoundaryGeometry() != nullptr && getGeometry()->getType() == 2 && getBoundaryGeometry()->getType() == 1);
+			idx_t ncon = boundaryConstraint ? 2 : 1;
 
-			std::vector<idx_t> adjncy(duenedges);
-
-			idx_t i;
-			idx_t j=0;
-			std::vector<long> neighs;
-			for (i=0; i<getGeometry()->getNInternals(); i++){
-				xadj[i] = j;
-				neighs.clear();
-				getGeometry()->getPatch()->findCellFaceNeighs(mapcell[i], &neighs);
-				for (long id : neighs){
-					if (id > 0){
-						adjncy[j] = idx_t(mapcellinv[id]);
-						j++;
-					}
-				}
+			// Build the dual graph of the cells
+			std::vector<long> cells(nvtxs);
+			for (idx_t i=0; i<nvtxs; i++){
+				cells[i] = mapcell[i];
 			}
-			xadj[i] = j;
+			std::vector<idx_t> xadj, adjncy, vwgt, adjwgt;
+			buildDualGraph(*getGeometry(), cells, mapcellinv, m_cellWeights, m_interfaceWeights, boundaryConstraint, xadj, adjncy, vwgt, adjwgt);
 
 			idx_t nParts = getGeometry()->getProcessorCount();
 
@@ -374,8 +503,9 @@ Partition::parmetisPartGeom(){
 			//
 			std::vector<idx_t> part(nvtxs);
 
-			int ret = METIS_PartGraphKway ( &nvtxs, &ncon, xadj.data(), adjncy.data(), nullptr, nullptr,
-					nullptr, &nParts, nullptr, nullptr, nullptr, &objval, part.data() );
+			metisStatus = METIS_PartGraphKway ( &nvtxs, &ncon, xadj.data(), adjncy.data(), vwgt.data(), nullptr,
+					adjwgt.data(), &nParts, nullptr, nullptr, nullptr, &objval, part.data() );
+			m_edgeCut = long(objval);
 
 			m_partition.clear();
 			m_partition.reserve(nvtxs);
@@ -383,9 +513,296 @@ Partition::parmetisPartGeom(){
 				m_partition[mapcell[i]] = part[i];
 			}
 		}
+		MPI_Bcast(&metisStatus, 1, MPI_INT, 0, m_communicator);
+		if (metisStatus != METIS_OK){
+			throw std::runtime_error(m_name + " : METIS graph partitioning failed.");
+		}
+		MPI_Bcast(&m_edgeCut, 1, MPI_LONG, 0, m_communicator);
 	} // end if geometry is not distributed
 }
 
+/*!
+ * It spreads the cells of the geometry on all the processes in contiguous blocks of their
+ * local order (rank 0 first), if any process has no interior cells, as a serial geometry.
+ * It is the preliminary step of distributed graph partitioning, which needs cells on
+ * every process; no graph is built. Cell and interface weights follow their cells.
+ */
+void
+Partition::blockPartition(){
+
+	MimmoSharedPointer<MimmoObject> geometry = getGeometry();
+	const MPI_Comm & comm = geometry->getCommunicator();
+	int nprocs = geometry->getProcessorCount();
+
+	long nlocal = geometry->getNInternals();
+	long nmin = nlocal;
+	MPI_Allreduce(MPI_IN_PLACE, &nmin, 1, MPI_LONG, MPI_MIN, comm);
+	if (nmin > 0){
+		return;
+	}
+
+	long offset = 0;
+	MPI_Exscan(&nlocal, &offset, 1, MPI_LONG, MPI_SUM, comm);
+	if (geometry->getRank() == 0){
+		offset = 0;
+	}
+	long nglobal = nlocal;
+	MPI_Allreduce(MPI_IN_PLACE, &nglobal, 1, MPI_LONG, MPI_SUM, comm);
+	if (nglobal < long(nprocs)){
+		throw std::runtime_error(m_name + " : less cells than processes found during graph partition.");
+	}
+
+	std::unordered_map<long, int>().swap(m_partition);
+	m_partition.reserve(nlocal);
+	long index = offset;
+	for (const bitpit::Cell & cell : geometry->getCells()){
+		if (cell.isInterior()){
+			m_partition[cell.getId()] = int((index * nprocs) / nglobal);
+			++index;
+		}
+	}
+
+	// The weights are keyed by local ids: they are moved together with their cells.
+	// Interface weights are referred to the faces of the interior cells, since interfaces
+	// are renumbered by the partitioning; cells keep their ids.
+	int hasWeights[2] = {int(!m_cellWeights.empty()), int(!m_interfaceWeights.empty())};
+	MPI_Allreduce(MPI_IN_PLACE, hasWeights, 2, MPI_INT, MPI_MAX, comm);
+	if (!hasWeights[0] && !hasWeights[1]){
+		applyPartition(geometry, m_partition);
+		return;
+	}
+
+	// Packed weights of each interior cell: id, cell weight (-1 if not set), number of
+	// weighted faces and their (face, adjacency, weight) triplets.
+	int myrank = geometry->getRank();
+	if (hasWeights[1]){
+		geometry->updateInterfaces();
+	}
+	std::vector<long> kept;
+	std::unordered_map<int, std::vector<long>> sent;
+	for (const bitpit::Cell & cell : geometry->getCells()){
+		if (!cell.isInterior()) continue;
+		long id = cell.getId();
+		int rank = m_partition.at(id);
+		std::vector<long> & packed = (rank == myrank) ? kept : sent[rank];
+		auto itW = m_cellWeights.find(id);
+		packed.push_back(id);
+		packed.push_back((itW != m_cellWeights.end()) ? long(itW->second) : -1);
+		std::size_t countPos = packed.size();
+		packed.push_back(0);
+		if (m_interfaceWeights.empty()) continue;
+		for (int iface = 0; iface < cell.getFaceCount(); ++iface){
+			if (cell.isFaceBorder(iface)) continue;
+			for (int k = 0; k < cell.getAdjacencyCount(iface); ++k){
+				auto itI = m_interfaceWeights.find(cell.getInterface(iface, k));
+				if (itI == m_interfaceWeights.end()) continue;
+				packed.push_back(long(iface));
+				packed.push_back(long(k));
+				packed.push_back(long(itI->second));
+				++packed[countPos];
+			}
+		}
+	}
+
+	std::vector<long> received;
+	{
+		std::unique_ptr<bitpit::DataCommunicator> dataCommunicator(new bitpit::DataCommunicator(comm));
+		for (auto & entry : sent){
+			dataCommunicator->setSend(entry.first, (entry.second.size() + 1) * sizeof(long));
+			bitpit::SendBuffer & buffer = dataCommunicator->getSendBuffer(entry.first);
+			buffer << long(entry.second.size());
+			for (long value : entry.second){
+				buffer << value;
+			}
+			dataCommunicator->startSend(entry.first);
+		}
+
+		dataCommunicator->discoverRecvs();
+		dataCommunicator->startAllRecvs();
+
+		int nCompletedRecvs = 0;
+		long size, value;
+		while (nCompletedRecvs < dataCommunicator->getRecvCount()){
+			int rank = dataCommunicator->waitAnyRecv();
+			bitpit::RecvBuffer & buffer = dataCommunicator->getRecvBuffer(rank);
+			buffer >> size;
+			for (long i = 0; i < size; ++i){
+				buffer >> value;
+				received.push_back(value);
+			}
+			++nCompletedRecvs;
+		}
+
+		dataCommunicator->waitAllSends();
+		dataCommunicator->finalize();
+	}
+
+	applyPartition(geometry, m_partition);
+
+	// Weights of the cells now owned, interface weights on the new interfaces
+	std::unordered_map<long, int>().swap(m_cellWeights);
+	std::unordered_map<long, int>().swap(m_interfaceWeights);
+	if (hasWeights[1] && geometry->getInterfacesSyncStatus() != SyncStatus::SYNC){
+		geometry->updateInterfaces();
+	}
+	bitpit::PatchKernel * patch = geometry->getPatch();
+	for (const std::vector<long> * packed : {&kept, &received}){
+		std::size_t pos = 0;
+		while (pos < packed->size()){
+			long id = (*packed)[pos];
+			long weight = (*packed)[pos+1];
+			long nfaces = (*packed)[pos+2];
+			pos += 3;
+			if (weight >= 0){
+				m_cellWeights[id] = int(weight);
+			}
+			const bitpit::Cell & cell = patch->getCell(id);
+			for (long i = 0; i < nfaces; ++i, pos += 3){
+				m_interfaceWeights[cell.getInterface(int((*packed)[pos]), int((*packed)[pos+1]))] = int((*packed)[pos+2]);
+			}
+		}
+	}
+}
+
+/*!
+ * It computes the partition structure of a distributed geometry by the distributed multilevel
+ * k-way graph partitioning of ParMETIS. Each process builds the dual graph of its interior cells
+ * only; the graph indices of the ghost cells are received from their owners.
+ * The cell weights of the first constraint are taken by setCellWeights, the edge weights by
+ * setInterfaceWeights. If a boundary geometry is linked, the number of border faces of the cells
+ * is balanced as second constraint.
+ */
+void
+Partition::parmetisPartGraph(){
+
+	MimmoSharedPointer<MimmoObject> geometry = getGeometry();
+	MPI_Comm comm = geometry->getCommunicator();
+	int nprocs = geometry->getProcessorCount();
+	int myrank = geometry->getRank();
+
+	// Contiguous graph numbering of the interior cells over the processes
+	std::vector<long> cells;
+	cells.reserve(geometry->getNInternals());
+	for (const bitpit::Cell & cell : geometry->getCells()){
+		if (cell.isInterior()){
+			cells.push_back(cell.getId());
+		}
+	}
+	idx_t nlocal = idx_t(cells.size());
+	std::vector<idx_t> vtxdist(nprocs + 1, 0);
+	MPI_Allgather(&nlocal, 1, IDX_T, vtxdist.data() + 1, 1, IDX_T, comm);
+	for (int i = 0; i < nprocs; ++i){
+		vtxdist[i+1] += vtxdist[i];
+	}
+
+	lilimap globalIndex;
+	globalIndex.reserve(geometry->getNCells());
+	for (idx_t i = 0; i < nlocal; ++i){
+		globalIndex[cells[i]] = long(vtxdist[myrank] + i);
+	}
+
+	// Graph indices of the ghost cells from their owners
+	{
+		std::unique_ptr<bitpit::DataCommunicator> dataCommunicator(new bitpit::DataCommunicator(comm));
+		for (const auto & entry : geometry->getPatch()->getGhostCellExchangeSources()){
+			const int rank = entry.first;
+			const auto & list = entry.second;
+			dataCommunicator->setSend(rank, list.size() * sizeof(long));
+			bitpit::SendBuffer & buffer = dataCommunicator->getSendBuffer(rank);
+			for (long id : list){
+				buffer << globalIndex.at(id);
+			}
+			dataCommunicator->startSend(rank);
+		}
+
+		dataCommunicator->discoverRecvs();
+		dataCommunicator->startAllRecvs();
+
+		int nCompletedRecvs = 0;
+		long index;
+		while (nCompletedRecvs < dataCommunicator->getRecvCount()){
+			int rank = dataCommunicator->waitAnyRecv();
+			bitpit::RecvBuffer & buffer = dataCommunicator->getRecvBuffer(rank);
+			for (long id : geometry->getPatch()->getGhostCellExchangeTargets(rank)){
+				buffer >> index;
+				globalIndex[id] = index;
+			}
+			++nCompletedRecvs;
+		}
+
+		dataCommunicator->waitAllSends();
+		dataCommunicator->finalize();
+	}
+
+	// Local part of the distributed dual graph
+	bool boundaryConstraint = (getBoundaryGeometry() != nullptr && geometry->getType() == 2 && getBoundaryGeometry()->getType() == 1);
+	std::vector<idx_t> xadj, adjncy, vwgt, adjwgt;
+	buildDualGraph(*geometry, cells, globalIndex, m_cellWeights, m_interfaceWeights, boundaryConstraint, xadj, adjncy, vwgt, adjwgt);
+
+	idx_t wgtflag = 3;
+	idx_t numflag = 0;
+	idx_t ncon = boundaryConstraint ? 2 : 1;
+	idx_t nparts = idx_t(nprocs);
+	std::vector<real_t> tpwgts(ncon * nparts, real_t(1.0) / real_t(nparts));
+	std::vector<real_t> ubvec(ncon, real_t(1.05));
+	idx_t options[3] = {0, 0, 0};
+	idx_t edgecut = 0;
+	std::vector<idx_t> part(std::max(nlocal, idx_t(1)));
+
+	int ret = ParMETIS_V3_PartKway(vtxdist.data(), xadj.data(), adjncy.data(), vwgt.data(), adjwgt.data(),
+			&wgtflag, &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), options, &edgecut, part.data(), &comm);
+	if (ret != METIS_OK){
+		throw std::runtime_error(m_name + " : ParMETIS graph partitioning failed.");
+	}
+	m_edgeCut = long(edgecut);
+
+	std::unordered_map<long, int>().swap(m_partition);
+	m_partition.reserve(nlocal);
+	for (idx_t i = 0; i < nlocal; ++i){
+		m_partition[cells[i]] = int(part[i]);
+	}
+}
+
+/*!
+ * It evaluates the imbalance of a partition as the ratio between the maximum and the
+ * average weight assigned to the processes. Local cells not in the partition stay on
+ * the current process.
+ * \param[in] geometry partitioned geometry
+ * \param[in] partition partition structure of the local cells
+ * \param[in] weights (optional) weights of the cells (default 1); if null all cells have unit weight.
+ * \return imbalance of the partition
+ */
+double
+Partition::evalImbalance(MimmoSharedPointer<MimmoObject> geometry, const std::unordered_map<long, int> & partition, const std::unordered_map<long, int> * weights){
+
+	int nprocs = geometry->getProcessorCount();
+	int myrank = geometry->getRank();
+	std::vector<double> loads(nprocs, 0.0);
+	for (const bitpit::Cell & cell : geometry->getCells()){
+		if (!cell.isInterior()) continue;
+		long id = cell.getId();
+		auto itP = partition.find(id);
+		int rank = (itP != partition.end()) ? itP->second : myrank;
+		double weight = 1.0;
+		if (weights){
+			auto itW = weights->find(id);
+			if (itW != weights->end()) weight = double(itW->second);
+		}
+		loads[rank] += weight;
+	}
+	MPI_Allreduce(MPI_IN_PLACE, loads.data(), nprocs, MPI_DOUBLE, MPI_SUM, geometry->getCommunicator());
+
+	double total = 0.0, maxload = 0.0;
+	for (double load : loads){
+		total += load;
+		maxload = std::max(maxload, load);
+	}
+	if (total <= 0.0){
+		return 1.0;
+	}
+	return maxload * double(nprocs) / total;
+}
+
 /*!
  * It computes the partition structure to communicate the entire mesh to processor with rank 0.
  */
@@ -427,6 +844,9 @@ Partition::computeBoundaryPartition()
 
 		} // end if geometry is distributed
 	}
+	else if (m_mode == PartitionMethod::PARTGRAPH){
+		graphBoundaryPartition();
+	}
 	else{
 
 		if (!(getBoundaryGeometry()->isDistributed())){
@@ -487,6 +907,111 @@ Partition::computeBoundaryPartition()
 	} // end if mode is not serialize
 }
 
+/*!
+ * It computes the boundary patch partition coherently with the volume partition computed by
+ * distributed graph partitioning. Serial and distributed boundary geometries are supported.
+ * Each process matches the centers of the border faces of its interior volume cells with the
+ * closest boundary cells over all the processes, and sends to their owners the final rank of
+ * the volume cell; the closest match is kept for each boundary cell.
+ */
+void
+Partition::graphBoundaryPartition()
+{
+	MimmoSharedPointer<MimmoObject> boundary = getBoundaryGeometry();
+	MPI_Comm comm = boundary->getCommunicator();
+	int nprocs = boundary->getProcessorCount();
+
+	std::unordered_map<long, int>().swap(m_boundarypartition);
+
+	// Build Skd Tree to find correspondence between surface and volume elements
+	boundary->buildSkdTree();
+
+	// Centers of the border faces of the local volume cells and their final rank
+	std::vector<std::array<double,3>> centers;
+	std::vector<double> radii;
+	std::vector<int> destinations;
+	bitpit::PatchKernel * patch = getGeometry()->getPatch();
+	for (const bitpit::Cell & cell : getGeometry()->getCells()){
+		if (!cell.isInterior()) continue;
+		for (int iface=0; iface<cell.getFaceCount(); iface++){
+			if (!cell.isFaceBorder(iface)) continue;
+			std::array<double,3> intercenter({0.,0.,0.});
+			bitpit::ConstProxyVector<long> vertices = cell.getFaceVertexIds(iface);
+			int nV = cell.getFaceVertexCount(iface);
+			for (int iv=0; iv<nV; iv++){
+				intercenter += patch->getVertexCoords(vertices[iv]);
+			}
+			intercenter /= double(nV);
+			centers.push_back(intercenter);
+			radii.push_back(norm2(patch->getVertexCoords(vertices[0]) - intercenter));
+			destinations.push_back(m_partition.at(cell.getId()));
+		}
+	}
+
+	int nP = int(centers.size());
+	std::vector<long> ids(nP, bitpit::Cell::NULL_ID);
+	std::vector<int> ranks(nP, -1);
+	std::vector<double> distances(nP, std::numeric_limits<double>::max());
+	skdTreeUtils::globalDistance(nP, centers.data(), boundary->getSkdTree(), ids.data(), ranks.data(), distances.data(), radii.data(), false);
+
+	// Send matches to the owners of the boundary cells
+	std::vector<std::vector<long>> sendIds(nprocs);
+	std::vector<std::vector<double>> sendData(nprocs);
+	for (int i=0; i<nP; i++){
+		if (ids[i] == bitpit::Cell::NULL_ID || ranks[i] < 0) continue;
+		sendIds[ranks[i]].push_back(ids[i]);
+		sendData[ranks[i]].push_back(double(destinations[i]));
+		sendData[ranks[i]].push_back(distances[i]);
+	}
+
+	std::vector<int> sendCounts(nprocs), recvCounts(nprocs), sendDispls(nprocs, 0), recvDispls(nprocs, 0);
+	for (int i=0; i<nprocs; i++){
+		sendCounts[i] = int(sendIds[i].size());
+	}
+	MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+	for (int i=1; i<nprocs; i++){
+		sendDispls[i] = sendDispls[i-1] + sendCounts[i-1];
+		recvDispls[i] = recvDispls[i-1] + recvCounts[i-1];
+	}
+	int nsend = sendDispls[nprocs-1] + sendCounts[nprocs-1];
+	int nrecv = recvDispls[nprocs-1] + recvCounts[nprocs-1];
+
+	std::vector<long> sendIdsBuffer, recvIdsBuffer(nrecv);
+	std::vector<double> sendDataBuffer, recvDataBuffer(2*nrecv);
+	sendIdsBuffer.reserve(nsend);
+	sendDataBuffer.reserve(2*nsend);
+	for (int i=0; i<nprocs; i++){
+		sendIdsBuffer.insert(sendIdsBuffer.end(), sendIds[i].begin(), sendIds[i].end());
+		sendDataBuffer.insert(sendDataBuffer.end(), sendData[i].begin(), sendData[i].end());
+	}
+	MPI_Alltoallv(sendIdsBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_LONG,
+			recvIdsBuffer.data(), recvCounts.data(), recvDispls.data(), MPI_LONG, comm);
+	for (int i=0; i<nprocs; i++){
+		sendCounts[i] *= 2;
+		sendDispls[i] *= 2;
+		recvCounts[i] *= 2;
+		recvDispls[i] *= 2;
+	}
+	MPI_Alltoallv(sendDataBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_DOUBLE,
+			recvDataBuffer.data(), recvCounts.data(), recvDispls.data(), MPI_DOUBLE, comm);
+
+	// Keep the closest match of each local boundary cell
+	std::unordered_map<long, double> matchDistances;
+	m_boundarypartition.reserve(boundary->getNInternals());
+	for (int i=0; i<nrecv; i++){
+		long id = recvIdsBuffer[i];
+		double distance = recvDataBuffer[2*i+1];
+		auto it = matchDistances.find(id);
+		if (it == matchDistances.end() || distance < it->second){
+			matchDistances[id] = distance;
+			m_boundarypartition[id] = int(recvDataBuffer[2*i]);
+		}
+	}
+
+	// Clean SkdTree
+	boundary->cleanSkdTree();
+}
+
 /*!
  * Update ID of boundary vertices to be coherent with volume vertices
  */
@@ -38,6 +38,7 @@ enum class PartitionMethod{
     NONE = -1, /**< Not set partition method*/
             SERIALIZE = 0, /**< Communicate the whole mesh to rank 0*/
             PARTGEOM = 1, /**< Partition a serial geometry via geometric space filling curve*/
+            PARTGRAPH = 2, /**< Partition a serial or distributed geometry via distributed multilevel graph partitioning*/
             CUSTOM = 99 /**< Partition a serial geometry via custom provided partitioning map*/
 };
 
@@ -52,6 +53,15 @@ enum class PartitionMethod{
  * To parallelize a serial input geometry, the geometry has to be stored entirely on processor with rank = 0.
  * The partition map is computed automatically by the block by set the PartitionMethod::PARTGEOM; a geometric
  * space filling curve is computed by the use of METIS library.
+ * The partition method PartitionMethod::PARTGRAPH partitions serial or already distributed geometries
+ * with the distributed multilevel k-way graph partitioning of ParMETIS: each process builds only the dual
+ * graph of its own cells, so no process holds the whole graph. Serial geometries (or distributed ones with
+ * empty processes) are first spread in contiguous blocks of cells, with no graph involved.
+ * Graph partitioning supports cell (vertex) weights, set by setCellWeights, and interface (edge) weights, set by
+ * setInterfaceWeights. If a boundary geometry is linked, the number of boundary faces of each cell is used as
+ * a second balancing constraint, so that the boundary patch is balanced together with the bulk.
+ * The edge-cut and the imbalance of the computed partition are available after execution
+ * (getEdgeCut, getImbalance, getBoundaryImbalance).
  * The user can set a custom partitioning structure by provide the map through the setPartition method of
  * the class; the function automatically sets the partition method to PartitionMethod::CUSTOM.
  * The default partition method is PartitionMethod::NONE; by leaving the method to the default value
@@ -91,7 +101,7 @@ enum class PartitionMethod{
  * - <B>OutputPlot</B>: target directory for optional results writing.
  *
  * Proper of the class:
- * - <B>PartitionMethod</B>: Partition method.
+ * - <B>PartitionMethod</B>: Partition method (0-SERIALIZE, 1-PARTGEOM, 2-PARTGRAPH).
  *
  * Geometry has to be mandatorily passed through port.
  *
@@ -102,6 +112,11 @@ private:
     PartitionMethod                 m_mode;                 /**<Partition method. Default 1 - Cartesian Axes Subdivision*/
     MimmoSharedPointer<MimmoObject> m_boundary;             /**<Reference to external boundary MimmoObject. */
     std::unordered_map<long, int>   m_boundarypartition;    /**<Partition structure for boundary geometry, i-th term is the final rank of the i-th cell after partitioning.*/
+    std::unordered_map<long, int>   m_cellWeights;          /**<Weights of the local cells in graph partitioning (default 1).*/
+    std::unordered_map<long, int>   m_interfaceWeights;     /**<Weights of the local interfaces in graph partitioning (default 1).*/
+    long                            m_edgeCut;              /**<Edge-cut of the last computed graph partition.*/
+    double                          m_imbalance;            /**<Imbalance of the cell weights of the last computed partition.*/
+    double                          m_boundaryImbalance;    /**<Imbalance of the boundary cells of the last computed partition.*/
 
 public:
     Partition();
@@ -118,6 +133,12 @@ public:
     void setPartitionMethod(PartitionMethod mode);
     void setPartitionMethod(int mode);
     void setPartition(std::unordered_map<long, int> partition);
+    void setCellWeights(std::unordered_map<long, int> weights);
+    void setInterfaceWeights(std::unordered_map<long, int> weights);
+
+    long getEdgeCut();
+    double getImbalance();
+    double getBoundaryImbalance();
 
     void execute();
 
@@ -131,7 +152,12 @@ private:
     void computePartition();
     void computeBoundaryPartition();
     void parmetisPartGeom();
+    void parmetisPartGraph();
+    void blockPartition();
     void serialPartition();
+    void graphBoundaryPartition();
+    void applyPartition(MimmoSharedPointer<MimmoObject> geometry, std::unordered_map<long, int> & partition);
+    double evalImbalance(MimmoSharedPointer<MimmoObject> geometry, const std::unordered_map<long, int> & partition, const std::unordered_map<long, int> * weights);
     void updateBoundaryVerticesID();
 #if MIMMO_ENABLE_MPI
     void serialize(MimmoSharedPointer<MimmoObject> &geometry, bool isBoundary);
@@ -0,0 +1,817 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "GraphLaplMultigrid.hpp"
+
+namespace mimmo{
+
+/*!
+ * Default constructor.
+ */
+GraphLaplMultigrid::GraphLaplMultigrid(){
+    m_n = 0;
+    m_bandRelax = 1.0;
+    m_hierarchy = false;
+    m_tol = 1.0E-12;
+    m_maxIt = 1000;
+    m_iterations = 0;
+    m_residual = 0.0;
+}
+
+/*!
+ * Destructor.
+ */
+GraphLaplMultigrid::~GraphLaplMultigrid(){}
+
+/*!
+ * Release the operator and the multigrid hierarchy.
+ */
+void
+GraphLaplMultigrid::clear(){
+    m_n = 0;
+    std::vector<long>().swap(m_adjOffsets);
+    std::vector<int>().swap(m_adjacency);
+    dvecarr3E().swap(m_coords);
+    dvector1D().swap(m_diffusivity);
+    dvector1D().swap(m_band);
+    m_bandRelax = 1.0;
+    dvector1D().swap(m_rowSum);
+    std::vector<char>().swap(m_fixed);
+    std::vector<Level>().swap(m_levels);
+    m_hierarchy = false;
+    dvector1D().swap(m_coarseLU);
+    std::vector<int>().swap(m_coarsePivots);
+    m_iterations = 0;
+    m_residual = 0.0;
+}
+
+/*!
+ * Build the fine operator from the point adjacency of a mesh. The previous operator,
+ * and constraints, are released.
+ * \param[in] geo target mesh (serial).
+ * \param[in] maplocals map from point ids to consecutive local row indices.
+ * \param[in] diffusivity (optional) diffusivity on points.
+ * \param[in] banddistances (optional) distances of the points of the narrow band from its surfaces.
+ * \param[in] bandrelax narrow band relaxation factor within [0,1].
+ */
+void
+GraphLaplMultigrid::build(MimmoSharedPointer<MimmoObject> geo, const lilimap & maplocals,
+                          MimmoPiercedVector<double> * diffusivity,
+                          const bitpit::PiercedVector<double> * banddistances,
+                          double bandrelax){
+
+    clear();
+    if(!geo)    return;
+
+    if(geo->getPointConnectivitySyncStatus() != SyncStatus::SYNC){
+        geo->buildPointConnectivity();
+    }
+
+    long offset = 0;
+#if MIMMO_ENABLE_MPI
+    offset = geo->getPointGlobalCountOffset();
+#endif
+
+    //point ids of the rows.
+    long n = geo->getNInternalVertices();
+    std::vector<long> ids(n, bitpit::Vertex::NULL_ID);
+    for(long id : geo->getVertices().getIds()){
+        if(!geo->isPointInterior(id))   continue;
+        long ind = maplocals.at(id) - offset;
+        if(ind >= 0 && ind < n)    ids[ind] = id;
+    }
+
+    //adjacency in local row indices, sorted for memory locality.
+    m_adjOffsets.assign(n+1, 0);
+    for(long i=0; i<n; ++i){
+        m_adjOffsets[i+1] = m_adjOffsets[i];
+        if(ids[i] != bitpit::Vertex::NULL_ID){
+            m_adjOffsets[i+1] += long(geo->getPointConnectivity(ids[i]).size());
+        }
+    }
+    m_adjacency.resize(m_adjOffsets[n]);
+    m_coords.assign(n, {{0.0,0.0,0.0}});
+    for(long i=0; i<n; ++i){
+        if(ids[i] == bitpit::Vertex::NULL_ID)   continue;
+        m_coords[i] = geo->getVertexCoords(ids[i]);
+        long k = m_adjOffsets[i];
+        for(long idN : geo->getPointConnectivity(ids[i])){
+            long ind = maplocals.at(idN) - offset;
+            if(ind < 0 || ind >= n){
+                throw std::runtime_error("GraphLaplMultigrid: points adjacency crosses the local rows, only serial meshes are supported");
+            }
+            m_adjacency[k] = int(ind);
+            ++k;
+        }
+        std::sort(m_adjacency.begin() + m_adjOffsets[i], m_adjacency.begin() + m_adjOffsets[i+1]);
+    }
+
+    if(diffusivity){
+        m_diffusivity.assign(n, 1.0);
+        for(long i=0; i<n; ++i){
+            if(ids[i] != bitpit::Vertex::NULL_ID && diffusivity->exists(ids[i])){
+                m_diffusivity[i] = diffusivity->at(ids[i]);
+            }
+        }
+    }
+
+    m_bandRelax = std::max(0.0, std::min(1.0, bandrelax));
+    if(banddistances && !banddistances->empty()){
+        m_band.assign(n, -1.0);
+        for(long i=0; i<n; ++i){
+            if(ids[i] != bitpit::Vertex::NULL_ID && banddistances->exists(ids[i])){
+                m_band[i] = banddistances->at(ids[i]);
+            }
+        }
+    }
+    m_n = n;
+
+    //row normalization of the stencils and diagonal of the fine operator.
+    Level fine;
+    fine.n = n;
+    fine.diag.assign(n, 0.0);
+    m_rowSum.assign(n, 0.0);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(long i=0; i<n; ++i){
+        for(long k=m_adjOffsets[i]; k<m_adjOffsets[i+1]; ++k){
+            m_rowSum[i] += weight(i, k, false);
+            fine.diag[i] += weight(i, k, true);
+        }
+    }
+    m_levels.push_back(std::move(fine));
+
+    m_fixed.assign(n, 0);
+    m_hierarchy = false;
+}
+
+/*!
+ * Set the constrained rows, whose equations are identities (Dirichlet conditions).
+ * The multigrid hierarchy is rebuilt at the next solve only if the constrained rows change.
+ * \param[in] rows local indices of the constrained rows.
+ */
+void
+GraphLaplMultigrid::setConstraints(const std::vector<long> & rows){
+
+    std::vector<char> fixed(m_n, 0);
+    for(long i : rows){
+        if(i >= 0 && i < m_n)   fixed[i] = 1;
+    }
+    if(fixed != m_fixed){
+        m_fixed.swap(fixed);
+        m_hierarchy = false;
+    }
+}
+
+/*!
+ * Set the relative tolerance on the residual of the solver.
+ * \param[in] tol tolerance
+ */
+void
+GraphLaplMultigrid::setTolerance(double tol){
+    m_tol = std::max(std::numeric_limits<double>::min(), tol);
+}
+
+/*!
+ * Set the maximum number of iterations of the solver.
+ * \param[in] maxit maximum number of iterations
+ */
+void
+GraphLaplMultigrid::setMaxIterations(int maxit){
+    m_maxIt = std::max(1, maxit);
+}
+
+/*!
+ * \return true if the operator is built.
+ */
+bool
+GraphLaplMultigrid::isBuilt() const{
+    return !m_levels.empty();
+}
+
+/*!
+ * \return number of rows of the operator.
+ */
+long
+GraphLaplMultigrid::getRowCount() const{
+    return m_n;
+}
+
+/*!
+ * \return number of levels of the current multigrid hierarchy.
+ */
+int
+GraphLaplMultigrid::getLevelCount() const{
+    return int(m_levels.size());
+}
+
+/*!
+ * \return number of iterations of the last solve.
+ */
+int
+GraphLaplMultigrid::getIterationCount() const{
+    return m_iterations;
+}
+
+/*!
+ * \return relative residual of the last solve.
+ */
+double
+GraphLaplMultigrid::getResidual() const{
+    return m_residual;
+}
+
+/*!
+ * \return memory allocated by the operator and the multigrid hierarchy, in bytes.
+ */
+std::size_t
+GraphLaplMultigrid::getMemoryUsage() const{
+
+    std::size_t bytes = sizeof(GraphLaplMultigrid);
+    bytes += m_adjOffsets.capacity()*sizeof(long) + m_adjacency.capacity()*sizeof(int);
+    bytes += m_coords.capacity()*sizeof(std::array<double,3>);
+    bytes += (m_diffusivity.capacity() + m_band.capacity() + m_rowSum.capacity())*sizeof(double);
+    bytes += m_fixed.capacity()*sizeof(char);
+    for(const Level & level : m_levels){
+        bytes += sizeof(Level);
+        bytes += level.offsets.capacity()*sizeof(long) + level.cols.capacity()*sizeof(int);
+        bytes += level.aggregate.capacity()*sizeof(int);
+        bytes += (level.vals.capacity() + level.diag.capacity())*sizeof(double);
+        bytes += (level.x.capacity() + level.b.capacity() + level.r.capacity())*sizeof(double);
+    }
+    bytes += m_coarseLU.capacity()*sizeof(double) + m_coarsePivots.capacity()*sizeof(int);
+    return bytes;
+}
+
+/*!
+ * Weight of an edge of the point adjacency.
+ * \param[in] i row
+ * \param[in] k position of the edge in the adjacency
+ * \param[in] relaxed true to apply the narrow band relaxation.
+ * \return weight of the edge
+ */
+double
+GraphLaplMultigrid::weight(long i, long k, bool relaxed) const{
+
+    int j = m_adjacency[k];
+    const std::array<double,3> & pi = m_coords[i];
+    const std::array<double,3> & pj = m_coords[j];
+    double d2 = (pj[0]-pi[0])*(pj[0]-pi[0]) + (pj[1]-pi[1])*(pj[1]-pi[1]) + (pj[2]-pi[2])*(pj[2]-pi[2]);
+    double w = 1.0/d2;
+    if(!m_diffusivity.empty()){
+        w *= 0.5*(m_diffusivity[i] + m_diffusivity[j]);
+    }
+    if(relaxed && !m_band.empty() && m_band[i] >= 0.0 && m_band[j] > m_band[i]){
+        w *= m_bandRelax;
+    }
+    return w;
+}
+
+/*!
+ * Apply the fine operator, scaled by the stencils normalization: on free rows
+ * y_i = sum_j w_ij (x_i - x_j), on constrained rows y_i = 0.
+ * \param[in] x input vector
+ * \param[out] y result, already sized.
+ */
+void
+GraphLaplMultigrid::applyFine(const dvector1D & x, dvector1D & y) const{
+
+    const dvector1D & diag = m_levels[0].diag;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(long i=0; i<m_n; ++i){
+        if(m_fixed[i]){
+            y[i] = 0.0;
+            continue;
+        }
+        double sum = diag[i]*x[i];
+        for(long k=m_adjOffsets[i]; k<m_adjOffsets[i+1]; ++k){
+            sum -= weight(i, k, true)*x[m_adjacency[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+/*!
+ * Apply the operator of a level of the hierarchy.
+ * \param[in] level target level
+ * \param[in] x input vector
+ * \param[out] y result, already sized.
+ */
+void
+GraphLaplMultigrid::apply(int level, const dvector1D & x, dvector1D & y) const{
+
+    if(level == 0){
+        applyFine(x, y);
+        return;
+    }
+    const Level & L = m_levels[level];
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(long i=0; i<L.n; ++i){
+        double sum = 0.0;
+        for(long e=L.offsets[i]; e<L.offsets[i+1]; ++e){
+            sum += L.vals[e]*x[L.cols[e]];
+        }
+        y[i] = sum;
+    }
+}
+
+/*!
+ * Off-diagonal entries of a row of a level operator, restricted to the free columns.
+ * \param[in] level target level
+ * \param[in] i row
+ * \param[out] row pairs of column and value.
+ */
+void
+GraphLaplMultigrid::getRow(int level, long i, std::vector<std::pair<int,double> > & row) const{
+
+    row.clear();
+    if(level == 0){
+        if(m_fixed[i])  return;
+        for(long k=m_adjOffsets[i]; k<m_adjOffsets[i+1]; ++k){
+            int j = m_adjacency[k];
+            if(m_fixed[j] || j == i)   continue;
+            row.emplace_back(j, -weight(i, k, true));
+        }
+        return;
+    }
+    const Level & L = m_levels[level];
+    for(long e=L.offsets[i]; e<L.offsets[i+1]; ++e){
+        if(L.cols[e] == i)  continue;
+        row.emplace_back(L.cols[e], L.vals[e]);
+    }
+}
+
+/*!
+ * Group the rows of a level in aggregates (vertex agglomeration). Each row is grouped with
+ * its strongly connected neighbours; leftover rows join the most strongly connected
+ * neighbouring aggregate or form new ones. Constrained rows of the fine level are excluded.
+ * \param[in] level target level
+ * \param[out] aggregates aggregate of each row, -1 for excluded rows.
+ * \return number of aggregates.
+ */
+long
+GraphLaplMultigrid::aggregate(int level, std::vector<int> & aggregates) const{
+
+    const double theta = 0.25;
+    const int unassigned = -1;
+    const int excluded = -2;
+    long n = m_levels[level].n;
+
+    aggregates.assign(n, unassigned);
+    if(level == 0){
+        for(long i=0; i<n; ++i){
+            if(m_fixed[i])  aggregates[i] = excluded;
+        }
+    }
+
+    std::vector<std::pair<int,double> > row;
+    auto strongNeighbours = [&](long i){
+        getRow(level, i, row);
+        double smax = 0.0;
+        for(const auto & entry : row)   smax = std::max(smax, -entry.second);
+        std::size_t count = 0;
+        for(const auto & entry : row){
+            if(-entry.second > 0.0 && -entry.second >= theta*smax){
+                row[count] = std::make_pair(entry.first, -entry.second);
+                ++count;
+            }
+        }
+        row.resize(count);
+    };
+
+    long ncoarse = 0;
+
+    //first pass: rows whose strong neighbours are all unassigned become aggregate roots.
+    for(long i=0; i<n; ++i){
+        if(aggregates[i] != unassigned)   continue;
+        strongNeighbours(i);
+        bool isolated = true;
+        for(const auto & entry : row){
+            if(aggregates[entry.first] != unassigned){
+                isolated = false;
+                break;
+            }
+        }
+        if(!isolated)   continue;
+        aggregates[i] = int(ncoarse);
+        for(const auto & entry : row)   aggregates[entry.first] = int(ncoarse);
+        ++ncoarse;
+    }
+
+    //second pass: join the most strongly connected aggregate of the first pass.
+    std::vector<int> roots(aggregates);
+    for(long i=0; i<n; ++i){
+        if(aggregates[i] != unassigned)   continue;
+        strongNeighbours(i);
+        double smax = 0.0;
+        for(const auto & entry : row){
+            if(roots[entry.first] >= 0 && entry.second > smax){
+                smax = entry.second;
+                aggregates[i] = roots[entry.first];
+            }
+        }
+    }
+
+    //third pass: leftovers form new aggregates with their unassigned strong neighbours.
+    for(long i=0; i<n; ++i){
+        if(aggregates[i] != unassigned)   continue;
+        strongNeighbours(i);
+        aggregates[i] = int(ncoarse);
+        for(const auto & entry : row){
+            if(aggregates[entry.first] == unassigned)   aggregates[entry.first] = int(ncoarse);
+        }
+        ++ncoarse;
+    }
+
+    for(long i=0; i<n; ++i){
+        if(aggregates[i] == excluded)   aggregates[i] = -1;
+    }
+    return ncoarse;
+}
+
+/*!
+ * Build the Galerkin operator of the next coarser level, with the piecewise constant
+ * prolongation defined by the aggregates of the level, and append it to the hierarchy.
+ * \param[in] level target level, with aggregates already computed.
+ * \param[in] ncoarse number of aggregates.
+ */
+void
+GraphLaplMultigrid::buildCoarseOperator(int level, long ncoarse){
+
+    const Level & F = m_levels[level];
+
+    //rows of each aggregate.
+    std::vector<long> memberOffsets(ncoarse+1, 0);
+    for(long i=0; i<F.n; ++i){
+        if(F.aggregate[i] >= 0)   ++memberOffsets[F.aggregate[i]+1];
+    }
+    for(long c=0; c<ncoarse; ++c)   memberOffsets[c+1] += memberOffsets[c];
+    std::vector<int> members(memberOffsets[ncoarse]);
+    {
+        std::vector<long> position(memberOffsets.begin(), memberOffsets.end()-1);
+        for(long i=0; i<F.n; ++i){
+            if(F.aggregate[i] >= 0)   members[position[F.aggregate[i]]++] = int(i);
+        }
+    }
+
+    Level C;
+    C.n = ncoarse;
+    C.offsets.assign(ncoarse+1, 0);
+    C.diag.assign(ncoarse, 0.0);
+
+    //sparse accumulator of the coarse rows.
+    dvector1D accumulator(ncoarse, 0.0);
+    std::vector<long> marker(ncoarse, -1);
+    std::vector<int> touched;
+    std::vector<std::pair<int,double> > row;
+    auto add = [&](long I, int J, double value){
+        if(marker[J] != I){
+            marker[J] = I;
+            accumulator[J] = 0.0;
+            touched.push_back(J);
+        }
+        accumulator[J] += value;
+    };
+
+    for(long I=0; I<ncoarse; ++I){
+        touched.clear();
+        add(I, int(I), 0.0);
+        for(long m=memberOffsets[I]; m<memberOffsets[I+1]; ++m){
+            long i = members[m];
+            add(I, int(I), F.diag[i]);
+            getRow(level, i, row);
+            for(const auto & entry : row){
+                int J = F.aggregate[entry.first];
+                if(J >= 0)  add(I, J, entry.second);
+            }
+        }
+        std::sort(touched.begin(), touched.end());
+        for(int J : touched){
+            C.cols.push_back(J);
+            C.vals.push_back(accumulator[J]);
+        }
+        C.offsets[I+1] = long(C.cols.size());
+        C.diag[I] = accumulator[I];
+    }
+    C.cols.shrink_to_fit();
+    C.vals.shrink_to_fit();
+
+    m_levels.push_back(std::move(C));
+}
+
+/*!
+ * Build the multigrid hierarchy for the current constraints. Levels are coarsened down to
+ * a few hundreds of rows; the coarsest operator is factorized with a dense LU, if small enough.
+ */
+void
+GraphLaplMultigrid::buildHierarchy(){
+
+    const long coarseSize = 400;
+    const int maxLevels = 20;
+
+    m_levels.resize(1);
+    m_levels[0].aggregate.clear();
+
+    int level = 0;
+    while(m_levels[level].n > coarseSize && level < maxLevels-1){
+        std::vector<int> aggregates;
+        long ncoarse = aggregate(level, aggregates);
+        //stop if the coarsening stagnates.
+        if(ncoarse == 0 || double(ncoarse) > 0.9*double(m_levels[level].n))   break;
+        m_levels[level].aggregate.swap(aggregates);
+        buildCoarseOperator(level, ncoarse);
+        ++level;
+    }
+
+    for(Level & L : m_levels){
+        L.x.assign(L.n, 0.0);
+        L.b.assign(L.n, 0.0);
+        L.r.assign(L.n, 0.0);
+    }
+    factorizeCoarsest();
+    m_hierarchy = true;
+}
+
+/*!
+ * Dense LU factorization with partial pivoting of the coarsest operator. If the coarsest level
+ * is too large the factorization is skipped and the level is smoothed only.
+ * Null pivots (singular operator, e.g. without constraints) are regularized.
+ */
+void
+GraphLaplMultigrid::factorizeCoarsest(){
+
+    const long maxDenseSize = 2000;
+    dvector1D().swap(m_coarseLU);
+    std::vector<int>().swap(m_coarsePivots);
+
+    int level = int(m_levels.size()) - 1;
+    long n = m_levels[level].n;
+    if(n == 0 || n > maxDenseSize)  return;
+
+    dvector1D & A = m_coarseLU;
+    A.assign(n*n, 0.0);
+    std::vector<std::pair<int,double> > row;
+    double scale = 0.0;
+    for(long i=0; i<n; ++i){
+        double diag = m_levels[level].diag[i];
+        if(level == 0 && m_fixed[i])    diag = 1.0;
+        A[i*n+i] = diag;
+        scale = std::max(scale, std::abs(diag));
+        getRow(level, i, row);
+        for(const auto & entry : row)   A[i*n+entry.first] += entry.second;
+    }
+    if(!(scale > 0.0))  scale = 1.0;
+
+    m_coarsePivots.resize(n);
+    for(long k=0; k<n; ++k){
+        long p = k;
+        for(long i=k+1; i<n; ++i){
+            if(std::abs(A[i*n+k]) > std::abs(A[p*n+k]))   p = i;
+        }
+        m_coarsePivots[k] = int(p);
+        if(p != k){
+            for(long j=0; j<n; ++j)   std::swap(A[k*n+j], A[p*n+j]);
+        }
+        if(std::abs(A[k*n+k]) < 1.0E-13*scale)    A[k*n+k] = scale;
+        double pivot = A[k*n+k];
+        for(long i=k+1; i<n; ++i){
+            double factor = A[i*n+k] / pivot;
+            A[i*n+k] = factor;
+            if(factor == 0.0)   continue;
+            for(long j=k+1; j<n; ++j)   A[i*n+j] -= factor*A[k*n+j];
+        }
+    }
+}
+
+/*!
+ * Damped Jacobi smoothing of the work vectors of a level, starting from a null solution.
+ * \param[in] level target level
+ * \param[in] sweeps number of sweeps
+ */
+void
+GraphLaplMultigrid::smooth(int level, int sweeps){
+
+    const double omega = 2.0/3.0;
+    Level & L = m_levels[level];
+    for(int s=0; s<sweeps; ++s){
+        if(s > 0)   apply(level, L.x, L.r);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(long i=0; i<L.n; ++i){
+            if(!(L.diag[i] > 0.0) || (level == 0 && m_fixed[i])){
+                L.x[i] = 0.0;
+                continue;
+            }
+            double residual = (s > 0) ? L.b[i] - L.r[i] : L.b[i];
+            L.x[i] = ((s > 0) ? L.x[i] : 0.0) + omega*residual/L.diag[i];
+        }
+    }
+}
+
+/*!
+ * Multigrid V-cycle on the work vectors of a level: L.x approximates the solution of the
+ * level operator with right-hand-side L.b.
+ * \param[in] level target level
+ */
+void
+GraphLaplMultigrid::vcycle(int level){
+
+    const int sweeps = 2;
+    Level & L = m_levels[level];
+    int coarsest = int(m_levels.size()) - 1;
+
+    if(level == coarsest){
+        if(m_coarseLU.empty()){
+            smooth(level, 10*sweeps);
+            return;
+        }
+        long n = L.n;
+        const dvector1D & A = m_coarseLU;
+        L.x = L.b;
+        if(level == 0){
+            for(long i=0; i<n; ++i){
+                if(m_fixed[i])  L.x[i] = 0.0;
+            }
+        }
+        for(long k=0; k<n; ++k){
+            std::swap(L.x[k], L.x[m_coarsePivots[k]]);
+        }
+        for(long i=0; i<n; ++i){
+            for(long j=0; j<i; ++j)     L.x[i] -= A[i*n+j]*L.x[j];
+        }
+        for(long i=n-1; i>=0; --i){
+            for(long j=i+1; j<n; ++j)   L.x[i] -= A[i*n+j]*L.x[j];
+            L.x[i] /= A[i*n+i];
+        }
+        return;
+    }
+
+    //pre-smoothing and residual.
+    smooth(level, sweeps);
+    apply(level, L.x, L.r);
+
+    //restriction (sum on aggregates), coarse correction and prolongation.
+    Level & C = m_levels[level+1];
+    std::fill(C.b.begin(), C.b.end(), 0.0);
+    for(long i=0; i<L.n; ++i){
+        if(L.aggregate[i] >= 0)   C.b[L.aggregate[i]] += L.b[i] - L.r[i];
+    }
+    vcycle(level+1);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(long i=0; i<L.n; ++i){
+        if(L.aggregate[i] >= 0)   L.x[i] += C.x[L.aggregate[i]];
+    }
+
+    //post-smoothing, continuing from the corrected solution.
+    const double omega = 2.0/3.0;
+    for(int s=0; s<sweeps; ++s){
+        apply(level, L.x, L.r);
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(long i=0; i<L.n; ++i){
+            if(!(L.diag[i] > 0.0) || (level == 0 && m_fixed[i]))   continue;
+            L.x[i] += omega*(L.b[i] - L.r[i])/L.diag[i];
+        }
+    }
+}
+
+/*!
+ * Apply the multigrid preconditioner: one V-cycle from a null initial solution.
+ * \param[in] r residual on the fine level
+ * \param[out] z preconditioned residual, already sized.
+ */
+void
+GraphLaplMultigrid::precondition(const dvector1D & r, dvector1D & z){
+    m_levels[0].b = r;
+    vcycle(0);
+    z = m_levels[0].x;
+}
+
+/*!
+ * Solve the system. Constrained rows take the value of the right-hand-side, the equations
+ * of free rows are the graph Laplacian stencils (see class doc), with right-hand-side rhs.
+ * The solution is computed with BiCGSTAB preconditioned by a multigrid V-cycle.
+ * \param[in] rhs right-hand-side on local rows.
+ * \param[in,out] result in input initial solution on free rows, in output the solution.
+ * \return true if converged to the relative tolerance, false otherwise.
+ */
+bool
+GraphLaplMultigrid::solve(const dvector1D & rhs, dvector1D & result){
+
+    m_iterations = 0;
+    m_residual = 0.0;
+    if(!isBuilt() || long(rhs.size()) != m_n)  return false;
+    if(!m_hierarchy)    buildHierarchy();
+
+    long n = m_n;
+    result.resize(n, 0.0);
+    dvector1D & x = result;
+
+    auto dot = [n](const dvector1D & a, const dvector1D & b){
+        double sum = 0.0;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp parallel for reduction(+:sum) schedule(static)
+#endif
+        for(long i=0; i<n; ++i)    sum += a[i]*b[i];
+        return sum;
+    };
+
+    //scaled right-hand-side of free rows, constrained values in x.
+    dvector1D f(n, 0.0), r(n), t(n);
+    for(long i=0; i<n; ++i){
+        if(m_fixed[i]){
+            x[i] = rhs[i];
+        }else{
+            f[i] = -m_rowSum[i]*rhs[i];
+        }
+    }
+
+    //reference norm: residual of a null solution on free rows.
+    for(long i=0; i<n; ++i)    t[i] = m_fixed[i] ? x[i] : 0.0;
+    applyFine(t, r);
+    for(long i=0; i<n; ++i)    r[i] = f[i] - r[i];
+    double bnorm = std::sqrt(dot(r, r));
+    if(!(bnorm > 0.0)){
+        for(long i=0; i<n; ++i){
+            if(!m_fixed[i]) x[i] = 0.0;
+        }
+        return true;
+    }
+
+    applyFine(x, t);
+    for(long i=0; i<n; ++i)    r[i] = f[i] - t[i];
+    m_residual = std::sqrt(dot(r, r))/bnorm;
+    if(m_residual <= m_tol)     return true;
+
+    dvector1D r0(r), p(n, 0.0), v(n, 0.0), s(n), phat(n), shat(n);
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+    bool converged = false;
+    for(int it=0; it<m_maxIt; ++it){
+        m_iterations = it+1;
+        double rhoNew = dot(r0, r);
+        if(!(std::abs(rhoNew) > 0.0))   break;
+        double beta = (rhoNew / rho) * (alpha / omega);
+        rho = rhoNew;
+        for(long i=0; i<n; ++i)    p[i] = r[i] + beta*(p[i] - omega*v[i]);
+        precondition(p, phat);
+        applyFine(phat, v);
+        double r0v = dot(r0, v);
+        if(!(std::abs(r0v) > 0.0))   break;
+        alpha = rho / r0v;
+        for(long i=0; i<n; ++i)    s[i] = r[i] - alpha*v[i];
+        m_residual = std::sqrt(dot(s, s))/bnorm;
+        if(m_residual <= m_tol){
+            for(long i=0; i<n; ++i)    x[i] += alpha*phat[i];
+            converged = true;
+            break;
+        }
+        precondition(s, shat);
+        applyFine(shat, t);
+        double tt = dot(t, t);
+        if(!(tt > 0.0))   break;
+        omega = dot(t, s) / tt;
+        for(long i=0; i<n; ++i){
+            x[i] += alpha*phat[i] + omega*shat[i];
+            r[i] = s[i] - omega*t[i];
+        }
+        m_residual = std::sqrt(dot(r, r))/bnorm;
+        if(m_residual <= m_tol){
+            converged = true;
+            break;
+        }
+        if(!(std::abs(omega) > 0.0))   break;
+    }
+    return converged;
+}
+
+}
@@ -0,0 +1,132 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+#ifndef __GRAPHLAPLMULTIGRID_HPP__
+#define __GRAPHLAPLMULTIGRID_HPP__
+
+#include "MimmoObject.hpp"
+#include "MimmoPiercedVector.hpp"
+
+namespace mimmo{
+
+/*!
+ * \class GraphLaplMultigrid
+ * \ingroup propagators
+ * \brief Matrix-free solver of the graph Laplacian systems on mesh points, preconditioned
+ * by an aggregation multigrid.
+ *
+ * The operator is the weighted graph Laplacian of GraphLaplStencil::computeLaplacianStencils:
+ * the equation of the point i is \f$\sum_j a_{ij}(x_j - x_i) = b_i\f$, with
+ * \f$a_{ij} = w_{ij}/\sum_k w_{ik}\f$ and \f$w_{ij} = 0.5(D_i + D_j)/|p_i - p_j|^2\f$,
+ * D being an optional diffusivity on points. The Narrow Band Control relaxation of
+ * PropagateField (weights toward points farther from the band surfaces multiplied by the
+ * relaxation factor) is reproduced as well. Rows of constrained points are identities.
+ *
+ * On the fine level the operator is applied directly from the point adjacency and the point
+ * coordinates of the mesh, weights are computed on the fly: no matrix is assembled.
+ * Coarse levels are built by vertex agglomeration, grouping each point with its strongly
+ * connected neighbours; coarse operators are Galerkin products with the piecewise constant
+ * prolongation and they are stored explicitly, being much smaller than the fine one.
+ * The system is solved with BiCGSTAB, right-preconditioned by a multigrid V-cycle with damped
+ * Jacobi smoothing and a dense direct solver on the coarsest level.
+ *
+ * Rows follow the consecutive local indexing of the points (see MimmoObject::getMapDataInv).
+ * Only serial meshes (without ghost points) are supported.
+ */
+class GraphLaplMultigrid{
+
+public:
+    GraphLaplMultigrid();
+    ~GraphLaplMultigrid();
+
+    void        clear();
+    void        build(MimmoSharedPointer<MimmoObject> geo, const lilimap & maplocals,
+                      MimmoPiercedVector<double> * diffusivity = nullptr,
+                      const bitpit::PiercedVector<double> * banddistances = nullptr,
+                      double bandrelax = 1.0);
+    void        setConstraints(const std::vector<long> & rows);
+    bool        solve(const dvector1D & rhs, dvector1D & result);
+
+    void        setTolerance(double tol);
+    void        setMaxIterations(int maxit);
+
+    bool        isBuilt() const;
+    long        getRowCount() const;
+    int         getLevelCount() const;
+    int         getIterationCount() const;
+    double      getResidual() const;
+    std::size_t getMemoryUsage() const;
+
+protected:
+    /*!
+     * \brief Level of the multigrid hierarchy. Level 0 is the matrix-free fine operator,
+     * coarser levels are stored in CSR format (diagonal included).
+     */
+    struct Level{
+        long                n;          /**< number of rows.*/
+        std::vector<long>   offsets;    /**< CSR row offsets (coarse levels only).*/
+        std::vector<int>    cols;       /**< CSR column indices (coarse levels only).*/
+        dvector1D           vals;       /**< CSR values (coarse levels only).*/
+        dvector1D           diag;       /**< diagonal of the operator.*/
+        std::vector<int>    aggregate;  /**< row of the next coarser level of each row, -1 for excluded rows.*/
+        dvector1D           x;          /**< work vector, solution.*/
+        dvector1D           b;          /**< work vector, right-hand-side.*/
+        dvector1D           r;          /**< work vector, residual.*/
+    };
+
+    long                    m_n;            /**< number of fine rows (points).*/
+    std::vector<long>       m_adjOffsets;   /**< offsets of the point adjacency of each row.*/
+    std::vector<int>        m_adjacency;    /**< point adjacency, in local row indices.*/
+    dvecarr3E               m_coords;       /**< point coordinates.*/
+    dvector1D               m_diffusivity;  /**< diffusivity on points, empty if unitary.*/
+    dvector1D               m_band;         /**< narrow band distance on points (-1 outside), empty if not active.*/
+    double                  m_bandRelax;    /**< narrow band relaxation factor.*/
+    dvector1D               m_rowSum;       /**< sum of the unrelaxed weights of each row (stencil normalization).*/
+    std::vector<char>       m_fixed;        /**< true for constrained rows.*/
+
+    std::vector<Level>      m_levels;       /**< multigrid hierarchy.*/
+    bool                    m_hierarchy;    /**< true if the hierarchy is consistent with the constraints.*/
+    dvector1D               m_coarseLU;     /**< dense LU factors of the coarsest operator.*/
+    std::vector<int>        m_coarsePivots; /**< pivoting of the coarsest LU factors.*/
+
+    double                  m_tol;          /**< relative tolerance on the residual.*/
+    int                     m_maxIt;        /**< maximum number of iterations.*/
+    int                     m_iterations;   /**< iterations of the last solve.*/
+    double                  m_residual;     /**< relative residual of the last solve.*/
+
+    double      weight(long i, long k, bool relaxed = true) const;
+    void        applyFine(const dvector1D & x, dvector1D & y) const;
+    void        apply(int level, const dvector1D & x, dvector1D & y) const;
+    void        getRow(int level, long i, std::vector<std::pair<int,double> > & row) const;
+    void        buildHierarchy();
+    long        aggregate(int level, std::vector<int> & aggregates) const;
+    void        buildCoarseOperator(int level, long ncoarse);
+    void        factorizeCoarsest();
+    void        smooth(int level, int sweeps);
+    void        vcycle(int level);
+    void        precondition(const dvector1D & r, dvector1D & z);
+};
+
+};
+
+#endif /* __GRAPHLAPLMULTIGRID_HPP__ */
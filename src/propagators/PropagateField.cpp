@@ -45,6 +45,7 @@ PropagateScalarField::PropagateScalarField():PropagateField<1>(){
  * Set most significant parameters to constructor defaults
  */
 void PropagateScalarField::setDefaults(){
+    setDirty();
     PropagateField<1>::setDefaults();
     m_thres = -1.0;
     m_nstep = 1;
@@ -136,6 +137,7 @@ PropagateScalarField::getPropagatedField(){
  */
 void
 PropagateScalarField::addDirichletConditions(dmpvector1D * bc){
+    setDirty();
     //avoid linking null field or field with null geometry inside.
     if(!bc) return;
     if(!bc->getGeometry()) return;
@@ -158,6 +160,7 @@ PropagateScalarField::addDirichletConditions(dmpvector1D * bc){
  */
 void
 PropagateScalarField::setSolverMultiStep(unsigned int sstep){
+    setDirty();
     unsigned int loc(1);
     m_nstep = std::max(loc,sstep);
 }
@@ -253,70 +256,94 @@ PropagateScalarField::execute(){
         (*m_log)<<"Warning in "<<m_name<<" .Boundary patches linked are uncoherent with target bulk geometry"<<std::endl;
     }
 
-    //allocate the solver;
-    m_solver = std::unique_ptr<bitpit::SystemSolver>(new bitpit::SystemSolver(m_print));
-    //get this inverse map -> you will need it to compact the stencils.
-    lilimap dataInv;
+    //damping and narrow band reference surfaces are the Dirichlet patches, if not specified.
+    if(m_dampingActive && m_dampingSurfaces.empty())    m_dampingSurfaces = m_dirichletPatches;
+    if(m_bandActive && m_bandSurfaces.empty())          m_bandSurfaces = m_dirichletPatches;
 
-    //check if damping or narrow band control are active,
-    //initialize their reference surfaces and compute them
-    if(m_dampingActive){
-        if(m_dampingSurfaces.empty())   m_dampingSurfaces = m_dirichletPatches;
-        initializeUniqueSurface(m_dampingSurfaces, m_dampingUniSurface);
+    //check if the Laplacian operator cached by a previous execution can be reused.
+    std::size_t operatorKey = 0;
+    bool reuseOperator = false;
+    if(m_operatorCache){
+        operatorKey = computeOperatorKey();
+        reuseOperator = isOperatorCached(operatorKey);
     }
 
-    if(m_bandActive){
-        if(m_bandSurfaces.empty())   m_bandSurfaces = m_dirichletPatches;
-        initializeUniqueSurface(m_bandSurfaces, m_bandUniSurface);
-    }
+    //get this inverse map -> you will need it to compact the stencils.
+    //MPI version, here get ghost also for renumbering stencils purpose in initializeLaplaceSolver and assignBCAndEvaluateRHS.
+    lilimap dataInv = geo->getMapDataInv(true);
 
-    //initialize damping and Narrow band Control. If UniSurfaces are null the methods set:
-    // - unitary m_damping field.
-    // - empty m_banddistances member.
-    //
-    initializeDampingFunction();
-    updateNarrowBand();
+    //pass dirichlet bc point information to bulk m_bc_dir member.
+    distributeBCOnBoundaryPoints();
 
-    // Instantiate damping function on points
-    MimmoPiercedVector<double> dampingOnPoints;
+    //laplacian stencils of border nodes.
+    GraphLaplStencil::MPVStencilUPtr laplaceStencils;
 
-    // Graph Laplace method on points
+    if(reuseOperator){
+        //take back the border stencils of the cached operator. Matrix and preconditioner are in m_solver.
+        laplaceStencils = std::move(m_operatorBorderStencils);
+    }else{
+        clearOperatorCache();
 
-    //Laplacians update on border: store the id of the border, internal nodes only.
-    // Don't worry here for ghosts, laplacianStencils are always defined on rank internals.
-    //TODO extract boundary vertex ID as unordered_set
-    livector1D borderPointsID_vector = geo->extractBoundaryVertexID(false);
-    std::unordered_set<long> borderPointsID(borderPointsID_vector.begin(), borderPointsID_vector.end());
+        //check if damping or narrow band control are active,
+        //initialize their reference surfaces and compute them
+        if(m_dampingActive){
+            initializeUniqueSurface(m_dampingSurfaces, m_dampingUniSurface);
+        }
 
-    //get this inverse map -> you will need it to compact the stencils.
-    //MPI version, here get ghost also for renumbering stencils purpose in initializeLaplaceSolver and assignBCAndEvaluateRHS.
-    dataInv = geo->getMapDataInv(true);
+        if(m_bandActive){
+            initializeUniqueSurface(m_bandSurfaces, m_bandUniSurface);
+        }
 
-    //pass dirichlet bc point information to bulk m_bc_dir member.
-    distributeBCOnBoundaryPoints();
+        //initialize damping and Narrow band Control. If UniSurfaces are null the methods set:
+        // - unitary m_damping field.
+        // - empty m_banddistances member.
+        //
+        initializeDampingFunction();
+        updateNarrowBand();
 
-    // Insert dirichlet points in borderPoints set to consider even dirichlet points immersed in bulk (not physical boundaries)
-    for (long id : m_bc_dir.getIds()){
-        borderPointsID.insert(id);
-    }
+        // Instantiate damping function on points
+        MimmoPiercedVector<double> dampingOnPoints;
 
-    //interpolate damping function from cell data to point data
-    dampingCellToPoint(dampingOnPoints);
+        if(useMultigrid()){
+            //matrix-free operator: no stencils and no matrix are needed.
+            dampingCellToPoint(dampingOnPoints);
+            initializeMultigridSolver(dampingOnPoints, dataInv);
+        }else{
+            //allocate the solver;
+            m_solver = std::unique_ptr<bitpit::SystemSolver>(new bitpit::SystemSolver(m_print));
 
-    //compute the laplacian stencils
-    GraphLaplStencil::MPVStencilUPtr laplaceStencils = GraphLaplStencil::computeLaplacianStencils(geo, m_tol, &dampingOnPoints);
+            // Graph Laplace method on points
 
-    //modify stencils if Narrow band is active i.e. m_banddistances is not empty.
-    //This is directly managed in the method.
-    modifyStencilsForNarrowBand(laplaceStencils);
+            //Laplacians update on border: store the id of the border, internal nodes only.
+            // Don't worry here for ghosts, laplacianStencils are always defined on rank internals.
+            //TODO extract boundary vertex ID as unordered_set
+            livector1D borderPointsID_vector = geo->extractBoundaryVertexID(false);
+            std::unordered_set<long> borderPointsID(borderPointsID_vector.begin(), borderPointsID_vector.end());
 
-    // initialize the laplacian Matrix in solver and squeeze out the laplace stencils and save border nodes only.
-    initializeLaplaceSolver(laplaceStencils.get(), dataInv);
-    laplaceStencils->squeezeOutExcept(borderPointsID);
-    //release list of boundary nodes
-    borderPointsID.clear();
-    //release dampingOnPoints, because already embedded inside the laplacianStencils.
-    dampingOnPoints.clear();
+            // Insert dirichlet points in borderPoints set to consider even dirichlet points immersed in bulk (not physical boundaries)
+            for (long id : m_bc_dir.getIds()){
+                borderPointsID.insert(id);
+            }
+
+            //interpolate damping function from cell data to point data
+            dampingCellToPoint(dampingOnPoints);
+
+            //compute the laplacian stencils
+            laplaceStencils = GraphLaplStencil::computeLaplacianStencils(geo, m_tol, &dampingOnPoints);
+
+            //modify stencils if Narrow band is active i.e. m_banddistances is not empty.
+            //This is directly managed in the method.
+            modifyStencilsForNarrowBand(laplaceStencils);
+
+            // initialize the laplacian Matrix in solver and squeeze out the laplace stencils and save border nodes only.
+            initializeLaplaceSolver(laplaceStencils.get(), dataInv);
+            laplaceStencils->squeezeOutExcept(borderPointsID);
+            //release list of boundary nodes
+            borderPointsID.clear();
+            //release dampingOnPoints, because already embedded inside the laplacianStencils.
+            dampingOnPoints.clear();
+        }
+    }
 
     //create step bc in case of multistep.
     MimmoPiercedVector<std::array<double, 1> > stepBCdir(geo, MPVLocation::POINT);
@@ -350,8 +377,14 @@ PropagateScalarField::execute(){
     m_dampingUniSurface = nullptr;
     //clear temp bc;
     m_bc_dir.clear();
-    //clear the solver;
-    m_solver->clear();
+    if(m_operatorCache){
+        //keep the operator for the next execution.
+        m_operatorKey = operatorKey;
+        m_operatorBorderStencils = std::move(laplaceStencils);
+    }else{
+        //clear the solver;
+        clearOperatorCache();
+    }
     (*m_log) << bitpit::log::priority(bitpit::log::DEBUG);
 }
 
@@ -374,6 +407,7 @@ PropagateVectorField::PropagateVectorField():PropagateField<3>(){
  * Set most significant parameters to constructor defaults
  */
 void PropagateVectorField::setDefaults(){
+    setDirty();
     PropagateField<3>::setDefaults();
     m_nstep = 1;
     m_forcePlanarSlip = false;
@@ -481,6 +515,7 @@ PropagateVectorField::isForcingPlanarSlip(){
  */
 void
 PropagateVectorField::addSlipBoundarySurface(MimmoSharedPointer<MimmoObject> surface){
+    setDirty();
     if (!surface)       return;
     if (surface->getType()!= 1 ){
         (*m_log)<<"Warning: "<<m_name<<" allows only slip boundary surfaces. Skipping input slip patch."<<std::endl;
@@ -501,6 +536,7 @@ PropagateVectorField::addSlipBoundarySurface(MimmoSharedPointer<MimmoObject> sur
  */
 void
 PropagateVectorField::addSlipReferenceSurface(MimmoSharedPointer<MimmoObject> surface){
+    setDirty();
     if (!surface)       return;
     if (surface->getType()!= 1 ){
         (*m_log)<<"Warning: "<<m_name<<" allows only slip boundary surfaces. Skipping input slip reference patch."<<std::endl;
@@ -524,6 +560,7 @@ PropagateVectorField::addSlipReferenceSurface(MimmoSharedPointer<MimmoObject> su
  */
 void
 PropagateVectorField::addPeriodicBoundarySurface(MimmoSharedPointer<MimmoObject> surface){
+    setDirty();
     if (!surface)       return;
     if (surface->getType()!= 1 ){
         (*m_log)<<"Warning: "<<m_name<<" allows only slip boundary surfaces. Skipping input periodic patch."<<std::endl;
@@ -561,6 +598,7 @@ PropagateVectorField::forcePlanarSlip(bool planar){
  */
 void
 PropagateVectorField::addDirichletConditions(dmpvecarr3E * bc){
+    setDirty();
     if(!bc) return;
     if(!bc->getGeometry()) return;
 
@@ -576,6 +614,7 @@ PropagateVectorField::addDirichletConditions(dmpvecarr3E * bc){
  */
 void
 PropagateVectorField::setSolverMultiStep(unsigned int sstep){
+	setDirty();
 	unsigned int loc(1);
 	m_nstep = std::max(loc,sstep);
 }
@@ -821,10 +860,9 @@ void PropagateVectorField::propagateMaskMovingPoints(livector1D & vertexList) {
     if(getGeometry()->getPointConnectivitySyncStatus() != SyncStatus::SYNC){
         getGeometry()->buildPointConnectivity();
     }
-    std::unordered_set<long> tempV1;
     for(long id: vertexList){
-        tempV1 = getGeometry()->getPointConnectivity(id);
-        core.insert(tempV1.begin(), tempV1.end());
+        bitpit::ConstProxyVector<long> ring = getGeometry()->getPointConnectivity(id);
+        core.insert(ring.begin(), ring.end());
     }
     vertexList.clear();
     vertexList.insert(vertexList.end(), core.begin(), core.end());
@@ -833,7 +871,34 @@ void PropagateVectorField::propagateMaskMovingPoints(livector1D & vertexList) {
 /*!
  * OVERRIDE Base class:
  * This method evaluate the bc corrections for a singular run of the system solver,
- * update the system matrix in m_solver and evaluate the rhs part due to bc.
+ * update the system matrix in m_solver and evaluate the rhs part due to bc on a single component.
+ * See the block version of the method assignBCAndEvaluateRHS, which evaluates all
+ * the components at once, for further details.
+ *
+ * \param[in] comp target component of bc conditions (0,1,2).
+ * \param[in] slipCorrect true to apply the bc slip corrector step(Dirichlet), false for bc slip predictor(Neumann).
+ * \param[in] borderLaplacianStencil list of laplacian Stencil on border nodes, where the bc is temporarely imposed as homogeneous Neumann
+ * \param[in] maplocals map from global id numbering to local system solver numbering.
+ * \param[in,out] rhs vector of right-hand-side's to append constant data from bc corrections.
+ */
+void
+PropagateVectorField::assignBCAndEvaluateRHS(std::size_t comp, bool slipCorrect,
+                                            GraphLaplStencil::MPVStencil * borderLaplacianStencil,
+                                            const lilimap & maplocals, dvector1D & rhs)
+{
+    dvector2D rhsBlock;
+    assignBCAndEvaluateRHS(slipCorrect, borderLaplacianStencil, maplocals, rhsBlock);
+    std::swap(rhs, rhsBlock[std::min(comp, std::size_t(2))]);
+}
+
+/*!
+ * This method evaluate the bc corrections for a singular run of the system solver,
+ * update the system matrix in m_solver and evaluate the rhs part due to bc for all the
+ * three components of the field.
+ * The bc modify the system matrix in the same way for all the components (constrained rows
+ * become identity rows), only their values differ: the matrix is updated once and the three
+ * right-hand-sides are filled together, so that they can be solved as a block
+ * (see solveLaplace) sharing the same preconditioner setup.
  * After you call this method, you are typically ready to solve the laplacian system.
  * The type of bc @ nodes are directly desumed from class nodes member m_bc_dir and m_slip_bc_dir.
  * The method requires the Laplacian m_solver to be initialized. No ghost are taken into account.
@@ -846,89 +911,87 @@ void PropagateVectorField::propagateMaskMovingPoints(livector1D & vertexList) {
  * On second call, the corrected m_slip_bc_dir is applied on nodes of slip surfaces, as a Dirichlet condition.
    The slipCorrect boolean rules the switch between slip predictor/corrector mode.
  *
- * \param[in] comp target component of bc conditions (0,1,2).
  * \param[in] slipCorrect true to apply the bc slip corrector step(Dirichlet), false for bc slip predictor(Neumann).
  * \param[in] borderLaplacianStencil list of laplacian Stencil on border nodes, where the bc is temporarely imposed as homogeneous Neumann
  * \param[in] maplocals map from global id numbering to local system solver numbering.
- * \param[in,out] rhs vector of right-hand-side's to append constant data from bc corrections.
+ * \param[in,out] rhs right-hand-side's of the three components, to append constant data from bc corrections.
  */
 void
-PropagateVectorField::assignBCAndEvaluateRHS(std::size_t comp, bool slipCorrect,
+PropagateVectorField::assignBCAndEvaluateRHS(bool slipCorrect,
                                             GraphLaplStencil::MPVStencil * borderLaplacianStencil,
-                                            const lilimap & maplocals, dvector1D & rhs)
+                                            const lilimap & maplocals, dvector2D & rhs)
 {
 
     //resize rhs to the number of internal cells
     MimmoSharedPointer<MimmoObject> geo = getGeometry();
     {
-        dvector1D temp(geo->getNInternalVertices(), 0.0);
+        dvector2D temp(3, dvector1D(geo->getNInternalVertices(), 0.0));
         std::swap(rhs, temp);
     }
 
 
-    if (!m_solver->isAssembled()) {
-        (*m_log)<<"Warning in "<<m_name<<". Unable to assign BC to the system. The solver is not yet initialized."<<std::endl;
-        return;
-    }
+    //copy laplacian stencils in a work mpv (not needed by the matrix-free multigrid solver).
+    GraphLaplStencil::MPVStencilUPtr lapwork;
+    if(!m_multigrid){
+        if (!m_solver->isAssembled()) {
+            (*m_log)<<"Warning in "<<m_name<<". Unable to assign BC to the system. The solver is not yet initialized."<<std::endl;
+            return;
+        }
 
-    if (!borderLaplacianStencil) {
-        (*m_log)<<"Warning in "<<m_name<<". Unable to reach border cells stencils data. Nothing to do."<<std::endl;
-        return;
+        if (!borderLaplacianStencil) {
+            (*m_log)<<"Warning in "<<m_name<<". Unable to reach border cells stencils data. Nothing to do."<<std::endl;
+            return;
+        }
+        lapwork = GraphLaplStencil::MPVStencilUPtr(new GraphLaplStencil::MPVStencil(*borderLaplacianStencil));
     }
-
-    //copy laplacian stencils in a work mpv .
-    GraphLaplStencil::MPVStencilUPtr lapwork(new GraphLaplStencil::MPVStencil(*borderLaplacianStencil));
+    //bc are imposed on rank internal border nodes.
+    auto isBorder = [&](long id){
+        return lapwork ? lapwork->exists(id) : geo->isPointInterior(id);
+    };
 
     //correct the original border laplacian stencils applying the Dirichlet
     //conditions and slip conditions.
     //Neumann are implicitely imposed by graph-laplacian scheme.
+    //Constrained rows are the same for all components: their constant is kept null
+    //and the bc values of the three components are stored apart to fill the rhs.
     //renumber it and update the laplacian matrix and fill the rhs.
     bitpit::StencilScalar correction;
+    std::unordered_map<long, std::array<double,3> > bcValues;
 
     //loop on all slip boundary nodes first.
     //Correct if it is the correction step. If not the neumann condition are automatically imposed by Graph-Laplace scheme.
     if(slipCorrect && !m_slipSurfaces.empty()){
         for(auto it = m_slip_bc_dir.begin(); it!=m_slip_bc_dir.end(); ++it){
             long id = it.getId();
-            if (!lapwork->exists(id)) continue;
-
-            //apply the correction relative to bc @ dirichlet node.
-            correction.clear(true);
-            correction.appendItem(id, 1.);
-            correction.sumConstant(-1.0 * ((*it)[comp]) );
-            //Fix to zero the old stencil (the update of system solver doesn't substitute but modify or append new pattern item and weights)
-            lapwork->at(id) *= 0.;
-            lapwork->at(id).setConstant(0.);
-            //sum the correction
-            lapwork->at(id) += correction;
+            if (!isBorder(id)) continue;
+            bcValues[id] = *it;
         }
     }
 
     //add zero dirichlet for all periodic points if any
     //Loop on all periodic boundary points and force to be fixed (dirichlet 0)
     for (long id : m_periodicBoundaryPoints){
-
-        if (!lapwork->exists(id)) continue;
-
-        correction.clear(true);
-        correction.appendItem(id, 1.);
-        correction.sumConstant(0.);
-        //Fix to zero the old stencil (the update of system solver doesn't substitute but modify or append new pattern item and weights)
-        lapwork->at(id) *= 0.;
-        lapwork->at(id).setConstant(0.);
-        //sum the correction
-        lapwork->at(id) += correction;
+        if (!isBorder(id)) continue;
+        bcValues[id] = {{0.,0.,0.}};
     }
 
     //loop on all dirichlet boundary nodes -> They have priority on all other conditions.
     for(auto it = m_bc_dir.begin(); it!=m_bc_dir.end(); ++it){
         long id = it.getId();
-        if (!lapwork->exists(id)) continue;
+        if (!isBorder(id)) continue;
+        bcValues[id] = *it;
+    }
 
-        //apply the correction relative to bc @ dirichlet node.
+    if(m_multigrid){
+        assignBCOnMultigrid(bcValues, maplocals, rhs);
+        return;
+    }
+
+    //apply the correction relative to bc @ dirichlet nodes.
+    for(const auto & bc : bcValues){
+        long id = bc.first;
         correction.clear(true);
         correction.appendItem(id, 1.);
-        correction.sumConstant(-1.0* ( (*it)[comp]) );
         //Fix to zero the old stencil (the update of system solver doesn't substitute but modify or append new pattern item and weights)
         lapwork->at(id) *= 0.;
         lapwork->at(id).setConstant(0.);
@@ -937,15 +1000,34 @@ PropagateVectorField::assignBCAndEvaluateRHS(std::size_t comp, bool slipCorrect,
     }
 
     // now its time to update the solver matrix and to extract the rhs contributes.
-    updateLaplaceSolver(lapwork.get(), maplocals);
+    // The matrix rows depend only on the constrained nodes, not on the bc values.
+    {
+        std::vector<long> constrained;
+        constrained.reserve(bcValues.size());
+        for(const auto & bc : bcValues){
+            constrained.push_back(bc.first);
+        }
+        updateLaplaceSolverOnBC(lapwork.get(), maplocals, idsSignature(constrained));
+    }
 
     // now get the rhs
     for(auto it = lapwork->begin(); it != lapwork->end();++it){
-        long index = maplocals.at(it.getId());
+        long id = it.getId();
+        long index = maplocals.at(id);
 #if MIMMO_ENABLE_MPI
         index -= getGeometry()->getPointGlobalCountOffset();
 #endif
-        rhs[index] -= it->getConstant();
+        auto itbc = bcValues.find(id);
+        if(itbc != bcValues.end()){
+            for(int comp=0; comp<3; ++comp){
+                rhs[comp][index] += itbc->second[comp];
+            }
+        }else{
+            double constant = it->getConstant();
+            for(int comp=0; comp<3; ++comp){
+                rhs[comp][index] -= constant;
+            }
+        }
     }
 }
 
@@ -1098,24 +1180,23 @@ PropagateVectorField::execute(){
     }
     //after this call m_slip_bc_dir is initialized and periodic points stored, in case.
 
-    //allocate the solver;
-    m_solver = std::unique_ptr<bitpit::SystemSolver>(new bitpit::SystemSolver(m_print));
+    //damping and narrow band reference surfaces are the Dirichlet patches, if not specified.
+    if(m_dampingActive && m_dampingSurfaces.empty())    m_dampingSurfaces = m_dirichletPatches;
+    if(m_bandActive && m_bandSurfaces.empty())          m_bandSurfaces = m_dirichletPatches;
+
+    //check if the Laplacian operator cached by a previous execution can be reused.
+    //Multistep modifies the operator along the steps: the cache is not used.
+    bool cacheOperator = (m_operatorCache && m_nstep == 1);
+    std::size_t operatorKey = 0;
+    bool reuseOperator = false;
+    if(cacheOperator){
+        operatorKey = computeOperatorKey();
+        reuseOperator = isOperatorCached(operatorKey);
+    }
 
     //declare inverse and direct map
     lilimap dataInv, data;
 
-    //check if damping or narrow band control are active,
-    //initialize their reference surfaces and compute them
-    if(m_dampingActive){
-        if(m_dampingSurfaces.empty())   m_dampingSurfaces = m_dirichletPatches;
-        initializeUniqueSurface(m_dampingSurfaces, m_dampingUniSurface);
-    }
-
-    if(m_bandActive){
-        if(m_bandSurfaces.empty())   m_bandSurfaces = m_dirichletPatches;
-        initializeUniqueSurface(m_bandSurfaces, m_bandUniSurface);
-    }
-
     //check the slip part
     if(!m_slipSurfaces.empty()){
         if(m_slipReferenceSurfaces.empty())   m_slipReferenceSurfaces = m_slipSurfaces;
@@ -1126,25 +1207,9 @@ PropagateVectorField::execute(){
         }
     }
 
-    //initialize damping and Narrow band Control. If UniSurfaces are null the methods set:
-    // - unitary m_damping field.
-    // - empty m_banddistances member.
-    //
-    initializeDampingFunction();
-    updateNarrowBand();
-
-
     // Instantiate damping function on points
     MimmoPiercedVector<double> dampingOnPoints;
 
-    // Graph Laplace method on points
-
-    //store the id of the border nodes only;
-    //always defined on internals node. No need to ghosts for this list.
-    //TODO extract boundary vertex ID as unordered_set
-    livector1D borderPointsID_vector = geo->extractBoundaryVertexID(false);
-    std::unordered_set<long> borderPointsID(borderPointsID_vector.begin(), borderPointsID_vector.end());
-
     //get this inverse map -> you will need it to compact the stencils.
     dataInv = geo->getMapDataInv(true);
     //get this direct map -> you will need it to deflate compact solution of the system.
@@ -1155,25 +1220,69 @@ PropagateVectorField::execute(){
     //pass dirichlet bc point information to bulk m_bc_dir internal member.
     distributeBCOnBoundaryPoints();
 
-    // Insert dirichlet points in borderPoints set to consider even dirichlet points immersed in bulk (not physical boundaries)
-    for (long id : m_bc_dir.getIds()){
-        borderPointsID.insert(id);
-    }
+    //laplacian stencils of border nodes.
+    GraphLaplStencil::MPVStencilUPtr laplaceStencils;
+
+    if(reuseOperator){
+        //take back the border stencils of the cached operator. Matrix and preconditioner are in m_solver.
+        laplaceStencils = std::move(m_operatorBorderStencils);
+    }else{
+        clearOperatorCache();
+
+        //check if damping or narrow band control are active,
+        //initialize their reference surfaces and compute them
+        if(m_dampingActive){
+            initializeUniqueSurface(m_dampingSurfaces, m_dampingUniSurface);
+        }
+
+        if(m_bandActive){
+            initializeUniqueSurface(m_bandSurfaces, m_bandUniSurface);
+        }
+
+        //initialize damping and Narrow band Control. If UniSurfaces are null the methods set:
+        // - unitary m_damping field.
+        // - empty m_banddistances member.
+        //
+        initializeDampingFunction();
+        updateNarrowBand();
+
+        if(useMultigrid()){
+            //matrix-free operator: no stencils and no matrix are needed.
+            dampingCellToPoint(dampingOnPoints);
+            initializeMultigridSolver(dampingOnPoints, dataInv);
+        }else{
+            //allocate the solver;
+            m_solver = std::unique_ptr<bitpit::SystemSolver>(new bitpit::SystemSolver(m_print));
+
+            // Graph Laplace method on points
+
+            //store the id of the border nodes only;
+            //always defined on internals node. No need to ghosts for this list.
+            //TODO extract boundary vertex ID as unordered_set
+            livector1D borderPointsID_vector = geo->extractBoundaryVertexID(false);
+            std::unordered_set<long> borderPointsID(borderPointsID_vector.begin(), borderPointsID_vector.end());
 
-    //interpolate damping funciton from cell data to point data
-    dampingCellToPoint(dampingOnPoints);
+            // Insert dirichlet points in borderPoints set to consider even dirichlet points immersed in bulk (not physical boundaries)
+            for (long id : m_bc_dir.getIds()){
+                borderPointsID.insert(id);
+            }
 
-    //compute the laplacian stencils
-    GraphLaplStencil::MPVStencilUPtr laplaceStencils = GraphLaplStencil::computeLaplacianStencils(geo, m_tol, &dampingOnPoints);
+            //interpolate damping funciton from cell data to point data
+            dampingCellToPoint(dampingOnPoints);
 
-    //modify stencils if Narrow band is active i.e. m_banddistances is not empty.
-    //This is directly managed in the method.
-    modifyStencilsForNarrowBand(laplaceStencils);
+            //compute the laplacian stencils
+            laplaceStencils = GraphLaplStencil::computeLaplacianStencils(geo, m_tol, &dampingOnPoints);
 
-    // initialize the laplacian Matrix in solver and squeeze out the laplace stencils and save border cells only.
-    initializeLaplaceSolver(laplaceStencils.get(), dataInv);
-    laplaceStencils->squeezeOutExcept(borderPointsID);
-    borderPointsID.clear();
+            //modify stencils if Narrow band is active i.e. m_banddistances is not empty.
+            //This is directly managed in the method.
+            modifyStencilsForNarrowBand(laplaceStencils);
+
+            // initialize the laplacian Matrix in solver and squeeze out the laplace stencils and save border cells only.
+            initializeLaplaceSolver(laplaceStencils.get(), dataInv);
+            laplaceStencils->squeezeOutExcept(borderPointsID);
+            borderPointsID.clear();
+        }
+    }
 
     //declare results here and keep it during the loop to re-use the older steps.
     std::vector<std::vector<double>> results(3);
@@ -1188,18 +1297,18 @@ PropagateVectorField::execute(){
     }
 
     //loop on multistep
-    dvector1D rhs;
+    dvector2D rhs;
     for(int istep=0; istep < m_nstep; ++istep){
 
         //3-COMPONENT SYSTEM SOLVING ---> ///////////////////////////////////////////////////////////////////////
-        // solve the field component by component
-        //first loop -> if slip is enforced in some walls, this is the PREDICTOR
+        // solve the three components of the field together
+        //first solve -> if slip is enforced in some walls, this is the PREDICTOR
         //stage of guess solution with 0-Neumann on slip walls
-        for(int comp = 0; comp<3; ++comp){
-            //rhs dimensioned and zero initialized inside assign.
-            assignBCAndEvaluateRHS(comp, false, laplaceStencils.get(), dataInv, rhs);
-            solveLaplace(rhs, results[comp]);
-        }
+        //the three components share the system matrix: bc are assigned once for all
+        //of them and the rhs block is solved reusing the same preconditioner.
+        //rhs dimensioned and zero initialized inside assign.
+        assignBCAndEvaluateRHS(false, laplaceStencils.get(), dataInv, rhs);
+        solveLaplace(rhs, results);
 
         //if I have slip walls active, it needs a corrector stage for slip boundaries;
         if(!m_slipSurfaces.empty()){
@@ -1209,13 +1318,11 @@ PropagateVectorField::execute(){
             //compute the correction/reprojection @ slip walls
             computeSlipBCCorrector(m_field);
             //now you have a set of BC Dirichlet condition m_slip_bc_dir internal.
-            // so loop again on the components, reusing the previous result as starting guess, and setting
+            // so solve again the components, reusing the previous result as starting guess, and setting
             // the boolean of slipCorrect to true (corrector stage of slip, read Dirichlet from m_slip_bc_dir)
-            for(int comp = 0; comp<3; ++comp){
-                //rhs dimensioned and zero initialized inside assign.
-                assignBCAndEvaluateRHS(comp, true, laplaceStencils.get(), dataInv, rhs);
-                solveLaplace(rhs, results[comp]);
-            }
+            //rhs dimensioned and zero initialized inside assign.
+            assignBCAndEvaluateRHS(true, laplaceStencils.get(), dataInv, rhs);
+            solveLaplace(rhs, results);
         }
 
         //RECONSTRUCT M_FIELD --> //////////////////////////////////////////////
@@ -1245,21 +1352,27 @@ PropagateVectorField::execute(){
             // interpolate damping function on points
             dampingCellToPoint(dampingOnPoints);
 
-            // update the laplacian stencils
-            GraphLaplStencil::MPVStencilUPtr updateLaplaceStencils = GraphLaplStencil::computeLaplacianStencils(geo, movingElementList.get(), m_tol, &dampingOnPoints);
-            movingElementList->clear();
+            if(m_multigrid){
+                //matrix-free operator: rebuild it on the deformed mesh.
+                movingElementList->clear();
+                initializeMultigridSolver(dampingOnPoints, dataInv);
+            }else{
+                // update the laplacian stencils
+                GraphLaplStencil::MPVStencilUPtr updateLaplaceStencils = GraphLaplStencil::computeLaplacianStencils(geo, movingElementList.get(), m_tol, &dampingOnPoints);
+                movingElementList->clear();
 
-            //apply modification to the interested stencils if narrow band control is active
-            modifyStencilsForNarrowBand(updateLaplaceStencils);
+                //apply modification to the interested stencils if narrow band control is active
+                modifyStencilsForNarrowBand(updateLaplaceStencils);
 
-            //store the update boundary stencils in laplaceStencils structure
-            laplaceStencils->getDataFrom(*(updateLaplaceStencils.get()), true); //only common elements are updated.
+                //store the update boundary stencils in laplaceStencils structure
+                laplaceStencils->getDataFrom(*(updateLaplaceStencils.get()), true); //only common elements are updated.
 
-            // update the laplacian Matrix in solver free the updateLaplaceStencils
-            updateLaplaceSolver(updateLaplaceStencils.get(), dataInv);
+                // update the laplacian Matrix in solver free the updateLaplaceStencils
+                updateLaplaceSolver(updateLaplaceStencils.get(), dataInv);
 
-            //clear updateLaplaceStencils
-            updateLaplaceStencils = nullptr;
+                //clear updateLaplaceStencils
+                updateLaplaceStencils = nullptr;
+            }
         }
 
     } //end of multistep loop;
@@ -1285,8 +1398,14 @@ PropagateVectorField::execute(){
     m_bc_dir.clear();
     m_slip_bc_dir.clear();
 
-    //clear the solver;
-    m_solver->clear();
+    if(cacheOperator){
+        //keep the operator for the next execution.
+        m_operatorKey = operatorKey;
+        m_operatorBorderStencils = std::move(laplaceStencils);
+    }else{
+        //clear the solver;
+        clearOperatorCache();
+    }
 
 }
 
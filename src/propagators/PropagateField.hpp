@@ -26,6 +26,8 @@
 
 #include "BaseManipulation.hpp"
 #include "StencilFunctions.hpp"
+#include "GraphLaplMultigrid.hpp"
+#include "DistanceFieldUtils.hpp"
 
 #if MIMMO_ENABLE_MPI
 #include "mimmo_parallel.hpp"
@@ -33,6 +35,15 @@
 
 namespace mimmo{
 
+/*!
+ * \ingroup propagators
+ * \brief Backend of the Laplacian solver of PropagateField classes.
+ */
+enum class LaplaceSolverType{
+    KSP = 0,        /**< system matrix assembled from the Laplacian stencils and solved by bitpit::SystemSolver (PETSc KSP).*/
+    MULTIGRID = 1   /**< matrix-free graph Laplacian with aggregation multigrid preconditioner (see GraphLaplMultigrid). Serial only.*/
+};
+
 /*!
  * \class PropagateField
  * \ingroup propagators
@@ -77,6 +88,22 @@ namespace mimmo{
 
     <B>Note.</B> Currently, NBC and artificial diffusivity are available only for volume bulk mesh.
 
+    When the block is executed many times on the same mesh changing only the boundary
+    conditions values (e.g. optimization loops), the Laplacian operator can be cached
+    (setOperatorCache). The system matrix assembled in the solver, with its preconditioner,
+    is kept after the execution and reused as long as the target geometry, the boundary
+    patches and the damping, narrow band and tolerance settings are unchanged; only the
+    right-hand-side is evaluated again. The rows of the matrix constrained by the boundary
+    conditions are updated only if the set of constrained nodes changes.
+
+    The Laplacian system is solved by default assembling its matrix in a PETSc KSP solver
+    (LaplaceSolverType::KSP). On large serial meshes the matrix-free multigrid backend
+    (LaplaceSolverType::MULTIGRID, see setSolverType) applies the graph Laplacian directly
+    from the mesh point adjacency, without stencils or assembled matrix, and it is
+    preconditioned by a vertex agglomeration multigrid: memory is reduced and the number
+    of iterations is nearly independent of the mesh size. On partitioned meshes the KSP
+    backend is always used.
+
  * Result field is stored in m_field member and returned as data field through ports.
  *
  * The xml available parameters, sections and subsections are the following :
@@ -105,6 +132,10 @@ namespace mimmo{
                                    field norm is above its value, for update purposes
  * - <B>Print</B>                : print solver debug information, Active only
                                    if MIMMO_ENABLE_MPI is enabled in compilation.
+ * - <B>OperatorCache</B>        : 1-true keep the Laplacian operator between executions,
+                                   0-false rebuild it at each execution (default).
+ * - <B>SolverType</B>           : Laplacian solver backend, 0-KSP assembled matrix (default),
+                                   1-matrix-free multigrid (see LaplaceSolverType).
  *
  * Geometry, boundary surfaces, boundary condition values
  * for the target geometry have to be mandatorily passed through ports.
@@ -149,6 +180,16 @@ protected:
     std::unordered_set<MimmoSharedPointer<MimmoObject> >  m_bandSurfaces;   /**<list of MimmoObject boundary patches pointers to identify target baundaries for Narrow Band definition.*/
     MimmoSharedPointer<MimmoObject> m_bandUniSurface; /**< INTERNAL use. Final narrow band reference surface.*/
 
+    // Laplacian operator cache
+    bool          m_operatorCache;  /**< true keep the Laplacian operator between executions.*/
+    std::size_t   m_operatorKey;    /**< INTERNAL use. Signature of geometry and settings of the cached operator, 0 if none.*/
+    std::size_t   m_bcRowsKey;      /**< INTERNAL use. Signature of the nodes constrained by bc in the solver matrix, 0 if unknown.*/
+    GraphLaplStencil::MPVStencilUPtr m_operatorBorderStencils; /**< INTERNAL use. Laplacian stencils of border nodes of the cached operator.*/
+
+    // Laplacian solver backend
+    LaplaceSolverType   m_solverType;   /**< backend of the Laplacian solver.*/
+    std::unique_ptr<GraphLaplMultigrid> m_multigrid; /**< matrix-free multigrid solver, if MULTIGRID backend is in use.*/
+
 public:
 
     PropagateField();
@@ -177,6 +218,14 @@ public:
     void    setDampingInnerDistance(double plateau);
     void    setDampingOuterDistance(double radius);
 
+    void    setOperatorCache(bool flag);
+    bool    isOperatorCacheEnabled();
+    void    clearOperatorCache();
+
+    void    setSolverType(LaplaceSolverType type);
+    void    setSolverType(int type);
+    LaplaceSolverType getSolverType();
+
     //XML utilities from reading writing settings to file
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name="");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name="");
@@ -206,6 +255,18 @@ protected:
     virtual void assignBCAndEvaluateRHS(std::size_t comp, bool unused, GraphLaplStencil::MPVStencil * borderLaplacianStencil,
                                         const lilimap & maplocals, dvector1D & rhs);
     virtual void solveLaplace(const dvector1D &rhs, dvector1D & result);
+    virtual void solveLaplace(const dvector2D &rhs, dvector2D & results);
+    void updateLaplaceSolverOnBC(GraphLaplStencil::MPVStencil * laplacianStencils, const lilimap & maplocals, std::size_t rowsKey);
+    bool useMultigrid();
+    void initializeMultigridSolver(MimmoPiercedVector<double> & dampingOnPoints, const lilimap & maplocals);
+    void assignBCOnMultigrid(const std::unordered_map<long, std::array<double,NCOMP> > & bcValues, const lilimap & maplocals, dvector2D & rhs);
+
+    // Laplacian operator cache
+    std::size_t computeOperatorKey();
+    bool isOperatorCached(std::size_t key);
+    static std::size_t geometrySignature(MimmoObject * geometry);
+    static std::size_t idsSignature(std::vector<long> ids);
+    static void hashCombine(std::size_t & seed, std::size_t value);
 
     // Reconstruct final result field
     virtual void reconstructResults(const dvector2D & results, const lilimap & mapglobals,  livector1D * markedcells = nullptr);
@@ -273,6 +334,10 @@ protected:
  * - <B>Tolerance</B>            : convergence tolerance for laplacian solver.
  * - <B>Print</B>                : print solver debug information, Active only
                                    if MIMMO_ENABLE_MPI is enabled in compilation.
+ * - <B>OperatorCache</B>        : 1-true keep the Laplacian operator between executions,
+                                   0-false rebuild it at each execution (default).
+ * - <B>SolverType</B>           : Laplacian solver backend, 0-KSP assembled matrix (default),
+                                   1-matrix-free multigrid (see LaplaceSolverType).
  *
  * Proper fo the class:
  * - <B>MultiStep</B> : get field solution in a finite number of substeps;
@@ -412,6 +477,10 @@ private:
                                    field norm is above its value, for update purposes
  * - <B>Print</B>                : print solver debug information, Active only
                                    if MIMMO_ENABLE_MPI is enabled in compilation.
+ * - <B>OperatorCache</B>        : 1-true keep the Laplacian operator between executions,
+                                   0-false rebuild it at each execution (default).
+ * - <B>SolverType</B>           : Laplacian solver backend, 0-KSP assembled matrix (default),
+                                   1-matrix-free multigrid (see LaplaceSolverType).
  *
  * Proper fo the class:
  * - <B>MultiStep</B> : got deformation in a finite number of substep of solution;
@@ -491,6 +560,10 @@ protected:
                                 GraphLaplStencil::MPVStencil * borderLaplacianStencil,
                                 const lilimap & maplocals,
                                 dvector1D & rhs);
+    virtual void assignBCAndEvaluateRHS(bool slipCorrect,
+                                GraphLaplStencil::MPVStencil * borderLaplacianStencil,
+                                const lilimap & maplocals,
+                                dvector2D & rhs);
 
     virtual void computeSlipBCCorrector(const MimmoPiercedVector<std::array<double,3> > & guessSolutionOnPoint);
 
@@ -41,6 +41,7 @@ PropagateField<NCOMP>::PropagateField(){
  */
 template<std::size_t NCOMP>
 void PropagateField<NCOMP>::setDefaults(){
+    setDirty();
     this->m_thres = 1.0E-8;
     this->m_tol   = 1.0E-12;
     this->m_print = false;
@@ -55,6 +56,11 @@ void PropagateField<NCOMP>::setDefaults(){
     this->m_bandwidth = 0.0;
     this->m_bandrelax = 1.0;
 
+    this->m_operatorCache = false;
+    this->m_operatorKey = 0;
+    this->m_bcRowsKey = 0;
+
+    this->m_solverType = LaplaceSolverType::KSP;
 }
 
 /*!
@@ -89,6 +95,8 @@ PropagateField<NCOMP>::PropagateField(const PropagateField<NCOMP> & other):BaseM
     this->m_bandrelax    = other.m_bandrelax;
     this->m_bandSurfaces = other.m_bandSurfaces;
 
+    this->m_operatorCache = other.m_operatorCache;
+    this->m_solverType = other.m_solverType;
 };
 
 /*!
@@ -120,6 +128,14 @@ void PropagateField<NCOMP>::swap(PropagateField<NCOMP> & x) noexcept {
     std::swap(this->m_bandSurfaces, x.m_bandSurfaces);
     this->m_banddistances.swap(x.m_banddistances);
 
+    std::swap(this->m_solver, x.m_solver);
+    std::swap(this->m_operatorCache, x.m_operatorCache);
+    std::swap(this->m_operatorKey, x.m_operatorKey);
+    std::swap(this->m_bcRowsKey, x.m_bcRowsKey);
+    std::swap(this->m_operatorBorderStencils, x.m_operatorBorderStencils);
+    std::swap(this->m_solverType, x.m_solverType);
+    std::swap(this->m_multigrid, x.m_multigrid);
+
     this->BaseManipulation::swap(x);
 }
 
@@ -143,6 +159,7 @@ PropagateField<NCOMP>::buildPorts(){
  */
 template <std::size_t NCOMP>
 void PropagateField<NCOMP>::setTolerance(double tol){
+    setDirty();
     m_tol = std::max(std::numeric_limits<double>::min(), tol);;
 }
 
@@ -153,6 +170,7 @@ void PropagateField<NCOMP>::setTolerance(double tol){
  */
 template <std::size_t NCOMP>
 void PropagateField<NCOMP>::setUpdateThreshold(double thres){
+    setDirty();
     m_thres = std::max(std::numeric_limits<double>::min(), thres);
 }
 
@@ -163,6 +181,7 @@ void PropagateField<NCOMP>::setUpdateThreshold(double thres){
  */
 template <std::size_t NCOMP>
 void PropagateField<NCOMP>::setPrint(bool print){
+    setDirty();
     bool check = false;
 #if MIMMO_ENABLE_MPI
     check = print;
@@ -180,6 +199,7 @@ void PropagateField<NCOMP>::setPrint(bool print){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setGeometry(MimmoSharedPointer<MimmoObject> geometry_){
+    setDirty();
 
     if (geometry_ == nullptr) return;
     if (geometry_->getType() != 2 && geometry_->getType() != 1){
@@ -209,6 +229,7 @@ PropagateField<NCOMP>::setGeometry(MimmoSharedPointer<MimmoObject> geometry_){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::addDirichletBoundarySurface(MimmoSharedPointer<MimmoObject> bsurface){
+    setDirty();
     if (bsurface == nullptr)       return;
 
     m_dirichletPatches.insert(bsurface);
@@ -223,6 +244,7 @@ PropagateField<NCOMP>::addDirichletBoundarySurface(MimmoSharedPointer<MimmoObjec
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::addDirichletBoundaryPatch(MimmoSharedPointer<MimmoObject> bsurface){
+    setDirty();
     if (bsurface == nullptr)       return;
 
     //getting it ready
@@ -237,6 +259,7 @@ PropagateField<NCOMP>::addDirichletBoundaryPatch(MimmoSharedPointer<MimmoObject>
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setNarrowBand(bool flag){
+	setDirty();
 	m_bandActive = flag;
 }
 
@@ -250,6 +273,7 @@ PropagateField<NCOMP>::setNarrowBand(bool flag){
  template <std::size_t NCOMP>
  void
  PropagateField<NCOMP>::addNarrowBandBoundarySurface(MimmoSharedPointer<MimmoObject> surface){
+	setDirty();
 	if (surface == nullptr)      return;
 	if (surface->getType()!= 1 ){
         m_log->setPriority(bitpit::log::Verbosity::DEBUG);
@@ -271,6 +295,7 @@ PropagateField<NCOMP>::setNarrowBand(bool flag){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setNarrowBandWidth(double width){
+    setDirty();
     m_bandwidth = std::max(width, 0.0);
 }
 
@@ -282,6 +307,7 @@ PropagateField<NCOMP>::setNarrowBandWidth(double width){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setNarrowBandRelaxation(double relax){
+    setDirty();
     m_bandrelax = std::max(0.0,std::min(relax, 1.0));
 }
 
@@ -292,6 +318,7 @@ PropagateField<NCOMP>::setNarrowBandRelaxation(double relax){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setDamping(bool flag){
+	setDirty();
 	m_dampingActive = flag;
 }
 
@@ -302,6 +329,7 @@ PropagateField<NCOMP>::setDamping(bool flag){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setDampingType(int type){
+	setDirty();
 	m_dampingType = std::max(0, std::min(1, type));
 }
 
@@ -313,6 +341,7 @@ PropagateField<NCOMP>::setDampingType(int type){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setDampingDecayFactor(double decay){
+	setDirty();
 	m_decayFactor = decay;
 }
 
@@ -325,6 +354,7 @@ PropagateField<NCOMP>::setDampingDecayFactor(double decay){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::addDampingBoundarySurface(MimmoSharedPointer<MimmoObject> bdamping){
+	setDirty();
 	if (bdamping == nullptr)       return;
 	if (bdamping->getType()!= 1 ){
         m_log->setPriority(bitpit::log::Verbosity::DEBUG);
@@ -346,6 +376,7 @@ PropagateField<NCOMP>::addDampingBoundarySurface(MimmoSharedPointer<MimmoObject>
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setDampingInnerDistance(double plateau){
+	setDirty();
 	m_plateau = plateau;
 }
 
@@ -356,9 +387,84 @@ PropagateField<NCOMP>::setDampingInnerDistance(double plateau){
 template <std::size_t NCOMP>
 void
 PropagateField<NCOMP>::setDampingOuterDistance(double radius){
+	setDirty();
 	m_radius = radius;
 }
 
+/*!
+ * Enable the cache of the Laplacian operator between executions (see class doc).
+ * The cached operator is reused if the target geometry, the Dirichlet, damping and
+ * narrow band boundary patches and the damping, narrow band and tolerance settings are
+ * unchanged since the execution that built it, as tracked by the MimmoObject revisions:
+ * geometries modified directly on their bitpit patch have to be marked by
+ * MimmoObject::setUnsyncAll. Disabling the cache releases it.
+ * \param[in] flag boolean true activate, false deactivate.
+ */
+template <std::size_t NCOMP>
+void
+PropagateField<NCOMP>::setOperatorCache(bool flag){
+    setDirty();
+    m_operatorCache = flag;
+    if(!flag)   clearOperatorCache();
+}
+
+/*!
+ * \return true if the cache of the Laplacian operator between executions is enabled.
+ */
+template <std::size_t NCOMP>
+bool
+PropagateField<NCOMP>::isOperatorCacheEnabled(){
+    return m_operatorCache;
+}
+
+/*!
+ * Release the cached Laplacian operator, if any. It will be built again at the next execution.
+ */
+template <std::size_t NCOMP>
+void
+PropagateField<NCOMP>::clearOperatorCache(){
+    m_operatorKey = 0;
+    m_bcRowsKey = 0;
+    m_operatorBorderStencils = nullptr;
+    if(m_solver)    m_solver->clear();
+    m_multigrid = nullptr;
+}
+
+/*!
+ * Set the backend of the Laplacian solver (see LaplaceSolverType). The MULTIGRID backend
+ * is available for serial meshes only: on partitioned meshes the KSP one is used anyway.
+ * Changing the backend releases the cached operator, if any.
+ * \param[in] type backend of the solver
+ */
+template <std::size_t NCOMP>
+void
+PropagateField<NCOMP>::setSolverType(LaplaceSolverType type){
+    setDirty();
+    if(type != m_solverType)    clearOperatorCache();
+    m_solverType = type;
+}
+
+/*!
+ * Set the backend of the Laplacian solver (see LaplaceSolverType).
+ * \param[in] type 0-KSP, 1-MULTIGRID. Other values are ignored.
+ */
+template <std::size_t NCOMP>
+void
+PropagateField<NCOMP>::setSolverType(int type){
+    setDirty();
+    if(type < 0 || type > 1)    return;
+    setSolverType(static_cast<LaplaceSolverType>(type));
+}
+
+/*!
+ * \return backend of the Laplacian solver.
+ */
+template <std::size_t NCOMP>
+LaplaceSolverType
+PropagateField<NCOMP>::getSolverType(){
+    return m_solverType;
+}
+
 
 /*!
  * It sets infos reading from a XML bitpit::Config::section.
@@ -408,6 +514,27 @@ void PropagateField<NCOMP>::absorbSectionXML(const bitpit::Config::Section & slo
         setPrint(value);
     }
 
+    if(slotXML.hasOption("OperatorCache")){
+        std::string input = slotXML.get("OperatorCache");
+        input = bitpit::utils::string::trim(input);
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setOperatorCache(value);
+    }
+
+    if(slotXML.hasOption("SolverType")){
+        std::string input = slotXML.get("SolverType");
+        input = bitpit::utils::string::trim(input);
+        int value = 0;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setSolverType(value);
+    }
 
     if(slotXML.hasOption("NarrowBand")){
         std::string input = slotXML.get("NarrowBand");
@@ -541,6 +668,12 @@ void PropagateField<NCOMP>::flushSectionXML(bitpit::Config::Section & slotXML, s
     slotXML.set("Tolerance",std::to_string(m_tol));
     slotXML.set("UpdateThres",std::to_string(m_thres));
     slotXML.set("Print",std::to_string(int(m_print)));
+    if(m_operatorCache){
+        slotXML.set("OperatorCache",std::to_string(int(m_operatorCache)));
+    }
+    if(m_solverType != LaplaceSolverType::KSP){
+        slotXML.set("SolverType",std::to_string(static_cast<int>(m_solverType)));
+    }
 
     slotXML.set("NarrowBand", std::to_string(int(m_bandActive)));
     if(m_bandActive){
@@ -573,6 +706,7 @@ PropagateField<NCOMP>::clear(){
     m_banddistances.clear();
     m_bandSurfaces.clear();
     m_bandUniSurface = nullptr;
+    clearOperatorCache();
 
     setDefaults();
 }
@@ -762,33 +896,16 @@ PropagateField<NCOMP>::updateDampingFunction(){
     }
 
     const double maxd(m_radius);
-    //get the list of elements in m_damping with diffusivity > 1.0;
-    // at the same time reset the dumping function values to 1.0;
-    livector1D seedlist;
-    seedlist.reserve(m_damping.size());
+    //reset the damping function values to 1.0 on the cells of the old narrow band;
     for(auto it= m_damping.begin(); it!=m_damping.end(); ++it){
         if(*it > 1.0){
-            seedlist.push_back(it.getId());
-            //reset local value of m_damping to 1.0.
             *it = 1.0;
         }
     }
 
-    // if seedlist is still empty have a try finding some seeds along
-    // bulk volume mesh borders (ghost included)
-    if (seedlist.empty()){
-        // Initialize seeds to avoid use of skdtree in narrowband computing
-        // BEWARE this is done to seed the partition initially, and if updating,
-        //to avoid the case in which a single partition does not have seeds.
-        // Due to flawed propagation in getCellsNarrowBandToExtSurfaceWDist in parallel
-        //
-        seedlist = getGeometry()->getBorderCells(); // all border ghost included
-    }
-    seedlist.shrink_to_fit();
-
-    //reevaluate narrow band cells at distance d < maxd
-    bitpit::PiercedVector<double> distFactor = getGeometry()->getCellsNarrowBandToExtSurfaceWDist(*(m_dampingUniSurface.get()), maxd, &seedlist);
-    seedlist.clear();
+    //reevaluate narrow band cells at distance d < maxd. The distance field is computed by
+    //fast marching seeded from the cells touching the damping surface, ghost cells included.
+    bitpit::PiercedVector<double> distFactor = distanceFieldUtils::cellsDistance(*getGeometry(), *(m_dampingUniSurface.get()), maxd);
 
     double distanceMax = std::pow((maxd/m_plateau), m_decayFactor);
     for(auto it = distFactor.begin(); it !=distFactor.end(); ++it){
@@ -863,8 +980,6 @@ PropagateField<NCOMP>::dampingCellToPoint(MimmoPiercedVector<double> & dampingOn
 /*!
     Compute/Update the list of vertices in the narrow band and store it with their distance
     in m_banddistances member.
-    If m_banddistances is not empty, use its information as starting point to update
-    the narrow band list.
     It requires the initialization of a Unique Surface (m_bandUniSurface) for m_bandSurfaces list first.
 */
 template<std::size_t NCOMP>
@@ -879,23 +994,9 @@ PropagateField<NCOMP>::updateNarrowBand(){
         return;
     }
 
-    //get the list of vertex elements in m_banddistances;
-    livector1D seedlist = m_banddistances.getIds();
-
-    // is seedlist is still empty have a try finding some vertex seeds along
-    // bulk volume mesh borders (ghost included)
-    if (seedlist.empty()){
-        // Initialize seeds to avoid use of skdtree in narrowband computing
-        // BEWARE this is done to seed the partition initially, and if updating,
-        //to avoid the case in which a single partition does not have seeds.
-        // Due to flawed propagation in getVerticesNarrowBandToExtSurfaceWDist in parallel
-        //
-        seedlist = getGeometry()->getBorderVertices(); // all border ghost included
-    }
-    seedlist.shrink_to_fit();
-
-    //re-evaluate narrow band vertices at distance d < m_bandwidth
-    m_banddistances = getGeometry()->getVerticesNarrowBandToExtSurfaceWDist(*(m_bandUniSurface.get()), m_bandwidth, &seedlist);
+    //re-evaluate narrow band vertices at distance d < m_bandwidth. The distance field is computed
+    //by fast marching seeded from the vertices touching the band surface, ghost vertices included.
+    m_banddistances = distanceFieldUtils::pointsDistance(*getGeometry(), *(m_bandUniSurface.get()), m_bandwidth);
 }
 
 
@@ -1000,6 +1101,7 @@ PropagateField<NCOMP>::initializeLaplaceSolver(GraphLaplStencil::MPVStencil * la
 
 	//clean up the previous stuff in the solver.
 	m_solver->clear();
+	m_bcRowsKey = 0;
 	// now you can initialize the m_solver with this matrix.
 	m_solver->getKSPOptions().restart = 30;
 	m_solver->getKSPOptions().overlap = 1;
@@ -1061,9 +1163,224 @@ PropagateField<NCOMP>::updateLaplaceSolver(FVolStencil::MPVDivergence * laplacia
 
 	//call the solver update;
 	m_solver->update(rows_involved.size(), rows_involved.data(), upelements);
+	m_bcRowsKey = 0;
 
 }
 
+/*!
+ * Update the system matrix in m_solver with the border laplacian stencils modified by bc.
+ * If the nodes constrained by bc are the same of the previous update (same rowsKey) and the
+ * matrix has not been modified in the meanwhile, the rows are unchanged: the update is skipped
+ * and the preconditioner already set up by m_solver is kept.
+ * \param[in] laplacianStencils border laplacian stencils modified by bc.
+ * \param[in] maplocals map from global id numbering to local system solver numbering.
+ * \param[in] rowsKey signature of the nodes constrained by bc (see idsSignature).
+ */
+template<std::size_t NCOMP>
+void
+PropagateField<NCOMP>::updateLaplaceSolverOnBC(GraphLaplStencil::MPVStencil * laplacianStencils, const lilimap & maplocals, std::size_t rowsKey){
+
+    int unchanged = (rowsKey != 0 && rowsKey == m_bcRowsKey) ? 1 : 0;
+#if MIMMO_ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &unchanged, 1, MPI_INT, MPI_MIN, m_communicator);
+#endif
+    if(unchanged == 1)  return;
+
+    updateLaplaceSolver(laplacianStencils, maplocals);
+    m_bcRowsKey = rowsKey;
+}
+
+/*!
+ * Check if the Laplacian system has to be solved with the matrix-free multigrid backend.
+ * The backend requires a serial mesh: on partitioned meshes the KSP one is used.
+ * \return true if the MULTIGRID backend is selected and available.
+ */
+template<std::size_t NCOMP>
+bool
+PropagateField<NCOMP>::useMultigrid(){
+
+    if(m_solverType != LaplaceSolverType::MULTIGRID)    return false;
+#if MIMMO_ENABLE_MPI
+    if(m_nprocs > 1 && getGeometry()->isParallel()){
+        (*m_log)<<"Warning in "<<m_name<<". Multigrid Laplacian solver available only on serial meshes. KSP solver is used."<<std::endl;
+        return false;
+    }
+#endif
+    return true;
+}
+
+/*!
+ * Build the matrix-free multigrid solver of the Laplacian on the target geometry, with the
+ * current damping and narrow band settings. It replaces the computation of the Laplacian
+ * stencils and the initialization of m_solver when the MULTIGRID backend is in use.
+ * m_banddistances must be already updated.
+ * \param[in] dampingOnPoints diffusivity on points.
+ * \param[in] maplocals map from global id numbering to local system solver numbering.
+ */
+template<std::size_t NCOMP>
+void
+PropagateField<NCOMP>::initializeMultigridSolver(MimmoPiercedVector<double> & dampingOnPoints, const lilimap & maplocals){
+
+    if(!m_multigrid){
+        m_multigrid = std::unique_ptr<GraphLaplMultigrid>(new GraphLaplMultigrid());
+    }
+    m_multigrid->setTolerance(m_tol);
+    m_multigrid->build(getGeometry(), maplocals, &dampingOnPoints, &m_banddistances, m_bandrelax);
+}
+
+/*!
+ * Impose the bc on the multigrid solver: constrained rows are set and the rhs of
+ * constrained rows takes the bc values. The multigrid hierarchy is rebuilt by the solver
+ * only if the constrained rows change.
+ * \param[in] bcValues bc values on constrained nodes.
+ * \param[in] maplocals map from global id numbering to local system solver numbering.
+ * \param[in,out] rhs right-hand-sides of the components, already sized.
+ */
+template<std::size_t NCOMP>
+void
+PropagateField<NCOMP>::assignBCOnMultigrid(const std::unordered_map<long, std::array<double,NCOMP> > & bcValues,
+                                           const lilimap & maplocals, dvector2D & rhs){
+
+    MimmoSharedPointer<MimmoObject> geo = getGeometry();
+    std::vector<long> rows;
+    rows.reserve(bcValues.size());
+    for(const auto & bc : bcValues){
+        if(!geo->isPointInterior(bc.first))  continue;
+        long index = maplocals.at(bc.first);
+#if MIMMO_ENABLE_MPI
+        index -= geo->getPointGlobalCountOffset();
+#endif
+        rows.push_back(index);
+        for(std::size_t comp=0; comp<rhs.size() && comp<NCOMP; ++comp){
+            rhs[comp][index] = bc.second[comp];
+        }
+    }
+    m_multigrid->setConstraints(rows);
+}
+
+/*!
+ * Compute the signature of the Laplacian operator of the current execution, combining
+ * the target geometry, the Dirichlet, damping and narrow band boundary patches and the
+ * damping, narrow band and tolerance settings.
+ * \return signature of the operator (never 0).
+ */
+template<std::size_t NCOMP>
+std::size_t
+PropagateField<NCOMP>::computeOperatorKey(){
+
+    std::hash<double> hashDouble;
+    std::size_t key = geometrySignature(getGeometry().get());
+    hashCombine(key, hashDouble(m_tol));
+    hashCombine(key, std::size_t(m_solverType));
+
+    //boundary patches sets are unordered: their signatures are summed.
+    std::size_t patchesKey = 0;
+    for(MimmoSharedPointer<MimmoObject> obj : m_dirichletPatches){
+        patchesKey += geometrySignature(obj.get());
+    }
+    hashCombine(key, patchesKey);
+
+    hashCombine(key, std::size_t(m_dampingActive));
+    if(m_dampingActive){
+        hashCombine(key, std::size_t(m_dampingType));
+        hashCombine(key, hashDouble(m_decayFactor));
+        hashCombine(key, hashDouble(m_radius));
+        hashCombine(key, hashDouble(m_plateau));
+        patchesKey = 0;
+        for(MimmoSharedPointer<MimmoObject> obj : m_dampingSurfaces){
+            patchesKey += geometrySignature(obj.get());
+        }
+        hashCombine(key, patchesKey);
+    }
+
+    hashCombine(key, std::size_t(m_bandActive));
+    if(m_bandActive){
+        hashCombine(key, hashDouble(m_bandwidth));
+        hashCombine(key, hashDouble(m_bandrelax));
+        patchesKey = 0;
+        for(MimmoSharedPointer<MimmoObject> obj : m_bandSurfaces){
+            patchesKey += geometrySignature(obj.get());
+        }
+        hashCombine(key, patchesKey);
+    }
+
+    if(key == 0)    key = 1;
+    return key;
+}
+
+/*!
+ * Check if the cached Laplacian operator can be reused. In parallel the check is
+ * collective: the operator is reused only if it is valid on all the ranks.
+ * \param[in] key signature of the operator of the current execution (see computeOperatorKey).
+ * \return true if the cached operator is available and corresponds to key.
+ */
+template<std::size_t NCOMP>
+bool
+PropagateField<NCOMP>::isOperatorCached(std::size_t key){
+
+    int cached = 0;
+    if(key != 0 && key == m_operatorKey){
+        if(m_multigrid){
+            cached = m_multigrid->isBuilt() ? 1 : 0;
+        }else{
+            cached = (m_operatorBorderStencils && m_solver && m_solver->isAssembled()) ? 1 : 0;
+        }
+    }
+#if MIMMO_ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &cached, 1, MPI_INT, MPI_MIN, m_communicator);
+#endif
+    return (cached == 1);
+}
+
+/*!
+ * Compute a signature of a geometry, combining the revisions of its vertices and cells.
+ * Revisions are renewed by MimmoObject at each modification of the geometry and are
+ * unique among geometries, so the signature is evaluated in constant time.
+ * \param[in] geometry target geometry
+ * \return signature of the geometry (0 for null geometry).
+ */
+template<std::size_t NCOMP>
+std::size_t
+PropagateField<NCOMP>::geometrySignature(MimmoObject * geometry){
+
+    std::size_t seed = 0;
+    if(!geometry)   return seed;
+
+    hashCombine(seed, geometry->getVerticesRevision());
+    hashCombine(seed, geometry->getCellsRevision());
+    return seed;
+}
+
+/*!
+ * Compute a signature of a set of ids, independent of their order.
+ * \param[in] ids list of ids
+ * \return signature of the list (never 0).
+ */
+template<std::size_t NCOMP>
+std::size_t
+PropagateField<NCOMP>::idsSignature(std::vector<long> ids){
+
+    std::sort(ids.begin(), ids.end());
+    std::hash<long> hashLong;
+    std::size_t seed = ids.size();
+    for(long id : ids){
+        hashCombine(seed, hashLong(id));
+    }
+    if(seed == 0)   seed = 1;
+    return seed;
+}
+
+/*!
+ * Combine a hash value into a seed.
+ * \param[in,out] seed hash to be updated.
+ * \param[in] value hash value to combine.
+ */
+template<std::size_t NCOMP>
+void
+PropagateField<NCOMP>::hashCombine(std::size_t & seed, std::size_t value){
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
 /*!
  * This method evaluate the bc corrections for a singular run of the system solver,
  * update the system matrix in m_solver and evaluate the rhs part due to bc.
@@ -1092,6 +1409,17 @@ PropagateField<NCOMP>::assignBCAndEvaluateRHS(std::size_t comp, bool unused,
         std::swap(rhs, temp);
     }
 
+    if(m_multigrid){
+        std::unordered_map<long, std::array<double,NCOMP> > bcValues;
+        for(auto it = m_bc_dir.begin(); it != m_bc_dir.end(); ++it){
+            bcValues[it.getId()] = *it;
+        }
+        dvector2D rhsBlock(NCOMP, dvector1D(rhs.size(), 0.0));
+        assignBCOnMultigrid(bcValues, maplocals, rhsBlock);
+        std::swap(rhs, rhsBlock[std::min(comp, NCOMP-1)]);
+        return;
+    }
+
     if (!m_solver->isAssembled()) {
         m_log->setPriority(bitpit::log::Verbosity::DEBUG);
         (*m_log)<<"Warning in "<<m_name<<". Unable to assign BC to the system. The solver is not yet initialized."<<std::endl;
@@ -1115,8 +1443,11 @@ PropagateField<NCOMP>::assignBCAndEvaluateRHS(std::size_t comp, bool unused,
     bitpit::StencilScalar correction;
 
     //loop on all dirichlet boundary nodes
+    std::vector<long> constrained;
+    constrained.reserve(m_bc_dir.size());
     for(long id : m_bc_dir.getIds()){
         if (lapwork->exists(id)){
+            constrained.push_back(id);
             //apply the correction relative to bc @ dirichlet node.
             correction.clear(true);
             correction.appendItem(id, 1.);
@@ -1128,7 +1459,8 @@ PropagateField<NCOMP>::assignBCAndEvaluateRHS(std::size_t comp, bool unused,
     }
 
     // now its time to update the solver matrix and to extract the rhs contributes.
-    updateLaplaceSolver(lapwork.get(), maplocals);
+    // The matrix rows depend only on the constrained nodes, not on the bc values.
+    updateLaplaceSolverOnBC(lapwork.get(), maplocals, idsSignature(constrained));
 
     // now get the rhs
     for(auto it = lapwork->begin(); it != lapwork->end();++it){
@@ -1156,6 +1488,14 @@ PropagateField<NCOMP>::solveLaplace(const dvector1D &rhs, dvector1D &result){
 
     result.resize(getGeometry()->getNInternalVertices(), 0.);
 
+    if(m_multigrid){
+        if(!m_multigrid->solve(rhs, result)){
+            (*m_log)<<"Warning in "<<m_name<<". Multigrid Laplacian solver not converged after "<<m_multigrid->getIterationCount()
+                    <<" iterations, relative residual "<<m_multigrid->getResidual()<<std::endl;
+        }
+        return;
+    }
+
     // Check if the internal solver is initialized
     if (!m_solver->isAssembled()) {
         m_log->setPriority(bitpit::log::Verbosity::DEBUG);
@@ -1170,6 +1510,27 @@ PropagateField<NCOMP>::solveLaplace(const dvector1D &rhs, dvector1D &result){
     //think I've done my job.
 }
 
+/*!
+ * It solves the laplacian problem for a block of right-hand-sides sharing the same
+ * system matrix (e.g. the components of a vector field).
+ * The matrix is not modified between the solutions, so the preconditioner is set up
+ * by m_solver at the first solution only and reused for the others.
+ * Before calling this method be sure to have initialized the Laplacian linear system
+ *
+ * \param[in] rhs on internal nodes, one vector for each field;
+ * \param[in,out] results on internal nodes, one vector for each field. In input are the initial
+ * solutions, in output the results of computation.
+ */
+template<std::size_t NCOMP>
+void
+PropagateField<NCOMP>::solveLaplace(const dvector2D &rhs, dvector2D &results){
+
+    results.resize(rhs.size());
+    for(std::size_t i=0; i<rhs.size(); ++i){
+        solveLaplace(rhs[i], results[i]);
+    }
+}
+
 /*!
  * Utility to put laplacian solution directly into m_field (cleared and refreshed).
  * Ghost communication is already taken into account in case of MPI version.
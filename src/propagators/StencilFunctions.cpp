@@ -627,9 +627,10 @@ MPVStencilUPtr computeLaplacianStencils(MimmoSharedPointer<MimmoObject> geo, dou
     double d_1;
     double p = 2.0;
     double localdiff, avgdiff;
-    for (long id1 : geo->getVertices().getIds()){
+    for (auto itV = geo->getVertices().cbegin(); itV != geo->getVertices().cend(); ++itV){
+        long id1 = itV.getId();
         localdiff = pdiffusivity->at(id1);
-        auto pconn = geo->getPointConnectivity(id1);
+        auto pconn = geo->getPointConnectivityRaw(itV.getRawIndex());
         for (long id2 : pconn){
             avgdiff = 0.5*(localdiff + pdiffusivity->at(id2));
             d_1 =1.0/std::pow(norm2(geo->getVertexCoords(id1)-geo->getVertexCoords(id2)),p);
@@ -173,6 +173,7 @@ AABBox::getGeometries(){
  */
 void
 AABBox::setGeometries(std::vector<MimmoSharedPointer<MimmoObject> > listgeo){
+    setDirty();
     m_listgeo.clear();
     for( auto val : listgeo){
         setGeometry(val);
@@ -186,6 +187,7 @@ AABBox::setGeometries(std::vector<MimmoSharedPointer<MimmoObject> > listgeo){
  */
 void
 AABBox::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
 
     if (geo == nullptr)    {
         (*m_log)<<"warning: "<<m_name<<" not valid Geometry pointer. Doing nothing"<<std::endl;
@@ -202,6 +204,7 @@ AABBox::setGeometry(MimmoSharedPointer<MimmoObject> geo){
  */
 void
 AABBox::setAxes(dmatrix33E axes){
+    setDirty();
     m_axes = axes;
 }
 
@@ -211,6 +214,7 @@ AABBox::setAxes(dmatrix33E axes){
  */
 void
 AABBox::setWriteInfo(bool flag){
+    setDirty();
     m_writeInfo = flag;
 }
 
@@ -178,6 +178,7 @@ ControlDeformExtSurface::getConstraintFiles() const{
  */
 void
 ControlDeformExtSurface::setDefField(dmpvecarr3E *field){
+    setDirty();
     if(!field)  return;
     m_defField.clear();
     m_defField = *field;
@@ -189,6 +190,7 @@ ControlDeformExtSurface::setDefField(dmpvecarr3E *field){
  */
 void
 ControlDeformExtSurface::setGeometry( mimmo::MimmoSharedPointer<mimmo::MimmoObject> target){
+    setDirty();
     if(target == nullptr)       return;
     if(target->getType() != 1){
         (*m_log)<<"warning: ControlDeformExtSurface cannot support current geometry. It works only w/ 3D surface."<<std::endl;
@@ -207,6 +209,7 @@ ControlDeformExtSurface::setGeometry( mimmo::MimmoSharedPointer<mimmo::MimmoObje
  */
 void
 ControlDeformExtSurface::setTolerance(double tol){
+    setDirty();
     m_tolerance = std::max(0.0, tol);
 }
 
@@ -218,6 +221,7 @@ ControlDeformExtSurface::setTolerance(double tol){
  */
 void
 ControlDeformExtSurface::addConstraint( mimmo::MimmoSharedPointer<mimmo::MimmoObject> constraint){
+    setDirty();
     if(constraint == nullptr)       return;
     if(constraint->getType() != 1){
         (*m_log)<<"warning: ControlDeformExtSurface cannot support current constraint geometry. It works only w/ 3D surface."<<std::endl;
@@ -240,6 +244,7 @@ ControlDeformExtSurface::addConstraint( mimmo::MimmoSharedPointer<mimmo::MimmoOb
  */
 void
 ControlDeformExtSurface::setConstraintFiles(ControlDeformExtSurface::fileListWithType files){
+    setDirty();
     for(auto & val : files){
         addConstraintFile(val.first, val.second);
     }
@@ -252,6 +257,7 @@ ControlDeformExtSurface::setConstraintFiles(ControlDeformExtSurface::fileListWit
  */
 void
 ControlDeformExtSurface::addConstraintFile(std::string file, int format){
+    setDirty();
     if(m_allowed.count(format)>0){
         m_geoFileList[file] = format;
     }
@@ -263,6 +269,7 @@ ControlDeformExtSurface::addConstraintFile(std::string file, int format){
  *\param[in] format  type of file as  Filetype enum. only nas, stl, stvtu and sqvtu are supported.
  */
 void     ControlDeformExtSurface::addConstraintFile(std::string file, FileType format){
+    setDirty();
     addConstraintFile(file,format._to_integral());
 };
 
@@ -272,6 +279,7 @@ void     ControlDeformExtSurface::addConstraintFile(std::string file, FileType f
  */
 void
 ControlDeformExtSurface::removeConstraintFile(std::string file){
+    setDirty();
     if(m_geoFileList.count(file) >0)    m_geoFileList.erase(file);
 };
 
@@ -280,6 +288,7 @@ ControlDeformExtSurface::removeConstraintFile(std::string file){
  */
 void
 ControlDeformExtSurface::removeConstraintFiles(){
+    setDirty();
     m_geoFileList.clear();
 };
 
@@ -141,6 +141,7 @@ ControlDeformMaxDistance::getViolationField(){
  */
 void
 ControlDeformMaxDistance::setDefField(dmpvecarr3E *field){
+    setDirty();
     if(!field) return;
     m_defField.clear();
     m_violationField.clear();
@@ -154,6 +155,7 @@ ControlDeformMaxDistance::setDefField(dmpvecarr3E *field){
  */
 void
 ControlDeformMaxDistance::setLimitDistance(double dist){
+    setDirty();
     m_maxDist = std::fmax(1.0E-12,dist);
 };
 
@@ -164,6 +166,7 @@ ControlDeformMaxDistance::setLimitDistance(double dist){
  */
 void
 ControlDeformMaxDistance::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if (geo == nullptr) return;
     if (geo->getType() != 1 ) return;
 
@@ -244,6 +244,7 @@ CreateSeedsOnSurface::getRandomSignature(){
  */
 void
 CreateSeedsOnSurface::setNPoints(int val){
+    setDirty();
     m_nPoints = std::max(val,0);
 }
 
@@ -253,6 +254,7 @@ CreateSeedsOnSurface::setNPoints(int val){
  */
 void
 CreateSeedsOnSurface::setEngineENUM(CSeedSurf eng){
+    setDirty();
     m_engine = eng;
 }
 
@@ -262,6 +264,7 @@ CreateSeedsOnSurface::setEngineENUM(CSeedSurf eng){
  */
 void
 CreateSeedsOnSurface::setEngine(int eng){
+    setDirty();
     if(eng <0 || eng >2)    eng = 2;
     setEngineENUM(static_cast<CSeedSurf>(eng));
 }
@@ -274,6 +277,7 @@ CreateSeedsOnSurface::setEngine(int eng){
  */
 void
 CreateSeedsOnSurface::setSeed(darray3E seed){
+    setDirty();
     m_seed = seed;
 }
 
@@ -284,6 +288,7 @@ CreateSeedsOnSurface::setSeed(darray3E seed){
  */
 void
 CreateSeedsOnSurface::setMassCenterAsSeed(bool flag){
+    setDirty();
     m_seedbaricenter = flag;
 }
 
@@ -295,6 +300,7 @@ CreateSeedsOnSurface::setMassCenterAsSeed(bool flag){
  */
 void
 CreateSeedsOnSurface::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(geo == nullptr)    return;
     if(geo->getType() != 1)    return;
 
@@ -314,6 +320,7 @@ CreateSeedsOnSurface::setGeometry(MimmoSharedPointer<MimmoObject> geo){
  */
 void
 CreateSeedsOnSurface::setRandomFixed(bool fix){
+    setDirty();
     m_randomFixed = fix;
 }
 
@@ -326,6 +333,7 @@ CreateSeedsOnSurface::setRandomFixed(bool fix){
  */
 void
 CreateSeedsOnSurface::setRandomSignature( uint32_t signature){
+    setDirty();
     m_randomSignature = signature;
 }
 
@@ -337,6 +345,7 @@ CreateSeedsOnSurface::setRandomSignature( uint32_t signature){
  */
 void
 CreateSeedsOnSurface::setSensitivityMap( dmpvector1D *field){
+    setDirty();
     if(!field) return;
     m_sensitivity = *field;
 }
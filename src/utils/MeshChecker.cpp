@@ -121,6 +121,7 @@ MeshChecker::swap(MeshChecker & x) noexcept
 void
 MeshChecker::setDefault()
 {
+	setDirty();
 	m_minVolume = 1.e+18;
 	m_maxVolume = 0.;
 	m_maxSkewness = 0.;
@@ -185,6 +186,7 @@ MeshChecker::buildPorts(){
     \param[in] geo target geometry
 */
 void MeshChecker::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(geo){
         BaseManipulation::setGeometry(geo);
         //Clear auxiliary variables
@@ -198,6 +200,7 @@ void MeshChecker::setGeometry(MimmoSharedPointer<MimmoObject> geo){
 void
 MeshChecker::setMinimumVolumeTolerance(double tol)
 {
+	setDirty();
 	m_minVolumeTol = tol;
 }
 
@@ -207,6 +210,7 @@ MeshChecker::setMinimumVolumeTolerance(double tol)
 void
 MeshChecker::setMaximumVolumeTolerance(double tol)
 {
+	setDirty();
 	m_maxVolumeTol = tol;
 }
 
@@ -216,6 +220,7 @@ MeshChecker::setMaximumVolumeTolerance(double tol)
 void
 MeshChecker::setMaximumSkewnessTolerance(double tol)
 {
+	setDirty();
 	m_maxSkewnessTol = tol / 180. * BITPIT_PI;
 }
 
@@ -225,6 +230,7 @@ MeshChecker::setMaximumSkewnessTolerance(double tol)
 void
 MeshChecker::setMaximumBoundarySkewnessTolerance(double tol)
 {
+	setDirty();
 	m_maxSkewnessBoundaryTol = tol / 180. * BITPIT_PI;
 }
 
@@ -234,6 +240,7 @@ MeshChecker::setMaximumBoundarySkewnessTolerance(double tol)
 void
 MeshChecker::setMinimumFaceValidityTolerance(double tol)
 {
+	setDirty();
 	m_minFaceValidityTol = tol;
 }
 
@@ -243,6 +250,7 @@ MeshChecker::setMinimumFaceValidityTolerance(double tol)
 void
 MeshChecker::setMinimumVolumeChangeTolerance(double tol)
 {
+	setDirty();
 	m_minVolumeChangeTol = tol;
 }
 
@@ -252,6 +260,7 @@ MeshChecker::setMinimumVolumeChangeTolerance(double tol)
 void
 MeshChecker::setPrintResumeFile(bool flag)
 {
+	setDirty();
 	m_printResumeFile = flag;
 }
 
@@ -197,6 +197,7 @@ OBBox::getOBBStrategy(){
  */
 void
 OBBox::setGeometries(std::vector<MimmoSharedPointer<MimmoObject> > listgeo){
+    setDirty();
     m_listgeo.clear();
     for( auto val : listgeo){
         setGeometry(val);
@@ -210,6 +211,7 @@ OBBox::setGeometries(std::vector<MimmoSharedPointer<MimmoObject> > listgeo){
  */
 void
 OBBox::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
 
     if (geo == nullptr)    {
         (*m_log)<<"warning: "<<m_name<<" not valid Geometry pointer. Doing nothing"<<std::endl;
@@ -230,6 +232,7 @@ OBBox::setGeometry(MimmoSharedPointer<MimmoObject> geo){
  */
 void
 OBBox::setForceAABB(bool flag){
+    setDirty();
     m_strategy = OBBStrategy::OBB;
     if (flag)   m_strategy = OBBStrategy::AABB;
 }
@@ -240,6 +243,7 @@ OBBox::setForceAABB(bool flag){
  */
 void
 OBBox::setOBBStrategy(OBBStrategy strategy){
+    setDirty();
     m_strategy = strategy;
 }
 
@@ -249,6 +253,7 @@ OBBox::setOBBStrategy(OBBStrategy strategy){
  */
 void
 OBBox::setOBBStrategyInt(int strategyflag){
+    setDirty();
     strategyflag = std::min(2, std::max(strategyflag, 0));
     m_strategy = static_cast<OBBStrategy>(strategyflag);
 }
@@ -260,6 +265,7 @@ OBBox::setOBBStrategyInt(int strategyflag){
  */
 void
 OBBox::setWriteInfo(bool flag){
+    setDirty();
     m_writeInfo = flag;
 }
 
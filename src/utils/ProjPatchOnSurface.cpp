@@ -120,6 +120,7 @@ ProjPatchOnSurface::clear(){
  */
 void
 ProjPatchOnSurface::setPatch(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
 
     if(geo == nullptr)    return;
     int type = geo->getType();
@@ -148,6 +149,7 @@ ProjPatchOnSurface::isWorkingOnTarget(){
 */
 void
 ProjPatchOnSurface::setWorkingOnTarget(bool flag){
+    setDirty();
     m_workingOnTarget = flag;
 }
 
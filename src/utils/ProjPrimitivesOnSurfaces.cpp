@@ -140,6 +140,7 @@ ProjPrimitivesOnSurfaces::getProjectedElement(){
  */
 void
 ProjPrimitivesOnSurfaces::setGeometry(MimmoSharedPointer<MimmoObject> geo){
+    setDirty();
     if(geo == nullptr) return;
     if(geo->getType() != 1)    return;
     m_geometry = geo;
@@ -152,6 +153,7 @@ ProjPrimitivesOnSurfaces::setGeometry(MimmoSharedPointer<MimmoObject> geo){
  */
 void
 ProjPrimitivesOnSurfaces::setBuildSkdTree(bool build){
+    setDirty();
     m_buildSkdTree = build;
 }
 
@@ -161,6 +163,7 @@ ProjPrimitivesOnSurfaces::setBuildSkdTree(bool build){
  */
 void
 ProjPrimitivesOnSurfaces::setBuildKdTree(bool build){
+    setDirty();
     m_buildKdTree = build;
 }
 
@@ -169,6 +172,7 @@ ProjPrimitivesOnSurfaces::setBuildKdTree(bool build){
  */
 void
 ProjPrimitivesOnSurfaces::setProjElementTargetNCells(int nC){
+    setDirty();
     m_nC = nC;
 }
 
@@ -121,6 +121,7 @@ ProjSegmentOnSurface::clear(){
  */
 void
 ProjSegmentOnSurface::setSegment(darray3E pointA, darray3E pointB){
+    setDirty();
 
     if(norm2(pointB - pointA) < 1.E-18)    return;
 
@@ -136,6 +137,7 @@ ProjSegmentOnSurface::setSegment(darray3E pointA, darray3E pointB){
  */
 void
 ProjSegmentOnSurface::setSegment(darray3E origin, darray3E dir, double length){
+    setDirty();
     setSegment(origin, origin+length*dir);
 }
 
@@ -140,6 +140,7 @@ RBFBox::getAABB(darray3E & bMin,darray3E & bMax ){
  * \param[in] cloud set of rbf nodes.
  */
 void RBFBox::setGeometry(MimmoSharedPointer<MimmoObject> cloud){
+    setDirty();
     if(cloud == nullptr)    return;
     if(cloud->getType() != 3)   return;
     BaseManipulation::setGeometry(cloud);
@@ -151,6 +152,7 @@ void RBFBox::setGeometry(MimmoSharedPointer<MimmoObject> cloud){
  */
 void
 RBFBox::setSupportRadius(double suppR_){
+    setDirty();
     m_suppR = std::fmax(0.0,suppR_);
 }
 
@@ -151,6 +151,7 @@ RotationAxes::buildPorts(){
  */
 void
 RotationAxes::setAxis(darray3E origin, darray3E direction){
+    setDirty();
     setOrigin(origin);
     setDirection(direction);
 }
@@ -160,6 +161,7 @@ RotationAxes::setAxis(darray3E origin, darray3E direction){
  */
 void
 RotationAxes::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
 }
 
@@ -168,6 +170,7 @@ RotationAxes::setOrigin(darray3E origin){
  */
 void
 RotationAxes::setDirection(darray3E direction){
+    setDirty();
     m_direction = direction;
     double norm = norm2(m_direction);
     if(norm > std::numeric_limits<double>::min()){
@@ -180,6 +183,7 @@ RotationAxes::setDirection(darray3E direction){
  */
 void
 RotationAxes::setRotation(double alpha){
+    setDirty();
     m_alpha = alpha;
 }
 
@@ -188,6 +192,7 @@ RotationAxes::setRotation(double alpha){
  */
 void
 RotationAxes::setAxes(dmatrix33E axes){
+    setDirty();
     m_axes = axes;
 }
 
@@ -196,6 +201,7 @@ RotationAxes::setAxes(dmatrix33E axes){
  */
 void
 RotationAxes::setAxesOrigin(darray3E axes_origin){
+    setDirty();
     m_axes_origin = axes_origin;
 }
 
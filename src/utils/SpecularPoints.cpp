@@ -248,6 +248,7 @@ SpecularPoints::isForced(){
  */
 void
 SpecularPoints::setPointCloud(MimmoSharedPointer<MimmoObject> targetpatch){
+    setDirty();
 
     if(targetpatch == nullptr) return;
     if(targetpatch->getType() !=3) return;
@@ -261,6 +262,7 @@ SpecularPoints::setPointCloud(MimmoSharedPointer<MimmoObject> targetpatch){
  */
 void
 SpecularPoints::setScalarData(dmpvector1D * scalardata){
+    setDirty();
     if(scalardata == nullptr) return;
     if(scalardata->getDataLocation() != MPVLocation::POINT)  return;
     m_scalar = scalardata;
@@ -272,6 +274,7 @@ SpecularPoints::setScalarData(dmpvector1D * scalardata){
  */
 void
 SpecularPoints::setVectorData(dmpvecarr3E * vectordata){
+    setDirty();
     if(vectordata == nullptr) return;
     if(vectordata->getDataLocation() != MPVLocation::POINT)  return;
     m_vector = vectordata;
@@ -283,6 +286,7 @@ SpecularPoints::setVectorData(dmpvecarr3E * vectordata){
  */
 void
 SpecularPoints::setPlane(darray4E plane){
+    setDirty();
     m_plane = plane;
     m_implicit = true;
 };
@@ -295,6 +299,7 @@ SpecularPoints::setPlane(darray4E plane){
  */
 void
 SpecularPoints::setPlane(darray3E origin, darray3E normal){
+    setDirty();
 
     double normx=norm2(normal);
     if(normx > std::numeric_limits<double>::min())  normal /= normx;
@@ -315,6 +320,7 @@ SpecularPoints::setPlane(darray3E origin, darray3E normal){
  */
 void
 SpecularPoints::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
 };
 
@@ -325,6 +331,7 @@ SpecularPoints::setOrigin(darray3E origin){
  */
 void
 SpecularPoints::setNormal(darray3E normal){
+    setDirty();
     m_normal = normal;
 };
 
@@ -334,6 +341,7 @@ SpecularPoints::setNormal(darray3E normal){
  */
 void
 SpecularPoints::setInsideOut(bool flag){
+    setDirty();
     m_insideout = flag;
 };
 
@@ -344,6 +352,7 @@ SpecularPoints::setInsideOut(bool flag){
  */
 void
 SpecularPoints::setForce(bool flag){
+    setDirty();
     m_force = flag;
 }
 
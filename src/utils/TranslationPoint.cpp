@@ -131,6 +131,7 @@ TranslationPoint::getTranslatedOrigin(){
  */
 void
 TranslationPoint::setDirection(darray3E direction){
+    setDirty();
     m_direction = direction;
     double norm = norm2(m_direction);
     if(norm < std::numeric_limits<double>::min()){
@@ -143,6 +144,7 @@ TranslationPoint::setDirection(darray3E direction){
  */
 void
 TranslationPoint::setTranslation(double alpha){
+    setDirty();
     m_alpha = alpha;
 }
 
@@ -151,6 +153,7 @@ TranslationPoint::setTranslation(double alpha){
  */
 void
 TranslationPoint::setOrigin(darray3E origin){
+    setDirty();
     m_origin = origin;
 }
 
@@ -0,0 +1,196 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+# ifndef __TESTMESHES_HPP__
+# define __TESTMESHES_HPP__
+
+# include "MimmoObject.hpp"
+
+/*
+ * Meshes shared by the tests.
+ */
+
+// =================================================================================== //
+/*!
+ * Create a triangulated unit sphere, with n parallels and 2n meridians.
+ */
+inline mimmo::MimmoSharedPointer<mimmo::MimmoObject> createSphere(int n){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> sphere(new mimmo::MimmoObject(1));
+    darray3E point;
+    for(int j=0; j<=n; ++j){
+        double theta = BITPIT_PI*double(j)/double(n);
+        for(int i=0; i<2*n; ++i){
+            double phi = BITPIT_PI*double(i)/double(n);
+            point = {{std::sin(theta)*std::cos(phi), std::sin(theta)*std::sin(phi), std::cos(theta)}};
+            sphere->addVertex(point, long(2*n*j + i));
+        }
+    }
+    std::vector<long> conn(3,0);
+    for(int j=0; j<n; ++j){
+        for(int i=0; i<2*n; ++i){
+            long v0 = 2*n*j + i, v1 = 2*n*j + (i+1)%(2*n);
+            long v2 = 2*n*(j+1) + (i+1)%(2*n), v3 = 2*n*(j+1) + i;
+            if(j > 0){
+                conn = {v0, v1, v2};
+                sphere->addConnectedCell(conn, bitpit::ElementType::TRIANGLE);
+            }
+            if(j < n-1){
+                conn = {v0, v2, v3};
+                sphere->addConnectedCell(conn, bitpit::ElementType::TRIANGLE);
+            }
+        }
+    }
+    sphere->update();
+    return sphere;
+}
+
+// =================================================================================== //
+/*!
+ * Create a unit cube hexa mesh of n^3 cells, with adjacencies built.
+ */
+inline mimmo::MimmoSharedPointer<mimmo::MimmoObject> createBoxMesh(int n){
+
+    double h = 1.0/double(n);
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(2));
+    mesh->getPatch()->reserveVertices((n+1)*(n+1)*(n+1));
+    darray3E point;
+    for(int k=0; k<=n; ++k){
+        for(int j=0; j<=n; ++j){
+            for(int i=0; i<=n; ++i){
+                point = {{h*i, h*j, h*k}};
+                mesh->addVertex(point, long((n+1)*(n+1)*k + (n+1)*j + i));
+            }
+        }
+    }
+
+    mesh->getPatch()->reserveCells(n*n*n);
+    std::vector<long> conn(8,0);
+    for(int k=0; k<n; ++k){
+        for(int j=0; j<n; ++j){
+            for(int i=0; i<n; ++i){
+                conn[0] = (n+1)*(n+1)*k + (n+1)*j + i;
+                conn[1] = (n+1)*(n+1)*k + (n+1)*j + i+1;
+                conn[2] = (n+1)*(n+1)*k + (n+1)*(j+1) + i+1;
+                conn[3] = (n+1)*(n+1)*k + (n+1)*(j+1) + i;
+                conn[4] = (n+1)*(n+1)*(k+1) + (n+1)*j + i;
+                conn[5] = (n+1)*(n+1)*(k+1) + (n+1)*j + i+1;
+                conn[6] = (n+1)*(n+1)*(k+1) + (n+1)*(j+1) + i+1;
+                conn[7] = (n+1)*(n+1)*(k+1) + (n+1)*(j+1) + i;
+                mesh->addConnectedCell(conn, bitpit::ElementType::HEXAHEDRON);
+            }
+        }
+    }
+    mesh->updateAdjacencies();
+    mesh->update();
+    return mesh;
+}
+
+// =================================================================================== //
+/*!
+ * Create a unit cube hexa mesh with nc[0] x nc[1] x nc[2] cells. In MPI runs the whole
+ * mesh is created on the master rank 0, the other ranks hold an empty patch until the
+ * mesh is partitioned.
+ */
+inline mimmo::MimmoSharedPointer<mimmo::MimmoObject> createTestVolumeMesh(const std::array<int,3> & nc){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(2));
+    if(mesh->getRank() == 0){
+
+        std::array<int,3> np = {{nc[0]+1, nc[1]+1, nc[2]+1}};
+        std::array<double,3> dx = {{1./double(nc[0]), 1./double(nc[1]), 1./double(nc[2])}};
+
+        mesh->getPatch()->reserveVertices(np[0]*np[1]*np[2]);
+        mesh->getPatch()->reserveCells(nc[0]*nc[1]*nc[2]);
+
+        //push vertices
+        for(int k=0; k<np[2]; ++k){
+            for(int j=0; j<np[1]; ++j){
+                for(int i=0; i<np[0]; ++i){
+                    long gentry = np[1]*np[0]*k + np[0]*j + i;
+                    mesh->addVertex({{i*dx[0], j*dx[1], k*dx[2]}}, gentry);
+                }
+            }
+        }
+
+        //push connectivity as HEXA element.
+        long PID(1);
+        long countC(0);
+        livector1D locConn(8);
+        for(int k=0; k<nc[2]; ++k){
+            for(int j=0; j<nc[1]; ++j){
+                for(int i=0; i<nc[0]; ++i){
+                    locConn[0] = np[1]*np[0]*k + np[0]*j + i;
+                    locConn[1] = np[1]*np[0]*k + np[0]*j + i+1;
+                    locConn[2] = np[1]*np[0]*k + np[0]*(j+1) + (i+1);
+                    locConn[3] = np[1]*np[0]*k + np[0]*(j+1) + i;
+                    locConn[4] = np[1]*np[0]*(k+1) + np[0]*j + i;
+                    locConn[5] = np[1]*np[0]*(k+1) + np[0]*j + i+1;
+                    locConn[6] = np[1]*np[0]*(k+1) + np[0]*(j+1) + (i+1);
+                    locConn[7] = np[1]*np[0]*(k+1) + np[0]*(j+1) + i;
+
+                    mesh->addConnectedCell(locConn, bitpit::ElementType::HEXAHEDRON, PID, countC, -1);
+                    ++countC;
+                }
+            }
+        }
+    }
+
+    mesh->update();
+    return mesh;
+}
+
+// =================================================================================== //
+/*!
+ * Create a quad surface mesh of the z=0 face of the unit cube, with m^2 cells and
+ * adjacencies built. In MPI runs the whole surface is created on the master rank 0.
+ */
+inline mimmo::MimmoSharedPointer<mimmo::MimmoObject> createBottomSurface(int m){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> surface(new mimmo::MimmoObject(1));
+    if(surface->getRank() == 0){
+        double h = 1.0/double(m);
+        for(int j=0; j<=m; ++j){
+            for(int i=0; i<=m; ++i){
+                surface->addVertex({{h*i, h*j, 0.0}}, long((m+1)*j + i));
+            }
+        }
+        livector1D conn(4);
+        long countC(0);
+        for(int j=0; j<m; ++j){
+            for(int i=0; i<m; ++i){
+                conn[0] = (m+1)*j + i;
+                conn[1] = (m+1)*j + i+1;
+                conn[2] = (m+1)*(j+1) + i+1;
+                conn[3] = (m+1)*(j+1) + i;
+                surface->addConnectedCell(conn, bitpit::ElementType::QUAD, 0, countC, -1);
+                ++countC;
+            }
+        }
+    }
+    surface->updateAdjacencies();
+    surface->update();
+    return surface;
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <chrono>
+#include <random>
+#if MIMMO_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+/*
+ * Benchmark 00001
+ * Thread scaling of the batched skdTreeUtils queries (distance,
+ * projection and location on patch) on a triangulated sphere. Results must not
+ * depend on the number of threads.
+ */
+
+// =================================================================================== //
+
+int benchmark1() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> sphere = createSphere(300);
+    sphere->buildSkdTree();
+    bitpit::PatchSkdTree * tree = sphere->getSkdTree();
+
+    int nP = 400000;
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> uniform(-1.2, 1.2);
+    dvecarr3E points(nP);
+    for(darray3E & point : points){
+        point = {{uniform(generator), uniform(generator), uniform(generator)}};
+    }
+
+    std::vector<int> nthreads(1, 1);
+#if MIMMO_ENABLE_OPENMP
+    int maxThreads = omp_get_max_threads();
+    while(2*nthreads.back() <= maxThreads) nthreads.push_back(2*nthreads.back());
+    if(nthreads.back() != maxThreads) nthreads.push_back(maxThreads);
+#endif
+
+    bool check = true;
+    livector1D refDistIds, refProjIds, refLocIds;
+    dvecarr3E refProjs;
+    std::cout<<"threads   distance [s]   projection [s]   location [s]"<<std::endl;
+    for(int nt : nthreads){
+#if MIMMO_ENABLE_OPENMP
+        omp_set_num_threads(nt);
+#endif
+        livector1D distIds(nP), projIds(nP), locIds(nP);
+        dvector1D distances(nP);
+        dvecarr3E projs(nP);
+
+        auto start = std::chrono::steady_clock::now();
+        mimmo::skdTreeUtils::distance(nP, points.data(), tree, distIds.data(), distances.data(), 0.5);
+        auto stop = std::chrono::steady_clock::now();
+        double elapsedDistance = std::chrono::duration<double>(stop - start).count();
+
+        start = std::chrono::steady_clock::now();
+        mimmo::skdTreeUtils::projectPoint(nP, points.data(), tree, projs.data(), projIds.data(), 0.05);
+        stop = std::chrono::steady_clock::now();
+        double elapsedProjection = std::chrono::duration<double>(stop - start).count();
+
+        start = std::chrono::steady_clock::now();
+        mimmo::skdTreeUtils::locatePointOnPatch(nP, projs.data(), tree, locIds.data());
+        stop = std::chrono::steady_clock::now();
+        double elapsedLocation = std::chrono::duration<double>(stop - start).count();
+
+        std::cout<<nt<<"         "<<elapsedDistance<<"       "<<elapsedProjection<<"         "<<elapsedLocation<<std::endl;
+
+        if(refDistIds.empty()){
+            refDistIds = distIds;
+            refProjIds = projIds;
+            refLocIds = locIds;
+            refProjs = projs;
+            //projected points lie on the sphere and (up to round-off on the cell borders) are located on it
+            int located = 0;
+            for(int i=0; i<nP; ++i){
+                check = check && (std::abs(norm2(projs[i]) - 1.0) < 1.0E-3);
+                located += int(locIds[i] != bitpit::Cell::NULL_ID);
+            }
+            check = check && (located >= 0.99*nP);
+        }else{
+            check = check && (distIds == refDistIds) && (projIds == refProjIds) && (locIds == refLocIds);
+            for(int i=0; i<nP; ++i){
+                check = check && (norm2(projs[i] - refProjs[i]) < 1.0E-12);
+            }
+        }
+    }
+
+    std::cout<<"benchmark passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = benchmark1() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"benchmark_core_00001 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -79,6 +79,36 @@ public:
 
 };
 
+class ManipValue: public mimmo::BaseManipulation{
+public:
+	double m_add;
+	double m_out;
+	int m_nexec;
+	dvector1D m_in;
+	dvector1D m_received;
+
+	ManipValue(double add = 0.0){m_add = add; m_out = 0.0; m_nexec = 0;};
+	virtual ~ManipValue(){};
+	double getValue(){ return m_out;};
+	void addValue(double value){ m_in.push_back(value);};
+	void buildPorts(){
+
+        //Register ports
+		mimmo::PortManager::instance().addPort(M_VALUED, MC_SCALAR, MD_FLOAT,"test_core_00001.cpp");
+		bool built = true;
+		built = built && createPortIn<double, ManipValue>(this, &ManipValue::addValue, M_VALUED);
+		built = built && createPortOut<double, ManipValue>(this, &ManipValue::getValue, M_VALUED);
+		m_arePortsBuilt = built;
+	};
+	void execute(){
+		m_out = m_add;
+		for (double val : m_in) m_out += val;
+		m_received = m_in;
+		m_in.clear();
+		m_nexec++;
+	};
+};
+
 // =================================================================================== //
 
 int test1() {
@@ -156,6 +186,195 @@ int test1() {
 
 // =================================================================================== //
 
+/*
+ * Execution of a diamond chain A -> (B, C) -> D in serial and task graph mode,
+ * and incremental execution of the same chain.
+ */
+int test2() {
+
+	ManipValue * objA = new ManipValue(1.0);
+	ManipValue * objB = new ManipValue(10.0);
+	ManipValue * objC = new ManipValue(100.0);
+	ManipValue * objD = new ManipValue(1000.0);
+
+	bool check = true;
+	check = check && mimmo::pin::addPin(objA, objB, M_VALUED, M_VALUED);
+	check = check && mimmo::pin::addPin(objA, objC, M_VALUED, M_VALUED);
+	check = check && mimmo::pin::addPin(objB, objD, M_VALUED, M_VALUED);
+	check = check && mimmo::pin::addPin(objC, objD, M_VALUED, M_VALUED);
+
+	mimmo::Chain c0;
+	c0.addObject(objD);
+	c0.addObject(objC);
+	c0.addObject(objB);
+	c0.addObject(objA);
+
+	std::vector<mimmo::ChainExecMode> modes = {mimmo::ChainExecMode::SERIAL, mimmo::ChainExecMode::TASKGRAPH};
+	std::vector<dvector1D> received;
+	for (mimmo::ChainExecMode mode : modes){
+		c0.setExecMode(mode);
+		c0.exec(false);
+		check = check && (objD->m_out == 1000.0 + 11.0 + 101.0);
+		received.push_back(objD->m_received);
+	}
+	check = check && (received[0] == received[1]);
+
+	//incremental execution: nothing changed, nothing executed.
+	c0.setIncremental(true);
+	c0.exec(false);
+	check = check && (objA->m_nexec == 2) && (objB->m_nexec == 2) && (objC->m_nexec == 2) && (objD->m_nexec == 2);
+
+	//incremental execution: B changed, only B and D executed.
+	objB->m_add = 20.0;
+	objB->setDirty();
+	for (mimmo::ChainExecMode mode : modes){
+		c0.setExecMode(mode);
+		c0.exec(false);
+		objB->setDirty();
+	}
+	check = check && (objA->m_nexec == 2) && (objC->m_nexec == 2);
+	check = check && (objB->m_nexec == 4) && (objD->m_nexec == 4);
+	check = check && (objD->m_out == 1000.0 + 21.0 + 101.0);
+
+	if(!check){
+		std::cout<<"Failed serial/task graph/incremental execution of chain"<<std::endl;
+	}else{
+		std::cout<<"Successfull serial/task graph/incremental execution of chain"<<std::endl;
+	}
+
+	delete objA;
+	delete objB;
+	delete objC;
+	delete objD;
+
+	return !check;
+}
+
+// =================================================================================== //
+
+/*
+ * Execution in task graph mode of a fan-out chain A -> (B1..B8), where the children
+ * share the same geometry: children receive the data of A and are executed one at a time.
+ */
+class ManipShared: public ManipValue{
+public:
+	static int s_running;
+	static int s_maxRunning;
+
+	ManipShared(double add = 0.0):ManipValue(add){};
+	void execute(){
+		int running;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif
+		running = ++s_running;
+#if MIMMO_ENABLE_OPENMP
+#pragma omp critical (test_core_00001_max)
+#endif
+		s_maxRunning = std::max(s_maxRunning, running);
+		ManipValue::execute();
+#if MIMMO_ENABLE_OPENMP
+#pragma omp atomic
+#endif
+		--s_running;
+	};
+};
+int ManipShared::s_running = 0;
+int ManipShared::s_maxRunning = 0;
+
+int test3() {
+
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> geometry(new mimmo::MimmoObject(1));
+	ManipValue * objA = new ManipValue(1.0);
+	std::vector<ManipShared *> children;
+	mimmo::Chain c0;
+	c0.addObject(objA);
+	bool check = true;
+	for (int i=0; i<8; i++){
+		children.push_back(new ManipShared(double(i)));
+		children.back()->setGeometry(geometry);
+		check = check && mimmo::pin::addPin(objA, children.back(), M_VALUED, M_VALUED);
+		c0.addObject(children.back());
+	}
+
+	c0.setExecMode(mimmo::ChainExecMode::TASKGRAPH);
+	c0.exec(false);
+	for (int i=0; i<8; i++){
+		check = check && (children[i]->m_out == 1.0 + double(i));
+	}
+	check = check && (ManipShared::s_maxRunning == 1);
+
+	if(!check){
+		std::cout<<"Failed task graph execution of objects sharing a geometry"<<std::endl;
+	}else{
+		std::cout<<"Successfull task graph execution of objects sharing a geometry"<<std::endl;
+	}
+
+	delete objA;
+	for (ManipShared * child : children) delete child;
+
+	return !check;
+}
+
+// =================================================================================== //
+
+/*
+ * Incremental execution of a chain A -> B -> M, Q, where M modifies in place its geometry:
+ * when M is executed all its ancestors are executed, while Q is skipped.
+ */
+class ManipModifier: public ManipValue{
+public:
+	ManipModifier(double add = 0.0):ManipValue(add){};
+	bool isModifyingGeometry(){ return true;};
+};
+
+int test4() {
+
+	ManipValue * objA = new ManipValue(1.0);
+	ManipValue * objB = new ManipValue(10.0);
+	ManipModifier * objM = new ManipModifier(100.0);
+	ManipValue * objQ = new ManipValue(1000.0);
+
+	bool check = true;
+	check = check && mimmo::pin::addPin(objA, objB, M_VALUED, M_VALUED);
+	check = check && mimmo::pin::addPin(objB, objM, M_VALUED, M_VALUED);
+
+	mimmo::Chain c0;
+	c0.addObject(objA);
+	c0.addObject(objB);
+	c0.addObject(objM);
+	c0.addObject(objQ);
+	c0.setIncremental(true);
+	c0.exec(false);
+	check = check && (objA->m_nexec == 1) && (objB->m_nexec == 1) && (objM->m_nexec == 1) && (objQ->m_nexec == 1);
+
+	//nothing changed, nothing executed.
+	c0.exec(false);
+	check = check && (objA->m_nexec == 1) && (objB->m_nexec == 1) && (objM->m_nexec == 1) && (objQ->m_nexec == 1);
+
+	//M changed: its ancestors are executed again, Q is skipped.
+	objM->m_add = 200.0;
+	objM->setDirty();
+	c0.exec(false);
+	check = check && (objA->m_nexec == 2) && (objB->m_nexec == 2) && (objM->m_nexec == 2) && (objQ->m_nexec == 1);
+	check = check && (objM->m_out == 200.0 + 11.0);
+
+	if(!check){
+		std::cout<<"Failed incremental execution of chain with geometry modifiers"<<std::endl;
+	}else{
+		std::cout<<"Successfull incremental execution of chain with geometry modifiers"<<std::endl;
+	}
+
+	delete objA;
+	delete objB;
+	delete objM;
+	delete objQ;
+
+	return !check;
+}
+
+// =================================================================================== //
+
 int main( int argc, char *argv[] ) {
 
 	BITPIT_UNUSED(argc);
@@ -169,6 +388,9 @@ int main( int argc, char *argv[] ) {
 	/**<Calling mimmo Test routines*/
     try{
         val = test1() ;
+        val = std::max(val, test2());
+        val = std::max(val, test3());
+        val = std::max(val, test4());
     }
     catch(std::exception & e){
         std::cout<<"test_core_00001 exited with an error of type : "<<e.what()<<std::endl;
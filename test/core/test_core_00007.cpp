@@ -0,0 +1,163 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include <chrono>
+
+/*
+ * Test 00007
+ * Testing direct transfer of data between ports of the same type vs buffer stream transfer,
+ * and timing of the port execution on a large vector field.
+ */
+
+class ManipSender: public mimmo::BaseManipulation{
+public:
+    dvecarr3E m_field;
+
+    ManipSender(){};
+    virtual ~ManipSender(){};
+    dvecarr3E getField(){ return m_field;};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort(M_DISPLS, MC_VECARR3, MD_FLOAT,"test_core_00007.cpp");
+        bool built = true;
+        built = built && createPortOut<dvecarr3E, ManipSender>(this, &ManipSender::getField, M_DISPLS);
+        m_arePortsBuilt = built;
+    };
+    void execute(){};
+};
+
+class ManipReceiver: public mimmo::BaseManipulation{
+public:
+    dvecarr3E m_field;
+
+    ManipReceiver(){};
+    virtual ~ManipReceiver(){};
+    void setField(dvecarr3E field){ m_field = std::move(field);};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort(M_DISPLS, MC_VECARR3, MD_FLOAT,"test_core_00007.cpp");
+        bool built = true;
+        built = built && createPortIn<dvecarr3E, ManipReceiver>(this, &ManipReceiver::setField, M_DISPLS);
+        m_arePortsBuilt = built;
+    };
+    void execute(){};
+};
+
+// =================================================================================== //
+
+/*
+ * Execute nrun times the sender and return the mean time per run in seconds.
+ */
+double timeExec(ManipSender * sender, int nrun){
+    auto start = std::chrono::steady_clock::now();
+    for (int i=0; i<nrun; i++){
+        sender->exec();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count() / double(nrun);
+}
+
+int test7() {
+
+    long nfield = 2000000;
+    int nrun = 5;
+
+    ManipSender * objA = new ManipSender();
+    ManipReceiver * objB = new ManipReceiver();
+    ManipReceiver * objC = new ManipReceiver();
+
+    objA->m_field.resize(nfield);
+    for (long i=0; i<nfield; i++){
+        objA->m_field[i] = {{double(i), -1.0*double(i), 0.5}};
+    }
+
+    bool check = true;
+    check = check && mimmo::pin::addPin(objA, objB, M_DISPLS, M_DISPLS);
+    check = check && mimmo::pin::addPin(objA, objC, M_DISPLS, M_DISPLS);
+    if(!check){
+        std::cout<<"Failed getting connections"<<std::endl;
+        delete objA;
+        delete objB;
+        delete objC;
+        return 1;
+    }
+
+    mimmo::PortOut * port = objA->getPortsOut()[M_DISPLS];
+
+    //buffer stream transfer
+    port->setDirectTransfer(false);
+    double tstream = timeExec(objA, nrun);
+    check = check && (objB->m_field == objA->m_field) && (objC->m_field == objA->m_field);
+
+    objB->m_field.clear();
+    objC->m_field.clear();
+
+    //direct transfer
+    port->setDirectTransfer(true);
+    double tdirect = timeExec(objA, nrun);
+    check = check && (objB->m_field == objA->m_field) && (objC->m_field == objA->m_field);
+
+    std::cout<<"Port execution on "<<nfield<<" vector field, 2 pins"<<std::endl;
+    std::cout<<"    buffer stream transfer : "<<tstream<<" s per run"<<std::endl;
+    std::cout<<"    direct transfer        : "<<tdirect<<" s per run"<<std::endl;
+
+    if(!check){
+        std::cout<<"Failed port data transfer"<<std::endl;
+    }else{
+        std::cout<<"Successfull port data transfer"<<std::endl;
+    }
+
+    delete objA;
+    delete objB;
+    delete objC;
+
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test7() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00007 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
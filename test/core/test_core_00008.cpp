@@ -0,0 +1,111 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <chrono>
+
+/*
+ * Test 00008
+ * Testing the fast marching distance field of a surface on the points and on the cells
+ * of a volume mesh (distanceFieldUtils), against the exact distance from a plane.
+ */
+
+// =================================================================================== //
+
+int test8() {
+
+    int n = 30;
+    double maxdist = 0.35;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createBoxMesh(n);
+    // surface not conformal to the mesh, to test the transport of closest cells
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> surface = createBottomSurface(7);
+
+    auto start = std::chrono::steady_clock::now();
+    bitpit::PiercedVector<double> pdist = mimmo::distanceFieldUtils::pointsDistance(*mesh, *surface, maxdist);
+    bitpit::PiercedVector<double> cdist = mimmo::distanceFieldUtils::cellsDistance(*mesh, *surface, maxdist);
+    auto stop = std::chrono::steady_clock::now();
+
+    //exact distance from the bottom face is the z coordinate.
+    bool check = true;
+    double maxerr = 0.0;
+    for(const bitpit::Vertex & vertex : mesh->getVertices()){
+        double exact = vertex.getCoords()[2];
+        if(exact < maxdist - 1.0E-12){
+            check = check && pdist.exists(vertex.getId());
+            if(pdist.exists(vertex.getId()))  maxerr = std::max(maxerr, std::abs(pdist[vertex.getId()] - exact));
+        }else if(exact > maxdist + 1.0E-12){
+            check = check && !pdist.exists(vertex.getId());
+        }
+    }
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        double exact = mesh->evalCellCentroid(cell.getId())[2];
+        if(exact < maxdist - 1.0E-12){
+            check = check && cdist.exists(cell.getId());
+            if(cdist.exists(cell.getId()))  maxerr = std::max(maxerr, std::abs(cdist[cell.getId()] - exact));
+        }else if(exact > maxdist + 1.0E-12){
+            check = check && !cdist.exists(cell.getId());
+        }
+    }
+    check = check && (maxerr < 1.0E-10);
+
+    //the member functions of MimmoObject share the same engine.
+    bitpit::PiercedVector<double> pdist2 = mesh->getVerticesNarrowBandToExtSurfaceWDist(*surface, maxdist);
+    check = check && (pdist2.size() == pdist.size());
+
+    std::cout<<"points in narrow band : "<<pdist.size()<<", cells in narrow band : "<<cdist.size()<<std::endl;
+    std::cout<<"max error             : "<<maxerr<<std::endl;
+    std::cout<<"elapsed time          : "<<std::chrono::duration<double>(stop - start).count()<<" s"<<std::endl;
+    std::cout<<"test passed           : "<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test8() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00008 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -0,0 +1,126 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <chrono>
+#include <random>
+
+/*
+ * Test 00009
+ * Testing the batched distance queries of skdTreeUtils against the single point ones,
+ * on a triangulated sphere, and timing of both.
+ */
+
+// =================================================================================== //
+
+int test9() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> sphere = createSphere(200);
+    sphere->buildSkdTree();
+    bitpit::PatchSkdTree * tree = sphere->getSkdTree();
+
+    int nP = 100000;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> uniform(-1.5, 1.5);
+    dvecarr3E points(nP);
+    for(darray3E & point : points){
+        point = {{uniform(generator), uniform(generator), uniform(generator)}};
+    }
+    double radius = 0.3;
+
+    //single point queries
+    livector1D ids(nP);
+    dvector1D distances(nP);
+    auto start = std::chrono::steady_clock::now();
+    for(int i=0; i<nP; ++i){
+        distances[i] = mimmo::skdTreeUtils::distance(&points[i], tree, ids[i], radius);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double elapsedSingle = std::chrono::duration<double>(stop - start).count();
+
+    //batched queries
+    livector1D bids(nP);
+    dvector1D bdistances(nP);
+    start = std::chrono::steady_clock::now();
+    mimmo::skdTreeUtils::distance(nP, points.data(), tree, bids.data(), bdistances.data(), radius);
+    stop = std::chrono::steady_clock::now();
+    double elapsedBatch = std::chrono::duration<double>(stop - start).count();
+
+    bool check = true;
+    double maxdiff = 0.0;
+    for(int i=0; i<nP; ++i){
+        bool found = (ids[i] != bitpit::Cell::NULL_ID);
+        check = check && (found == (bids[i] != bitpit::Cell::NULL_ID));
+        if(found){
+            maxdiff = std::max(maxdiff, std::abs(distances[i] - bdistances[i]));
+        }
+    }
+
+    //signed distances: absolute values must approximate the distance from the exact sphere.
+    dvecarr3E normals(nP);
+    mimmo::skdTreeUtils::signedDistance(nP, points.data(), tree, bids.data(), bdistances.data(), normals.data(), radius);
+    for(int i=0; i<nP; ++i){
+        if(bids[i] != bitpit::Cell::NULL_ID){
+            double exact = norm2(points[i]) - 1.0;
+            check = check && (std::abs(bdistances[i]) <= radius) && (std::abs(std::abs(bdistances[i]) - std::abs(exact)) <= 1.0E-3);
+        }
+    }
+    check = check && (maxdiff <= 1.0E-12);
+
+    std::cout<<"single point queries : "<<elapsedSingle<<" s"<<std::endl;
+    std::cout<<"batched queries      : "<<elapsedBatch<<" s"<<std::endl;
+    std::cout<<"max difference       : "<<maxdiff<<std::endl;
+    std::cout<<"test passed          : "<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test9() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00009 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
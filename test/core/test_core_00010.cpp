@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <random>
+#if MIMMO_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+/*
+ * Test 00010
+ * Testing the batched skdTreeUtils queries (distance, projection and location on patch)
+ * on a triangulated sphere: results must not depend on the number of threads.
+ * Timings on large sizes are measured by benchmark_core_00001 (BUILD_BENCHMARKS).
+ */
+
+// =================================================================================== //
+
+int test10() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> sphere = createSphere(100);
+    sphere->buildSkdTree();
+    bitpit::PatchSkdTree * tree = sphere->getSkdTree();
+
+    int nP = 20000;
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> uniform(-1.2, 1.2);
+    dvecarr3E points(nP);
+    for(darray3E & point : points){
+        point = {{uniform(generator), uniform(generator), uniform(generator)}};
+    }
+
+    std::vector<int> nthreads(1, 1);
+#if MIMMO_ENABLE_OPENMP
+    int maxThreads = omp_get_max_threads();
+    while(2*nthreads.back() <= maxThreads) nthreads.push_back(2*nthreads.back());
+    if(nthreads.back() != maxThreads) nthreads.push_back(maxThreads);
+#endif
+
+    bool check = true;
+    livector1D refDistIds, refProjIds, refLocIds;
+    dvecarr3E refProjs;
+    for(int nt : nthreads){
+#if MIMMO_ENABLE_OPENMP
+        omp_set_num_threads(nt);
+#endif
+        livector1D distIds(nP), projIds(nP), locIds(nP);
+        dvector1D distances(nP);
+        dvecarr3E projs(nP);
+
+        mimmo::skdTreeUtils::distance(nP, points.data(), tree, distIds.data(), distances.data(), 0.5);
+        mimmo::skdTreeUtils::projectPoint(nP, points.data(), tree, projs.data(), projIds.data(), 0.05);
+        mimmo::skdTreeUtils::locatePointOnPatch(nP, projs.data(), tree, locIds.data());
+
+        if(refDistIds.empty()){
+            refDistIds = distIds;
+            refProjIds = projIds;
+            refLocIds = locIds;
+            refProjs = projs;
+            //projected points lie on the sphere and (up to round-off on the cell borders) are located on it
+            int located = 0;
+            for(int i=0; i<nP; ++i){
+                check = check && (std::abs(norm2(projs[i]) - 1.0) < 1.0E-3);
+                located += int(locIds[i] != bitpit::Cell::NULL_ID);
+            }
+            check = check && (located >= 0.99*nP);
+        }else{
+            check = check && (distIds == refDistIds) && (projIds == refProjIds) && (locIds == refLocIds);
+            for(int i=0; i<nP; ++i){
+                check = check && (norm2(projs[i] - refProjs[i]) < 1.0E-12);
+            }
+        }
+    }
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test10() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00010 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
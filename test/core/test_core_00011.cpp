@@ -0,0 +1,157 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <sstream>
+
+/*
+ * Test 00011
+ * Testing dump and restore of a MimmoObject together with its search trees: the restored
+ * KdTree has to be synchronized and equal to the dumped one, the SkdTree is not persisted,
+ * and trees are refused if the geometry does not match the dumped one.
+ * Dumps in the layout preceding the trees support have to be still readable.
+ */
+
+// =================================================================================== //
+/*!
+ * Write a MimmoObject in the dump layout used before the search trees support,
+ * i.e. without format marker and trees section.
+ */
+void writeLegacyDump(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geometry, std::ostream & stream){
+
+    std::vector<long> pid;
+    std::vector<std::string> sspid;
+    for(const auto & touple : geometry->getPIDTypeListWNames()){
+        pid.push_back(touple.first);
+        sspid.push_back(touple.second);
+    }
+    bitpit::utils::binary::write(stream, geometry->getType());
+#if MIMMO_ENABLE_MPI
+    bitpit::utils::binary::write(stream, geometry->getProcessorCount());
+#endif
+    bitpit::utils::binary::write(stream, pid);
+    bitpit::utils::binary::write(stream, sspid);
+    bitpit::utils::binary::write(stream, geometry->getAdjacenciesSyncStatus());
+    bitpit::utils::binary::write(stream, geometry->getInterfacesSyncStatus());
+    bitpit::utils::binary::write(stream, geometry->getPointConnectivitySyncStatus());
+    geometry->getPatch()->dump(stream);
+}
+
+// =================================================================================== //
+
+int test11() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> sphere = createSphere(50);
+    sphere->buildSkdTree();
+    sphere->buildKdTree();
+
+    std::stringstream stream;
+    sphere->dump(stream, true);
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> restored(new mimmo::MimmoObject(1));
+    restored->restore(stream);
+
+    //the KdTree is restored as it is, the SkdTree is not persisted
+    bool check = (restored->getKdTreeSyncStatus() == mimmo::SyncStatus::SYNC);
+    check = check && (restored->getSkdTreeSyncStatus() == mimmo::SyncStatus::NONE);
+
+    bitpit::KdTree<3, bitpit::Vertex, long> * kdOriginal = sphere->getKdTree();
+    bitpit::KdTree<3, bitpit::Vertex, long> * kdRestored = restored->getKdTree();
+    check = check && (kdOriginal->n_nodes == kdRestored->n_nodes);
+    for(int i=0; check && i<kdOriginal->n_nodes; ++i){
+        check = (kdOriginal->nodes[i].label == kdRestored->nodes[i].label)
+             && (kdOriginal->nodes[i].lchild_ == kdRestored->nodes[i].lchild_)
+             && (kdOriginal->nodes[i].rchild_ == kdRestored->nodes[i].rchild_)
+             && (kdRestored->nodes[i].object_->getId() == kdRestored->nodes[i].label);
+    }
+    std::cout<<"restored trees equal to dumped ones : "<<check<<std::endl;
+
+    //dump without trees
+    std::stringstream plain;
+    sphere->dump(plain);
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> plainRestored(new mimmo::MimmoObject(1));
+    plainRestored->restore(plain);
+    check = check && (plainRestored->getNCells() == sphere->getNCells());
+    check = check && (plainRestored->getKdTreeSyncStatus() == mimmo::SyncStatus::NONE);
+
+    //old dump format (no format marker, starting with the type of geometry) still readable
+    std::stringstream legacy;
+    writeLegacyDump(sphere, legacy);
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> legacyRestored(new mimmo::MimmoObject(1));
+    legacyRestored->restore(legacy);
+    bool legacyRead = (legacyRestored->getType() == sphere->getType())
+                   && (legacyRestored->getNVertices() == sphere->getNVertices())
+                   && (legacyRestored->getNCells() == sphere->getNCells())
+                   && (legacyRestored->getPIDTypeListWNames() == sphere->getPIDTypeListWNames())
+                   && (legacyRestored->getKdTreeSyncStatus() == mimmo::SyncStatus::NONE)
+                   && (legacyRestored->getSkdTreeSyncStatus() == mimmo::SyncStatus::NONE);
+    for(const bitpit::Vertex & vertex : sphere->getVertices()){
+        if(!legacyRead) break;
+        long id = vertex.getId();
+        legacyRead = norm2(legacyRestored->getVertexCoords(id) - vertex.getCoords()) < 1.0E-14;
+    }
+    std::cout<<"old dump format restored : "<<legacyRead<<std::endl;
+    check = check && legacyRead;
+
+    //trees dumped in a separate stream are refused by a modified geometry
+    std::stringstream treeStream;
+    sphere->dumpTrees(treeStream);
+    darray3E coords = restored->getVertexCoords(0);
+    coords[2] += 0.01;
+    restored->modifyVertex(coords, 0);
+    bool refused = !restored->restoreTrees(treeStream);
+    std::cout<<"trees refused on modified geometry : "<<refused<<std::endl;
+    check = check && refused;
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		int val = 1;
+        try{
+            /**<Calling mimmo Test routines*/
+            val = test11() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_core_00011 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,140 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <algorithm>
+#include <random>
+
+/*
+ * Test 00012
+ * Testing the search trees of MimmoObject after a non affine deformation of the
+ * vertices: update rebuilds both trees, and their searches give the same results
+ * of brute force ones on the deformed geometry.
+ */
+
+// =================================================================================== //
+
+/*!
+ * Brute force search of the vertices of geo within distance h from point.
+ */
+std::vector<long> bruteNeighbors(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo, const darray3E & point, double h){
+    std::vector<long> ids;
+    for(const bitpit::Vertex & vertex : geo->getVertices()){
+        if(norm2(vertex.getCoords() - point) <= h)  ids.push_back(vertex.getId());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+/*!
+ * Brute force distance of point from the cells of the surface geo.
+ */
+double bruteDistance(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo, const darray3E & point){
+    double dist = std::numeric_limits<double>::max();
+    darray3E foot;
+    for(const bitpit::Cell & cell : geo->getCells()){
+        dist = std::min(dist, mimmo::skdTreeUtils::distanceFromSurfaceCell(point, *(geo->getPatch()), cell.getId(), foot));
+    }
+    return dist;
+}
+
+// =================================================================================== //
+
+int test12() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> sphere = createSphere(30);
+    sphere->buildSkdTree();
+    sphere->buildKdTree();
+
+    //non affine deformation: a gaussian bump along the normal, plus a twist around z.
+    for(const bitpit::Vertex & vertex : sphere->getVertices()){
+        darray3E coords = vertex.getCoords();
+        double bump = 1.0 + 0.3*std::exp(-8.0*(std::pow(coords[0]-0.6, 2) + coords[1]*coords[1]));
+        double angle = 0.5*coords[2];
+        darray3E moved = {{bump*(std::cos(angle)*coords[0] - std::sin(angle)*coords[1]),
+                           bump*(std::sin(angle)*coords[0] + std::cos(angle)*coords[1]),
+                           bump*coords[2]}};
+        sphere->modifyVertex(moved, vertex.getId());
+    }
+    bool check = (sphere->getKdTreeSyncStatus() == mimmo::SyncStatus::UNSYNC);
+    check = check && (sphere->getSkdTreeSyncStatus() == mimmo::SyncStatus::UNSYNC);
+    sphere->update();
+    check = check && (sphere->getKdTreeSyncStatus() == mimmo::SyncStatus::SYNC);
+    check = check && (sphere->getSkdTreeSyncStatus() == mimmo::SyncStatus::SYNC);
+    std::cout<<"trees rebuilt by update : "<<check<<std::endl;
+
+    double h = 0.15;
+    for(const bitpit::Vertex & vertex : sphere->getVertices()){
+        if(!check) break;
+        std::vector<long> ids;
+        darray3E point = vertex.getCoords() + darray3E({{0.01, -0.02, 0.03}});
+        bitpit::Vertex probe(bitpit::Vertex::NULL_ID, point);
+        sphere->getKdTree()->hNeighbors(&probe, h, &ids, nullptr);
+        std::sort(ids.begin(), ids.end());
+        check = (ids == bruteNeighbors(sphere, point, h));
+    }
+    std::cout<<"KdTree neighbours equal to brute force ones : "<<check<<std::endl;
+
+    std::mt19937 generator(12);
+    std::uniform_real_distribution<double> uniform(-1.5, 1.5);
+    double maxdiff = 0.0;
+    for(int i=0; i<200; ++i){
+        darray3E point = {{uniform(generator), uniform(generator), uniform(generator)}};
+        long id;
+        double dist = mimmo::skdTreeUtils::distance(&point, sphere->getSkdTree(), id, 5.0);
+        maxdiff = std::max(maxdiff, std::abs(dist - bruteDistance(sphere, point)));
+    }
+    std::cout<<"SkdTree distance vs brute force max difference : "<<maxdiff<<std::endl;
+    check = check && (maxdiff < 1.0E-12);
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		int val = 1;
+        try{
+            /**<Calling mimmo Test routines*/
+            val = test12() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_core_00012 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,111 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <algorithm>
+#include <set>
+
+/*
+ * Test 00013
+ * Testing the compressed point connectivity of MimmoObject: the 1-Ring of each vertex
+ * of a surface and of a volume mesh is compared with the one collected from the cell
+ * edges, accessing rows both by vertex id and by raw index.
+ */
+
+// =================================================================================== //
+/*!
+ * Check the point connectivity of geo against the one collected from the cell edges.
+ */
+bool checkConnectivity(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo){
+
+    std::unordered_map<long, std::set<long>> expected;
+    for(const bitpit::Cell & cell : geo->getCells()){
+        int ne = (geo->getType() == 1) ? cell.getFaceCount() : cell.getEdgeCount();
+        for(int i=0; i<ne; ++i){
+            bitpit::ConstProxyVector<long> ids = (geo->getType() == 1) ? cell.getFaceVertexIds(i) : cell.getEdgeVertexIds(i);
+            expected[ids[0]].insert(ids[1]);
+            expected[ids[1]].insert(ids[0]);
+        }
+    }
+
+    geo->buildPointConnectivity();
+    bool check = (geo->getPointConnectivitySyncStatus() == mimmo::SyncStatus::SYNC);
+    for(auto it = geo->getVertices().cbegin(); it != geo->getVertices().cend(); ++it){
+        bitpit::ConstProxyVector<long> ring = geo->getPointConnectivity(it.getId());
+        bitpit::ConstProxyVector<long> ringRaw = geo->getPointConnectivityRaw(it.getRawIndex());
+        std::vector<long> list(ring.begin(), ring.end());
+        std::vector<long> listRaw(ringRaw.begin(), ringRaw.end());
+        const std::set<long> & ref = expected[it.getId()];
+        check = check && (list == std::vector<long>(ref.begin(), ref.end())) && (listRaw == list);
+    }
+    return check;
+}
+
+// =================================================================================== //
+
+int test13() {
+
+    bool check = checkConnectivity(createSphere(20));
+    std::cout<<"surface point connectivity : "<<check<<std::endl;
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> box = createBoxMesh(6);
+    check = check && checkConnectivity(box);
+    //interior vertex of the box has 6 neighbours, corner vertex 3
+    check = check && (box->getPointConnectivity(7*7*3 + 7*3 + 3).size() == 6);
+    check = check && (box->getPointConnectivity(0).size() == 3);
+    std::cout<<"volume point connectivity : "<<check<<std::endl;
+
+    box->cleanPointConnectivity();
+    check = check && (box->getPointConnectivitySyncStatus() == mimmo::SyncStatus::UNSYNC);
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		int val = 1;
+        try{
+            /**<Calling mimmo Test routines*/
+            val = test13() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_core_00013 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
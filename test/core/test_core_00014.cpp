@@ -0,0 +1,117 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+#include "../TestMeshes.hpp"
+#include <algorithm>
+
+/*
+ * Test 00014
+ * Testing MimmoObject::update: search trees rebuilt concurrently after a deformation,
+ * KdTree balanced on a lexicographically numbered mesh and timing of each structure.
+ */
+
+// =================================================================================== //
+
+int test14() {
+
+    int n = 24;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> box = createBoxMesh(n);
+    box->buildSkdTree();
+    box->buildKdTree();
+
+    //shear deformation, trees rebuilt by update
+    for(const bitpit::Vertex & vertex : box->getVertices()){
+        darray3E coords = vertex.getCoords();
+        coords[0] += 0.3*coords[2];
+        box->modifyVertex(coords, vertex.getId());
+    }
+    box->update();
+
+    const std::map<std::string, double> & times = box->getUpdateTimes();
+    for(const auto & entry : times){
+        std::cout<<"update "<<entry.first<<" : "<<entry.second<<" s"<<std::endl;
+    }
+    bool check = (times.count("kdtree") > 0) && (times.count("skdtree") > 0);
+    check = check && (box->getKdTreeSyncStatus() == mimmo::SyncStatus::SYNC);
+    check = check && (box->getSkdTreeSyncStatus() == mimmo::SyncStatus::SYNC);
+    std::cout<<"trees rebuilt by update : "<<check<<std::endl;
+
+    //depth of the KdTree, balanced whatever the vertex numbering
+    bitpit::KdTree<3, bitpit::Vertex, long> * tree = box->getKdTree();
+    std::vector<int> level(tree->n_nodes, 0);
+    int depth = 0;
+    for(int i=0; i<tree->n_nodes; ++i){
+        if(tree->nodes[i].lchild_ >= 0)  level[tree->nodes[i].lchild_] = level[i] + 1;
+        if(tree->nodes[i].rchild_ >= 0)  level[tree->nodes[i].rchild_] = level[i] + 1;
+        depth = std::max(depth, level[i]);
+    }
+    check = check && (tree->n_nodes == (n+1)*(n+1)*(n+1)) && (depth <= 2*int(std::log2(double(tree->n_nodes))) + 1);
+    std::cout<<"KdTree depth "<<depth<<" on "<<tree->n_nodes<<" vertices : "<<check<<std::endl;
+
+    //tree queries against brute force search
+    double h = 0.1;
+    for(long id : {0L, 100L, 5000L, 10000L}){
+        darray3E point = box->getVertexCoords(id) + darray3E({{0.01, 0.02, -0.01}});
+        bitpit::Vertex probe(bitpit::Vertex::NULL_ID, point);
+        std::vector<long> ids, brute;
+        tree->hNeighbors(&probe, h, &ids, nullptr);
+        for(const bitpit::Vertex & vertex : box->getVertices()){
+            if(norm2(vertex.getCoords() - point) <= h)  brute.push_back(vertex.getId());
+        }
+        std::sort(ids.begin(), ids.end());
+        std::sort(brute.begin(), brute.end());
+        check = check && (ids == brute);
+    }
+    std::cout<<"KdTree neighbours equal to brute force ones : "<<check<<std::endl;
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		int val = 1;
+        try{
+            /**<Calling mimmo Test routines*/
+            val = test14() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_core_00014 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,120 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00015
+ * Testing the contiguous coordinates view of MimmoObject: consistency with the vertices,
+ * revision tracking of the cache and bulk write back of the coordinates.
+ */
+
+// =================================================================================== //
+/*!
+ * Check that the coordinates view matches the vertices of the geometry.
+ */
+bool checkView(mimmo::MimmoObject & cloud){
+
+    const mimmo::VertexCoordsSoA & coords = cloud.getVerticesCoordsSoA();
+    bool check = (long(coords.size()) == cloud.getNVertices());
+    for(std::size_t i=0; i<coords.size(); ++i){
+        const darray3E & point = cloud.getVertexCoords(coords.ids[i]);
+        check = check && (coords.indices.at(coords.ids[i]) == i);
+        check = check && (point[0] == coords.x[i]) && (point[1] == coords.y[i]) && (point[2] == coords.z[i]);
+    }
+    return check;
+}
+
+// =================================================================================== //
+
+int test15() {
+
+    mimmo::MimmoObject cloud(3);
+    for(int i=0; i<1000; ++i){
+        cloud.addVertex(darray3E({{0.001*i, std::sin(0.01*i), std::cos(0.01*i)}}), long(2*i));
+    }
+
+    bool check = checkView(cloud);
+    std::size_t revision = cloud.getVerticesRevision();
+    const mimmo::VertexCoordsSoA & coords = cloud.getVerticesCoordsSoA();
+    check = check && (cloud.getVerticesRevision() == revision);
+    std::cout<<"view built on vertices : "<<check<<std::endl;
+
+    //bulk write back of displaced coordinates
+    dvector1D x(coords.x), y(coords.y), z(coords.z);
+    for(std::size_t i=0; i<coords.size(); ++i){
+        x[i] += 1.0;
+        z[i] *= 2.0;
+    }
+    cloud.modifyVerticesCoords(x, y, z);
+    check = check && (cloud.getVerticesRevision() > revision) && checkView(cloud);
+    check = check && (std::abs(cloud.getVertexCoords(10)[0] - 1.005) < 1.0E-12) && (cloud.getKdTreeSyncStatus() != mimmo::SyncStatus::SYNC);
+    std::cout<<"coordinates written back : "<<check<<std::endl;
+
+    //single vertex modification and insertion invalidate the view
+    revision = cloud.getVerticesRevision();
+    cloud.modifyVertex(darray3E({{-1.0, -1.0, -1.0}}), 20);
+    cloud.addVertex(darray3E({{5.0, 5.0, 5.0}}), 1);
+    check = check && (cloud.getVerticesRevision() > revision) && checkView(cloud);
+    check = check && (cloud.getVerticesCoordsSoA().x[cloud.getVerticesCoordsSoA().indices.at(20)] == -1.0);
+    std::cout<<"view rebuilt after modifications : "<<check<<std::endl;
+
+    //wrong sizes are rejected
+    bool thrown = false;
+    try{
+        cloud.modifyVerticesCoords(x, y, z);
+    }catch(std::runtime_error &){
+        thrown = true;
+    }
+    check = check && thrown;
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		int val = 1;
+        try{
+            /**<Calling mimmo Test routines*/
+            val = test15() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_core_00015 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,152 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iogeneric.hpp"
+#include <fstream>
+
+/*
+ * Test 00005
+ * Testing the multithreaded STL and NAS readers of MimmoGeometry: multi-solid ascii STL,
+ * binary STL and NAS files of a tessellated cube, with coincident vertices merged while
+ * reading.
+ */
+
+// =================================================================================== //
+/*!
+ * Write an ascii STL of the unit cube, each face split in 2*n*n triangles. Facets
+ * have their own vertices. Bottom and top faces are in the solid "caps", the side
+ * faces in the solid "sides".
+ */
+void writeCubeSTL(const std::string & filename, int n){
+
+    std::ofstream out(filename);
+    out.precision(17);
+    double h = 1.0/double(n);
+    for(int solid=0; solid<2; ++solid){
+        out<<"solid "<<(solid == 0 ? "caps" : "sides")<<std::endl;
+        for(int face=0; face<6; ++face){
+            int axis = face/2;
+            if((axis == 2) != (solid == 0))   continue;
+            for(int i=0; i<n; ++i){
+                for(int j=0; j<n; ++j){
+                    std::array<darray3E,4> quad;
+                    for(int v=0; v<4; ++v){
+                        double u = h*(i + (v == 1 || v == 2));
+                        double w = h*(j + (v >= 2));
+                        quad[v][axis] = double(face%2);
+                        quad[v][(axis+1)%3] = u;
+                        quad[v][(axis+2)%3] = w;
+                    }
+                    for(const std::array<int,3> & tri : {std::array<int,3>({{0,1,2}}), std::array<int,3>({{0,2,3}})}){
+                        out<<"  facet normal 0 0 0"<<std::endl<<"    outer loop"<<std::endl;
+                        for(int v : tri){
+                            out<<"      vertex "<<quad[v][0]<<" "<<quad[v][1]<<" "<<quad[v][2]<<std::endl;
+                        }
+                        out<<"    endloop"<<std::endl<<"  endfacet"<<std::endl;
+                    }
+                }
+            }
+        }
+        out<<"endsolid "<<(solid == 0 ? "caps" : "sides")<<std::endl;
+    }
+}
+
+// =================================================================================== //
+
+int test5() {
+
+    int n = 40;
+    long nvertices = 6*n*n + 2;
+    long ncells = 12*n*n;
+    writeCubeSTL("cube_ascii.stl", n);
+
+    //multi-solid ascii STL
+    mimmo::MimmoGeometry * reader = new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::READ);
+    reader->setReadDir(".");
+    reader->setReadFilename("cube_ascii");
+    reader->setReadFileType(FileType::STL);
+    reader->exec();
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cube = reader->getGeometry();
+
+    bool check = (cube->getNVertices() == nvertices) && (cube->getNCells() == ncells);
+    check = check && (cube->getPIDTypeList().size() == 2) && (cube->getPIDTypeListWNames().at(1) == "sides");
+    check = check && cube->isClosedLoop();
+    std::cout<<"ascii multi-solid STL read : "<<check<<std::endl;
+
+    //binary STL and NAS written by MimmoGeometry and read back
+    mimmo::MimmoGeometry * writer = new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::WRITE);
+    writer->setWriteDir(".");
+    writer->setWriteFilename("cube_binary");
+    writer->setWriteFileType(FileType::STL);
+    writer->setCodex(true);
+    writer->setGeometry(cube);
+    writer->exec();
+    writer->setWriteFilename("cube_nas");
+    writer->setWriteFileType(FileType::NAS);
+    writer->exec();
+
+    for(bool nas : {false, true}){
+        mimmo::MimmoGeometry * rereader = new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::READ);
+        rereader->setReadDir(".");
+        rereader->setReadFilename(nas ? "cube_nas" : "cube_binary");
+        rereader->setReadFileType(nas ? FileType::NAS : FileType::STL);
+        rereader->exec();
+        mimmo::MimmoSharedPointer<mimmo::MimmoObject> copy = rereader->getGeometry();
+        check = check && (copy->getNVertices() == nvertices) && (copy->getNCells() == ncells);
+        std::cout<<(nas ? "NAS" : "binary STL")<<" read back : "<<check<<std::endl;
+        delete rereader;
+    }
+
+    std::cout<<"test passed :"<<check<<std::endl;
+
+    delete reader;
+    delete writer;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		/**<Calling mimmo Test routines*/
+        int val = 1;
+        try{
+            val = test5() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_iogeneric_00005 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
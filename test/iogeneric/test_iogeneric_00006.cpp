@@ -0,0 +1,185 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iogeneric.hpp"
+#include <fstream>
+
+/*
+ * Test 00006
+ * Testing the chunked reader and writer of IOWavefrontOBJ: a plate with textures, normals,
+ * materials, cell groups and smoothing groups, split in two objects, is read, written
+ * and read back. The file is small: it is read also forcing its split in several chunks,
+ * whose boundaries fall inside the objects and the vertex lists.
+ */
+
+// =================================================================================== //
+/*!
+ * Write an obj of the unit square plate tessellated by a n x n grid. The left half
+ * of the grid is the object "left", made by quads; the right half is the object
+ * "right", made by triangles referring to the vertices with relative indices.
+ */
+void writePlateOBJ(const std::string & filename, int n){
+
+    std::ofstream out(filename);
+    double h = 1.0/double(n);
+    out<<"# plate"<<std::endl<<"mtllib plate.mtl"<<std::endl;
+    out<<"o left"<<std::endl;
+    for(int j=0; j<=n; ++j){
+        for(int i=0; i<=n; ++i){
+            out<<"v "<<h*i<<" "<<h*j<<" 0.0"<<std::endl;
+            out<<"vt "<<h*i<<" "<<h*j<<std::endl;
+            out<<"vn 0.0 0.0 1.0"<<std::endl;
+        }
+    }
+    out<<"usemtl red"<<std::endl<<"g panel"<<std::endl<<"s 1"<<std::endl;
+    long nv = (n+1)*(n+1);
+    for(int j=0; j<n; ++j){
+        for(int i=0; i<n/2; ++i){
+            long v0 = j*(n+1) + i + 1;
+            std::array<long,4> quad({{v0, v0+1, v0+n+2, v0+n+1}});
+            out<<"f";
+            for(long v : quad)  out<<" "<<v<<"/"<<v<<"/"<<v;
+            out<<std::endl;
+        }
+    }
+    out<<"o right"<<std::endl<<"usemtl blue"<<std::endl<<"s off"<<std::endl;
+    for(int j=0; j<n; ++j){
+        for(int i=n/2; i<n; ++i){
+            long v0 = j*(n+1) + i + 1 - nv - 1;
+            for(const std::array<long,3> & tri : {std::array<long,3>({{v0, v0+1, v0+n+2}}), std::array<long,3>({{v0, v0+n+2, v0+n+1}})}){
+                out<<"f";
+                for(long v : tri)   out<<" "<<v<<"/"<<v<<"/"<<v;
+                out<<std::endl;
+            }
+        }
+    }
+}
+
+// =================================================================================== //
+/*!
+ * Check the plate read from file. Return true if correct.
+ */
+bool checkPlate(mimmo::IOWavefrontOBJ * reader, int n){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> plate = reader->getGeometry();
+    mimmo::WavefrontOBJData * data = reader->getData();
+    long ncells = n*n/2 + n*n;
+
+    bool check = (plate->getNVertices() == (n+1)*(n+1)) && (plate->getNCells() == ncells);
+    check = check && (plate->getPIDTypeListWNames().at(0) == "left") && (plate->getPIDTypeListWNames().at(1) == "right");
+    check = check && (data->materialfile == "plate.mtl");
+    check = check && data->normals && (data->normals->getNCells() == ncells);
+    check = check && data->textures && (data->textures->getNCells() == ncells);
+    if(!check)  return false;
+
+    for(bitpit::Cell & cell : plate->getCells()){
+        long id = cell.getId();
+        bool left = (cell.getPID() == 0);
+        check = check && (cell.getType() == (left ? bitpit::ElementType::QUAD : bitpit::ElementType::TRIANGLE));
+        check = check && (data->materials[id] == (left ? "red" : "blue"));
+        check = check && (data->cellgroups[id] == (left ? "panel" : ""));
+        check = check && (data->smoothids[id] == (left ? 1 : 0));
+    }
+    return check;
+}
+
+// =================================================================================== //
+
+int test6() {
+
+    int n = 40;
+    writePlateOBJ("plate.obj", n);
+
+    mimmo::IOWavefrontOBJ * reader = new mimmo::IOWavefrontOBJ(mimmo::IOWavefrontOBJ::IOMode::READ);
+    reader->setDir(".");
+    reader->setFilename("plate");
+    reader->printResumeFile(false);
+    reader->exec();
+
+    bool check = checkPlate(reader, n);
+    std::cout<<"obj read : "<<check<<std::endl;
+
+    for(int nchunks : {2, 7, 64}){
+        mimmo::IOWavefrontOBJ * chunkReader = new mimmo::IOWavefrontOBJ(mimmo::IOWavefrontOBJ::IOMode::READ);
+        chunkReader->setDir(".");
+        chunkReader->setFilename("plate");
+        chunkReader->printResumeFile(false);
+        chunkReader->setReadChunkCount(nchunks);
+        chunkReader->exec();
+        check = check && checkPlate(chunkReader, n);
+        std::cout<<"obj read in "<<nchunks<<" chunks : "<<check<<std::endl;
+        delete chunkReader;
+    }
+
+    mimmo::IOWavefrontOBJ * writer = new mimmo::IOWavefrontOBJ(mimmo::IOWavefrontOBJ::IOMode::WRITE);
+    writer->setDir(".");
+    writer->setFilename("plate_copy");
+    writer->printResumeFile(false);
+    writer->setGeometry(reader->getGeometry());
+    writer->setData(reader->getData());
+    writer->exec();
+
+    mimmo::IOWavefrontOBJ * rereader = new mimmo::IOWavefrontOBJ(mimmo::IOWavefrontOBJ::IOMode::READ);
+    rereader->setDir(".");
+    rereader->setFilename("plate_copy");
+    rereader->printResumeFile(false);
+    rereader->setReadChunkCount(5);
+    rereader->exec();
+
+    check = check && checkPlate(rereader, n);
+    std::cout<<"obj read back : "<<check<<std::endl;
+
+    std::cout<<"test passed :"<<check<<std::endl;
+
+    delete reader;
+    delete writer;
+    delete rereader;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		/**<Calling mimmo Test routines*/
+        int val = 1;
+        try{
+            val = test6() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_iogeneric_00006 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,108 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iogeneric.hpp"
+#include <exception>
+
+// =================================================================================== //
+/*!
+ * Read a serial vtu file with master rank and distributed over the processes.
+ * \return true if the global number of cells and vertices of the two reads match.
+ */
+bool compareReads(const std::string & filename, FileType type, bitpit::Logger & log) {
+
+    mimmo::MimmoGeometry * reader = new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::READ);
+    reader->setReadDir("geodata");
+    reader->setReadFilename(filename);
+    reader->setReadFileType(type);
+    reader->exec();
+
+    mimmo::MimmoGeometry * distReader = new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::READ);
+    distReader->setReadDir("geodata");
+    distReader->setReadFilename(filename);
+    distReader->setReadFileType(type);
+    distReader->setDistributedRead(true);
+    distReader->exec();
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> serial = reader->getGeometry();
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> distributed = distReader->getGeometry();
+
+    log<<filename<<" master rank read : "<<serial->getNGlobalCells()<<" cells, "<<serial->getNGlobalVertices()<<" vertices"<<std::endl;
+    log<<filename<<" distributed read : "<<distributed->getNGlobalCells()<<" cells, "<<distributed->getNGlobalVertices()<<" vertices"<<std::endl;
+
+    bool check = (distributed->getNGlobalCells() == serial->getNGlobalCells());
+    check = check && (distributed->getNGlobalVertices() == serial->getNGlobalVertices());
+    if (distributed->getProcessorCount() > 1){
+        check = check && distributed->isDistributed() && (distributed->getNInternals() > 0);
+    }
+
+    delete reader;
+    delete distReader;
+    return check;
+}
+
+// =================================================================================== //
+/*!
+ * //testing parallel :
+   - distributed reading of serial vtu curve (ascii) and surface (appended binary)
+ */
+int test1() {
+
+    bitpit::Logger & log = bitpit::log::cout("mimmo");
+    log.setPriority(bitpit::log::Priority::NORMAL);
+
+    bool check = compareReads("curve", FileType::CURVEVTU, log);
+    check = check && compareReads("mixedP2D", FileType::SURFVTU, log);
+
+    MPI_Allreduce(MPI_IN_PLACE, &check, 1, MPI_C_BOOL, MPI_LAND, MPI_COMM_WORLD);
+    log<<"test passed : "<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+    int val = 1;
+    try{
+        /**<Calling mimmo Test routines*/
+        val = test1() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_iogeneric_parallel_00002 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
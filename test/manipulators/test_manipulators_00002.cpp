@@ -83,6 +83,179 @@ int test2() {
     return int(!check);
 }
 
+// =================================================================================== //
+/*!
+ * Testing compact support RBF evaluation: results obtained visiting only the nodes
+ * whose support contains each vertex must be equal to the ones obtained evaluating all the nodes.
+ */
+int test3() {
+
+    //create a point cloud on a regular 21x21x21 lattice in the unit cube.
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud(new mimmo::MimmoObject(3));
+    long counter = 0;
+    darray3E point;
+    for(int i=0; i<21; ++i){
+        for(int j=0; j<21; ++j){
+            for(int k=0; k<21; ++k){
+                point = {{0.05*i, 0.05*j, 0.05*k}};
+                cloud->addVertex(point, counter);
+                ++counter;
+            }
+        }
+    }
+
+    //RBF nodes on a coarser lattice with small support radius
+    dvecarr3E rbfpoints, rbfdispls;
+    for(int i=0; i<10; ++i){
+        for(int j=0; j<10; ++j){
+            for(int k=0; k<10; ++k){
+                rbfpoints.push_back({{0.1*i+0.02, 0.1*j+0.03, 0.1*k+0.01}});
+                rbfdispls.push_back({{0.01*i, -0.02*j, 0.005*(i+k)}});
+            }
+        }
+    }
+
+    mimmo::MRBF * compact = new mimmo::MRBF();
+    compact->setGeometry(cloud);
+    compact->setNode(rbfpoints);
+    compact->setDisplacements(rbfdispls);
+    compact->setFunction(bitpit::RBFBasisFunction::WENDLANDC2, true);
+    compact->setSupportRadiusReal(0.12);
+    compact->exec();
+
+    mimmo::MRBF * full = new mimmo::MRBF();
+    full->setGeometry(cloud);
+    full->setNode(rbfpoints);
+    full->setDisplacements(rbfdispls);
+    full->setFunction(bitpit::RBFBasisFunction::WENDLANDC2, false);
+    full->setSupportRadiusReal(0.12);
+    full->exec();
+
+    mimmo::dmpvecarr3E * d1 = compact->getDisplacements();
+    mimmo::dmpvecarr3E * d2 = full->getDisplacements();
+    bool check = (d1->size() == d2->size()) && (d1->size() == std::size_t(counter));
+    double maxdiff = 0.0, maxval = 0.0;
+    if(check){
+        for(auto it=d2->begin(); it!=d2->end(); ++it){
+            maxdiff = std::max(maxdiff, norm2(d1->at(it.getId()) - *it));
+            maxval = std::max(maxval, norm2(*it));
+        }
+        check = (maxdiff <= 1.0E-12) && (maxval > 0.0);
+    }
+    std::cout<<"compact vs full evaluation max difference: "<<maxdiff<<std::endl;
+
+    delete compact;
+    delete full;
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+/*!
+ * Testing interpolation of RBF weights with compact support (sparse solver):
+ * the deformation evaluated on the RBF nodes must reproduce the imposed displacements.
+ */
+int test4() {
+
+    //RBF nodes on a 8x8x8 lattice; the point cloud contains the nodes themselves.
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud(new mimmo::MimmoObject(3));
+    dvecarr3E rbfpoints, rbfdispls;
+    darray3E point;
+    long counter = 0;
+    for(int i=0; i<8; ++i){
+        for(int j=0; j<8; ++j){
+            for(int k=0; k<8; ++k){
+                point = {{0.1*i, 0.1*j, 0.1*k}};
+                rbfpoints.push_back(point);
+                rbfdispls.push_back({{0.01*std::sin(double(i+j)), 0.02*j, -0.01*k}});
+                cloud->addVertex(point, counter);
+                ++counter;
+            }
+        }
+    }
+
+    mimmo::MRBF * mrbf = new mimmo::MRBF(mimmo::MRBFSol::WHOLE);
+    mrbf->setGeometry(cloud);
+    mrbf->setNode(rbfpoints);
+    mrbf->setDisplacements(rbfdispls);
+    mrbf->setFunction(bitpit::RBFBasisFunction::WENDLANDC2, true);
+    mrbf->setSupportRadiusReal(0.25);
+    mrbf->exec();
+
+    mimmo::dmpvecarr3E * displ = mrbf->getDisplacements();
+    double maxdiff = 0.0;
+    for(long id=0; id<counter; ++id){
+        maxdiff = std::max(maxdiff, norm2(displ->at(id) - rbfdispls[id]));
+    }
+    bool check = (maxdiff <= 1.0E-08);
+    std::cout<<"compact interpolation max error on nodes: "<<maxdiff<<std::endl;
+
+    delete mrbf;
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+/*!
+ * Interpolation with compact support and variable support radii is available to classes
+ * switching MRBF to MRBFSol::WHOLE mode after the radii are set.
+ */
+class MRBFVariableRadii: public mimmo::MRBF{
+public:
+    MRBFVariableRadii(dvector1D radii):mimmo::MRBF(mimmo::MRBFSol::NONE){
+        setVariableSupportRadii(radii);
+        setMode(mimmo::MRBFSol::WHOLE);
+    };
+};
+
+/*!
+ * Testing interpolation of RBF weights with compact support and variable support radii
+ * (non-symmetric sparse matrix): the deformation evaluated on the RBF nodes must reproduce
+ * the imposed displacements.
+ */
+int test5() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud(new mimmo::MimmoObject(3));
+    dvecarr3E rbfpoints, rbfdispls;
+    dvector1D radii;
+    darray3E point;
+    long counter = 0;
+    for(int i=0; i<8; ++i){
+        for(int j=0; j<8; ++j){
+            for(int k=0; k<8; ++k){
+                point = {{0.1*i, 0.1*j, 0.1*k}};
+                rbfpoints.push_back(point);
+                rbfdispls.push_back({{0.01*std::sin(double(i+j)), 0.02*j, -0.01*k}});
+                radii.push_back(0.2 + 0.01*double((i+2*j+3*k)%11));
+                cloud->addVertex(point, counter);
+                ++counter;
+            }
+        }
+    }
+
+    MRBFVariableRadii * mrbf = new MRBFVariableRadii(radii);
+    mrbf->setGeometry(cloud);
+    mrbf->setNode(rbfpoints);
+    mrbf->setDisplacements(rbfdispls);
+    mrbf->setFunction(bitpit::RBFBasisFunction::WENDLANDC2, true);
+    mrbf->exec();
+
+    mimmo::dmpvecarr3E * displ = mrbf->getDisplacements();
+    double maxdiff = 0.0;
+    for(long id=0; id<counter; ++id){
+        maxdiff = std::max(maxdiff, norm2(displ->at(id) - rbfdispls[id]));
+    }
+    bool check = (maxdiff <= 1.0E-08);
+    std::cout<<"compact interpolation with variable radii max error on nodes: "<<maxdiff<<std::endl;
+
+    delete mrbf;
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
 // =================================================================================== //
 
 int main( int argc, char *argv[] ) {
@@ -97,6 +270,9 @@ int main( int argc, char *argv[] ) {
         try{
             /**<Calling mimmo Test routines*/
             val = test2() ;
+            val = std::max(val, test3());
+            val = std::max(val, test4());
+            val = std::max(val, test5());
         }
         catch(std::exception & e){
             std::cout<<"test_manipulators_00002 exited with an error of type : "<<e.what()<<std::endl;
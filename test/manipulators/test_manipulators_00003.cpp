@@ -100,6 +100,189 @@ int test3() {
     return int(!check);
 }
 
+// =================================================================================== //
+/*!
+ * Testing Lattice manipulator basis cache: deformations computed with the cache enabled
+ * must match the direct evaluation, also after changing the displacements of the control
+ * nodes and after modifying the geometry.
+ */
+
+int test4() {
+
+    //point cloud on a regular lattice in the unit cube.
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud(new mimmo::MimmoObject(3));
+    long counter = 0;
+    darray3E point;
+    for(int i=0; i<11; ++i){
+        for(int j=0; j<11; ++j){
+            for(int k=0; k<11; ++k){
+                point = {{0.1*i, 0.1*j, 0.1*k}};
+                cloud->addVertex(point, counter);
+                ++counter;
+            }
+        }
+    }
+
+    darray3E origin = {{0.5,0.5,0.5}};
+    darray3E span = {{1.2,1.2,1.2}};
+    iarray3E dimension = {{5,5,5}};
+    iarray3E degrees = {{2,2,2}};
+
+    std::vector<mimmo::FFDLattice*> latt(2);
+    for(int i=0; i<2; ++i){
+        latt[i] = new mimmo::FFDLattice();
+        latt[i]->setGeometry(cloud);
+        latt[i]->setShape(mimmo::ShapeType::CUBE);
+        latt[i]->setOrigin(origin);
+        latt[i]->setSpan(span);
+        latt[i]->setDimension(dimension);
+        latt[i]->setDegrees(degrees);
+    }
+    latt[1]->setBasisCache(true);
+
+    bool check = true;
+    for(int run=0; run<3; ++run){
+
+        //modify the geometry before the last run: cache must be invalidated.
+        if(run == 2){
+            for(long id=0; id<counter; id+=7){
+                point = cloud->getVertexCoords(id);
+                point[0] += 0.013;
+                cloud->modifyVertex(point, id);
+            }
+        }
+
+        dvecarr3E displ(125);
+        for(int n=0; n<125; ++n){
+            displ[n] = {{0.01*std::sin(double(n+run)), 0.02*std::cos(double(n*run)), 0.005*(n%7)}};
+        }
+
+        for(int i=0; i<2; ++i){
+            latt[i]->setDisplacements(displ);
+            latt[i]->exec();
+        }
+
+        mimmo::dmpvecarr3E * d0 = latt[0]->getDeformation();
+        mimmo::dmpvecarr3E * d1 = latt[1]->getDeformation();
+        double maxdiff = 0.0;
+        for(auto it=d0->begin(); it!=d0->end(); ++it){
+            maxdiff = std::max(maxdiff, norm2(d1->at(it.getId()) - *it));
+        }
+        std::cout<<"run "<<run<<" cached vs direct max difference: "<<maxdiff<<std::endl;
+        check = check && (d0->size() == d1->size()) && (maxdiff <= 1.0E-12);
+    }
+
+    delete latt[0];
+    delete latt[1];
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+/*!
+ * Testing Lattice manipulator basis cache in a FFD -> Apply -> FFD sequence: the geometry
+ * deformed in place by Apply must invalidate the cache, even if its search trees have been
+ * rebuilt in the meanwhile by another object. The public apply and a new geometry of the
+ * same size must not reuse the cache either.
+ */
+
+int test5() {
+
+    //point cloud on a regular lattice in the unit cube.
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud(new mimmo::MimmoObject(3));
+    long counter = 0;
+    darray3E point;
+    for(int i=0; i<11; ++i){
+        for(int j=0; j<11; ++j){
+            for(int k=0; k<11; ++k){
+                point = {{0.1*i, 0.1*j, 0.1*k}};
+                cloud->addVertex(point, counter);
+                ++counter;
+            }
+        }
+    }
+
+    dvecarr3E displ(125);
+    for(int n=0; n<125; ++n){
+        displ[n] = {{0.01*std::sin(double(n)), 0.02*std::cos(double(n)), 0.005*(n%7)}};
+    }
+
+    darray3E origin = {{0.5,0.5,0.5}};
+    darray3E span = {{1.2,1.2,1.2}};
+    iarray3E dimension = {{5,5,5}};
+    iarray3E degrees = {{2,2,2}};
+
+    std::vector<mimmo::FFDLattice*> latt(2);
+    for(int i=0; i<2; ++i){
+        latt[i] = new mimmo::FFDLattice();
+        latt[i]->setGeometry(cloud);
+        latt[i]->setShape(mimmo::ShapeType::CUBE);
+        latt[i]->setOrigin(origin);
+        latt[i]->setSpan(span);
+        latt[i]->setDimension(dimension);
+        latt[i]->setDegrees(degrees);
+        latt[i]->setDisplacements(displ);
+    }
+    latt[1]->setBasisCache(true);
+
+    //FFD with cache, then Apply of its deformation.
+    latt[1]->exec();
+    mimmo::Apply * applier = new mimmo::Apply();
+    applier->setGeometry(cloud);
+    applier->setInput(latt[1]->getDeformation());
+    applier->exec();
+
+    //FFD without cache rebuilds the trees of the deformed geometry, then FFD with cache.
+    latt[0]->exec();
+    latt[1]->exec();
+
+    mimmo::dmpvecarr3E * d0 = latt[0]->getDeformation();
+    mimmo::dmpvecarr3E * d1 = latt[1]->getDeformation();
+    double maxdiff = 0.0;
+    for(auto it=d0->begin(); it!=d0->end(); ++it){
+        maxdiff = std::max(maxdiff, norm2(d1->at(it.getId()) - *it));
+    }
+    std::cout<<"FFD -> Apply -> FFD cached vs direct max difference: "<<maxdiff<<std::endl;
+    bool check = (d0->size() == d1->size()) && (maxdiff <= 1.0E-12);
+
+    //public apply after a further deformation of the geometry, then on a new geometry
+    //of the same size: the cached basis must not be reused.
+    mimmo::Apply * applier2 = new mimmo::Apply();
+    applier2->setGeometry(cloud);
+    applier2->setInput(latt[0]->getDeformation());
+    applier2->exec();
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> shifted(new mimmo::MimmoObject(3));
+    for(const bitpit::Vertex & vertex : cloud->getVertices()){
+        shifted->addVertex(vertex.getCoords() + darray3E({{0.03, 0.0, 0.0}}), vertex.getId());
+    }
+
+    for(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo : {cloud, shifted}){
+        geo->buildKdTree();
+        livector1D list0, list1;
+        latt[0]->setGeometry(geo);
+        latt[1]->setGeometry(geo);
+        dvecarr3E def0 = latt[0]->apply(list0);
+        dvecarr3E def1 = latt[1]->apply(list1);
+        check = check && (list0 == list1);
+        maxdiff = 0.0;
+        for(std::size_t i=0; check && i<def0.size(); ++i){
+            maxdiff = std::max(maxdiff, norm2(def1[i] - def0[i]));
+        }
+        std::cout<<"public apply cached vs direct max difference: "<<maxdiff<<std::endl;
+        check = check && (maxdiff <= 1.0E-12);
+    }
+
+    delete applier2;
+    delete applier;
+    delete latt[0];
+    delete latt[1];
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
 // =================================================================================== //
 
 int main( int argc, char *argv[] ) {
@@ -114,6 +297,8 @@ int main( int argc, char *argv[] ) {
         int val =1;
         try{
             val = test3() ;
+            val = std::max(val, test4());
+            val = std::max(val, test5());
         }
 
         catch(std::exception & e){
@@ -0,0 +1,186 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_manipulators.hpp"
+#include <chrono>
+
+/*
+ * Test 00004
+ * Benchmark of the hierarchical evaluation of global support RBF against the exact one:
+ * error and timing of the parameterization (MRBFSol::NONE) on a point cloud, and
+ * interpolation error of the matrix-free weights solver (MRBFSol::WHOLE).
+ */
+
+// =================================================================================== //
+/*!
+ * Create a point cloud on a regular lattice of n^3 points in the unit cube.
+ */
+mimmo::MimmoSharedPointer<mimmo::MimmoObject> createCloud(int n){
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud(new mimmo::MimmoObject(3));
+    long counter = 0;
+    darray3E point;
+    double h = 1.0/double(n-1);
+    for(int i=0; i<n; ++i){
+        for(int j=0; j<n; ++j){
+            for(int k=0; k<n; ++k){
+                point = {{h*i, h*j, h*k}};
+                cloud->addVertex(point, counter);
+                ++counter;
+            }
+        }
+    }
+    return cloud;
+}
+
+// =================================================================================== //
+/*!
+ * Parameterization: hierarchical vs exact evaluation.
+ */
+int test1() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud = createCloud(40);
+
+    //RBF nodes scattered in the cube
+    dvecarr3E rbfpoints, rbfdispls;
+    int nnodes = 4000;
+    for(int i=0; i<nnodes; ++i){
+        double t = double(i)/double(nnodes);
+        rbfpoints.push_back({{std::fmod(7.31*t, 1.0), std::fmod(13.17*t, 1.0), std::fmod(3.73*t, 1.0)}});
+        rbfdispls.push_back({{0.01*std::sin(10.0*t), 0.01*std::cos(7.0*t), 0.005}});
+    }
+    double sumWeights = 0.0;
+    for(auto & val : rbfdispls)    sumWeights += norm2(val);
+
+    double tol = 1.0E-05;
+    std::vector<mimmo::MRBF*> mrbf(2);
+    std::vector<double> elapsed(2);
+    for(int i=0; i<2; ++i){
+        mrbf[i] = new mimmo::MRBF();
+        mrbf[i]->setGeometry(cloud);
+        mrbf[i]->setNode(rbfpoints);
+        mrbf[i]->setDisplacements(rbfdispls);
+        mrbf[i]->setFunction(mimmo::MRBFBasisFunction::DSIGMOID);
+        mrbf[i]->setSupportRadiusReal(0.05);
+        if(i == 1)    mrbf[i]->setHierarchicalTolerance(tol);
+
+        auto start = std::chrono::steady_clock::now();
+        mrbf[i]->exec();
+        auto stop = std::chrono::steady_clock::now();
+        elapsed[i] = std::chrono::duration<double>(stop - start).count();
+    }
+
+    mimmo::dmpvecarr3E * exact = mrbf[0]->getDisplacements();
+    mimmo::dmpvecarr3E * approx = mrbf[1]->getDisplacements();
+    double maxdiff = 0.0;
+    for(auto it=exact->begin(); it!=exact->end(); ++it){
+        maxdiff = std::max(maxdiff, norm2(approx->at(it.getId()) - *it));
+    }
+
+    std::cout<<"exact evaluation        : "<<elapsed[0]<<" s"<<std::endl;
+    std::cout<<"hierarchical evaluation : "<<elapsed[1]<<" s"<<std::endl;
+    std::cout<<"max error               : "<<maxdiff<<" (bound "<<tol*sumWeights<<")"<<std::endl;
+    std::cout<<"far-field approximations: "<<mrbf[1]->getFarFieldApproximationsCount()<<std::endl;
+
+    //the hierarchical evaluation must actually approximate far clusters.
+    bool check = (exact->size() == approx->size()) && (maxdiff <= tol*sumWeights);
+    check = check && (mrbf[0]->getFarFieldApproximationsCount() == 0);
+    check = check && (mrbf[1]->getFarFieldApproximationsCount() > 0);
+
+    delete mrbf[0];
+    delete mrbf[1];
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+/*!
+ * Interpolation: weights computed with the hierarchical matrix-free solver must
+ * reproduce the imposed displacements on the RBF nodes.
+ */
+int test2() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud = createCloud(12);
+
+    //RBF nodes coincident with the cloud vertices
+    dvecarr3E rbfpoints, rbfdispls;
+    long nnodes = cloud->getNVertices();
+    for(long id=0; id<nnodes; ++id){
+        darray3E coords = cloud->getVertexCoords(id);
+        rbfpoints.push_back(coords);
+        rbfdispls.push_back({{0.01*std::sin(5.0*coords[0]), 0.01*coords[1]*coords[2], 0.0}});
+    }
+
+    mimmo::MRBF * mrbf = new mimmo::MRBF(mimmo::MRBFSol::WHOLE);
+    mrbf->setGeometry(cloud);
+    mrbf->setNode(rbfpoints);
+    mrbf->setDisplacements(rbfdispls);
+    mrbf->setFunction(mimmo::MRBFBasisFunction::DSIGMOID);
+    mrbf->setSupportRadiusReal(0.1);
+    mrbf->setHierarchicalTolerance(1.0E-08);
+    mrbf->exec();
+
+    mimmo::dmpvecarr3E * displ = mrbf->getDisplacements();
+    double maxdiff = 0.0;
+    for(long id=0; id<nnodes; ++id){
+        maxdiff = std::max(maxdiff, norm2(displ->at(id) - rbfdispls[id]));
+    }
+    std::cout<<"interpolation max error on nodes: "<<maxdiff<<std::endl;
+    bool check = (maxdiff <= 1.0E-06);
+    std::cout<<"weights solver used     : "<<int(mrbf->getWeightsSolver())<<std::endl;
+    //the weights have to be computed by the matrix-free solver, not by the dense fallback.
+    check = check && (mrbf->getWeightsSolver() == mimmo::MRBFWeightsSolver::HIERARCHICAL);
+
+    delete mrbf;
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		int val = 1;
+        try{
+            /**<Calling mimmo Test routines*/
+            val = test1() ;
+            val = std::max(val, test2());
+        }
+        catch(std::exception & e){
+            std::cout<<"test_manipulators_00004 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,145 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+ #include "mimmo_core.hpp"
+ #include "Partition.hpp"
+ #include "../TestMeshes.hpp"
+
+// =================================================================================== //
+/*!
+ * Distributed graph partitioning of a volume mesh and of its boundary: partition of
+ * a serial mesh, then repartition of the distributed mesh with cell weights, and
+ * partition of a serial mesh with cell weights.
+ */
+
+//count the interior cells of a geometry over all the processes
+long countGlobalCells(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo){
+    long count = geo->getNInternals();
+    MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_LONG, MPI_SUM, geo->getCommunicator());
+    return count;
+}
+
+//proper core of the test
+int testcore() {
+
+    //create bulk mesh and extract its boundary, both on rank 0
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> bulk = createTestVolumeMesh({{12,10,8}});
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> boundary = bulk->extractBoundaryMesh();
+    long nbulk = countGlobalCells(bulk);
+    long nboundary = countGlobalCells(boundary);
+
+    mimmo::Partition * part = new mimmo::Partition();
+    part->setGeometry(bulk);
+    part->setBoundaryGeometry(boundary);
+    part->setPartitionMethod(mimmo::PartitionMethod::PARTGRAPH);
+    part->exec();
+
+    bitpit::Logger & log = bulk->getLog();
+    log.setPriority(bitpit::log::Priority::NORMAL);
+    log<<"partition edge-cut : "<<part->getEdgeCut()<<", imbalance : "<<part->getImbalance()
+       <<", boundary imbalance : "<<part->getBoundaryImbalance()<<std::endl;
+
+    bool check = (countGlobalCells(bulk) == nbulk) && (countGlobalCells(boundary) == nboundary);
+    check = check && bulk->isDistributed() && boundary->isDistributed();
+    check = check && (part->getEdgeCut() > 0) && (part->getImbalance() < 1.1) && (part->getBoundaryImbalance() < 1.5);
+
+    //repartition of the distributed mesh, doubling the weight of the cells with x < 0.5
+    std::unordered_map<long, int> weights;
+    for(const bitpit::Cell & cell : bulk->getCells()){
+        if(cell.isInterior()){
+            weights[cell.getId()] = (bulk->getPatch()->evalCellCentroid(cell.getId())[0] < 0.5) ? 2 : 1;
+        }
+    }
+    part->setCellWeights(weights);
+    part->exec();
+    log<<"weighted repartition edge-cut : "<<part->getEdgeCut()<<", imbalance : "<<part->getImbalance()<<std::endl;
+
+    check = check && (countGlobalCells(bulk) == nbulk) && (countGlobalCells(boundary) == nboundary);
+    check = check && (part->getImbalance() < 1.1);
+
+    //partition of a serial mesh with cell weights given on rank 0: the weights have to
+    //follow the cells spread over the processes before the graph partitioning.
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> weighted = createTestVolumeMesh({{12,10,8}});
+    auto cellWeight = [&weighted](long id){
+        return (weighted->getPatch()->evalCellCentroid(id)[0] < 0.25) ? 8 : 1;
+    };
+    std::unordered_map<long, int> serialWeights;
+    for(const bitpit::Cell & cell : weighted->getCells()){
+        serialWeights[cell.getId()] = cellWeight(cell.getId());
+    }
+    mimmo::Partition * weightedPart = new mimmo::Partition();
+    weightedPart->setGeometry(weighted);
+    weightedPart->setPartitionMethod(mimmo::PartitionMethod::PARTGRAPH);
+    weightedPart->setCellWeights(serialWeights);
+    weightedPart->exec();
+
+    std::vector<double> loads(weighted->getProcessorCount(), 0.0);
+    for(const bitpit::Cell & cell : weighted->getCells()){
+        if(cell.isInterior())   loads[weighted->getRank()] += double(cellWeight(cell.getId()));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, loads.data(), int(loads.size()), MPI_DOUBLE, MPI_SUM, weighted->getCommunicator());
+    double total = 0.0, maxload = 0.0;
+    for(double load : loads){
+        total += load;
+        maxload = std::max(maxload, load);
+    }
+    double imbalance = maxload * double(loads.size()) / total;
+    log<<"weighted partition of serial mesh, imbalance of the given weights : "<<imbalance<<std::endl;
+    check = check && (countGlobalCells(weighted) == nbulk) && (imbalance < 1.1);
+
+    MPI_Allreduce(MPI_IN_PLACE, &check, 1, MPI_C_BOOL, MPI_LAND, bulk->getCommunicator());
+    log<<"test passed : "<<check<<std::endl;
+
+    delete weightedPart;
+    delete part;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = testcore();
+	}
+	catch(std::exception & e){
+		std::cout<<"test_parallel_00004 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
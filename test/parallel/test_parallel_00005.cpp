@@ -0,0 +1,134 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+ #include "mimmo_core.hpp"
+ #include "Partition.hpp"
+ #include "../TestMeshes.hpp"
+
+// =================================================================================== //
+/*!
+ * Ghost data exchange of MimmoPiercedVector: complete exchange, exchange of changed
+ * entries only overlapped with local work, and consistency of point consecutive ids.
+ */
+
+//proper core of the test
+int testcore() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createTestVolumeMesh({{10,10,10}});
+
+    mimmo::Partition * part = new mimmo::Partition();
+    part->setGeometry(mesh);
+    part->setPartitionMethod(mimmo::PartitionMethod::PARTGEOM);
+    part->setPlotInExecution(false);
+    part->exec();
+    delete part;
+
+    bitpit::Logger & log = mesh->getLog();
+    log.setPriority(bitpit::log::Priority::NORMAL);
+
+    //complete exchange of cell data, ghosts initialized to a wrong value
+    mimmo::MimmoPiercedVector<double> field(mesh, mimmo::MPVLocation::CELL);
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        field.insert(cell.getId(), cell.isInterior() ? double(cell.getId()) : -1.0);
+    }
+    field.beginCommunicateData();
+    bool check = field.isCommunicatingData();
+    field.endCommunicateData();
+    check = check && !field.isCommunicatingData();
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        check = check && (field.at(cell.getId()) == double(cell.getId()));
+    }
+    log<<"complete exchange : "<<check<<std::endl;
+
+    //exchange of changed entries only: double the value of interior cells with x < 0.5
+    livector1D changed;
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        if(cell.isInterior() && mesh->getPatch()->evalCellCentroid(cell.getId())[0] < 0.5){
+            field.at(cell.getId()) *= 2.0;
+            changed.push_back(cell.getId());
+        }
+    }
+    field.beginCommunicateData(&changed);
+    //local work on interior entries while ghost data are in flight
+    double sum = 0.0;
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        if(cell.isInterior())   sum += field.at(cell.getId());
+    }
+    field.endCommunicateData();
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        double expected = double(cell.getId());
+        if (mesh->getPatch()->evalCellCentroid(cell.getId())[0] < 0.5)  expected *= 2.0;
+        check = check && (field.at(cell.getId()) == expected);
+    }
+    log<<"changed entries exchange : "<<check<<", local sum "<<sum<<std::endl;
+
+    //consecutive ids of ghost points equal to the ones assigned by their owners
+    mesh->updatePointGhostExchangeInfo();
+    lilimap consecutive = mesh->getMapDataInv(true);
+    mimmo::MimmoPiercedVector<long> consecutiveField(mesh, mimmo::MPVLocation::POINT);
+    for(const bitpit::Vertex & vertex : mesh->getVertices()){
+        consecutiveField.insert(vertex.getId(), vertex.isInterior() ? consecutive.at(vertex.getId()) : -1);
+    }
+    consecutiveField.communicateData();
+    long maxConsecutive = -1;
+    for(const bitpit::Vertex & vertex : mesh->getVertices()){
+        check = check && (consecutiveField.at(vertex.getId()) == consecutive.at(vertex.getId()));
+        maxConsecutive = std::max(maxConsecutive, consecutive.at(vertex.getId()));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &maxConsecutive, 1, MPI_LONG, MPI_MAX, mesh->getCommunicator());
+    check = check && (maxConsecutive == mesh->getNGlobalVertices() - 1) && (mesh->getNGlobalVertices() == 11*11*11);
+    log<<"point consecutive ids : "<<check<<std::endl;
+
+    MPI_Allreduce(MPI_IN_PLACE, &check, 1, MPI_C_BOOL, MPI_LAND, mesh->getCommunicator());
+    log<<"test passed : "<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = testcore();
+	}
+	catch(std::exception & e){
+		std::cout<<"test_parallel_00005 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
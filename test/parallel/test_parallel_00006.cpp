@@ -0,0 +1,128 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+ #include "mimmo_core.hpp"
+ #include "Partition.hpp"
+ #include "../TestMeshes.hpp"
+
+// =================================================================================== //
+/*!
+ * Distance field of a surface on the points and on the cells of a partitioned volume
+ * mesh (distanceFieldUtils): values must match the exact distance and ghost values
+ * must be equal to the ones of their owners.
+ */
+
+//check a distance field against the exact one and against the values of the owners of the ghosts
+bool checkDistance(mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh, bitpit::PiercedVector<double> & dist,
+                   bool onPoints, double maxdist, double & maxerr){
+
+    mimmo::MPVLocation location = onPoints ? mimmo::MPVLocation::POINT : mimmo::MPVLocation::CELL;
+    mimmo::MimmoPiercedVector<double> owners(mesh, location);
+    std::vector<long> ids = onPoints ? mesh->getVerticesIds() : mesh->getCellsIds();
+
+    bool check = true;
+    for(long id : ids){
+        double exact = onPoints ? mesh->getVertexCoords(id)[2] : mesh->evalCellCentroid(id)[2];
+        if(exact < maxdist - 1.0E-12){
+            check = check && dist.exists(id);
+            if(dist.exists(id))  maxerr = std::max(maxerr, std::abs(dist[id] - exact));
+        }else if(exact > maxdist + 1.0E-12){
+            check = check && !dist.exists(id);
+        }
+        //ghost values are overwritten by the ones of their owners, -1 if not computed
+        owners.insert(id, dist.exists(id) ? dist[id] : -1.0);
+    }
+
+    if(onPoints)    mesh->updatePointGhostExchangeInfo();
+    owners.communicateData();
+    for(long id : ids){
+        double local = dist.exists(id) ? dist[id] : -1.0;
+        check = check && (owners.at(id) == local);
+    }
+    return check;
+}
+
+//proper core of the test
+int testcore() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createTestVolumeMesh({{12,12,12}});
+    // surface not conformal to the mesh, to test the transport of closest cells
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> surface = createBottomSurface(5);
+
+    mimmo::Partition * part = new mimmo::Partition();
+    part->setGeometry(mesh);
+    part->setPartitionMethod(mimmo::PartitionMethod::PARTGEOM);
+    part->setPlotInExecution(false);
+    part->exec();
+    delete part;
+
+    bitpit::Logger & log = mesh->getLog();
+    log.setPriority(bitpit::log::Priority::NORMAL);
+
+    double maxdist = 0.45;
+    bitpit::PiercedVector<double> pdist = mimmo::distanceFieldUtils::pointsDistance(*mesh, *surface, maxdist);
+    bitpit::PiercedVector<double> cdist = mimmo::distanceFieldUtils::cellsDistance(*mesh, *surface, maxdist);
+
+    double maxerr = 0.0;
+    bool check = checkDistance(mesh, pdist, true, maxdist, maxerr);
+    log<<"points distance : "<<check<<std::endl;
+    check = check && checkDistance(mesh, cdist, false, maxdist, maxerr);
+    log<<"cells distance : "<<check<<std::endl;
+
+    //exact distance from the bottom face is the z coordinate.
+    MPI_Allreduce(MPI_IN_PLACE, &maxerr, 1, MPI_DOUBLE, MPI_MAX, mesh->getCommunicator());
+    check = check && (maxerr <= 1.0E-10);
+    log<<"max error : "<<maxerr<<std::endl;
+
+    MPI_Allreduce(MPI_IN_PLACE, &check, 1, MPI_C_BOOL, MPI_LAND, mesh->getCommunicator());
+    log<<"test passed : "<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = testcore();
+	}
+	catch(std::exception & e){
+		std::cout<<"test_parallel_00006 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
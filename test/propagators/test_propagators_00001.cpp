@@ -119,13 +119,11 @@ mimmo::MimmoSharedPointer<mimmo::MimmoObject> createTestVolumeMesh(std::vector<l
 // =================================================================================== //
 
 /*
-    Testing scalar and vector field propagation.
+    Create the boundary patch of the test volume mesh carrying Dirichlet conditions.
 */
-int test1() {
+mimmo::MimmoSharedPointer<mimmo::MimmoObject> createDirichletPatch(mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh,
+                                                                   std::vector<long> &bc1list, std::vector<long> &bc2list){
 
-    std::vector<long> bc1list, bc2list;
-    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createTestVolumeMesh(bc1list, bc2list);
-    //serial test.
     livector1D cellInterfaceList1 = mesh->getInterfaceFromVertexList(bc1list, true, true);
     livector1D cellInterfaceList2 = mesh->getInterfaceFromVertexList(bc2list, true, true);
 
@@ -156,6 +154,19 @@ int test1() {
     bdirMesh->updateAdjacencies();
     bdirMesh->update();
 
+    return bdirMesh;
+}
+
+/*
+    Testing scalar and vector field propagation.
+*/
+int test1() {
+
+    std::vector<long> bc1list, bc2list;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createTestVolumeMesh(bc1list, bc2list);
+    //serial test.
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> bdirMesh = createDirichletPatch(mesh, bc1list, bc2list);
+
     bool check = false;
     long targetNode =  (10 +1)*(6+1)*3 + (6+1)*5 + 3;
 
@@ -229,6 +240,110 @@ int test1() {
 
 // =================================================================================== //
 
+/*
+    Testing repeated propagations with the Laplacian operator cache:
+    only the boundary condition values change between the executions, then
+    the mesh is deformed and the operator has to be rebuilt.
+*/
+int test2() {
+
+    std::vector<long> bc1list, bc2list;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createTestVolumeMesh(bc1list, bc2list);
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> bdirMesh = createDirichletPatch(mesh, bc1list, bc2list);
+
+    bool check = false;
+    long targetNode =  (10 +1)*(6+1)*3 + (6+1)*5 + 3;
+
+    mimmo::MimmoPiercedVector<double> bc_surf_field;
+    bc_surf_field.setGeometry(bdirMesh);
+    bc_surf_field.setDataLocation(mimmo::MPVLocation::POINT);
+
+    mimmo::PropagateScalarField * prop = new mimmo::PropagateScalarField();
+    prop->setName("test00001_PropagateScalarFieldCached");
+    prop->setGeometry(mesh);
+    prop->addDirichletBoundaryPatch(bdirMesh);
+    prop->addDirichletConditions(&bc_surf_field);
+    prop->setOperatorCache(true);
+
+    mimmo::MimmoPiercedVector<std::array<double,3>> bc_surf_3Dfield;
+    bc_surf_3Dfield.setGeometry(bdirMesh);
+    bc_surf_3Dfield.setDataLocation(mimmo::MPVLocation::POINT);
+
+    mimmo::PropagateVectorField * prop3D = new mimmo::PropagateVectorField();
+    prop3D->setName("test00001_PropagateVectorFieldCached");
+    prop3D->setGeometry(mesh);
+    prop3D->addDirichletBoundaryPatch(bdirMesh);
+    prop3D->addDirichletConditions(&bc_surf_3Dfield);
+    prop3D->setDamping(true);
+    prop3D->setDampingType(1);
+    prop3D->setDampingDecayFactor(1.0);
+    prop3D->setDampingInnerDistance(0.5);
+    prop3D->setDampingOuterDistance(3.5);
+    prop3D->setOperatorCache(true);
+
+    for(auto & val : bc1list){
+        bc_surf_field.insert(val, 0.0);
+        bc_surf_3Dfield.insert(val, {{0.0,0.0,0.0}});
+    }
+    for(auto & val : bc2list){
+        bc_surf_field.insert(val, 0.0);
+        bc_surf_3Dfield.insert(val, {{0.0,0.0,0.0}});
+    }
+
+    for(int run=1; run<=3; ++run){
+        double factor = double(run);
+
+        //change the bc values only: the operator of the first run is reused.
+        for(auto & val : bc1list){
+            bc_surf_field.at(val) = 10.0*factor;
+            bc_surf_3Dfield.at(val) = {{10.0*factor, 7.0*factor, -4.0*factor}};
+        }
+
+        prop->exec();
+        prop3D->exec();
+
+        auto values = prop->getPropagatedField();
+        check = check || (std::abs(values->at(targetNode)-5.0*factor) > 1.0E-6);
+
+        auto values3D = prop3D->getPropagatedField();
+        check = check || (norm2(values3D->at(targetNode)-std::array<double,3>({{5.0*factor,3.5*factor,-2.0*factor}})) > 1.0E-6);
+    }
+
+    //a non uniform stretch of the mesh renews its vertices revision: the cached operator
+    //is rebuilt and the result equals the one of an uncached propagator.
+    for(const bitpit::Vertex & vertex : mesh->getVertices()){
+        darray3E coords = vertex.getCoords();
+        coords[0] += 0.05*coords[0]*coords[0];
+        mesh->modifyVertex(coords, vertex.getId());
+    }
+    mesh->update();
+    prop->exec();
+
+    mimmo::PropagateScalarField * fresh = new mimmo::PropagateScalarField();
+    fresh->setName("test00001_PropagateScalarFieldFresh");
+    fresh->setGeometry(mesh);
+    fresh->addDirichletBoundaryPatch(bdirMesh);
+    fresh->addDirichletConditions(&bc_surf_field);
+    fresh->exec();
+
+    auto cachedValues = prop->getPropagatedField();
+    auto freshValues = fresh->getPropagatedField();
+    double maxdiff = 0.0;
+    for(auto it = freshValues->begin(); it != freshValues->end(); ++it){
+        maxdiff = std::max(maxdiff, std::abs(cachedValues->at(it.getId()) - *it));
+    }
+    std::cout<<"cached operator after mesh deformation, max difference from uncached: "<<maxdiff<<std::endl;
+    check = check || (maxdiff > 1.0E-6);
+
+    delete fresh;
+    delete prop3D;
+    delete prop;
+
+    return check;
+}
+
+// =================================================================================== //
+
 int main( int argc, char *argv[] ) {
 
 	BITPIT_UNUSED(argc);
@@ -241,6 +356,7 @@ int main( int argc, char *argv[] ) {
         int val = 1;
         try{
             val = test1() ;
+            val = std::max(val, test2());
         }
         catch(std::exception & e){
             std::cout<<"test_propagators_00001 exited with an error of type : "<<e.what()<<std::endl;
@@ -0,0 +1,240 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2017 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_propagators.hpp"
+#include "../TestMeshes.hpp"
+#include <chrono>
+
+/*
+ * Test 00004
+ * Benchmark of the Laplacian solver backends of PropagateField: KSP on the assembled
+ * matrix against the matrix-free multigrid one. Solutions and execution times are compared
+ * on a hexa box mesh; the memory allocated by the multigrid hierarchy is reported next to
+ * an estimate of the storage of the assembled KSP matrix.
+ */
+
+// =================================================================================== //
+/*!
+ * Create a unit cube hexa mesh of n^3 cells and the list of the vertices of its bottom
+ * (z=0) and top (z=1) faces.
+ */
+mimmo::MimmoSharedPointer<mimmo::MimmoObject> createBoxMesh(int n, std::vector<long> & bottom, std::vector<long> & top){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createBoxMesh(n);
+    mesh->updateInterfaces();
+
+    bottom.clear();
+    top.clear();
+    for(int j=0; j<=n; ++j){
+        for(int i=0; i<=n; ++i){
+            bottom.push_back((n+1)*j + i);
+            top.push_back((n+1)*(n+1)*n + (n+1)*j + i);
+        }
+    }
+    return mesh;
+}
+
+// =================================================================================== //
+/*!
+ * Create the boundary patch of the box mesh made by its bottom and top faces.
+ */
+mimmo::MimmoSharedPointer<mimmo::MimmoObject> createDirichletPatch(mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh,
+                                                                   std::vector<long> & bottom, std::vector<long> & top){
+
+    std::vector<long> vertices(bottom);
+    vertices.insert(vertices.end(), top.begin(), top.end());
+    livector1D interfaces = mesh->getInterfaceFromVertexList(vertices, true, true);
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> bdirMesh(new mimmo::MimmoObject(1));
+    bdirMesh->getPatch()->reserveVertices(vertices.size());
+    bdirMesh->getPatch()->reserveCells(interfaces.size());
+    for(long val : vertices){
+        bdirMesh->addVertex(mesh->getVertexCoords(val), val);
+    }
+    for(long val : interfaces){
+        int sizeconn = mesh->getInterfaces().at(val).getConnectSize();
+        long * conn = mesh->getInterfaces().at(val).getConnect();
+        bdirMesh->addConnectedCell(std::vector<long>(&conn[0], &conn[sizeconn]),
+                                   bitpit::ElementType::QUAD, val);
+    }
+    bdirMesh->updateAdjacencies();
+    bdirMesh->update();
+    return bdirMesh;
+}
+
+// =================================================================================== //
+/*!
+ * Scalar propagation with unit value on the bottom face and null value on the top one:
+ * the solution is linear along z. KSP and multigrid backends are compared.
+ */
+int test1() {
+
+    int n = 30;
+    std::vector<long> bottom, top;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createBoxMesh(n, bottom, top);
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> bdirMesh = createDirichletPatch(mesh, bottom, top);
+
+    mimmo::MimmoPiercedVector<double> bc_surf_field(bdirMesh, mimmo::MPVLocation::POINT);
+    for(long val : bottom)  bc_surf_field.insert(val, 1.0);
+    for(long val : top)     bc_surf_field.insert(val, 0.0);
+
+    std::vector<mimmo::LaplaceSolverType> types = {mimmo::LaplaceSolverType::KSP, mimmo::LaplaceSolverType::MULTIGRID};
+    std::vector<dmpvector1D> results(2);
+    std::vector<double> elapsed(2);
+    for(int i=0; i<2; ++i){
+        mimmo::PropagateScalarField * prop = new mimmo::PropagateScalarField();
+        prop->setGeometry(mesh);
+        prop->addDirichletBoundaryPatch(bdirMesh);
+        prop->addDirichletConditions(&bc_surf_field);
+        prop->setTolerance(1.0E-10);
+        prop->setSolverType(types[i]);
+
+        auto start = std::chrono::steady_clock::now();
+        prop->exec();
+        auto stop = std::chrono::steady_clock::now();
+        elapsed[i] = std::chrono::duration<double>(stop - start).count();
+        results[i] = *(prop->getPropagatedField());
+        delete prop;
+    }
+
+    double maxdiff = 0.0, maxerr = 0.0;
+    for(auto it=results[0].begin(); it!=results[0].end(); ++it){
+        double exact = 1.0 - mesh->getVertexCoords(it.getId())[2];
+        maxdiff = std::max(maxdiff, std::abs(results[1].at(it.getId()) - *it));
+        maxerr = std::max(maxerr, std::abs(results[1].at(it.getId()) - exact));
+    }
+
+    //memory of the operators: the multigrid one is the storage allocated by its hierarchy,
+    //the KSP one is not measured but estimated from the non-zeros of the Laplacian, counting
+    //one index and one value for each non-zero both in the stencils and in the assembled
+    //matrix (PETSc internal work space and the solver preconditioner are not included).
+    lilimap dataInv = mesh->getMapDataInv(true);
+    mimmo::GraphLaplMultigrid multigrid;
+    multigrid.build(mesh, dataInv);
+    std::vector<long> rows;
+    for(long val : bottom)  rows.push_back(dataInv.at(val));
+    for(long val : top)     rows.push_back(dataInv.at(val));
+    multigrid.setConstraints(rows);
+    dvector1D rhs(multigrid.getRowCount(), 0.0), sol;
+    for(long val : bottom)  rhs[dataInv.at(val)] = 1.0;
+    multigrid.solve(rhs, sol);
+
+    std::size_t nnz = 0;
+    for(long id : mesh->getVertices().getIds()){
+        nnz += mesh->getPointConnectivity(id).size() + 1;
+    }
+    std::size_t kspMemoryEstimate = 2*nnz*(sizeof(long) + sizeof(double));
+
+    std::cout<<"points                  : "<<mesh->getNVertices()<<std::endl;
+    std::cout<<"KSP solver              : "<<elapsed[0]<<" s, estimated matrix storage "<<kspMemoryEstimate/1024<<" KB"<<std::endl;
+    std::cout<<"multigrid solver        : "<<elapsed[1]<<" s, allocated operator memory "<<multigrid.getMemoryUsage()/1024<<" KB, "
+             <<multigrid.getLevelCount()<<" levels"<<std::endl;
+    std::cout<<"max difference KSP/MG   : "<<maxdiff<<std::endl;
+    std::cout<<"max error MG            : "<<maxerr<<std::endl;
+
+    bool check = (results[0].size() == results[1].size()) && (maxdiff <= 1.0E-6) && (maxerr <= 1.0E-6);
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+/*!
+ * Vector propagation with damping and narrow band control: the multigrid backend must
+ * reproduce the KSP solution.
+ */
+int test2() {
+
+    int n = 16;
+    std::vector<long> bottom, top;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createBoxMesh(n, bottom, top);
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> bdirMesh = createDirichletPatch(mesh, bottom, top);
+
+    mimmo::MimmoPiercedVector<std::array<double,3>> bc_surf_field(bdirMesh, mimmo::MPVLocation::POINT);
+    for(long val : bottom){
+        darray3E coords = mesh->getVertexCoords(val);
+        bc_surf_field.insert(val, {{0.1*std::sin(3.0*coords[0]), 0.05*coords[1], 0.1}});
+    }
+    for(long val : top)     bc_surf_field.insert(val, {{0.0, 0.0, 0.0}});
+
+    std::vector<mimmo::LaplaceSolverType> types = {mimmo::LaplaceSolverType::KSP, mimmo::LaplaceSolverType::MULTIGRID};
+    std::vector<dmpvecarr3E> results(2);
+    for(int i=0; i<2; ++i){
+        mimmo::PropagateVectorField * prop = new mimmo::PropagateVectorField();
+        prop->setGeometry(mesh);
+        prop->addDirichletBoundaryPatch(bdirMesh);
+        prop->addDirichletConditions(&bc_surf_field);
+        prop->setTolerance(1.0E-10);
+        prop->setDamping(true);
+        prop->setDampingType(0);
+        prop->setDampingDecayFactor(1.0);
+        prop->setDampingInnerDistance(0.1);
+        prop->setDampingOuterDistance(0.5);
+        prop->setNarrowBand(true);
+        prop->setNarrowBandWidth(0.3);
+        prop->setNarrowBandRelaxation(0.5);
+        prop->setSolverType(types[i]);
+        prop->exec();
+        results[i] = *(prop->getPropagatedField());
+        delete prop;
+    }
+
+    double maxdiff = 0.0;
+    for(auto it=results[0].begin(); it!=results[0].end(); ++it){
+        maxdiff = std::max(maxdiff, norm2(results[1].at(it.getId()) - *it));
+    }
+    std::cout<<"max difference KSP/MG with damping and narrow band : "<<maxdiff<<std::endl;
+
+    bool check = (results[0].size() == results[1].size()) && (maxdiff <= 1.0E-6);
+
+    std::cout<<"test passed: "<<check<<std::endl;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		int val = 1;
+        try{
+            /**<Calling mimmo Test routines*/
+            val = test1() ;
+            val = std::max(val, test2());
+        }
+        catch(std::exception & e){
+            std::cout<<"test_propagators_00004 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}